@@ -144,6 +144,38 @@
  */
 #define ANJAY_WITH_NET_STATS
 
+/**
+ * Enable support for per-server LwM2M operation statistics, i.e. request
+ * counts, error counts and handling time histograms of each operation
+ * (<c>anjay_get_operation_stats()</c> and
+ * <c>anjay_reset_operation_stats()</c> APIs).
+ */
+/* #undef ANJAY_WITH_OPERATION_STATS */
+
+/**
+ * Enable support for per-subsystem heap usage accounting and memory budgets
+ * (<c>anjay_get_memory_stats()</c> and <c>anjay_set_memory_budget()</c>
+ * APIs).
+ */
+/* #undef ANJAY_WITH_MEMORY_STATS */
+
+/**
+ * Enable profiling of scheduler jobs posted by the library, i.e. invocation
+ * counts, run times and scheduling lags of each job function
+ * (<c>anjay_dump_sched_job_stats()</c> and
+ * <c>anjay_reset_sched_job_stats()</c> APIs).
+ */
+/* #undef ANJAY_WITH_SCHED_PROFILING */
+
+/**
+ * Enable support for user-registered request lifecycle tracing hooks
+ * (<c>anjay_set_trace_handler()</c> API declared in <c>anjay/trace.h</c>).
+ *
+ * If @ref ANJAY_WITH_THREAD_SAFETY is also enabled, requires C11
+ * <c>stdatomic.h</c> header to be available.
+ */
+/* #undef ANJAY_WITH_TRACE_HOOKS */
+
 /**
  * Enable support for the <c>anjay_resource_observation_status()</c> API.
  */
@@ -171,6 +203,18 @@
  */
 #define ANJAY_WITH_EVENT_LOOP
 
+/**
+ * Enable submitting changes reported via <c>anjay_notify_changed()</c> through
+ * a bounded lock-free queue, so that calling it from other threads does not
+ * need to wait for the <c>anjay_t</c> mutex (which may be held e.g. for the
+ * duration of a DTLS handshake). The queue is drained by a scheduler job.
+ *
+ * Requires @ref ANJAY_WITH_THREAD_SAFETY and
+ * <c>AVS_COMMONS_SCHED_THREAD_SAFE</c> to be enabled, and C11
+ * <c>stdatomic.h</c> header to be available.
+ */
+/* #undef ANJAY_WITH_LOCK_FREE_NOTIFY */
+
 /**
  * Enable support for features new to LwM2M protocol version 1.1.
  */
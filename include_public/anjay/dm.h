@@ -168,6 +168,35 @@ int anjay_dm_list_instances_SINGLE(anjay_t *anjay,
                                    const anjay_dm_object_def_t *const *obj_ptr,
                                    anjay_dm_list_ctx_t *ctx);
 
+/**
+ * A handler that checks whether an Object Instance with a given Instance ID is
+ * PRESENT, without enumerating all of them.
+ *
+ * If implemented, it is used instead of @ref anjay_dm_list_instances_t whenever
+ * the library needs to check presence of a single Object Instance, e.g. when
+ * handling requests targeting an Object Instance or its Resources. Its result
+ * MUST be consistent with @ref anjay_dm_list_instances_t.
+ *
+ * @param      anjay       Anjay object to operate on.
+ * @param      obj_ptr     Object definition pointer, as passed to
+ *                         @ref anjay_register_object .
+ * @param      iid         Instance ID to check.
+ * @param[out] out_present Shall be set to true if the Object Instance is
+ *                         PRESENT, or false otherwise.
+ *
+ * @returns This handler should return:
+ * - 0 on success,
+ * - a negative value in case of error. If it returns one of ANJAY_ERR_
+ *   constants, the response message will have an appropriate CoAP response
+ *   code. Otherwise, the device will respond with an unspecified (but valid)
+ *   error code.
+ */
+typedef int
+anjay_dm_instance_present_t(anjay_t *anjay,
+                            const anjay_dm_object_def_t *const *obj_ptr,
+                            anjay_iid_t iid,
+                            bool *out_present);
+
 /**
  * A handler that shall reset Object Instance to its default (after creational)
  * state.
@@ -318,6 +347,43 @@ anjay_dm_list_resources_t(anjay_t *anjay,
                           anjay_iid_t iid,
                           anjay_dm_resource_list_ctx_t *ctx);
 
+/**
+ * A handler that returns the kind and presence of a single SUPPORTED Resource,
+ * without enumerating all of them. Called only if the Object Instance is
+ * PRESENT.
+ *
+ * If implemented, it is used instead of @ref anjay_dm_list_resources_t whenever
+ * the library needs information about a single Resource, e.g. when handling
+ * requests targeting a Resource or Resource Instance. Its results MUST be
+ * consistent with @ref anjay_dm_list_resources_t.
+ *
+ * @param      anjay        Anjay object to operate on.
+ * @param      obj_ptr      Object definition pointer, as passed to
+ *                          @ref anjay_register_object .
+ * @param      iid          Object Instance ID.
+ * @param      rid          Resource ID to check.
+ * @param[out] out_kind     Shall be set to the kind of the Resource, as it
+ *                          would be passed to @ref anjay_dm_emit_res .
+ * @param[out] out_presence Shall be set to the presence of the Resource, as it
+ *                          would be passed to @ref anjay_dm_emit_res .
+ *
+ * @returns This handler should return:
+ * - 0 on success,
+ * - @ref ANJAY_ERR_NOT_FOUND if the Resource is not SUPPORTED, i.e. it would
+ *   not be returned by @ref anjay_dm_list_resources_t at all,
+ * - a negative value in case of error. If it returns one of ANJAY_ERR_
+ *   constants, the response message will have an appropriate CoAP response
+ *   code. Otherwise, the device will respond with an unspecified (but valid)
+ *   error code.
+ */
+typedef int
+anjay_dm_resource_present_t(anjay_t *anjay,
+                            const anjay_dm_object_def_t *const *obj_ptr,
+                            anjay_iid_t iid,
+                            anjay_rid_t rid,
+                            anjay_dm_resource_kind_t *out_kind,
+                            anjay_dm_resource_presence_t *out_presence);
+
 /**
  * A handler that reads the Resource or Resource Instance value, called only if
  * the Resource is PRESENT and is one of the @ref ANJAY_DM_RES_R,
@@ -363,6 +429,42 @@ anjay_dm_resource_read_t(anjay_t *anjay,
                          anjay_riid_t riid,
                          anjay_output_ctx_t *ctx);
 
+/**
+ * A handler that reads values of all Resources of an Object Instance in a
+ * single call, called only if the Object Instance is PRESENT.
+ *
+ * If implemented, it is used instead of calling
+ * @ref anjay_dm_list_resources_t and @ref anjay_dm_resource_read_t for each
+ * Resource whenever a whole Object Instance is read, i.e. when handling Read,
+ * Observe or Read-Composite on an Object or Object Instance path. It is not
+ * used for requests issued by the Bootstrap Server, as these may also target
+ * Resources that are not readable otherwise.
+ *
+ * For each Resource, the handler shall call @ref anjay_ret_resource_path
+ * (preceded by @ref anjay_ret_multiple_resource in case of Multiple Resources)
+ * followed by one of the <c>anjay_ret_*</c> value functions. Resources MUST be
+ * returned in strictly ascending order of Resource IDs. Only Resources that are
+ * PRESENT and readable (i.e. of kind @ref ANJAY_DM_RES_R,
+ * @ref ANJAY_DM_RES_RW, @ref ANJAY_DM_RES_RM or @ref ANJAY_DM_RES_RWM) shall
+ * be returned - the library does not verify that.
+ *
+ * @param anjay   Anjay object to operate on.
+ * @param obj_ptr Object definition pointer, as passed to
+ *                @ref anjay_register_object .
+ * @param iid     Object Instance ID.
+ * @param ctx     Output context to write the Resource values to.
+ *
+ * @returns This handler should return:
+ * - 0 on success,
+ * - a negative value in case of error. If it returns one of ANJAY_ERR_
+ *   constants, it will be used as a hint for the CoAP response code to use.
+ */
+typedef int
+anjay_dm_instance_read_t(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_output_ctx_t *ctx);
+
 /**
  * A handler that writes the Resource value, called only if the Resource is
  * SUPPORTED and not of the @ref ANJAY_DM_RES_E kind (as returned by
@@ -953,6 +1055,34 @@ typedef struct {
      * *Attribute Storage* logic.
      */
     anjay_dm_resource_instance_write_attrs_t *resource_instance_write_attrs;
+
+    /**
+     * Check presence of a single Object Instance,
+     * @ref anjay_dm_instance_present_t
+     *
+     * Optional. If NULL, @ref anjay_dm_handlers_t::list_instances is used
+     * instead. Recommended for objects with many instances.
+     */
+    anjay_dm_instance_present_t *instance_present;
+
+    /**
+     * Get kind and presence of a single Resource,
+     * @ref anjay_dm_resource_present_t
+     *
+     * Optional. If NULL, @ref anjay_dm_handlers_t::list_resources is used
+     * instead. Recommended for objects with many resources.
+     */
+    anjay_dm_resource_present_t *resource_present;
+
+    /**
+     * Get values of all Resources of an Object Instance,
+     * @ref anjay_dm_instance_read_t
+     *
+     * Optional. If NULL, @ref anjay_dm_handlers_t::resource_read is called for
+     * each Resource instead. Recommended for objects that can serve all their
+     * Resources from a single snapshot of their state.
+     */
+    anjay_dm_instance_read_t *instance_read;
 } anjay_dm_handlers_t;
 
 /** A struct defining a LwM2M Object. */
@@ -983,6 +1113,15 @@ struct anjay_dm_object_def_struct {
  * Note that it should not be called after a Write performed by the LwM2M
  * server.
  *
+ * If <c>ANJAY_WITH_LOCK_FREE_NOTIFY</c> is enabled, the change is submitted
+ * through a lock-free queue, and this function does not wait for the Anjay
+ * object mutex unless the queue is full. The change is then processed by a job
+ * scheduled on the Anjay scheduler. Changes to the Access Control Object, and
+ * all changes made while any values reported with
+ * <c>anjay_notify_value_changed_*()</c> are stored, are still processed with
+ * the mutex locked, so that their effects are visible when this function
+ * returns.
+ *
  * @param anjay Anjay object to operate on.
  * @param oid   Object ID of the changed Resource.
  * @param iid   Object Instance ID of the changed Resource.
@@ -995,6 +1134,99 @@ int anjay_notify_changed(anjay_t *anjay,
                          anjay_iid_t iid,
                          anjay_rid_t rid);
 
+/**
+ * Path of a changed Resource, as passed to @ref anjay_notify_changed_many.
+ */
+typedef struct {
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+} anjay_notify_path_t;
+
+/**
+ * Notifies the library that the values of multiple Resources changed.
+ *
+ * Equivalent to calling @ref anjay_notify_changed for each of @p paths, but
+ * locks the Anjay object only once and schedules processing of the changes
+ * only once, regardless of the number of paths. This makes it preferable when
+ * many Resources change at the same time, e.g. after a batch of sensor
+ * readings.
+ *
+ * Paths may be passed in any order and may contain duplicates.
+ *
+ * @param anjay       Anjay object to operate on.
+ * @param paths       Array of paths of the changed Resources. May be NULL if
+ *                    @p paths_count is 0.
+ * @param paths_count Number of elements in @p paths.
+ *
+ * @returns 0 on success, a negative value in case of error. In case of error,
+ *          changes of some of the Resources may still have been queued.
+ */
+int anjay_notify_changed_many(anjay_t *anjay,
+                              const anjay_notify_path_t *paths,
+                              size_t paths_count);
+
+/**
+ * Notifies the library that the value of given single-instance Resource
+ * changed, passing the new value along.
+ *
+ * Works like @ref anjay_notify_changed, but if the Resource itself is observed,
+ * the passed value is remembered and used when sending notifications (including
+ * evaluation of the "gt", "lt" and "st" attributes) instead of calling the
+ * <c>resource_read</c> handler. This avoids sampling the Resource again when
+ * reading its value is expensive. Observations of the containing Object
+ * Instance or Object always call the handler. Remembered values count towards
+ * the memory usage of the observe subsystem.
+ *
+ * The remembered value is used until the Resource is reported as changed by
+ * any other means, i.e. @ref anjay_notify_changed or a related function, or a
+ * modification performed by a LwM2M server. The value passed shall thus be
+ * exactly what the <c>resource_read</c> handler would return at that time.
+ *
+ * The Resource is still subject to the usual presence, readability and Access
+ * Control checks. For Multiple-Instance Resources, the value is ignored and the
+ * handler is called as usual.
+ *
+ * Unlike @ref anjay_notify_changed, these functions always wait for the Anjay
+ * object mutex, even if <c>ANJAY_WITH_LOCK_FREE_NOTIFY</c> is enabled.
+ *
+ * @param anjay Anjay object to operate on.
+ * @param oid   Object ID of the changed Resource.
+ * @param iid   Object Instance ID of the changed Resource.
+ * @param rid   Resource ID of the changed Resource.
+ * @param value New value of the Resource. For the string variant, it is copied
+ *              and must not be NULL.
+ *
+ * @returns 0 on success, a negative value in case of error. Failing to
+ *          remember the value is not considered an error; the
+ *          <c>resource_read</c> handler will be called in that case.
+ */
+/**@{*/
+int anjay_notify_value_changed_i64(anjay_t *anjay,
+                                   anjay_oid_t oid,
+                                   anjay_iid_t iid,
+                                   anjay_rid_t rid,
+                                   int64_t value);
+
+int anjay_notify_value_changed_double(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_rid_t rid,
+                                      double value);
+
+int anjay_notify_value_changed_bool(anjay_t *anjay,
+                                    anjay_oid_t oid,
+                                    anjay_iid_t iid,
+                                    anjay_rid_t rid,
+                                    bool value);
+
+int anjay_notify_value_changed_string(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_rid_t rid,
+                                      const char *value);
+/**@}*/
+
 /**
  * Notifies the library that the set of Instances existing in a given Object
  * changed. It may trigger a LwM2M Notify message, update server connections
@@ -1013,6 +1245,66 @@ int anjay_notify_changed(anjay_t *anjay,
  */
 int anjay_notify_instances_changed(anjay_t *anjay, anjay_oid_t oid);
 
+/**
+ * Enables or disables caching of the Resource layout of a given Object.
+ *
+ * When enabled, the result of the <c>list_resources</c> handler (i.e. the set
+ * of Resource IDs, along with their kinds and presence) is remembered for each
+ * Object Instance the first time it is needed, and reused by all subsequent
+ * Read, Observe and Discover operations, without calling the handler again.
+ *
+ * Cached layouts are dropped automatically:
+ *
+ * - when @ref anjay_notify_instances_changed is called for the Object,
+ * - when a transaction on the Object is committed or rolled back, i.e. after
+ *   every Write, Create or Delete operation performed by a LwM2M Server, as
+ *   well as during Bootstrap,
+ * - when the Object is unregistered; caching needs to be enabled again if the
+ *   Object is registered anew.
+ *
+ * If the Object's Resource layout changes in any other way (e.g. a Resource
+ * becomes present or absent as a result of an application-side change), the
+ * application MUST call @ref anjay_notify_resources_layout_changed.
+ *
+ * NOTE: The cache is bypassed while the Object is part of an ongoing
+ * transaction. If the Object implements the <c>resource_present</c> handler,
+ * it is still used for querying single Resources whose layout is not cached
+ * yet.
+ *
+ * @param anjay   Anjay object to operate on.
+ * @param oid     Object ID of a registered Object.
+ * @param enabled Whether the cache shall be enabled.
+ *
+ * @returns 0 on success, a negative value if the Object is not registered or
+ *          in case of an out of memory condition.
+ */
+int anjay_set_resource_layout_caching(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      bool enabled);
+
+/**
+ * Notifies the library that the set of Resources present in a given Object
+ * Instance, or their kinds, changed. Drops the relevant entries of the cache
+ * enabled using @ref anjay_set_resource_layout_caching.
+ *
+ * This function only invalidates the cache. It does not trigger any LwM2M
+ * Notify messages - if the values of the Resources changed as well,
+ * @ref anjay_notify_changed shall be called additionally.
+ *
+ * Calling this function for an Object for which caching is not enabled is a
+ * no-op.
+ *
+ * @param anjay Anjay object to operate on.
+ * @param oid   Object ID of the changed Object.
+ * @param iid   Object Instance ID of the changed Instance, or
+ *              @ref ANJAY_ID_INVALID to invalidate all Instances.
+ *
+ * @returns 0 on success, a negative value in case of error.
+ */
+int anjay_notify_resources_layout_changed(anjay_t *anjay,
+                                          anjay_oid_t oid,
+                                          anjay_iid_t iid);
+
 /**
  * Structure representing an observation state of a Resource.
  */
@@ -1085,6 +1377,77 @@ typedef struct {
 anjay_resource_observation_status_t anjay_resource_observation_status(
         anjay_t *anjay, anjay_oid_t oid, anjay_iid_t iid, anjay_rid_t rid);
 
+/**
+ * Enables or disables caching of effective attributes of observed paths.
+ *
+ * By default, the attributes that apply to each observed path (i.e. the ones
+ * set on the path itself, merged with the ones inherited from higher levels of
+ * the data model and from the Server Object) are resolved from scratch every
+ * time a notification is considered, which involves calling attribute and
+ * presence handlers of the relevant Object. When the cache is enabled, they are
+ * resolved once per observed path and LwM2M Server, and reused afterwards.
+ *
+ * Cached attributes are dropped automatically:
+ *
+ * - when a LwM2M Server performs a Write-Attributes operation,
+ * - when the attributes held by the Attribute Storage change in any way,
+ *   including the <c>anjay_attr_storage_set_*</c>, purge and restore APIs,
+ * - when the set of Instances of any Object changes, as notified using
+ *   @ref anjay_notify_instances_changed or as a result of operations
+ *   performed by a LwM2M Server,
+ * - when any change of the Default Minimum Period or Default Maximum Period
+ *   Resources of the Server Object is notified.
+ *
+ * If an Object implements its own attribute handlers and the attributes
+ * returned by them change in any other way, or if presence of observed
+ * Resources changes without the set of Instances changing, the application
+ * MUST call @ref anjay_notify_attributes_changed.
+ *
+ * @param anjay   Anjay object to operate on.
+ * @param enabled Whether the cache shall be enabled.
+ *
+ * @returns 0 on success, a negative value if Observe support is not compiled
+ *          in.
+ */
+int anjay_set_observe_attributes_caching(anjay_t *anjay, bool enabled);
+
+/**
+ * Notifies the library that attributes returned by attribute handlers of some
+ * Object, or presence of some Resources, changed. Drops all effective
+ * attributes cached as described in @ref anjay_set_observe_attributes_caching.
+ *
+ * This function only invalidates the cache. It does not trigger any LwM2M
+ * Notify messages. Calling it while the cache is disabled is a no-op.
+ *
+ * @param anjay Anjay object to operate on.
+ */
+void anjay_notify_attributes_changed(anjay_t *anjay);
+
+/**
+ * Enables or disables sharing of values read for notifications between
+ * observations of the same path.
+ *
+ * By default, every observation that needs a new value reads it from the data
+ * model separately, even if several LwM2M Servers, or the same Server using
+ * different Content-Formats, observe the same path and their notifications are
+ * triggered at the same time. When sharing is enabled, the value read for the
+ * first such observation is reused for all the others that are handled during
+ * the same scheduler run, so the read handlers are called only once.
+ *
+ * Values are shared only as long as no change of any observed path is
+ * notified. Access control is still checked separately for each LwM2M Server.
+ * Serialized payloads are not shared, as each notification may use a
+ * different Content-Format and timestamps relative to its own serialization
+ * time.
+ *
+ * @param anjay   Anjay object to operate on.
+ * @param enabled Whether the values shall be shared.
+ *
+ * @returns 0 on success, a negative value if Observe support is not compiled
+ *          in.
+ */
+int anjay_set_observe_read_sharing(anjay_t *anjay, bool enabled);
+
 /**
  * Registers the Object in the data model, making it available for RPC calls.
  *
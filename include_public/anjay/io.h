@@ -199,6 +199,63 @@ int anjay_ret_bytes_append(anjay_ret_bytes_ctx_t *ctx,
  */
 int anjay_ret_bytes(anjay_output_ctx_t *ctx, const void *data, size_t length);
 
+/**
+ * Type of a callback passed to @ref anjay_ret_bytes_ref, called when the
+ * library no longer needs access to the referenced data.
+ *
+ * NOTE: The callback may be called from within any function of the library
+ * that operates on the data, potentially with the Anjay object locked. It MUST
+ * NOT call any Anjay API functions.
+ *
+ * @param arg Opaque pointer passed to @ref anjay_ret_bytes_ref.
+ */
+typedef void anjay_ret_bytes_ref_release_t(void *arg);
+
+/**
+ * Returns a blob of data from the data model handler, without copying it if
+ * possible.
+ *
+ * Unlike @ref anjay_ret_bytes, the library is allowed to keep the @p data
+ * pointer and read from it after this function returns. This avoids
+ * intermediate copies of large values in places where the data would
+ * otherwise need to be buffered, e.g. when building Notify or Send messages
+ * or nested TLV structures.
+ *
+ * The @p data buffer MUST remain valid and unchanged until @p release is
+ * called. The callback is called exactly once, when the data is no longer
+ * needed. This might happen before this function returns, in particular if the
+ * output format does not support referencing data, or in case of an error.
+ *
+ * Example: returning a certificate kept in a reference-counted buffer.
+ *
+ * @code
+ * static void cert_release(void *cert) {
+ *     my_cert_unref((my_cert_t *) cert);
+ * }
+ *
+ * // inside resource_read handler
+ * my_cert_t *cert = my_cert_ref(obj->cert);
+ * return anjay_ret_bytes_ref(ctx, cert->der, cert->der_size, cert_release,
+ *                            cert);
+ * @endcode
+ *
+ * @param ctx         Output context to write data into.
+ * @param data        Data buffer.
+ * @param length      Number of bytes available in the @p data buffer.
+ * @param release     Callback to call when the data is no longer needed. May
+ *                    be NULL, in which case @p data MUST remain valid and
+ *                    unchanged for the whole lifetime of the Anjay object,
+ *                    e.g. if it is a constant array.
+ * @param release_arg Opaque argument to pass to @p release.
+ *
+ * @returns 0 on success, a negative value in case of error.
+ */
+int anjay_ret_bytes_ref(anjay_output_ctx_t *ctx,
+                        const void *data,
+                        size_t length,
+                        anjay_ret_bytes_ref_release_t *release,
+                        void *release_arg);
+
 /**
  * Returns a null-terminated string from the data model handler.
  *
@@ -318,6 +375,43 @@ int anjay_ret_bool(anjay_output_ctx_t *ctx, bool value);
  */
 int anjay_ret_objlnk(anjay_output_ctx_t *ctx, anjay_oid_t oid, anjay_iid_t iid);
 
+/**
+ * Selects the Resource or Resource Instance whose value will be returned by
+ * the next call to one of the <c>anjay_ret_*</c> value functions.
+ *
+ * May only be called from within @ref anjay_dm_instance_read_t - the path is
+ * relative to the Object Instance being read.
+ *
+ * @param ctx  Output context to operate on.
+ * @param rid  Resource ID.
+ * @param riid Resource Instance ID, or @ref ANJAY_ID_INVALID in case of a
+ *             Single Resource. Resource Instances of a given Resource MUST be
+ *             preceded by a call to @ref anjay_ret_multiple_resource for that
+ *             Resource.
+ *
+ * @returns 0 on success, a negative value in case of error, e.g. if called
+ *          outside of @ref anjay_dm_instance_read_t, or
+ *          @ref ANJAY_ERR_INTERNAL if Resources and Resource Instances are not
+ *          returned in strictly ascending order of their IDs.
+ */
+int anjay_ret_resource_path(anjay_output_ctx_t *ctx,
+                            anjay_rid_t rid,
+                            anjay_riid_t riid);
+
+/**
+ * Starts returning a Multiple Resource. Its Resource Instances, if any, shall
+ * be returned next, using @ref anjay_ret_resource_path followed by one of the
+ * <c>anjay_ret_*</c> value functions for each of them.
+ *
+ * May only be called from within @ref anjay_dm_instance_read_t .
+ *
+ * @param ctx Output context to operate on.
+ * @param rid Resource ID of the Multiple Resource.
+ *
+ * @returns 0 on success, a negative value in case of error.
+ */
+int anjay_ret_multiple_resource(anjay_output_ctx_t *ctx, anjay_rid_t rid);
+
 #ifdef ANJAY_WITH_SECURITY_STRUCTURED
 /**
  * Returns information about a certificate chain from the data model handler.
@@ -524,6 +618,53 @@ int anjay_get_bytes(anjay_input_ctx_t *ctx,
                     void *out_buf,
                     size_t buf_size);
 
+/**
+ * Reads a chunk of raw data from the RPC request content without copying it
+ * into a user-provided buffer.
+ *
+ * On success, <c>*out_data</c> is set to point to the next chunk of data,
+ * owned by the library. The chunk is valid only until the next call to any
+ * function operating on @p ctx, or until the handler returns, whichever comes
+ * first. The chunk may be empty even if the value is not finished yet.
+ *
+ * Only values already stored in memory in their entirety, i.e. those decoded
+ * from a SenML JSON or SenML CBOR payload, are returned without any copying, in
+ * a single chunk. In all other formats (opaque, plain text, TLV, CBOR), the
+ * data is still copied from the incoming message into a library-owned buffer,
+ * allocated on first use, in chunks of a library-defined size. In that case
+ * this function does not save any copying compared to @ref anjay_get_bytes -
+ * it only spares the caller from providing a buffer of its own.
+ *
+ * Example: hashing a large data blob.
+ *
+ * @code
+ * bool finished;
+ * do {
+ *     const void *chunk;
+ *     size_t chunk_size;
+ *     if (anjay_get_bytes_view(ctx, &chunk, &chunk_size, &finished)) {
+ *         // handle error
+ *     }
+ *     my_hash_update(&hash_ctx, chunk, chunk_size);
+ * } while (!finished);
+ * @endcode
+ *
+ * Calls to this function may be interleaved with calls to
+ * @ref anjay_get_bytes for the same value.
+ *
+ * @param      ctx                  Input context to operate on.
+ * @param[out] out_data             Set to point to the chunk of data.
+ * @param[out] out_length           Set to the size of the chunk.
+ * @param[out] out_message_finished Set to true if there is no more data
+ *                                  to read.
+ *
+ * @returns 0 on success, a negative value in case of error.
+ */
+int anjay_get_bytes_view(anjay_input_ctx_t *ctx,
+                         const void **out_data,
+                         size_t *out_length,
+                         bool *out_message_finished);
+
 #define ANJAY_BUFFER_TOO_SHORT 1
 /**
  * Reads a null-terminated string from the RPC request content. On success or
@@ -525,7 +525,9 @@ anjay_send_result_t anjay_send(anjay_t *anjay,
  * registered using a LwM2M version that does not support the Send operation
  * (i.e., LwM2M 1.0), or the Mute Send resource changes while the Send is
  * deferred, the operation is cancelled and @p finished_handler is called with
- * the @c result argument set to @ref ANJAY_SEND_DEFERRED_ERROR.
+ * the @c result argument set to @ref ANJAY_SEND_DEFERRED_ERROR. The same
+ * happens if a memory budget is set for @ref ANJAY_MEMORY_SEND using
+ * @ref anjay_set_memory_budget and newer deferred requests do not fit in it.
  *
  * @param anjay                 Anjay object to operate on.
  * @param ssid                  Short Server ID of target LwM2M Server. Cannot
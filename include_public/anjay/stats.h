@@ -46,6 +46,308 @@ uint64_t anjay_get_num_incoming_retransmissions(anjay_t *anjay);
  */
 uint64_t anjay_get_num_outgoing_retransmissions(anjay_t *anjay);
 
+/**
+ * LwM2M operations for which statistics are collected when
+ * ANJAY_WITH_OPERATION_STATS is enabled.
+ *
+ * Requests incoming from the LwM2M Server (all operations up to and including
+ * @ref ANJAY_OPERATION_DELETE) are accounted for when they are handled by the
+ * client. Composite variants of Read and Write, as well as Write (Update),
+ * are accounted for as @ref ANJAY_OPERATION_READ and
+ * @ref ANJAY_OPERATION_WRITE, respectively. Read requests that establish an
+ * observation are accounted for as @ref ANJAY_OPERATION_OBSERVE.
+ *
+ * Client-initiated operations (Send, Register and Update) are accounted for
+ * when the response is received or the request fails, and their handling time
+ * is the time elapsed since sending the request.
+ */
+typedef enum {
+    ANJAY_OPERATION_READ,
+    ANJAY_OPERATION_WRITE,
+    ANJAY_OPERATION_WRITE_ATTRIBUTES,
+    ANJAY_OPERATION_OBSERVE,
+    ANJAY_OPERATION_EXECUTE,
+    ANJAY_OPERATION_DISCOVER,
+    ANJAY_OPERATION_CREATE,
+    ANJAY_OPERATION_DELETE,
+    ANJAY_OPERATION_SEND,
+    ANJAY_OPERATION_REGISTER,
+    ANJAY_OPERATION_UPDATE
+} anjay_operation_t;
+
+/**
+ * Number of buckets in @ref anjay_operation_stats_t::time_histogram.
+ */
+#define ANJAY_OPERATION_STATS_HISTOGRAM_BUCKETS 24
+
+typedef struct {
+    /**
+     * Number of times the operation has been performed.
+     */
+    uint64_t count;
+
+    /**
+     * Number of times the operation has failed, i.e. an error response has
+     * been sent (for requests incoming from the server) or received (for
+     * client-initiated requests), or the request could not be performed at
+     * all.
+     */
+    uint64_t error_count;
+
+    /**
+     * Sum of handling times of all accounted operations, in microseconds.
+     */
+    uint64_t total_time_us;
+
+    /**
+     * Longest handling time of a single operation, in microseconds.
+     */
+    uint64_t max_time_us;
+
+    /**
+     * Logarithmically bucketed histogram of handling times. Bucket 0 counts
+     * operations handled in less than 1 microsecond; bucket <c>N</c> (for
+     * <c>N &gt; 0</c>) counts operations handled in at least
+     * <c>2^(N - 1)</c> but less than <c>2^N</c> microseconds. The last bucket
+     * additionally counts all operations that took even longer.
+     */
+    uint64_t time_histogram[ANJAY_OPERATION_STATS_HISTOGRAM_BUCKETS];
+} anjay_operation_stats_t;
+
+/**
+ * Retrieves statistics of a given LwM2M operation, collected since the
+ * creation of the Anjay object or the last call to
+ * @ref anjay_reset_operation_stats.
+ *
+ * NOTE: When ANJAY_WITH_OPERATION_STATS is disabled this function always
+ * fails.
+ *
+ * @param anjay     Anjay object to operate on.
+ *
+ * @param ssid      Short Server ID of the server for which the statistics shall
+ *                  be retrieved. @ref ANJAY_SSID_BOOTSTRAP may be used to query
+ *                  requests issued by the Bootstrap Server, and
+ *                  @ref ANJAY_SSID_ANY to aggregate statistics of all servers.
+ *
+ * @param operation Operation to query.
+ *
+ * @param out_stats Pointer to a structure that will be filled with the
+ *                  statistics. If no such operation has been performed with the
+ *                  given server, it will be filled with zeros.
+ *
+ * @returns 0 on success, a negative value in case of invalid arguments or if
+ *          the feature is disabled.
+ */
+int anjay_get_operation_stats(anjay_t *anjay,
+                              anjay_ssid_t ssid,
+                              anjay_operation_t operation,
+                              anjay_operation_stats_t *out_stats);
+
+/**
+ * Clears all statistics collected so far for all servers and operations.
+ *
+ * NOTE: When ANJAY_WITH_OPERATION_STATS is disabled this function does nothing.
+ */
+void anjay_reset_operation_stats(anjay_t *anjay);
+
+/**
+ * Library subsystems for which heap usage is accounted for when
+ * ANJAY_WITH_MEMORY_STATS is enabled.
+ *
+ * Usage is estimated from the sizes of the data structures owned by the
+ * subsystem - kept up to date as they are allocated and freed for Observe and
+ * Send, which enforce budgets on hot paths, and calculated on demand for the
+ * others. It includes the space taken by list and tree nodes, but not the
+ * overhead of the allocator itself. Buffers allocated internally by the CoAP, HTTP and
+ * network layers (including ones owned by in-flight CoAP exchanges) are not
+ * accounted for.
+ */
+typedef enum {
+    /**
+     * Observation state: observations, observed paths, last sent values,
+     * notifications queued for sending, values passed to
+     * <c>anjay_notify_value_changed_*()</c> and values shared between
+     * observations when <c>anjay_set_observe_read_sharing()</c> is enabled.
+     */
+    ANJAY_MEMORY_OBSERVE,
+
+    /**
+     * LwM2M Send requests that are in progress or deferred, including their
+     * payload batches.
+     */
+    ANJAY_MEMORY_SEND,
+
+    /**
+     * Attributes stored by the built-in Attribute Storage.
+     */
+    ANJAY_MEMORY_ATTR_STORAGE,
+
+    /**
+     * State of installed modules that support memory accounting - currently
+     * the Access Control object.
+     */
+    ANJAY_MEMORY_MODULES,
+
+    /**
+     * Download contexts of the CoAP and HTTP downloader.
+     */
+    ANJAY_MEMORY_DOWNLOADER
+} anjay_memory_subsystem_t;
+
+typedef struct {
+    /**
+     * Estimated number of heap bytes currently held by the subsystem.
+     */
+    size_t bytes_in_use;
+
+    /**
+     * Budget set using @ref anjay_set_memory_budget, or 0 if unlimited.
+     */
+    size_t budget;
+
+    /**
+     * Number of entries dropped so far because of exceeding the budget.
+     */
+    uint64_t dropped_count;
+} anjay_memory_stats_t;
+
+/**
+ * Retrieves heap usage statistics of a given subsystem.
+ *
+ * NOTE: When ANJAY_WITH_MEMORY_STATS is disabled this function always fails.
+ *
+ * @param anjay     Anjay object to operate on.
+ *
+ * @param subsystem Subsystem to query.
+ *
+ * @param out_stats Pointer to a structure that will be filled with the
+ *                  statistics.
+ *
+ * @returns 0 on success, a negative value in case of invalid arguments or if
+ *          the feature is disabled.
+ */
+int anjay_get_memory_stats(anjay_t *anjay,
+                           anjay_memory_subsystem_t subsystem,
+                           anjay_memory_stats_t *out_stats);
+
+/**
+ * Sets a hard limit on the heap usage of a given subsystem.
+ *
+ * Budgets are only supported for subsystems that hold queues of data that may
+ * be discarded:
+ *
+ * - @ref ANJAY_MEMORY_OBSERVE - whenever a new notification is about to be
+ *   queued and the subsystem would exceed the budget, the oldest queued
+ *   notifications are dropped, exactly as if the
+ *   <c>stored_notification_limit</c> configuration option was exceeded.
+ * - @ref ANJAY_MEMORY_SEND - whenever a new Send request is deferred and the
+ *   subsystem exceeds the budget, the oldest deferred requests are cancelled,
+ *   and their finished handlers are called with
+ *   @ref ANJAY_SEND_DEFERRED_ERROR.
+ *
+ * The newest entry is never dropped, so the budget may be temporarily exceeded
+ * if there is nothing else to drop.
+ *
+ * NOTE: When ANJAY_WITH_MEMORY_STATS is disabled this function always fails.
+ *
+ * @param anjay     Anjay object to operate on.
+ *
+ * @param subsystem Subsystem to set the budget for.
+ *
+ * @param budget    Maximum number of bytes the subsystem may use, or 0 to
+ *                  remove the limit.
+ *
+ * @returns 0 on success, a negative value if the subsystem does not support
+ *          budgets or if the feature is disabled.
+ */
+int anjay_set_memory_budget(anjay_t *anjay,
+                            anjay_memory_subsystem_t subsystem,
+                            size_t budget);
+
+/**
+ * Profiling statistics of a single type of scheduler job posted by the library,
+ * collected when ANJAY_WITH_SCHED_PROFILING is enabled.
+ */
+typedef struct {
+    /**
+     * Name of the job function, e.g. <c>"send_update_sched_job"</c>.
+     */
+    const char *name;
+
+    /**
+     * Number of times the job has been run.
+     */
+    uint64_t count;
+
+    /**
+     * Sum of run times of all invocations, in microseconds.
+     */
+    uint64_t total_time_us;
+
+    /**
+     * Longest run time of a single invocation, in microseconds.
+     */
+    uint64_t max_time_us;
+
+    /**
+     * Sum of scheduling lags of all invocations, in microseconds. Scheduling
+     * lag is the time between the moment the job has been scheduled for and
+     * the moment it has actually started. Jobs moved to a different time
+     * after having been scheduled are accounted for relative to the original
+     * time.
+     */
+    uint64_t total_lag_us;
+
+    /**
+     * Largest scheduling lag of a single invocation, in microseconds.
+     */
+    uint64_t max_lag_us;
+} anjay_sched_job_stats_t;
+
+/**
+ * Type of the handler passed to @ref anjay_dump_sched_job_stats.
+ *
+ * @param stats Statistics of a single job type. The pointer, including the
+ *              <c>name</c> field, is only valid during the call.
+ *
+ * @param arg   Opaque argument passed to @ref anjay_dump_sched_job_stats.
+ */
+typedef void anjay_sched_job_stats_handler_t(
+        const anjay_sched_job_stats_t *stats, void *arg);
+
+/**
+ * Calls @p handler for each type of scheduler job that has been run since the
+ * creation of the Anjay object or the last call to
+ * @ref anjay_reset_sched_job_stats. Only jobs posted by the library itself are
+ * accounted for.
+ *
+ * The handler is called with the Anjay object unlocked, so it may call other
+ * Anjay API functions.
+ *
+ * NOTE: When ANJAY_WITH_SCHED_PROFILING is disabled this function always
+ * fails.
+ *
+ * @param anjay   Anjay object to operate on.
+ *
+ * @param handler Function to call for each job type.
+ *
+ * @param arg     Opaque argument that will be passed to @p handler.
+ *
+ * @returns 0 on success, a negative value in case of invalid arguments, out of
+ *          memory condition or if the feature is disabled.
+ */
+int anjay_dump_sched_job_stats(anjay_t *anjay,
+                               anjay_sched_job_stats_handler_t *handler,
+                               void *arg);
+
+/**
+ * Clears all scheduler job statistics collected so far.
+ *
+ * NOTE: When ANJAY_WITH_SCHED_PROFILING is disabled this function does
+ * nothing.
+ */
+void anjay_reset_sched_job_stats(anjay_t *anjay);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_INCLUDE_ANJAY_TRACE_H
+#define ANJAY_INCLUDE_ANJAY_TRACE_H
+
+#include <anjay/core.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef ANJAY_WITH_TRACE_HOOKS
+
+/**
+ * Points in the request lifecycle at which the trace handler is called.
+ */
+typedef enum {
+    /**
+     * An incoming request has been parsed. <c>ssid</c> and the path are set;
+     * <c>name</c> is the name of the LwM2M operation (or NULL if the request
+     * could not be parsed) and <c>result</c> is the parsing result.
+     */
+    ANJAY_TRACE_REQUEST_PARSED,
+
+    /**
+     * A data model handler is about to be called. <c>name</c> is the name of
+     * the handler (e.g. <c>"resource_read"</c>) and <c>oid</c> is the Object
+     * ID.
+     */
+    ANJAY_TRACE_DM_HANDLER_ENTER,
+
+    /**
+     * A data model handler has returned. Fields are set as for
+     * @ref ANJAY_TRACE_DM_HANDLER_ENTER; <c>result</c> is the value returned
+     * by the handler.
+     */
+    ANJAY_TRACE_DM_HANDLER_EXIT,
+
+    /**
+     * An observation is about to be evaluated, either because of a value
+     * change or a pmin/pmax timeout. <c>ssid</c> and the first observed path
+     * are set.
+     */
+    ANJAY_TRACE_OBSERVE_TRIGGER,
+
+    /**
+     * A chunk of notification payload is about to be serialized. <c>ssid</c>
+     * is set.
+     */
+    ANJAY_TRACE_NOTIFY_SERIALIZE_BEGIN,
+
+    /**
+     * A chunk of notification payload has been serialized. <c>ssid</c> is
+     * set; <c>result</c> is the serialization result.
+     */
+    ANJAY_TRACE_NOTIFY_SERIALIZE_END,
+
+    /**
+     * An incoming packet is about to be received and handled. <c>ssid</c> is
+     * set.
+     */
+    ANJAY_TRACE_COAP_RECEIVE_BEGIN,
+
+    /**
+     * An incoming packet has been handled, including sending the response, if
+     * any. <c>ssid</c> is set; <c>result</c> is 0 on success or -1 if the CoAP
+     * layer reported an error.
+     */
+    ANJAY_TRACE_COAP_RECEIVE_END,
+
+    /**
+     * A client-initiated message has been passed to the CoAP layer for
+     * sending. <c>ssid</c> is set; <c>name</c> is the name of the message
+     * (<c>"Register"</c>, <c>"Update"</c>, <c>"Send"</c> or
+     * <c>"Notify"</c>) and <c>result</c> is 0 if it has been accepted by the
+     * CoAP layer, or -1 otherwise.
+     */
+    ANJAY_TRACE_COAP_SEND,
+
+    /**
+     * @ref anjay_sched_run is about to run the scheduler jobs.
+     */
+    ANJAY_TRACE_SCHED_RUN_BEGIN,
+
+    /**
+     * @ref anjay_sched_run has finished running the scheduler jobs.
+     */
+    ANJAY_TRACE_SCHED_RUN_END
+} anjay_trace_point_t;
+
+typedef struct {
+    anjay_trace_point_t point;
+    /**
+     * Short Server ID of the server the event relates to, or
+     * @ref ANJAY_SSID_ANY if not applicable.
+     */
+    anjay_ssid_t ssid;
+    /**
+     * Data model path the event relates to. Components that are not
+     * applicable are set to @ref ANJAY_ID_INVALID.
+     */
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    anjay_riid_t riid;
+    /**
+     * Static string further identifying the event, or NULL. See
+     * @ref anjay_trace_point_t for details.
+     */
+    const char *name;
+    /**
+     * Result of the traced step; 0 for events that do not carry one.
+     */
+    int result;
+} anjay_trace_event_t;
+
+/**
+ * Trace handler type.
+ *
+ * The handler is called synchronously from within the library, with the
+ * Anjay object locked if ANJAY_WITH_THREAD_SAFETY is enabled. It MUST NOT
+ * call any Anjay API functions, and SHOULD return as quickly as possible -
+ * typically it only records a timestamp together with the event.
+ *
+ * @param event Event being traced. The pointer is only valid during the call.
+ *
+ * @param arg   Opaque argument passed to @ref anjay_set_trace_handler.
+ */
+typedef void anjay_trace_handler_t(const anjay_trace_event_t *event,
+                                   void *arg);
+
+/**
+ * Sets the trace handler called at the points listed in
+ * @ref anjay_trace_point_t. When no handler is set, the only overhead of each
+ * trace point is a single pointer comparison.
+ *
+ * @param anjay   Anjay object to operate on.
+ *
+ * @param handler Trace handler to set, or NULL to disable tracing.
+ *
+ * @param arg     Opaque argument that will be passed to @p handler.
+ */
+void anjay_set_trace_handler(anjay_t *anjay,
+                             anjay_trace_handler_t *handler,
+                             void *arg);
+
+#endif // ANJAY_WITH_TRACE_HOOKS
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ANJAY_INCLUDE_ANJAY_TRACE_H */
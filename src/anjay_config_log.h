@@ -117,6 +117,11 @@ static inline void _anjay_log_feature_list(void) {
 #else // ANJAY_WITH_LEGACY_CONTENT_FORMAT_SUPPORT
     _anjay_log(anjay, TRACE, "ANJAY_WITH_LEGACY_CONTENT_FORMAT_SUPPORT = OFF");
 #endif // ANJAY_WITH_LEGACY_CONTENT_FORMAT_SUPPORT
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_LOCK_FREE_NOTIFY = ON");
+#else // ANJAY_WITH_LOCK_FREE_NOTIFY
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_LOCK_FREE_NOTIFY = OFF");
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
 #ifdef ANJAY_WITH_LOGS
     _anjay_log(anjay, TRACE, "ANJAY_WITH_LOGS = ON");
 #else // ANJAY_WITH_LOGS
@@ -132,6 +137,11 @@ static inline void _anjay_log_feature_list(void) {
 #else // ANJAY_WITH_LWM2M_JSON
     _anjay_log(anjay, TRACE, "ANJAY_WITH_LWM2M_JSON = OFF");
 #endif // ANJAY_WITH_LWM2M_JSON
+#ifdef ANJAY_WITH_MEMORY_STATS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_MEMORY_STATS = ON");
+#else // ANJAY_WITH_MEMORY_STATS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_MEMORY_STATS = OFF");
+#endif // ANJAY_WITH_MEMORY_STATS
 #ifdef ANJAY_WITH_MODULE_ACCESS_CONTROL
     _anjay_log(anjay, TRACE, "ANJAY_WITH_MODULE_ACCESS_CONTROL = ON");
 #else // ANJAY_WITH_MODULE_ACCESS_CONTROL
@@ -207,6 +217,16 @@ static inline void _anjay_log_feature_list(void) {
 #else // ANJAY_WITH_OBSERVE
     _anjay_log(anjay, TRACE, "ANJAY_WITH_OBSERVE = OFF");
 #endif // ANJAY_WITH_OBSERVE
+#ifdef ANJAY_WITH_OPERATION_STATS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_OPERATION_STATS = ON");
+#else // ANJAY_WITH_OPERATION_STATS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_OPERATION_STATS = OFF");
+#endif // ANJAY_WITH_OPERATION_STATS
+#ifdef ANJAY_WITH_SCHED_PROFILING
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_SCHED_PROFILING = ON");
+#else // ANJAY_WITH_SCHED_PROFILING
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_SCHED_PROFILING = OFF");
+#endif // ANJAY_WITH_SCHED_PROFILING
 #ifdef ANJAY_WITH_SECURITY_STRUCTURED
     _anjay_log(anjay, TRACE, "ANJAY_WITH_SECURITY_STRUCTURED = ON");
 #else // ANJAY_WITH_SECURITY_STRUCTURED
@@ -237,6 +257,11 @@ static inline void _anjay_log_feature_list(void) {
 #else // ANJAY_WITH_THREAD_SAFETY
     _anjay_log(anjay, TRACE, "ANJAY_WITH_THREAD_SAFETY = OFF");
 #endif // ANJAY_WITH_THREAD_SAFETY
+#ifdef ANJAY_WITH_TRACE_HOOKS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_TRACE_HOOKS = ON");
+#else // ANJAY_WITH_TRACE_HOOKS
+    _anjay_log(anjay, TRACE, "ANJAY_WITH_TRACE_HOOKS = OFF");
+#endif // ANJAY_WITH_TRACE_HOOKS
 #ifdef ANJAY_WITH_TRACE_LOGS
     _anjay_log(anjay, TRACE, "ANJAY_WITH_TRACE_LOGS = ON");
 #else // ANJAY_WITH_TRACE_LOGS
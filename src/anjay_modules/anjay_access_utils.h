@@ -46,6 +46,20 @@ int _anjay_acl_ref_validate_inst_ref(anjay_unlocked_t *anjay,
                                      anjay_oid_t target_oid,
                                      anjay_iid_t target_iid);
 
+/**
+ * Marks the cached contents of Access Control object instance @p ac_iid as
+ * outdated, so that they are re-read before the next access check. If @p ac_iid
+ * is ANJAY_ID_INVALID, the whole cache is dropped.
+ *
+ * Changes notified via anjay_notify_changed() and
+ * anjay_notify_instances_changed(), as well as all transactions on the Access
+ * Control object, are handled automatically. This function needs to be called
+ * directly only when the object's state is replaced without notifying, e.g.
+ * when restoring it from persistent storage.
+ */
+void _anjay_access_mask_cache_invalidate(anjay_unlocked_t *anjay,
+                                         anjay_iid_t ac_iid);
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* ANJAY_INCLUDE_ANJAY_MODULES_ACCESS_UTILS_H */
@@ -558,6 +558,9 @@ typedef enum {
     ANJAY_DM_HANDLER_resource_instance_read_attrs,
     ANJAY_DM_HANDLER_resource_instance_write_attrs,
 #endif // ANJAY_WITH_LWM2M11
+    ANJAY_DM_HANDLER_instance_present,
+    ANJAY_DM_HANDLER_resource_present,
+    ANJAY_DM_HANDLER_instance_read,
 } anjay_dm_handler_t;
 
 /**
@@ -620,6 +623,22 @@ int _anjay_dm_call_list_resources(anjay_unlocked_t *anjay,
                                   const anjay_dm_installed_object_t *obj_ptr,
                                   anjay_iid_t iid,
                                   anjay_unlocked_dm_resource_list_ctx_t *ctx);
+int _anjay_dm_call_instance_present(anjay_unlocked_t *anjay,
+                                    const anjay_dm_installed_object_t *obj_ptr,
+                                    anjay_iid_t iid,
+                                    bool *out_present);
+int _anjay_dm_call_resource_present(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj_ptr,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        anjay_dm_resource_kind_t *out_kind,
+        anjay_dm_resource_presence_t *out_presence);
+
+int _anjay_dm_call_instance_read(anjay_unlocked_t *anjay,
+                                 const anjay_dm_installed_object_t *obj_ptr,
+                                 anjay_iid_t iid,
+                                 anjay_unlocked_output_ctx_t *ctx);
 
 int _anjay_dm_call_resource_read(anjay_unlocked_t *anjay,
                                  const anjay_dm_installed_object_t *obj_ptr,
@@ -909,6 +928,12 @@ int _anjay_ret_bytes_unlocked(anjay_unlocked_output_ctx_t *ctx,
                               const void *data,
                               size_t length);
 
+int _anjay_ret_bytes_ref_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                  const void *data,
+                                  size_t length,
+                                  anjay_ret_bytes_ref_release_t *release,
+                                  void *release_arg);
+
 int _anjay_ret_string_unlocked(anjay_unlocked_output_ctx_t *ctx,
                                const char *value);
 
@@ -922,6 +947,13 @@ int _anjay_ret_objlnk_unlocked(anjay_unlocked_output_ctx_t *ctx,
                                anjay_oid_t oid,
                                anjay_iid_t iid);
 
+int _anjay_ret_resource_path_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                      anjay_rid_t rid,
+                                      anjay_riid_t riid);
+
+int _anjay_ret_multiple_resource_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                          anjay_rid_t rid);
+
 #ifdef ANJAY_WITH_LWM2M11
 int _anjay_ret_u64_unlocked(anjay_unlocked_output_ctx_t *ctx, uint64_t value);
 #endif // ANJAY_WITH_LWM2M11
@@ -939,6 +971,11 @@ int _anjay_get_bytes_unlocked(anjay_unlocked_input_ctx_t *ctx,
                               void *out_buf,
                               size_t buf_size);
 
+int _anjay_get_bytes_view_unlocked(anjay_unlocked_input_ctx_t *ctx,
+                                   const void **out_data,
+                                   size_t *out_length,
+                                   bool *out_message_finished);
+
 int _anjay_get_string_unlocked(anjay_unlocked_input_ctx_t *ctx,
                                char *out_buf,
                                size_t buf_size);
@@ -94,6 +94,10 @@ int _anjay_notify_changed_unlocked(anjay_unlocked_t *anjay,
                                    anjay_iid_t iid,
                                    anjay_rid_t rid);
 
+int _anjay_notify_changed_many_unlocked(anjay_unlocked_t *anjay,
+                                        const anjay_notify_path_t *paths,
+                                        size_t paths_count);
+
 int _anjay_notify_instances_changed_unlocked(anjay_unlocked_t *anjay,
                                              anjay_oid_t oid);
 
@@ -20,6 +20,55 @@ static inline anjay_t *_anjay_get_from_sched(avs_sched_t *sched) {
     return (anjay_t *) avs_sched_data(sched);
 }
 
+#ifdef ANJAY_WITH_SCHED_PROFILING
+
+/**
+ * Schedules @p clb like @ref AVS_SCHED_AT, but wrapped in a job that records
+ * its run time and scheduling lag under @p job_name. The scheduler MUST be the
+ * main scheduler of an Anjay object. @p clb_data_size MUST NOT exceed 64 bytes,
+ * as the wrapper job data is built on the stack.
+ */
+int _anjay_sched_profiled_at(avs_sched_t *sched,
+                             avs_sched_handle_t *out_handle,
+                             avs_time_monotonic_t instant,
+                             const char *job_name,
+                             avs_sched_clb_t *clb,
+                             const void *clb_data,
+                             size_t clb_data_size);
+
+#    define ANJAY_SCHED_AT(Sched, OutHandle, Instant, Clb, ClbData,     \
+                           ClbDataSize)                                 \
+        _anjay_sched_profiled_at((Sched), (OutHandle), (Instant), #Clb, \
+                                 (Clb), (ClbData), (ClbDataSize))
+
+/**
+ * Profiled jobs cannot be moved, as the scheduled time is stored within the
+ * job data. Deleting the job and returning failure makes the callers fall
+ * back to scheduling a new one.
+ */
+#    define ANJAY_RESCHED_AT(OutHandle, Instant) \
+        (avs_sched_del(OutHandle), (void) (Instant), -1)
+
+#else // ANJAY_WITH_SCHED_PROFILING
+
+#    define ANJAY_SCHED_AT AVS_SCHED_AT
+#    define ANJAY_RESCHED_AT AVS_RESCHED_AT
+
+#endif // ANJAY_WITH_SCHED_PROFILING
+
+/**
+ * Wrappers over @ref AVS_SCHED_AT, @ref AVS_SCHED_DELAYED and
+ * @ref AVS_SCHED_NOW that shall be used for all jobs posted by the library, so
+ * that they can be profiled if ANJAY_WITH_SCHED_PROFILING is enabled.
+ */
+#define ANJAY_SCHED_DELAYED(Sched, OutHandle, Delay, ...)                     \
+    ANJAY_SCHED_AT((Sched), (OutHandle),                                      \
+                   avs_time_monotonic_add(avs_time_monotonic_now(), (Delay)), \
+                   __VA_ARGS__)
+
+#define ANJAY_SCHED_NOW(Sched, OutHandle, ...) \
+    ANJAY_SCHED_AT((Sched), (OutHandle), avs_time_monotonic_now(), __VA_ARGS__)
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* ANJAY_INCLUDE_ANJAY_MODULES_SCHED_H */
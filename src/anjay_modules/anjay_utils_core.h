@@ -10,9 +10,20 @@
 #ifndef ANJAY_INCLUDE_ANJAY_MODULES_UTILS_CORE_H
 #define ANJAY_INCLUDE_ANJAY_MODULES_UTILS_CORE_H
 
-#ifdef ANJAY_WITH_EVENT_LOOP
+#if defined(ANJAY_WITH_TRACE_HOOKS) && defined(ANJAY_WITH_THREAD_SAFETY)
+#    define ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+#endif // defined(ANJAY_WITH_TRACE_HOOKS) && defined(ANJAY_WITH_THREAD_SAFETY)
+
+#if defined(ANJAY_WITH_EVENT_LOOP) || defined(ANJAY_WITH_LOCK_FREE_NOTIFY) \
+        || defined(ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG)
 #    include <stdatomic.h>
-#endif // ANJAY_WITH_EVENT_LOOP
+#endif // defined(ANJAY_WITH_EVENT_LOOP) ||
+       // defined(ANJAY_WITH_LOCK_FREE_NOTIFY) ||
+       // defined(ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG)
+
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+#    include <avsystem/commons/avs_sched.h>
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
 
 #include <avsystem/commons/avs_list.h>
 #include <avsystem/commons/avs_url.h>
@@ -65,19 +76,91 @@ typedef enum {
 } anjay_event_loop_status_t;
 #endif // ANJAY_WITH_EVENT_LOOP
 
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+#    ifndef ANJAY_WITH_THREAD_SAFETY
+#        error "ANJAY_WITH_LOCK_FREE_NOTIFY requires ANJAY_WITH_THREAD_SAFETY"
+#    endif // ANJAY_WITH_THREAD_SAFETY
+
+/**
+ * Number of changes that can be queued by anjay_notify_changed() calls before
+ * the queue is drained. When the queue is full, anjay_notify_changed() falls
+ * back to locking the mutex. MUST be a power of two.
+ */
+#    define ANJAY_NOTIFY_RING_SIZE 256
+
+typedef struct {
+    atomic_size_t sequence;
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+} anjay_notify_ring_cell_t;
+
+/**
+ * Bounded multi-producer, single-consumer queue of Resource changes. Each cell
+ * is owned by a producer after it wins the CAS on enqueue_pos, and published to
+ * the consumer by storing its sequence number. The consumer (notify ring drain
+ * job) only runs with the mutex held.
+ */
+typedef struct {
+    anjay_notify_ring_cell_t cells[ANJAY_NOTIFY_RING_SIZE];
+    atomic_size_t enqueue_pos;
+    size_t dequeue_pos;
+    atomic_bool drain_scheduled;
+    /**
+     * Whether any values pushed with anjay_notify_value_changed_*() may be
+     * stored. Changes queued through the ring would only drop them when
+     * drained, so anjay_notify_changed() locks the mutex while this is set.
+     * Updated with the mutex held.
+     */
+    atomic_bool has_pushed_values;
+    /**
+     * Copy of the main scheduler pointer; set before the Anjay object is
+     * returned to the user and never changed afterwards.
+     */
+    avs_sched_t *sched;
+} anjay_notify_ring_t;
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
+
 // Please update this condition if anjay_atomic_fields_t ever gets more fields
-#if defined(ANJAY_WITH_EVENT_LOOP)
+#if defined(ANJAY_WITH_EVENT_LOOP) || defined(ANJAY_WITH_LOCK_FREE_NOTIFY) \
+        || defined(ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG)
 #    define ANJAY_ATOMIC_FIELDS_DEFINED
-#endif // defined(ANJAY_WITH_EVENT_LOOP)
+#endif // defined(ANJAY_WITH_EVENT_LOOP) ||
+       // defined(ANJAY_WITH_LOCK_FREE_NOTIFY) ||
+       // defined(ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG)
 
 #ifdef ANJAY_ATOMIC_FIELDS_DEFINED
 typedef struct {
 #    ifdef ANJAY_WITH_EVENT_LOOP
     volatile atomic_int event_loop_status;
 #    endif // ANJAY_WITH_EVENT_LOOP
+#    ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+    anjay_notify_ring_t notify_ring;
+#    endif // ANJAY_WITH_LOCK_FREE_NOTIFY
+#    ifdef ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+    /**
+     * Whether a trace handler is set; allows anjay_sched_run() to skip locking
+     * the mutex for its trace points when tracing is not used.
+     */
+    atomic_bool trace_handler_set;
+#    endif // ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
 } anjay_atomic_fields_t;
 #endif // ANJAY_ATOMIC_FIELDS_DEFINED
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+/**
+ * Estimated heap footprint of an AVS_LIST element holding an object of
+ * @p Size bytes, including the space for the "next" pointer.
+ */
+#    define ANJAY_LIST_ELEMENT_MEMORY(Size) (sizeof(void *) + (Size))
+
+/**
+ * Estimated heap footprint of an AVS_SORTED_SET element holding an object of
+ * @p Size bytes, including the space for the tree node header.
+ */
+#    define ANJAY_SORTED_SET_ELEMENT_MEMORY(Size) (4 * sizeof(void *) + (Size))
+#endif // ANJAY_WITH_MEMORY_STATS
+
 #ifdef ANJAY_WITH_THREAD_SAFETY
 
 typedef struct anjay_unlocked_struct anjay_unlocked_t;
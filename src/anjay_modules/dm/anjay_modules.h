@@ -224,6 +224,23 @@ anjay_unlocked_dm_transaction_commit_t(anjay_unlocked_t *anjay,
 typedef int
 anjay_unlocked_dm_transaction_rollback_t(anjay_unlocked_t *anjay,
                                          const anjay_dm_installed_object_t obj);
+typedef int
+anjay_unlocked_dm_instance_present_t(anjay_unlocked_t *anjay,
+                                     const anjay_dm_installed_object_t obj,
+                                     anjay_iid_t iid,
+                                     bool *out_present);
+typedef int anjay_unlocked_dm_resource_present_t(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t obj,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        anjay_dm_resource_kind_t *out_kind,
+        anjay_dm_resource_presence_t *out_presence);
+typedef int
+anjay_unlocked_dm_instance_read_t(anjay_unlocked_t *anjay,
+                                  const anjay_dm_installed_object_t obj,
+                                  anjay_iid_t iid,
+                                  anjay_unlocked_output_ctx_t *ctx);
 
 #ifdef ANJAY_WITH_THREAD_SAFETY
 typedef struct {
@@ -255,11 +272,16 @@ typedef struct {
     anjay_unlocked_dm_resource_instance_write_attrs_t
             *resource_instance_write_attrs;
 #    endif // ANJAY_WITH_LWM2M11
+    anjay_unlocked_dm_instance_present_t *instance_present;
+    anjay_unlocked_dm_resource_present_t *resource_present;
+    anjay_unlocked_dm_instance_read_t *instance_read;
 } anjay_unlocked_dm_handlers_t;
 #endif // ANJAY_WITH_THREAD_SAFETY
 
 typedef void anjay_dm_module_deleter_t(void *arg);
 
+typedef size_t anjay_dm_module_memory_usage_t(void *arg);
+
 typedef struct {
     /**
      * A function to be called every time when Anjay is notified of some data
@@ -273,6 +295,14 @@ typedef struct {
      * up any resources used by it.
      */
     anjay_dm_module_deleter_t *deleter;
+
+    /**
+     * Optional function returning the estimated number of heap bytes held by
+     * the module, reported by @ref anjay_get_memory_stats as part of
+     * @ref ANJAY_MEMORY_MODULES. Only called if ANJAY_WITH_MEMORY_STATS is
+     * enabled.
+     */
+    anjay_dm_module_memory_usage_t *memory_usage;
 } anjay_dm_module_t;
 
 /**
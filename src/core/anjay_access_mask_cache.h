@@ -0,0 +1,86 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_ACCESS_MASK_CACHE_H
+#define ANJAY_ACCESS_MASK_CACHE_H
+
+#include <avsystem/commons/avs_list.h>
+
+#include <anjay/dm.h>
+
+VISIBILITY_PRIVATE_HEADER_BEGIN
+
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+
+typedef struct {
+    anjay_ssid_t ssid;
+    anjay_access_mask_t mask;
+} anjay_access_mask_cache_acl_entry_t;
+
+/**
+ * Contents of a single Access Control object instance, as relevant for
+ * calculating access masks.
+ */
+typedef struct {
+    anjay_oid_t target_oid;
+    anjay_iid_t target_iid;
+    anjay_iid_t ac_iid;
+    /**
+     * ANJAY_SSID_ANY if the Owner resource could not be read.
+     */
+    anjay_ssid_t owner;
+    /**
+     * ACL entries, sorted by SSID. SSID == 0 denotes the default entry.
+     */
+    anjay_access_mask_cache_acl_entry_t *acl;
+    size_t acl_size;
+} anjay_access_mask_cache_entry_t;
+
+typedef enum {
+    ANJAY_ACCESS_MASK_CACHE_INVALID = 0,
+    ANJAY_ACCESS_MASK_CACHE_VALID,
+    /**
+     * Building the cache failed, e.g. because some Access Control object
+     * instance is not readable. Access masks are calculated by reading the data
+     * model directly until the cache is invalidated.
+     */
+    ANJAY_ACCESS_MASK_CACHE_UNAVAILABLE
+} anjay_access_mask_cache_state_t;
+
+/**
+ * Index of the Access Control object, used to calculate access masks without
+ * iterating over all its instances for every request.
+ */
+typedef struct {
+    anjay_access_mask_cache_state_t state;
+    /**
+     * Sorted by (target_oid, target_iid, ac_iid).
+     */
+    anjay_access_mask_cache_entry_t *entries;
+    size_t size;
+    size_t capacity;
+    /**
+     * Sorted list of IIDs of Access Control object instances that changed
+     * since the entries were last updated. Only meaningful in the VALID state.
+     */
+    AVS_LIST(anjay_iid_t) dirty_ac_iids;
+    /**
+     * Set while the cache is being updated. Data model handlers may be called
+     * with the mutex unlocked during that time, so invalidation requests
+     * are only recorded in invalidated_while_updating then.
+     */
+    bool updating;
+    bool invalidated_while_updating;
+} anjay_access_mask_cache_t;
+
+#endif // ANJAY_WITH_ACCESS_CONTROL
+
+VISIBILITY_PRIVATE_HEADER_END
+
+#endif /* ANJAY_ACCESS_MASK_CACHE_H */
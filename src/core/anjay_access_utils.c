@@ -10,6 +10,10 @@
 #include <anjay_init.h>
 
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_memory.h>
 
 #include <anjay_modules/anjay_access_utils.h>
 #include <anjay_modules/anjay_raw_buffer.h>
@@ -259,15 +263,336 @@ static int get_mask(anjay_unlocked_t *anjay,
     return 0;
 }
 
+static int acl_cache_entry_cmp(const void *left, const void *right) {
+    return (int) ((const anjay_access_mask_cache_acl_entry_t *) left)->ssid
+           - (int) ((const anjay_access_mask_cache_acl_entry_t *) right)->ssid;
+}
+
+static int cache_entry_cmp(const void *left_, const void *right_) {
+    const anjay_access_mask_cache_entry_t *left =
+            (const anjay_access_mask_cache_entry_t *) left_;
+    const anjay_access_mask_cache_entry_t *right =
+            (const anjay_access_mask_cache_entry_t *) right_;
+    if (left->target_oid != right->target_oid) {
+        return left->target_oid < right->target_oid ? -1 : 1;
+    }
+    if (left->target_iid != right->target_iid) {
+        return left->target_iid < right->target_iid ? -1 : 1;
+    }
+    if (left->ac_iid != right->ac_iid) {
+        return left->ac_iid < right->ac_iid ? -1 : 1;
+    }
+    return 0;
+}
+
+typedef struct {
+    anjay_access_mask_cache_acl_entry_t *acl;
+    size_t size;
+    size_t capacity;
+} cache_acl_builder_t;
+
+static int cache_read_acl_clb(anjay_unlocked_t *anjay,
+                              const anjay_dm_installed_object_t *obj,
+                              anjay_iid_t iid,
+                              anjay_rid_t rid,
+                              anjay_riid_t riid,
+                              void *builder_) {
+    cache_acl_builder_t *builder = (cache_acl_builder_t *) builder_;
+    if (builder->size == builder->capacity) {
+        size_t new_capacity = builder->capacity ? 2 * builder->capacity : 4;
+        anjay_access_mask_cache_acl_entry_t *new_acl =
+                (anjay_access_mask_cache_acl_entry_t *) avs_realloc(
+                        builder->acl, new_capacity * sizeof(*new_acl));
+        if (!new_acl) {
+            anjay_log(ERROR, _("out of memory"));
+            return -1;
+        }
+        builder->acl = new_acl;
+        builder->capacity = new_capacity;
+    }
+    anjay_access_mask_cache_acl_entry_t *entry = &builder->acl[builder->size];
+    entry->ssid = riid;
+    int result = read_mask(anjay, obj, iid, rid, riid, &entry->mask);
+    if (!result) {
+        ++builder->size;
+    }
+    return result;
+}
+
+static int read_cache_entry(anjay_unlocked_t *anjay,
+                            const anjay_dm_installed_object_t *ac_obj,
+                            anjay_iid_t ac_iid,
+                            anjay_access_mask_cache_entry_t *out_entry) {
+    int result = read_ids_from_ac_instance(anjay, ac_iid, &out_entry->target_oid,
+                                           &out_entry->target_iid, NULL);
+    if (result) {
+        return result;
+    }
+    out_entry->ac_iid = ac_iid;
+    if (read_ids_from_ac_instance(anjay, ac_iid, NULL, NULL,
+                                  &out_entry->owner)) {
+        // the uncached code path only reads the Owner if the ACL is empty, and
+        // treats failure to do so as lack of access, so let's just make sure
+        // the owner will not match any Server
+        out_entry->owner = ANJAY_SSID_ANY;
+    }
+
+    cache_acl_builder_t builder = { NULL, 0, 0 };
+    if ((result = foreach_acl(anjay, ac_obj, ac_iid, cache_read_acl_clb,
+                              &builder))) {
+        avs_free(builder.acl);
+        return result;
+    }
+    if (builder.size) {
+        qsort(builder.acl, builder.size, sizeof(*builder.acl),
+              acl_cache_entry_cmp);
+    }
+    out_entry->acl = builder.acl;
+    out_entry->acl_size = builder.size;
+    return 0;
+}
+
+static int cache_reserve(anjay_access_mask_cache_t *cache) {
+    if (cache->size < cache->capacity) {
+        return 0;
+    }
+    size_t new_capacity = cache->capacity ? 2 * cache->capacity : 8;
+    anjay_access_mask_cache_entry_t *new_entries =
+            (anjay_access_mask_cache_entry_t *) avs_realloc(
+                    cache->entries, new_capacity * sizeof(*new_entries));
+    if (!new_entries) {
+        anjay_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    cache->entries = new_entries;
+    cache->capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * Returns the index of the first entry not less than (oid, iid, ac_iid).
+ */
+static size_t cache_lower_bound(const anjay_access_mask_cache_t *cache,
+                                anjay_oid_t oid,
+                                anjay_iid_t iid,
+                                anjay_iid_t ac_iid) {
+    const anjay_access_mask_cache_entry_t query = {
+        .target_oid = oid,
+        .target_iid = iid,
+        .ac_iid = ac_iid
+    };
+    size_t begin = 0;
+    size_t end = cache->size;
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        if (cache_entry_cmp(&cache->entries[mid], &query) < 0) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+static void cache_reset(anjay_access_mask_cache_t *cache) {
+    for (size_t i = 0; i < cache->size; ++i) {
+        avs_free(cache->entries[i].acl);
+    }
+    avs_free(cache->entries);
+    cache->entries = NULL;
+    cache->size = 0;
+    cache->capacity = 0;
+    AVS_LIST_CLEAR(&cache->dirty_ac_iids);
+    cache->state = ANJAY_ACCESS_MASK_CACHE_INVALID;
+}
+
+static int cache_build_clb(anjay_unlocked_t *anjay,
+                           const anjay_dm_installed_object_t *ac_obj,
+                           anjay_iid_t ac_iid,
+                           void *cache_) {
+    anjay_access_mask_cache_t *cache = (anjay_access_mask_cache_t *) cache_;
+    int result = cache_reserve(cache);
+    if (!result
+            && !(result = read_cache_entry(anjay, ac_obj, ac_iid,
+                                           &cache->entries[cache->size]))) {
+        ++cache->size;
+    }
+    return result;
+}
+
+static int cache_refresh_instance(anjay_unlocked_t *anjay,
+                                  const anjay_dm_installed_object_t *ac_obj,
+                                  anjay_access_mask_cache_t *cache,
+                                  anjay_iid_t ac_iid) {
+    for (size_t i = 0; i < cache->size; ++i) {
+        if (cache->entries[i].ac_iid == ac_iid) {
+            avs_free(cache->entries[i].acl);
+            memmove(&cache->entries[i], &cache->entries[i + 1],
+                    (cache->size - i - 1) * sizeof(*cache->entries));
+            --cache->size;
+            break;
+        }
+    }
+    int result = _anjay_dm_instance_present(anjay, ac_obj, ac_iid);
+    if (result <= 0) {
+        // error, or the instance has been removed
+        return result;
+    }
+    anjay_access_mask_cache_entry_t entry;
+    if ((result = cache_reserve(cache))
+            || (result = read_cache_entry(anjay, ac_obj, ac_iid, &entry))) {
+        return result;
+    }
+    size_t index = cache_lower_bound(cache, entry.target_oid, entry.target_iid,
+                                     entry.ac_iid);
+    memmove(&cache->entries[index + 1], &cache->entries[index],
+            (cache->size - index) * sizeof(*cache->entries));
+    cache->entries[index] = entry;
+    ++cache->size;
+    return 0;
+}
+
+/**
+ * Brings the cache up to date, re-reading only the Access Control object
+ * instances that changed since the last call, or all of them if the set of
+ * instances might have changed. Returns a non-zero value if the cache cannot
+ * be used.
+ */
+static int cache_update_unguarded(anjay_unlocked_t *anjay,
+                                  const anjay_dm_installed_object_t *ac_obj,
+                                  anjay_access_mask_cache_t *cache) {
+    if (cache->state == ANJAY_ACCESS_MASK_CACHE_VALID) {
+        while (cache->dirty_ac_iids
+               && !cache_refresh_instance(anjay, ac_obj, cache,
+                                          *cache->dirty_ac_iids)) {
+            AVS_LIST_DELETE(&cache->dirty_ac_iids);
+        }
+        if (!cache->dirty_ac_iids) {
+            return 0;
+        }
+    }
+    cache_reset(cache);
+    if (_anjay_dm_foreach_instance(anjay, ac_obj, cache_build_clb, cache)) {
+        return -1;
+    }
+    if (cache->size) {
+        qsort(cache->entries, cache->size, sizeof(*cache->entries),
+              cache_entry_cmp);
+    }
+    cache->state = ANJAY_ACCESS_MASK_CACHE_VALID;
+    return 0;
+}
+
+static int cache_update(anjay_unlocked_t *anjay,
+                        const anjay_dm_installed_object_t *ac_obj) {
+    anjay_access_mask_cache_t *cache = &anjay->dm.access_mask_cache;
+    if (cache->updating
+            || cache->state == ANJAY_ACCESS_MASK_CACHE_UNAVAILABLE) {
+        return -1;
+    }
+    cache->updating = true;
+    cache->invalidated_while_updating = false;
+    int result = cache_update_unguarded(anjay, ac_obj, cache);
+    cache->updating = false;
+    if (cache->invalidated_while_updating) {
+        // the data read might be already outdated
+        cache_reset(cache);
+        return -1;
+    }
+    if (result) {
+        cache_reset(cache);
+        cache->state = ANJAY_ACCESS_MASK_CACHE_UNAVAILABLE;
+    }
+    return result;
+}
+
+static anjay_access_mask_t
+cached_entry_mask(const anjay_access_mask_cache_entry_t *entry,
+                  anjay_ssid_t ssid) {
+    // same logic as in access_control_mask(), see comments there
+    if (!entry->acl_size) {
+        return entry->owner == ssid
+                       ? ANJAY_ACCESS_MASK_FULL & ~ANJAY_ACCESS_MASK_CREATE
+                       : ANJAY_ACCESS_MASK_NONE;
+    }
+    const anjay_access_mask_cache_acl_entry_t query = {
+        .ssid = ssid
+    };
+    const anjay_access_mask_cache_acl_entry_t *acl_entry =
+            (const anjay_access_mask_cache_acl_entry_t *) bsearch(
+                    &query, entry->acl, entry->acl_size, sizeof(*entry->acl),
+                    acl_cache_entry_cmp);
+    if (acl_entry) {
+        return acl_entry->mask;
+    }
+    // the default entry, if present, is the first one
+    if (!entry->acl[0].ssid) {
+        return entry->acl[0].mask;
+    }
+    return ANJAY_ACCESS_MASK_NONE;
+}
+
+/**
+ * Returns the up to date cache, or NULL if it cannot be used, in which case the
+ * data model needs to be queried directly.
+ *
+ * NOTE: The returned pointer, as well as the entries, might be invalidated by
+ * any call to data model handlers.
+ */
+static const anjay_access_mask_cache_t *
+get_usable_cache(anjay_unlocked_t *anjay,
+                 const anjay_dm_installed_object_t *ac_obj) {
+    // Access Control object might be in an inconsistent state while it is part
+    // of an ongoing transaction, so let's not cache anything in that case
+    if (_anjay_dm_transaction_object_included(anjay, ac_obj)
+            || cache_update(anjay, ac_obj)) {
+        return NULL;
+    }
+    return &anjay->dm.access_mask_cache;
+}
+
+/**
+ * Calculates the access mask using the cache. Returns a non-zero value if the
+ * cache cannot be used, in which case the data model needs to be queried
+ * directly.
+ */
+static int cached_access_control_mask(anjay_unlocked_t *anjay,
+                                      const anjay_dm_installed_object_t *ac_obj,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_ssid_t ssid,
+                                      anjay_access_mask_t *out_mask) {
+    const anjay_access_mask_cache_t *cache = get_usable_cache(anjay, ac_obj);
+    if (!cache) {
+        return -1;
+    }
+    size_t index = cache_lower_bound(cache, oid, iid, 0);
+    if (index < cache->size && cache->entries[index].target_oid == oid
+            && cache->entries[index].target_iid == iid) {
+        *out_mask = cached_entry_mask(&cache->entries[index], ssid);
+    } else {
+        *out_mask = ANJAY_ACCESS_MASK_NONE;
+    }
+    return 0;
+}
+
 static anjay_access_mask_t access_control_mask(anjay_unlocked_t *anjay,
                                                anjay_oid_t oid,
                                                anjay_iid_t iid,
                                                anjay_ssid_t ssid) {
     const anjay_dm_installed_object_t *ac_obj =
             _anjay_dm_find_object_by_oid(anjay, ANJAY_DM_OID_ACCESS_CONTROL);
+    if (!ac_obj) {
+        return ANJAY_ACCESS_MASK_NONE;
+    }
+    anjay_access_mask_t cached_mask;
+    if (!cached_access_control_mask(anjay, ac_obj, oid, iid, ssid,
+                                    &cached_mask)) {
+        return cached_mask;
+    }
+
     anjay_iid_t ac_iid;
-    if (!ac_obj
-            || find_ac_instance_by_target(anjay, ac_obj, &ac_iid, oid, iid)) {
+    if (find_ac_instance_by_target(anjay, ac_obj, &ac_iid, oid, iid)) {
         return ANJAY_ACCESS_MASK_NONE;
     }
 
@@ -394,6 +719,22 @@ bool _anjay_instance_action_allowed(anjay_unlocked_t *anjay,
 
 #ifdef ANJAY_WITH_ACCESS_CONTROL
 
+static const anjay_notify_queue_object_entry_t *
+get_ac_notif_entry(anjay_notify_queue_t queue) {
+    AVS_LIST(anjay_notify_queue_object_entry_t) it;
+    AVS_LIST_FOREACH(it, queue) {
+        // Queue entries are sorted by OID, compare with
+        // find_or_create_object_entry() in notify.c
+        if (it->oid >= ANJAY_DM_OID_ACCESS_CONTROL) {
+            break;
+        }
+    }
+    if (it && it->oid == ANJAY_DM_OID_ACCESS_CONTROL) {
+        return it;
+    }
+    return NULL;
+}
+
 static void what_changed(anjay_ssid_t origin_ssid,
                          anjay_notify_queue_t notifications_already_queued,
                          bool *out_might_caused_orphaned_ac_instances,
@@ -535,11 +876,11 @@ typedef struct {
     anjay_iid_t ac_iid;
     anjay_oid_t target_oid;
     anjay_iid_t target_iid;
-} orphaned_instance_info_t;
+} ac_instance_info_t;
 
 typedef struct {
     AVS_LIST(anjay_ssid_t) valid_ssids;
-    AVS_LIST(orphaned_instance_info_t) *orphaned_instance_list_append_ptr;
+    AVS_LIST(ac_instance_info_t) *orphaned_instance_list_append_ptr;
     anjay_notify_queue_t *out_dm_changes;
 } process_orphaned_instances_args_t;
 
@@ -591,7 +932,7 @@ process_orphaned_instances_clb(anjay_unlocked_t *anjay,
         // remove_orphaned_instances().
         assert(!*args->orphaned_instance_list_append_ptr);
         if (!(*args->orphaned_instance_list_append_ptr =
-                      AVS_LIST_NEW_ELEMENT(orphaned_instance_info_t))) {
+                      AVS_LIST_NEW_ELEMENT(ac_instance_info_t))) {
             anjay_log(ERROR, _("out of memory"));
             result = -1;
             goto finish;
@@ -633,8 +974,61 @@ finish:
     return result;
 }
 
+static bool cached_acl_has_invalid_ssids(
+        const anjay_access_mask_cache_entry_t *entry,
+        AVS_LIST(anjay_ssid_t) valid_ssids) {
+    // both the ACL and valid_ssids are sorted
+    for (size_t i = 0; i < entry->acl_size; ++i) {
+        anjay_ssid_t ssid = entry->acl[i].ssid;
+        if (ssid == ANJAY_ACCESS_LIST_OWNER_BOOTSTRAP || ssid == ANJAY_SSID_ANY) {
+            continue;
+        }
+        while (valid_ssids && *valid_ssids < ssid) {
+            valid_ssids = AVS_LIST_NEXT(valid_ssids);
+        }
+        if (!valid_ssids || *valid_ssids != ssid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Uses the cache to list (in ascending order) IIDs of Access Control instances
+ * that have ACL entries referring to SSIDs not present in valid_ssids - other
+ * instances would be left intact by process_orphaned_instances_clb() anyway.
+ * Returns a non-zero value if the cache cannot be used.
+ */
+static int list_instances_with_invalid_ssids(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *ac_obj,
+        AVS_LIST(anjay_ssid_t) valid_ssids,
+        AVS_LIST(anjay_iid_t) *out_iids) {
+    assert(!*out_iids);
+    const anjay_access_mask_cache_t *cache = get_usable_cache(anjay, ac_obj);
+    if (!cache) {
+        return -1;
+    }
+    for (size_t i = 0; i < cache->size; ++i) {
+        if (!cached_acl_has_invalid_ssids(&cache->entries[i], valid_ssids)) {
+            continue;
+        }
+        AVS_LIST(anjay_iid_t) *insert_ptr = out_iids;
+        while (*insert_ptr && **insert_ptr < cache->entries[i].ac_iid) {
+            AVS_LIST_ADVANCE_PTR(&insert_ptr);
+        }
+        if (!AVS_LIST_INSERT_NEW(anjay_iid_t, insert_ptr)) {
+            anjay_log(ERROR, _("out of memory"));
+            AVS_LIST_CLEAR(out_iids);
+            return -1;
+        }
+        **insert_ptr = cache->entries[i].ac_iid;
+    }
+    return 0;
+}
+
 static int remove_referred_instance(anjay_unlocked_t *anjay,
-                                    const orphaned_instance_info_t *it,
+                                    const ac_instance_info_t *it,
                                     anjay_notify_queue_t *out_dm_changes) {
     // We do not fail if either of the following is true:
     // - the target Object does not exist
@@ -678,21 +1072,31 @@ remove_orphaned_instances(anjay_unlocked_t *anjay,
                           anjay_notify_queue_t *new_notifications_queue) {
     int result = 0;
     AVS_LIST(anjay_ssid_t) ssid_list = NULL;
-    AVS_LIST(orphaned_instance_info_t) instances_to_remove = NULL;
+    AVS_LIST(ac_instance_info_t) instances_to_remove = NULL;
     const anjay_dm_installed_object_t *security_obj =
             _anjay_dm_find_object_by_oid(anjay, ANJAY_DM_OID_SECURITY);
     if (security_obj) {
         result = _anjay_dm_foreach_instance(
                 anjay, security_obj, enumerate_valid_ssids_clb, &ssid_list);
     }
-    if (!result) {
+    process_orphaned_instances_args_t args = {
+        .valid_ssids = ssid_list,
+        .orphaned_instance_list_append_ptr = &instances_to_remove,
+        .out_dm_changes = new_notifications_queue
+    };
+    AVS_LIST(anjay_iid_t) candidates = NULL;
+    if (!result
+            && list_instances_with_invalid_ssids(anjay, ac_obj, ssid_list,
+                                                 &candidates)) {
         result = _anjay_dm_foreach_instance(
-                anjay, ac_obj, process_orphaned_instances_clb,
-                &(process_orphaned_instances_args_t) {
-                    .valid_ssids = ssid_list,
-                    .orphaned_instance_list_append_ptr = &instances_to_remove,
-                    .out_dm_changes = new_notifications_queue
-                });
+                anjay, ac_obj, process_orphaned_instances_clb, &args);
+    } else {
+        AVS_LIST_CLEAR(&candidates) {
+            if (!result) {
+                result = process_orphaned_instances_clb(anjay, ac_obj,
+                                                        *candidates, &args);
+            }
+        }
     }
     // Actually remove the instances marked by process_orphaned_instances_clb
     // as necessary for removal, and the Object Instances referred to by them.
@@ -796,6 +1200,27 @@ typedef struct {
     AVS_LIST(anjay_iid_t) iids_to_remove;
 } enumerate_instances_to_remove_args_t;
 
+/**
+ * Puts the IID of the Access Control instance onto the args->iids_to_remove
+ * list if it does not refer to any valid object instance.
+ */
+static int
+check_instance_to_remove(anjay_unlocked_t *anjay,
+                         enumerate_instances_to_remove_args_t *args,
+                         anjay_iid_t iid,
+                         anjay_oid_t target_oid,
+                         anjay_iid_t target_iid) {
+    if (_anjay_acl_ref_validate_inst_ref(anjay, &args->validation_ctx,
+                                         target_oid, target_iid)) {
+        if (!AVS_LIST_INSERT_NEW(anjay_iid_t, &args->iids_to_remove)) {
+            anjay_log(ERROR, _("out of memory"));
+            return -1;
+        }
+        *args->iids_to_remove = iid;
+    }
+    return 0;
+}
+
 /**
  * Puts IIDs for Accces Control instances that do not refer to any valid object
  * instance onto the args->iids_to_remove list.
@@ -812,18 +1237,55 @@ enumerate_instances_to_remove_clb(anjay_unlocked_t *anjay,
     anjay_iid_t target_iid;
     int result = read_ids_from_ac_instance(anjay, iid, &target_oid, &target_iid,
                                            NULL);
-    if (!result
-            && _anjay_acl_ref_validate_inst_ref(anjay, &args->validation_ctx,
-                                                target_oid, target_iid)) {
-        if (!AVS_LIST_INSERT_NEW(anjay_iid_t, &args->iids_to_remove)) {
-            anjay_log(ERROR, _("out of memory"));
-            return -1;
-        }
-        *args->iids_to_remove = iid;
+    if (!result) {
+        result = check_instance_to_remove(anjay, args, iid, target_oid,
+                                          target_iid);
     }
     return result;
 }
 
+/**
+ * Uses the cache to list Access Control instances that refer to objects whose
+ * sets of instances changed, according to the notification queue. Entries are
+ * ordered by target OID, target IID and Access Control instance IID. Returns
+ * a non-zero value if the cache cannot be used.
+ */
+static int
+list_instances_targeting_changed_objects(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *ac_obj,
+        anjay_notify_queue_t notifications_queue,
+        AVS_LIST(ac_instance_info_t) *out_instances) {
+    assert(!*out_instances);
+    const anjay_access_mask_cache_t *cache = get_usable_cache(anjay, ac_obj);
+    if (!cache) {
+        return -1;
+    }
+    AVS_LIST(ac_instance_info_t) *append_ptr = out_instances;
+    AVS_LIST(anjay_notify_queue_object_entry_t) it;
+    AVS_LIST_FOREACH(it, notifications_queue) {
+        if (!it->instance_set_changes.instance_set_changed
+                || it->oid == ANJAY_DM_OID_SECURITY
+                || it->oid == ANJAY_DM_OID_ACCESS_CONTROL) {
+            continue;
+        }
+        for (size_t i = cache_lower_bound(cache, it->oid, 0, 0);
+             i < cache->size && cache->entries[i].target_oid == it->oid;
+             ++i) {
+            if (!(*append_ptr = AVS_LIST_NEW_ELEMENT(ac_instance_info_t))) {
+                anjay_log(ERROR, _("out of memory"));
+                AVS_LIST_CLEAR(out_instances);
+                return -1;
+            }
+            (*append_ptr)->ac_iid = cache->entries[i].ac_iid;
+            (*append_ptr)->target_oid = cache->entries[i].target_oid;
+            (*append_ptr)->target_iid = cache->entries[i].target_iid;
+            AVS_LIST_ADVANCE_PTR(&append_ptr);
+        }
+    }
+    return 0;
+}
+
 /**
  * Removes Access Control instances that do not refer to any valid object
  * instance.
@@ -836,8 +1298,30 @@ static int perform_removes(anjay_unlocked_t *anjay,
         .iids_to_remove = NULL
     };
 
-    int result = _anjay_dm_foreach_instance(
-            anjay, ac_obj, enumerate_instances_to_remove_clb, &args);
+    const anjay_notify_queue_object_entry_t *ac_notif =
+            get_ac_notif_entry(*new_notifications_queue);
+    AVS_LIST(ac_instance_info_t) candidates = NULL;
+    int result = 0;
+    if ((ac_notif && ac_notif->instance_set_changes.instance_set_changed)
+            || list_instances_targeting_changed_objects(
+                       anjay, ac_obj, *new_notifications_queue,
+                       &candidates)) {
+        // Newly created Access Control instances might refer to any object, so
+        // we need to check all of them; the same if the cache is unavailable
+        result = _anjay_dm_foreach_instance(
+                anjay, ac_obj, enumerate_instances_to_remove_clb, &args);
+    } else {
+        // Only the instances referring to objects with changed sets of
+        // instances might have become invalid
+        AVS_LIST_CLEAR(&candidates) {
+            if (!result) {
+                result = check_instance_to_remove(anjay, &args,
+                                                  candidates->ac_iid,
+                                                  candidates->target_oid,
+                                                  candidates->target_iid);
+            }
+        }
+    }
     _anjay_acl_ref_validation_ctx_cleanup(&args.validation_ctx);
     AVS_LIST_CLEAR(&args.iids_to_remove) {
         (void) (result
@@ -925,6 +1409,24 @@ validate_resources_to_write(anjay_unlocked_t *anjay,
     return result;
 }
 
+static int
+find_ac_instance_by_target_cached(anjay_unlocked_t *anjay,
+                                  const anjay_dm_installed_object_t *ac_obj,
+                                  anjay_oid_t target_oid,
+                                  anjay_iid_t target_iid) {
+    const anjay_access_mask_cache_t *cache = get_usable_cache(anjay, ac_obj);
+    if (!cache) {
+        return find_ac_instance_by_target(anjay, ac_obj, NULL, target_oid,
+                                          target_iid);
+    }
+    size_t index = cache_lower_bound(cache, target_oid, target_iid, 0);
+    if (index < cache->size && cache->entries[index].target_oid == target_oid
+            && cache->entries[index].target_iid == target_iid) {
+        return 0;
+    }
+    return ANJAY_ERR_NOT_FOUND;
+}
+
 /**
  * Creates Access Control object instances for objects instances listed in
  * known_added_iids entries inside incoming_queue.
@@ -933,6 +1435,11 @@ static int perform_adds(anjay_unlocked_t *anjay,
                         const anjay_dm_installed_object_t *ac_obj,
                         anjay_ssid_t origin_ssid,
                         anjay_notify_queue_t *notifications_queue) {
+    // Look up all the targets first - the cache cannot be used after the
+    // Access Control object is modified within the transaction
+    AVS_LIST(ac_instance_info_t) missing = NULL;
+    AVS_LIST(ac_instance_info_t) *append_ptr = &missing;
+    int result = 0;
     AVS_LIST(anjay_notify_queue_object_entry_t) it;
     AVS_LIST_FOREACH(it, *notifications_queue) {
         if (it->oid == ANJAY_DM_OID_SECURITY
@@ -940,61 +1447,61 @@ static int perform_adds(anjay_unlocked_t *anjay,
             continue;
         }
 
-        // create Access Control object instances for created instances
         AVS_LIST(anjay_iid_t) iid_it;
         AVS_LIST_FOREACH(iid_it, it->instance_set_changes.known_added_iids) {
-            int result = find_ac_instance_by_target(anjay, ac_obj, NULL,
-                                                    it->oid, *iid_it);
+            result = find_ac_instance_by_target_cached(anjay, ac_obj, it->oid,
+                                                       *iid_it);
             if (!result) {
                 // AC instance already exists, skip
                 continue;
             }
-            anjay_iid_t ac_iid;
-            if (result != ANJAY_ERR_NOT_FOUND
-                    || (result = _anjay_dm_select_free_iid(anjay, ac_obj,
-                                                           &ac_iid))
-                    || (result = _anjay_dm_call_instance_create(anjay, ac_obj,
-                                                                ac_iid))
-                    || (result = validate_resources_to_write(anjay, ac_obj,
-                                                             ac_iid))
-                    || (result = write_u16(anjay, ac_obj, ac_iid,
-                                           ANJAY_DM_RID_ACCESS_CONTROL_OID,
-                                           ANJAY_ID_INVALID, it->oid))
-                    || (result = write_u16(anjay, ac_obj, ac_iid,
-                                           ANJAY_DM_RID_ACCESS_CONTROL_OIID,
-                                           ANJAY_ID_INVALID, *iid_it))
-                    || (result = write_u16(anjay, ac_obj, ac_iid,
-                                           ANJAY_DM_RID_ACCESS_CONTROL_ACL,
-                                           origin_ssid,
-                                           ANJAY_ACCESS_MASK_FULL
-                                                   & ~ANJAY_ACCESS_MASK_CREATE))
-                    || (result = write_u16(anjay, ac_obj, ac_iid,
-                                           ANJAY_DM_RID_ACCESS_CONTROL_OWNER,
-                                           ANJAY_ID_INVALID, origin_ssid))
-                    || (result = _anjay_notify_queue_instance_created(
-                                notifications_queue,
-                                ANJAY_DM_OID_ACCESS_CONTROL, ac_iid))) {
-                return result;
+            if (result != ANJAY_ERR_NOT_FOUND) {
+                goto finish;
+            }
+            if (!(*append_ptr = AVS_LIST_NEW_ELEMENT(ac_instance_info_t))) {
+                anjay_log(ERROR, _("out of memory"));
+                result = -1;
+                goto finish;
             }
+            (*append_ptr)->target_oid = it->oid;
+            (*append_ptr)->target_iid = *iid_it;
+            AVS_LIST_ADVANCE_PTR(&append_ptr);
+            result = 0;
         }
     }
-    return 0;
-}
 
-static const anjay_notify_queue_object_entry_t *
-get_ac_notif_entry(anjay_notify_queue_t queue) {
-    AVS_LIST(anjay_notify_queue_object_entry_t) it;
-    AVS_LIST_FOREACH(it, queue) {
-        // Queue entries are sorted by OID, compare with
-        // find_or_create_object_entry() in notify.c
-        if (it->oid >= ANJAY_DM_OID_ACCESS_CONTROL) {
+    // create Access Control object instances for created instances
+    AVS_LIST(ac_instance_info_t) target;
+    AVS_LIST_FOREACH(target, missing) {
+        if ((result = _anjay_dm_select_free_iid(anjay, ac_obj,
+                                                &target->ac_iid))
+                || (result = _anjay_dm_call_instance_create(anjay, ac_obj,
+                                                            target->ac_iid))
+                || (result = validate_resources_to_write(anjay, ac_obj,
+                                                         target->ac_iid))
+                || (result = write_u16(anjay, ac_obj, target->ac_iid,
+                                       ANJAY_DM_RID_ACCESS_CONTROL_OID,
+                                       ANJAY_ID_INVALID, target->target_oid))
+                || (result = write_u16(anjay, ac_obj, target->ac_iid,
+                                       ANJAY_DM_RID_ACCESS_CONTROL_OIID,
+                                       ANJAY_ID_INVALID, target->target_iid))
+                || (result = write_u16(anjay, ac_obj, target->ac_iid,
+                                       ANJAY_DM_RID_ACCESS_CONTROL_ACL,
+                                       origin_ssid,
+                                       ANJAY_ACCESS_MASK_FULL
+                                               & ~ANJAY_ACCESS_MASK_CREATE))
+                || (result = write_u16(anjay, ac_obj, target->ac_iid,
+                                       ANJAY_DM_RID_ACCESS_CONTROL_OWNER,
+                                       ANJAY_ID_INVALID, origin_ssid))
+                || (result = _anjay_notify_queue_instance_created(
+                            notifications_queue, ANJAY_DM_OID_ACCESS_CONTROL,
+                            target->ac_iid))) {
             break;
         }
     }
-    if (it && it->oid == ANJAY_DM_OID_ACCESS_CONTROL) {
-        return it;
-    }
-    return NULL;
+finish:
+    AVS_LIST_CLEAR(&missing);
+    return result;
 }
 
 static int generate_apparent_instance_set_change_notifications(
@@ -1067,3 +1574,41 @@ int _anjay_sync_access_control(anjay_unlocked_t *anjay,
     return _anjay_dm_transaction_finish(anjay, result);
 #endif // ANJAY_WITH_ACCESS_CONTROL
 }
+
+void _anjay_access_mask_cache_invalidate(anjay_unlocked_t *anjay,
+                                         anjay_iid_t ac_iid) {
+#ifndef ANJAY_WITH_ACCESS_CONTROL
+    (void) anjay;
+    (void) ac_iid;
+#else  // ANJAY_WITH_ACCESS_CONTROL
+    anjay_access_mask_cache_t *cache = &anjay->dm.access_mask_cache;
+    if (cache->updating) {
+        cache->invalidated_while_updating = true;
+        return;
+    }
+    if (cache->state != ANJAY_ACCESS_MASK_CACHE_VALID
+            || ac_iid == ANJAY_ID_INVALID) {
+        cache_reset(cache);
+        return;
+    }
+    AVS_LIST(anjay_iid_t) *insert_ptr = &cache->dirty_ac_iids;
+    while (*insert_ptr && **insert_ptr < ac_iid) {
+        AVS_LIST_ADVANCE_PTR(&insert_ptr);
+    }
+    if (*insert_ptr && **insert_ptr == ac_iid) {
+        return;
+    }
+    if (!AVS_LIST_INSERT_NEW(anjay_iid_t, insert_ptr)) {
+        anjay_log(ERROR, _("out of memory"));
+        cache_reset(cache);
+        return;
+    }
+    **insert_ptr = ac_iid;
+#endif // ANJAY_WITH_ACCESS_CONTROL
+}
+
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+void _anjay_access_mask_cache_cleanup(anjay_access_mask_cache_t *cache) {
+    cache_reset(cache);
+}
+#endif // ANJAY_WITH_ACCESS_CONTROL
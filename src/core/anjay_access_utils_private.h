@@ -61,6 +61,10 @@ int _anjay_sync_access_control(anjay_unlocked_t *anjay,
                                anjay_ssid_t origin_ssid,
                                anjay_notify_queue_t *notifications_queue);
 
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+void _anjay_access_mask_cache_cleanup(anjay_access_mask_cache_t *cache);
+#endif // ANJAY_WITH_ACCESS_CONTROL
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* ANJAY_ACCESS_UTILS_PRIVATE_H */
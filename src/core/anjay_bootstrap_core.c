@@ -655,7 +655,7 @@ static int schedule_bootstrap_timeout(anjay_unlocked_t *anjay) {
         /* This function is called on each Bootstrap Finish -- i.e. we might
          * have already scheduled a purge. For this reason, we need to release
          * the purge job handle first. */
-        if (AVS_SCHED_DELAYED(
+        if (ANJAY_SCHED_DELAYED(
                     anjay->sched, &anjay->bootstrap.purge_bootstrap_handle,
                     avs_time_duration_from_scalar(timeout, AVS_TIME_S),
                     purge_bootstrap, NULL, 0)) {
@@ -927,11 +927,12 @@ static void timeout_bootstrap_finish(avs_sched_t *sched, const void *dummy) {
 
 static avs_error_t schedule_finish_timeout(anjay_unlocked_t *anjay,
                                            anjay_connection_ref_t connection) {
-    if (AVS_SCHED_DELAYED(anjay->sched, &anjay->bootstrap.finish_timeout_handle,
-                          _anjay_exchange_lifetime_for_transport(
-                                  anjay,
-                                  _anjay_connection_transport(connection)),
-                          timeout_bootstrap_finish, NULL, 0)) {
+    if (ANJAY_SCHED_DELAYED(anjay->sched,
+                            &anjay->bootstrap.finish_timeout_handle,
+                            _anjay_exchange_lifetime_for_transport(
+                                    anjay,
+                                    _anjay_connection_transport(connection)),
+                            timeout_bootstrap_finish, NULL, 0)) {
         anjay_log(ERROR, _("could not schedule finish timeout"));
         return avs_errno(AVS_ENOMEM);
     }
@@ -1184,10 +1185,10 @@ static int schedule_request_bootstrap(anjay_unlocked_t *anjay) {
     anjay_log(DEBUG, _("Scheduling bootstrap in ") "%s" _(" seconds"),
               AVS_TIME_DURATION_AS_STRING(
                       anjay->bootstrap.client_initiated_bootstrap_holdoff));
-    if (AVS_SCHED_DELAYED(anjay->sched,
-                          &anjay->bootstrap.client_initiated_bootstrap_handle,
-                          avs_time_monotonic_diff(attempt_instant, now),
-                          request_bootstrap_job, NULL, 0)) {
+    if (ANJAY_SCHED_DELAYED(anjay->sched,
+                            &anjay->bootstrap.client_initiated_bootstrap_handle,
+                            avs_time_monotonic_diff(attempt_instant, now),
+                            request_bootstrap_job, NULL, 0)) {
         anjay_log(WARNING, _("Could not schedule Client Initiated Bootstrap"));
         return -1;
     }
@@ -242,12 +242,6 @@ static int init_anjay(anjay_unlocked_t *anjay,
         }
     }
 
-#ifdef ANJAY_WITH_ATTR_STORAGE
-    if (_anjay_attr_storage_init(anjay)) {
-        return -1;
-    }
-#endif // ANJAY_WITH_ATTR_STORAGE
-
     return 0;
 }
 
@@ -271,10 +265,10 @@ void _anjay_reschedule_coap_sched_job(anjay_unlocked_t *anjay) {
                 avs_sched_time_of_next(anjay->coap_sched);
         if (avs_time_monotonic_valid(next_job_time)) {
             if (!anjay->coap_sched_job_handle
-                    || AVS_RESCHED_AT(&anjay->coap_sched_job_handle,
-                                      next_job_time)) {
-                AVS_SCHED_AT(anjay->sched, &anjay->coap_sched_job_handle,
-                             next_job_time, coap_sched_job, NULL, 0);
+                    || ANJAY_RESCHED_AT(&anjay->coap_sched_job_handle,
+                                        next_job_time)) {
+                ANJAY_SCHED_AT(anjay->sched, &anjay->coap_sched_job_handle,
+                               next_job_time, coap_sched_job, NULL, 0);
             }
         } else {
             avs_sched_del(&anjay->coap_sched_job_handle);
@@ -318,6 +312,9 @@ static anjay_t *alloc_anjay(void) {
         avs_free(out);
         return NULL;
     }
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+    _anjay_notify_ring_init(&out->atomic_fields.notify_ring, anjay->sched);
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
     return out;
 }
 
@@ -354,12 +351,16 @@ static void anjay_cleanup_impl(anjay_unlocked_t *anjay, bool deregister) {
     _anjay_attr_storage_cleanup(&anjay->attr_storage);
 #endif // ANJAY_WITH_ATTR_STORAGE
     _anjay_dm_cleanup(anjay);
-    _anjay_notify_clear_queue(&anjay->scheduled_notify.queue);
+    _anjay_scheduled_notify_cleanup(&anjay->scheduled_notify);
 
 #ifdef ANJAY_WITH_SEND
     _anjay_send_cleanup(&anjay->sender);
 #endif // ANJAY_WITH_SEND
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+    _anjay_operation_stats_cleanup(&anjay->operation_stats);
+#endif // ANJAY_WITH_OPERATION_STATS
+
     avs_free(anjay->default_tls_ciphersuites.ids);
     avs_free(anjay->endpoint_name);
 
@@ -376,6 +377,9 @@ static void anjay_cleanup_impl(anjay_unlocked_t *anjay, bool deregister) {
 #ifdef ANJAY_WITH_THREAD_SAFETY
     avs_sched_cleanup(&anjay->coap_sched);
 #endif // ANJAY_WITH_THREAD_SAFETY
+#ifdef ANJAY_WITH_SCHED_PROFILING
+    _anjay_sched_job_stats_cleanup(&anjay->sched_job_stats);
+#endif // ANJAY_WITH_SCHED_PROFILING
 
     if (!anjay->prng_ctx.allocated_by_user) {
         avs_crypto_prng_free(&anjay->prng_ctx.ctx);
@@ -627,6 +631,47 @@ static const char *action_to_string(anjay_request_action_t action) {
     return "<invalid action>";
 }
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+static bool request_to_operation(const anjay_request_t *request,
+                                 anjay_operation_t *out_operation) {
+    switch (request->action) {
+    case ANJAY_ACTION_READ:
+#    ifdef ANJAY_WITH_LWM2M11
+    case ANJAY_ACTION_READ_COMPOSITE:
+#    endif // ANJAY_WITH_LWM2M11
+        *out_operation = request->observe ? ANJAY_OPERATION_OBSERVE
+                                          : ANJAY_OPERATION_READ;
+        return true;
+    case ANJAY_ACTION_DISCOVER:
+        *out_operation = ANJAY_OPERATION_DISCOVER;
+        return true;
+    case ANJAY_ACTION_WRITE:
+    case ANJAY_ACTION_WRITE_UPDATE:
+#    ifdef ANJAY_WITH_LWM2M11
+    case ANJAY_ACTION_WRITE_COMPOSITE:
+#    endif // ANJAY_WITH_LWM2M11
+        *out_operation = ANJAY_OPERATION_WRITE;
+        return true;
+    case ANJAY_ACTION_WRITE_ATTRIBUTES:
+        *out_operation = ANJAY_OPERATION_WRITE_ATTRIBUTES;
+        return true;
+    case ANJAY_ACTION_EXECUTE:
+        *out_operation = ANJAY_OPERATION_EXECUTE;
+        return true;
+    case ANJAY_ACTION_CREATE:
+        *out_operation = ANJAY_OPERATION_CREATE;
+        return true;
+    case ANJAY_ACTION_DELETE:
+        *out_operation = ANJAY_OPERATION_DELETE;
+        return true;
+    case ANJAY_ACTION_BOOTSTRAP_FINISH:
+        return false;
+    }
+    AVS_UNREACHABLE("invalid enum value");
+    return false;
+}
+#endif // ANJAY_WITH_OPERATION_STATS
+
 static int code_to_action(uint8_t code,
                           uint16_t requested_format,
                           bool is_bs_uri,
@@ -850,14 +895,37 @@ static bool critical_option_validator(uint8_t msg_code, uint32_t optnum) {
     }
 }
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+static void record_operation_stats(anjay_connection_ref_t connection,
+                                   const anjay_request_t *request,
+                                   avs_time_monotonic_t start_time,
+                                   int result) {
+    anjay_operation_t operation;
+    if (request_to_operation(request, &operation)) {
+        _anjay_operation_stats_record(_anjay_from_server(connection.server),
+                                      _anjay_server_ssid(connection.server),
+                                      operation, start_time, result != 0);
+    }
+}
+#endif // ANJAY_WITH_OPERATION_STATS
+
 static int handle_request(anjay_connection_ref_t connection,
                           const anjay_request_t *request) {
     int result = -1;
+#ifdef ANJAY_WITH_OPERATION_STATS
+    const avs_time_monotonic_t start_time = avs_time_monotonic_now();
+#endif // ANJAY_WITH_OPERATION_STATS
 
     if (_anjay_server_ssid(connection.server) == ANJAY_SSID_BOOTSTRAP) {
         result = _anjay_bootstrap_perform_action(connection, request);
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_operation_stats(connection, request, start_time, result);
+#endif // ANJAY_WITH_OPERATION_STATS
     } else {
         result = _anjay_dm_perform_action(connection, request);
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_operation_stats(connection, request, start_time, result);
+#endif // ANJAY_WITH_OPERATION_STATS
         _anjay_observe_sched_flush(connection);
     }
     return result;
@@ -888,8 +956,16 @@ handle_incoming_message(avs_coap_streaming_request_ctx_t *ctx,
     if (avs_coap_options_validate_critical(request_header,
                                            critical_option_validator)
             || parse_request(request_header, &request, observe_id)) {
+        _anjay_trace(_anjay_from_server(args->connection.server),
+                     ANJAY_TRACE_REQUEST_PARSED,
+                     _anjay_server_ssid(args->connection.server), NULL, NULL,
+                     -1);
         return AVS_COAP_CODE_BAD_OPTION;
     }
+    _anjay_trace(_anjay_from_server(args->connection.server),
+                 ANJAY_TRACE_REQUEST_PARSED,
+                 _anjay_server_ssid(args->connection.server), &request.uri,
+                 action_to_string(request.action), 0);
     request.ctx = ctx;
     request.payload_stream = payload_stream;
     request.observe = observe_id;
@@ -984,8 +1060,15 @@ static int serve_connection(anjay_connection_ref_t connection) {
         .connection = connection,
         .serve_result = 0
     };
+    _anjay_trace(_anjay_from_server(connection.server),
+                 ANJAY_TRACE_COAP_RECEIVE_BEGIN,
+                 _anjay_server_ssid(connection.server), NULL, NULL, 0);
     avs_error_t err = avs_coap_streaming_handle_incoming_packet(
             coap, handle_incoming_message, &args);
+    _anjay_trace(_anjay_from_server(connection.server),
+                 ANJAY_TRACE_COAP_RECEIVE_END,
+                 _anjay_server_ssid(connection.server), NULL, NULL,
+                 avs_is_ok(err) ? 0 : -1);
     _anjay_connection_schedule_queue_mode_close(connection);
 
     avs_coap_error_recovery_action_t recovery_action =
@@ -1081,10 +1164,32 @@ int anjay_sched_calculate_wait_time_ms(anjay_t *anjay, int limit_ms) {
     return limit_ms;
 }
 
+#ifdef ANJAY_WITH_TRACE_HOOKS
+static void trace_sched_run(anjay_t *anjay_locked, anjay_trace_point_t point) {
+#    ifdef ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+    // anjay_sched_run() may be called very often, don't lock the mutex for
+    // nothing; without thread safety, _anjay_trace() itself is cheap enough
+    if (!atomic_load_explicit(&anjay_locked->atomic_fields.trace_handler_set,
+                              memory_order_relaxed)) {
+        return;
+    }
+#    endif // ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    _anjay_trace(anjay, point, ANJAY_SSID_ANY, NULL, NULL, 0);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+#endif // ANJAY_WITH_TRACE_HOOKS
+
 void anjay_sched_run(anjay_t *anjay) {
     avs_sched_t *sched = anjay_get_scheduler(anjay);
     if (sched) {
+#ifdef ANJAY_WITH_TRACE_HOOKS
+        trace_sched_run(anjay, ANJAY_TRACE_SCHED_RUN_BEGIN);
+#endif // ANJAY_WITH_TRACE_HOOKS
         avs_sched_run(sched);
+#ifdef ANJAY_WITH_TRACE_HOOKS
+        trace_sched_run(anjay, ANJAY_TRACE_SCHED_RUN_END);
+#endif // ANJAY_WITH_TRACE_HOOKS
     }
 }
 
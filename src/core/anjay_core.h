@@ -26,6 +26,7 @@
 #include "anjay_downloader.h"
 #include "anjay_servers_private.h"
 #include "anjay_stats.h"
+#include "anjay_trace.h"
 #include "anjay_utils_private.h"
 
 #ifdef ANJAY_WITH_ATTR_STORAGE
@@ -37,8 +38,31 @@
 
 VISIBILITY_PRIVATE_HEADER_BEGIN
 
+typedef struct {
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    bool used;
+} anjay_notify_pending_change_t;
+
+/**
+ * Open-addressed (linear probing) hash set of Resource changes reported using
+ * anjay_notify_changed(), so that repeated calls are coalesced in constant
+ * time. The changes are merged into the sorted notification queue only right
+ * before performing the notifications.
+ */
+typedef struct {
+    anjay_notify_pending_change_t *slots;
+    /**
+     * Zero or a power of two.
+     */
+    size_t capacity;
+    size_t size;
+} anjay_notify_pending_changes_t;
+
 typedef struct {
     anjay_notify_queue_t queue;
+    anjay_notify_pending_changes_t pending_changes;
     avs_sched_handle_t handle;
 } anjay_scheduled_notify_t;
 
@@ -142,6 +166,18 @@ struct
 #ifdef ANJAY_WITH_NET_STATS
     closed_connections_stats_t closed_connections_stats;
 #endif // ANJAY_WITH_NET_STATS
+#ifdef ANJAY_WITH_OPERATION_STATS
+    AVS_LIST(anjay_server_operation_stats_t) operation_stats;
+#endif // ANJAY_WITH_OPERATION_STATS
+#ifdef ANJAY_WITH_MEMORY_STATS
+    anjay_memory_budget_t memory_budgets[ANJAY_MEMORY_SUBSYSTEMS_COUNT];
+#endif // ANJAY_WITH_MEMORY_STATS
+#ifdef ANJAY_WITH_SCHED_PROFILING
+    AVS_LIST(anjay_sched_job_stats_t) sched_job_stats;
+#endif // ANJAY_WITH_SCHED_PROFILING
+#ifdef ANJAY_WITH_TRACE_HOOKS
+    anjay_trace_hooks_t trace_hooks;
+#endif // ANJAY_WITH_TRACE_HOOKS
     bool use_connection_id;
     avs_ssl_additional_configuration_clb_t *additional_tls_config_clb;
 
@@ -171,6 +207,29 @@ _anjay_exchange_lifetime_for_transport(anjay_unlocked_t *anjay,
 int _anjay_serve_unlocked(anjay_unlocked_t *anjay,
                           avs_net_socket_t *ready_socket);
 
+/**
+ * Moves all the Resource changes from anjay->scheduled_notify.pending_changes
+ * into anjay->scheduled_notify.queue. On failure, the changes that could not
+ * be moved are kept in pending_changes, unless memory to keep them is lacking
+ * as well.
+ */
+int _anjay_notify_merge_pending_changes(anjay_unlocked_t *anjay);
+
+/**
+ * Drops all Resource changes of Object @p oid that have not been merged into
+ * anjay->scheduled_notify.queue yet, including ones still waiting in the
+ * lock-free queue. Removing them from pending_changes does not allocate
+ * memory.
+ */
+void _anjay_notify_remove_pending_changes(anjay_unlocked_t *anjay,
+                                          anjay_oid_t oid);
+
+void _anjay_scheduled_notify_cleanup(anjay_scheduled_notify_t *notify);
+
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+void _anjay_notify_ring_init(anjay_notify_ring_t *ring, avs_sched_t *sched);
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
+
 static inline avs_sched_t *_anjay_get_coap_sched(anjay_unlocked_t *anjay) {
 #ifdef ANJAY_WITH_THREAD_SAFETY
     return anjay->coap_sched;
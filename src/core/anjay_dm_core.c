@@ -16,11 +16,13 @@
 #include <string.h>
 
 #include <anjay/core.h>
+#include <avsystem/commons/avs_memory.h>
 #include <avsystem/commons/avs_stream.h>
 #include <avsystem/commons/avs_stream_membuf.h>
 #include <avsystem/commons/avs_stream_v_table.h>
 #include <avsystem/commons/avs_utils.h>
 
+#include <anjay_modules/anjay_access_utils.h>
 #include <anjay_modules/anjay_notify.h>
 
 #include <avsystem/coap/code.h>
@@ -105,6 +107,38 @@ static int validate_version(const anjay_dm_installed_object_t *obj) {
     return 0;
 }
 
+static int reserve_object_index(anjay_dm_t *dm, size_t size) {
+    if (size <= dm->object_index_capacity) {
+        return 0;
+    }
+    size_t new_capacity = 2 * dm->object_index_capacity;
+    if (new_capacity < size) {
+        new_capacity = size;
+    }
+    anjay_dm_object_index_entry_t *new_index =
+            (anjay_dm_object_index_entry_t *) avs_realloc(
+                    dm->object_index, new_capacity * sizeof(*new_index));
+    if (!new_index) {
+        dm_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    dm->object_index = new_index;
+    dm->object_index_capacity = new_capacity;
+    return 0;
+}
+
+static void rebuild_object_index(anjay_dm_t *dm) {
+    size_t size = 0;
+    AVS_LIST(anjay_dm_installed_object_t) obj;
+    AVS_LIST_FOREACH(obj, dm->objects) {
+        assert(size < dm->object_index_capacity);
+        dm->object_index[size].oid = _anjay_dm_installed_object_oid(obj);
+        dm->object_index[size].obj = obj;
+        ++size;
+    }
+    dm->object_index_size = size;
+}
+
 int _anjay_register_object_unlocked(
         anjay_unlocked_t *anjay,
         AVS_LIST(anjay_dm_installed_object_t) *elem_ptr_move) {
@@ -136,7 +170,12 @@ int _anjay_register_object_unlocked(
         return -1;
     }
 
+    if (reserve_object_index(&anjay->dm, anjay->dm.object_index_size + 1)) {
+        return -1;
+    }
+
     AVS_LIST_INSERT(obj_iter, *elem_ptr_move);
+    rebuild_object_index(&anjay->dm);
 
     dm_log(INFO, _("successfully registered object ") "/%u",
            _anjay_dm_installed_object_oid(*elem_ptr_move));
@@ -210,6 +249,13 @@ unregister_object_unlocked(anjay_unlocked_t *anjay,
     assert(AVS_LIST_FIND_PTR(&anjay->dm.objects, *def_ptr));
 
     AVS_LIST(anjay_dm_installed_object_t) detached = AVS_LIST_DETACH(def_ptr);
+    rebuild_object_index(&anjay->dm);
+    _anjay_dm_layout_cache_disable(anjay,
+                                   _anjay_dm_installed_object_oid(detached));
+    if (_anjay_dm_installed_object_oid(detached)
+            == ANJAY_DM_OID_ACCESS_CONTROL) {
+        _anjay_access_mask_cache_invalidate(anjay, ANJAY_ID_INVALID);
+    }
 
     AVS_LIST(const anjay_dm_installed_object_t *) *obj_in_transaction_iter;
     AVS_LIST_FOREACH_PTR(obj_in_transaction_iter,
@@ -239,6 +285,13 @@ unregister_object_unlocked(anjay_unlocked_t *anjay,
                _anjay_dm_installed_object_oid(detached));
     }
 
+    // changes of the removed object are dropped before merging, so that they
+    // do not stay pending if merging fails
+    _anjay_notify_remove_pending_changes(
+            anjay, _anjay_dm_installed_object_oid(detached));
+    if (_anjay_notify_merge_pending_changes(anjay)) {
+        dm_log(WARNING, _("could not merge pending notifications"));
+    }
     remove_oid_from_notify_queue(&anjay->scheduled_notify.queue,
                                  _anjay_dm_installed_object_oid(detached));
 #ifdef ANJAY_WITH_BOOTSTRAP
@@ -303,18 +356,32 @@ void _anjay_dm_cleanup(anjay_unlocked_t *anjay) {
         }
     }
 
+    _anjay_dm_layout_cache_cleanup(&anjay->dm.resource_layout_caches);
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+    _anjay_access_mask_cache_cleanup(&anjay->dm.access_mask_cache);
+#endif // ANJAY_WITH_ACCESS_CONTROL
     AVS_LIST_CLEAR(&anjay->dm.objects);
+    avs_free(anjay->dm.object_index);
+    anjay->dm.object_index = NULL;
+    anjay->dm.object_index_size = 0;
+    anjay->dm.object_index_capacity = 0;
 }
 
 const anjay_dm_installed_object_t *
 _anjay_dm_find_object_by_oid(anjay_unlocked_t *anjay, anjay_oid_t oid) {
-    AVS_LIST(anjay_dm_installed_object_t) obj;
-    AVS_LIST_FOREACH(obj, anjay->dm.objects) {
-        if (_anjay_dm_installed_object_oid(obj) == oid) {
-            return obj;
+    const anjay_dm_object_index_entry_t *index = anjay->dm.object_index;
+    size_t lo = 0;
+    size_t hi = anjay->dm.object_index_size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index[mid].oid < oid) {
+            lo = mid + 1;
+        } else if (index[mid].oid > oid) {
+            hi = mid;
+        } else {
+            return index[mid].obj;
         }
     }
-
     return NULL;
 }
 
@@ -902,6 +969,16 @@ static int instance_present_clb(anjay_unlocked_t *anjay,
 int _anjay_dm_instance_present(anjay_unlocked_t *anjay,
                                const anjay_dm_installed_object_t *obj_ptr,
                                anjay_iid_t iid) {
+    if (_anjay_dm_handler_implemented(obj_ptr,
+                                      ANJAY_DM_HANDLER_instance_present)) {
+        bool present = false;
+        int retval =
+                _anjay_dm_call_instance_present(anjay, obj_ptr, iid, &present);
+        if (retval) {
+            return retval < 0 ? retval : ANJAY_ERR_INTERNAL;
+        }
+        return present ? 1 : 0;
+    }
     instance_present_args_t args = {
         .iid_to_find = iid,
         .found = false
@@ -992,16 +1069,13 @@ void anjay_dm_emit_res(anjay_dm_resource_list_ctx_t *ctx,
 #endif // ANJAY_WITH_THREAD_SAFETY
 }
 
-int _anjay_dm_foreach_resource(anjay_unlocked_t *anjay,
-                               const anjay_dm_installed_object_t *obj,
-                               anjay_iid_t iid,
-                               anjay_dm_foreach_resource_handler_t *handler,
-                               void *data) {
-    if (!obj) {
-        dm_log(ERROR, _("attempt to iterate through NULL Object"));
-        return -1;
-    }
-
+int _anjay_dm_foreach_resource_uncached(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj,
+        anjay_iid_t iid,
+        anjay_dm_foreach_resource_handler_t *handler,
+        void *data) {
+    assert(obj);
     anjay_unlocked_dm_resource_list_ctx_t ctx = {
         .anjay = anjay,
         .obj = obj,
@@ -1022,6 +1096,60 @@ int _anjay_dm_foreach_resource(anjay_unlocked_t *anjay,
     return ctx.result == ANJAY_FOREACH_BREAK ? 0 : ctx.result;
 }
 
+static int
+foreach_cached_resource(anjay_unlocked_t *anjay,
+                        const anjay_dm_installed_object_t *obj,
+                        const anjay_dm_cached_instance_layout_t *layout,
+                        anjay_dm_foreach_resource_handler_t *handler,
+                        void *data) {
+    for (size_t i = 0; i < layout->resources_count; ++i) {
+        const anjay_dm_cached_resource_t *res = &layout->resources[i];
+        int result = handler(anjay, obj, layout->iid, res->rid, res->kind,
+                             res->presence, data);
+        if (result == ANJAY_FOREACH_BREAK) {
+            dm_log(TRACE, _("foreach_resource: break on ") "/%u/%u/%u",
+                   _anjay_dm_installed_object_oid(obj), layout->iid,
+                   res->rid);
+            return 0;
+        } else if (result) {
+            dm_log(DEBUG,
+                   _("foreach_resource_handler failed for ") "/%u/%u/%u" _(
+                           " (") "%d" _(")"),
+                   _anjay_dm_installed_object_oid(obj), layout->iid,
+                   res->rid, result);
+            return result;
+        }
+    }
+    return 0;
+}
+
+int _anjay_dm_foreach_resource(anjay_unlocked_t *anjay,
+                               const anjay_dm_installed_object_t *obj,
+                               anjay_iid_t iid,
+                               anjay_dm_foreach_resource_handler_t *handler,
+                               void *data) {
+    if (!obj) {
+        dm_log(ERROR, _("attempt to iterate through NULL Object"));
+        return -1;
+    }
+
+    anjay_dm_cached_instance_layout_t *layout = NULL;
+    int result =
+            _anjay_dm_layout_cache_acquire(anjay, obj, iid, true, &layout);
+    if (result) {
+        return result;
+    }
+    if (!layout) {
+        return _anjay_dm_foreach_resource_uncached(anjay, obj, iid, handler,
+                                                   data);
+    }
+    // The layout is referenced, so that it stays valid even if the handler
+    // unlocks the object and the cache is invalidated in the meantime
+    result = foreach_cached_resource(anjay, obj, layout, handler, data);
+    _anjay_dm_layout_cache_release(&layout);
+    return result;
+}
+
 typedef struct {
     anjay_rid_t rid_to_find;
     anjay_dm_resource_kind_t kind;
@@ -1062,13 +1190,51 @@ int _anjay_dm_resource_kind_and_presence(
         .presence = ANJAY_DM_RES_ABSENT
     };
     assert(!_anjay_dm_res_kind_valid(args.kind));
-    int retval = _anjay_dm_foreach_resource(anjay, obj_ptr, iid,
-                                            kind_and_presence_clb, &args);
+    bool has_resource_present =
+            _anjay_dm_handler_implemented(obj_ptr,
+                                          ANJAY_DM_HANDLER_resource_present);
+    anjay_dm_cached_instance_layout_t *layout = NULL;
+    // If there is a resource_present handler, calling list_resources just to
+    // populate the cache would not be any faster
+    int retval = _anjay_dm_layout_cache_acquire(
+            anjay, obj_ptr, iid, !has_resource_present, &layout);
     if (retval) {
         return retval;
     }
-    if (!_anjay_dm_res_kind_valid(args.kind)) {
-        return ANJAY_ERR_NOT_FOUND;
+    if (layout) {
+        const anjay_dm_cached_resource_t *res =
+                _anjay_dm_cached_layout_find_resource(layout, rid);
+        if (res) {
+            args.kind = res->kind;
+            args.presence = res->presence;
+        }
+        _anjay_dm_layout_cache_release(&layout);
+        if (!res) {
+            return ANJAY_ERR_NOT_FOUND;
+        }
+    } else if (has_resource_present) {
+        retval = _anjay_dm_call_resource_present(anjay, obj_ptr, iid, rid,
+                                                 &args.kind, &args.presence);
+        if (retval) {
+            return retval;
+        }
+        if (!_anjay_dm_res_kind_valid(args.kind)
+                || !presence_valid(args.presence)) {
+            dm_log(ERROR,
+                   _("resource_present returned invalid kind or presence "
+                     "for ") "/%u/%u/%u",
+                   _anjay_dm_installed_object_oid(obj_ptr), iid, rid);
+            return ANJAY_ERR_INTERNAL;
+        }
+    } else {
+        retval = _anjay_dm_foreach_resource_uncached(
+                anjay, obj_ptr, iid, kind_and_presence_clb, &args);
+        if (retval) {
+            return retval;
+        }
+        if (!_anjay_dm_res_kind_valid(args.kind)) {
+            return ANJAY_ERR_NOT_FOUND;
+        }
     }
     if (out_kind) {
         *out_kind = args.kind;
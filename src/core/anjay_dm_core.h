@@ -20,8 +20,10 @@
 
 #include <avsystem/coap/streaming.h>
 
+#include "anjay_access_mask_cache.h"
 #include "coap/anjay_msg_details.h"
 #include "dm/anjay_dm_attributes.h"
+#include "dm/anjay_dm_layout_cache.h"
 
 VISIBILITY_PRIVATE_HEADER_BEGIN
 
@@ -30,9 +32,36 @@ typedef struct {
     void *arg;
 } anjay_dm_installed_module_t;
 
+typedef struct {
+    anjay_oid_t oid;
+    const anjay_dm_installed_object_t *obj;
+} anjay_dm_object_index_entry_t;
+
 struct anjay_dm {
     AVS_LIST(anjay_dm_installed_object_t) objects;
     AVS_LIST(anjay_dm_installed_module_t) modules;
+
+    /**
+     * Array of all elements of @ref anjay_dm::objects, in the same order (i.e.
+     * sorted by OID), used to look up objects using binary search. Updated on
+     * every object registration and unregistration.
+     */
+    anjay_dm_object_index_entry_t *object_index;
+    size_t object_index_size;
+    size_t object_index_capacity;
+
+    /**
+     * Resource layout caches of objects for which caching has been enabled
+     * using @ref anjay_set_resource_layout_caching, sorted by OID.
+     */
+    AVS_LIST(anjay_dm_resource_layout_cache_t) resource_layout_caches;
+
+#ifdef ANJAY_WITH_ACCESS_CONTROL
+    /**
+     * Index of the Access Control object, see anjay_access_utils.c.
+     */
+    anjay_access_mask_cache_t access_mask_cache;
+#endif // ANJAY_WITH_ACCESS_CONTROL
 };
 
 void _anjay_dm_cleanup(anjay_unlocked_t *anjay);
@@ -103,6 +132,25 @@ AVS_LIST(anjay_dm_installed_module_t) *
 _anjay_dm_module_find_ptr(anjay_unlocked_t *anjay,
                           const anjay_dm_module_t *module);
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+/**
+ * Returns the sum of heap usage reported by all installed modules that
+ * implement the <c>memory_usage</c> callback.
+ */
+size_t _anjay_dm_modules_memory_usage(anjay_unlocked_t *anjay);
+#endif // ANJAY_WITH_MEMORY_STATS
+
+/**
+ * Variant of @ref _anjay_dm_foreach_resource that always calls the
+ * list_resources handler, bypassing the resource layout cache.
+ */
+int _anjay_dm_foreach_resource_uncached(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj,
+        anjay_iid_t iid,
+        anjay_dm_foreach_resource_handler_t *handler,
+        void *data);
+
 int _anjay_dm_select_free_iid(anjay_unlocked_t *anjay,
                               const anjay_dm_installed_object_t *obj,
                               anjay_iid_t *new_iid_ptr);
@@ -103,6 +103,15 @@ int _anjay_downloader_sched_reconnect(anjay_downloader_t *dl,
 
 int _anjay_downloader_sync_online_transports(anjay_downloader_t *dl);
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+/**
+ * Returns the estimated heap usage of all download contexts managed by @p dl,
+ * not including the buffers owned by the underlying sockets and CoAP/HTTP
+ * contexts.
+ */
+size_t _anjay_downloader_memory_usage(const anjay_downloader_t *dl);
+#endif // ANJAY_WITH_MEMORY_STATS
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* ANJAY_DOWNLOADER_H */
@@ -161,6 +161,44 @@ int anjay_ret_bytes(anjay_output_ctx_t *ctx, const void *data, size_t length) {
     return result;
 }
 
+int _anjay_ret_bytes_ref_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                  const void *data,
+                                  size_t length,
+                                  anjay_ret_bytes_ref_release_t *release,
+                                  void *release_arg) {
+    int result;
+    if (ctx->vtable->bytes_ref) {
+        // bytes_ref takes care of calling release
+        result = ctx->vtable->bytes_ref(ctx, data, length, release,
+                                        release_arg);
+        _anjay_update_ret(&ctx->error, result);
+    } else {
+        result = _anjay_ret_bytes_unlocked(ctx, data, length);
+        if (release) {
+            release(release_arg);
+        }
+    }
+    return result;
+}
+
+int anjay_ret_bytes_ref(anjay_output_ctx_t *ctx,
+                        const void *data,
+                        size_t length,
+                        anjay_ret_bytes_ref_release_t *release,
+                        void *release_arg) {
+    int result = -1;
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_LOCK(anjay, ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    result = _anjay_ret_bytes_ref_unlocked(_anjay_output_get_unlocked(ctx),
+                                           data, length, release,
+                                           release_arg);
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_UNLOCK(ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    return result;
+}
+
 int _anjay_ret_string_unlocked(anjay_unlocked_output_ctx_t *ctx,
                                const char *value) {
     int result = ANJAY_OUTCTXERR_METHOD_NOT_IMPLEMENTED;
@@ -371,6 +409,84 @@ int anjay_ret_psk_key_info(anjay_output_ctx_t *ctx,
 }
 #endif // ANJAY_WITH_SECURITY_STRUCTURED
 
+static int set_instance_read_path(anjay_unlocked_output_ctx_t *ctx,
+                                  anjay_rid_t rid,
+                                  anjay_riid_t riid) {
+    if (!ctx->instance_read_path) {
+        anjay_log(ERROR, _("Resource paths may only be set from within the "
+                           "instance_read handler"));
+        return -1;
+    }
+    if (rid == ANJAY_ID_INVALID) {
+        anjay_log(ERROR, "%" PRIu16 _(" is not a valid Resource ID"), rid);
+        return -1;
+    }
+    const int32_t riid_key = (riid == ANJAY_ID_INVALID ? -1 : (int32_t) riid);
+    if (rid < ctx->instance_read_last_rid
+            || (rid == ctx->instance_read_last_rid
+                && riid_key <= ctx->instance_read_last_riid)) {
+        anjay_log(ERROR,
+                  _("instance_read MUST return Resources in strictly "
+                    "ascending order; ") "/%" PRIu16 "/%" PRId32
+                          _(" returned after ") "/%" PRId32 "/%" PRId32,
+                  rid, riid_key, ctx->instance_read_last_rid,
+                  ctx->instance_read_last_riid);
+        return ANJAY_ERR_INTERNAL;
+    }
+    ctx->instance_read_last_rid = rid;
+    ctx->instance_read_last_riid = riid_key;
+    return _anjay_output_set_path(
+            ctx, &MAKE_RESOURCE_INSTANCE_PATH(
+                         ctx->instance_read_path->ids[ANJAY_ID_OID],
+                         ctx->instance_read_path->ids[ANJAY_ID_IID], rid,
+                         riid));
+}
+
+int _anjay_ret_resource_path_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                      anjay_rid_t rid,
+                                      anjay_riid_t riid) {
+    int result = set_instance_read_path(ctx, rid, riid);
+    _anjay_update_ret(&ctx->error, result);
+    return result;
+}
+
+int anjay_ret_resource_path(anjay_output_ctx_t *ctx,
+                            anjay_rid_t rid,
+                            anjay_riid_t riid) {
+    int result = -1;
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_LOCK(anjay, ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    result = _anjay_ret_resource_path_unlocked(_anjay_output_get_unlocked(ctx),
+                                               rid, riid);
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_UNLOCK(ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    return result;
+}
+
+int _anjay_ret_multiple_resource_unlocked(anjay_unlocked_output_ctx_t *ctx,
+                                          anjay_rid_t rid) {
+    int result;
+    (void) ((result = set_instance_read_path(ctx, rid, ANJAY_ID_INVALID))
+            || (result = _anjay_output_start_aggregate(ctx)));
+    _anjay_update_ret(&ctx->error, result);
+    return result;
+}
+
+int anjay_ret_multiple_resource(anjay_output_ctx_t *ctx, anjay_rid_t rid) {
+    int result = -1;
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_LOCK(anjay, ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    result = _anjay_ret_multiple_resource_unlocked(
+            _anjay_output_get_unlocked(ctx), rid);
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_UNLOCK(ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    return result;
+}
+
 int _anjay_output_bytes_begin(anjay_unlocked_output_ctx_t *ctx,
                               size_t length,
                               anjay_unlocked_ret_bytes_ctx_t **out_bytes_ctx) {
@@ -504,6 +620,52 @@ int anjay_get_bytes(anjay_input_ctx_t *ctx,
     return retval;
 }
 
+int _anjay_get_bytes_view_unlocked(anjay_unlocked_input_ctx_t *ctx,
+                                   const void **out_data,
+                                   size_t *out_length,
+                                   bool *out_message_finished) {
+    if (!ctx->vtable->bytes_view) {
+        return -1;
+    }
+    return ctx->vtable->bytes_view(ctx, out_data, out_length,
+                                   out_message_finished);
+}
+
+int anjay_get_bytes_view(anjay_input_ctx_t *ctx,
+                         const void **out_data,
+                         size_t *out_length,
+                         bool *out_message_finished) {
+    int retval = -1;
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_LOCK(anjay, ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    retval = _anjay_get_bytes_view_unlocked(_anjay_input_get_unlocked(ctx),
+                                            out_data, out_length,
+                                            out_message_finished);
+#ifdef ANJAY_WITH_THREAD_SAFETY
+    ANJAY_MUTEX_UNLOCK(ctx->anjay_locked);
+#endif // ANJAY_WITH_THREAD_SAFETY
+    return retval;
+}
+
+int _anjay_input_bytes_view_chunked(anjay_unlocked_input_ctx_t *ctx,
+                                    void **chunk_ptr,
+                                    const void **out_data,
+                                    size_t *out_length,
+                                    bool *out_message_finished) {
+    if (!*chunk_ptr
+            && !(*chunk_ptr = avs_malloc(ANJAY_INPUT_VIEW_CHUNK_SIZE))) {
+        anjay_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    int retval = get_some_bytes(ctx, out_length, out_message_finished,
+                                *chunk_ptr, ANJAY_INPUT_VIEW_CHUNK_SIZE);
+    if (!retval) {
+        *out_data = *chunk_ptr;
+    }
+    return retval;
+}
+
 int _anjay_get_string_unlocked(anjay_unlocked_input_ctx_t *ctx,
                                char *out_buf,
                                size_t buf_size) {
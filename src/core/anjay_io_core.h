@@ -73,6 +73,19 @@ typedef struct anjay_output_ctx_vtable_struct anjay_output_ctx_vtable_t;
 struct anjay_unlocked_output_ctx_struct {
     const anjay_output_ctx_vtable_t *vtable;
     int error;
+    /**
+     * Path of the Object Instance being read by the instance_read handler, or
+     * NULL if not inside such handler. Paths selected using
+     * anjay_ret_resource_path() are relative to it.
+     */
+    const anjay_uri_path_t *instance_read_path;
+    /**
+     * Last Resource (Instance) selected within the instance_read handler, used
+     * to enforce the strictly ascending order. -1 if none yet; Multiple
+     * Resources themselves are stored with riid equal to -1.
+     */
+    int32_t instance_read_last_rid;
+    int32_t instance_read_last_riid;
 };
 
 typedef struct anjay_input_ctx_vtable_struct anjay_input_ctx_vtable_t;
@@ -247,6 +260,21 @@ int _anjay_input_get_path(anjay_unlocked_input_ctx_t *ctx,
 int _anjay_input_update_root_path(anjay_unlocked_input_ctx_t *ctx,
                                   const anjay_uri_path_t *root_path);
 
+#define ANJAY_INPUT_VIEW_CHUNK_SIZE 1024
+
+/**
+ * Generic implementation of the bytes_view input context method, for contexts
+ * that do not keep the value in memory. Reads up to
+ * ANJAY_INPUT_VIEW_CHUNK_SIZE bytes using the some_bytes method into a buffer
+ * pointed to by @p chunk_ptr, allocating it if necessary. The buffer shall be
+ * freed by the caller when closing the context.
+ */
+int _anjay_input_bytes_view_chunked(anjay_unlocked_input_ctx_t *ctx,
+                                    void **chunk_ptr,
+                                    const void **out_data,
+                                    size_t *out_length,
+                                    bool *out_message_finished);
+
 typedef struct anjay_output_buf_ctx {
     anjay_unlocked_output_ctx_t base;
     const void *ret_bytes_vtable;
@@ -78,6 +78,9 @@ typedef struct {
     size_t expected_offset;
     avs_time_real_t serialization_time;
     const anjay_batch_data_output_state_t *output_state;
+#        ifdef ANJAY_WITH_OPERATION_STATS
+    avs_time_monotonic_t send_time;
+#        endif // ANJAY_WITH_OPERATION_STATS
 } exchange_status_t;
 
 struct anjay_send_entry {
@@ -97,7 +100,23 @@ static void clear_exchange_status(exchange_status_t *status) {
     status->output_state = NULL;
 }
 
+#        ifdef ANJAY_WITH_MEMORY_STATS
+static size_t send_entry_memory_usage(const anjay_send_entry_t *entry) {
+    size_t result = ANJAY_LIST_ELEMENT_MEMORY(sizeof(*entry));
+    if (entry->payload_batch) {
+        result += _anjay_batch_memory_usage(entry->payload_batch);
+    }
+    return result;
+}
+#        endif // ANJAY_WITH_MEMORY_STATS
+
 static void delete_send_entry(AVS_LIST(anjay_send_entry_t) *entry) {
+#        ifdef ANJAY_WITH_MEMORY_STATS
+    anjay_sender_t *sender = &(*entry)->anjay->sender;
+    const size_t entry_size = send_entry_memory_usage(*entry);
+    assert(sender->memory_usage >= entry_size);
+    sender->memory_usage -= entry_size;
+#        endif // ANJAY_WITH_MEMORY_STATS
     _anjay_batch_release(&(*entry)->payload_batch);
     clear_exchange_status(&(*entry)->exchange_status);
     AVS_LIST_DELETE(entry);
@@ -189,6 +208,12 @@ static void call_finished_handler(anjay_send_entry_t *entry, int result) {
     ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
 }
 
+static void cancel_send_entry(AVS_LIST(anjay_send_entry_t) *entry_ptr,
+                              int result) {
+    call_finished_handler(*entry_ptr, result);
+    delete_send_entry(entry_ptr);
+}
+
 static void response_handler(avs_coap_ctx_t *ctx,
                              avs_coap_exchange_id_t exchange_id,
                              avs_coap_client_request_state_t state,
@@ -201,6 +226,17 @@ static void response_handler(avs_coap_ctx_t *ctx,
     anjay_send_entry_t *entry = (anjay_send_entry_t *) entry_;
     assert(entry);
     assert(avs_coap_exchange_id_equal(exchange_id, entry->exchange_status.id));
+#        ifdef ANJAY_WITH_OPERATION_STATS
+    // CANCEL means that the exchange has been aborted locally, or follows
+    // a PARTIAL_CONTENT response that has already been accounted for
+    if (state != AVS_COAP_CLIENT_REQUEST_CANCEL) {
+        _anjay_operation_stats_record(
+                entry->anjay, entry->target_ssid, ANJAY_OPERATION_SEND,
+                entry->exchange_status.send_time,
+                state == AVS_COAP_CLIENT_REQUEST_FAIL
+                        || response->header.code != AVS_COAP_CODE_CHANGED);
+    }
+#        endif // ANJAY_WITH_OPERATION_STATS
     if (entry->finished_handler) {
         static const int STATE_TO_RESULT[] = {
             [AVS_COAP_CLIENT_REQUEST_OK] = ANJAY_SEND_SUCCESS,
@@ -267,10 +303,27 @@ create_exchange(anjay_unlocked_t *anjay,
         AVS_LIST_ADVANCE_PTR(&insert_ptr);
     }
     AVS_LIST_INSERT(insert_ptr, entry);
+#        ifdef ANJAY_WITH_MEMORY_STATS
+    anjay->sender.memory_usage += send_entry_memory_usage(entry);
+#        endif // ANJAY_WITH_MEMORY_STATS
 
     return insert_ptr;
 }
 
+#        ifdef ANJAY_WITH_OPERATION_STATS
+/**
+ * Accounts for a Send that could not even be sent, so response_handler() will
+ * never be called for it.
+ */
+static void record_send_failure(const anjay_send_entry_t *entry,
+                                avs_time_monotonic_t start_time) {
+    _anjay_operation_stats_record(entry->anjay, entry->target_ssid,
+                                  ANJAY_OPERATION_SEND, start_time, true);
+}
+#        else // ANJAY_WITH_OPERATION_STATS
+#            define record_send_failure(Entry, StartTime) ((void) (StartTime))
+#        endif // ANJAY_WITH_OPERATION_STATS
+
 static avs_error_t start_send_exchange(anjay_send_entry_t *entry,
                                        anjay_connection_ref_t connection) {
     assert(!avs_coap_exchange_id_valid(entry->exchange_status.id));
@@ -281,9 +334,11 @@ static avs_error_t start_send_exchange(anjay_send_entry_t *entry,
     assert(connection.server);
     assert(_anjay_server_ssid(connection.server) == entry->target_ssid);
 
+    const avs_time_monotonic_t start_time = avs_time_monotonic_now();
     if (!_anjay_connection_get_online_socket(connection)) {
         if (_anjay_schedule_refresh_server(connection.server,
                                            AVS_TIME_DURATION_ZERO)) {
+            record_send_failure(entry, start_time);
             return avs_errno(AVS_ENOMEM);
         } else {
             // once the connection is up, _anjay_send_sched_retry_deferred()
@@ -294,6 +349,7 @@ static avs_error_t start_send_exchange(anjay_send_entry_t *entry,
 
     avs_coap_ctx_t *coap = _anjay_connection_get_coap(connection);
     if (!coap) {
+        record_send_failure(entry, start_time);
         return avs_errno(AVS_EBADF);
     }
 
@@ -325,21 +381,71 @@ static avs_error_t start_send_exchange(anjay_send_entry_t *entry,
                                  entry->exchange_status.memstream, &base_path,
                                  content_format))) {
         send_log(ERROR, _("out of memory"));
+        err = avs_errno(AVS_ENOMEM);
         goto finish;
     }
     entry->exchange_status.expected_offset = 0;
     entry->exchange_status.serialization_time = avs_time_real_now();
+#        ifdef ANJAY_WITH_OPERATION_STATS
+    entry->exchange_status.send_time = start_time;
+#        endif // ANJAY_WITH_OPERATION_STATS
     err = avs_coap_client_send_async_request(coap, &entry->exchange_status.id,
                                              &request, request_payload_writer,
                                              entry, response_handler, entry);
+    _anjay_trace(entry->anjay, ANJAY_TRACE_COAP_SEND, entry->target_ssid, NULL,
+                 "Send", avs_is_ok(err) ? 0 : -1);
 finish:
     avs_coap_options_cleanup(&request.options);
     if (avs_is_err(err)) {
+        record_send_failure(entry, start_time);
         clear_exchange_status(&entry->exchange_status);
     }
     return err;
 }
 
+#        ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_send_memory_usage(const anjay_sender_t *sender) {
+    return sender->memory_usage;
+}
+
+static AVS_LIST(anjay_send_entry_t) *
+find_oldest_deferred_entry(anjay_sender_t *sender,
+                           const anjay_send_entry_t *skip) {
+    AVS_LIST(anjay_send_entry_t) *oldest_ptr = NULL;
+    AVS_LIST(anjay_send_entry_t) *entry_ptr;
+    AVS_LIST_FOREACH_PTR(entry_ptr, &sender->entries) {
+        if (*entry_ptr == skip || (*entry_ptr)->exchange_status.memstream
+                || !(*entry_ptr)->payload_batch) {
+            // Entry is the one being added, is not deferred or is empty
+            continue;
+        }
+        if (!oldest_ptr
+                || avs_time_real_before(
+                           _anjay_batch_get_compilation_time(
+                                   (*entry_ptr)->payload_batch),
+                           _anjay_batch_get_compilation_time(
+                                   (*oldest_ptr)->payload_batch))) {
+            oldest_ptr = entry_ptr;
+        }
+    }
+    return oldest_ptr;
+}
+
+static void enforce_memory_budget(anjay_unlocked_t *anjay,
+                                  const anjay_send_entry_t *new_entry) {
+    anjay_memory_budget_t *budget = &anjay->memory_budgets[ANJAY_MEMORY_SEND];
+    AVS_LIST(anjay_send_entry_t) *oldest_ptr;
+    while (_anjay_memory_budget_exceeded(budget, anjay->sender.memory_usage)
+           && (oldest_ptr =
+                       find_oldest_deferred_entry(&anjay->sender, new_entry))) {
+        send_log(DEBUG, _("Send memory budget exceeded, dropping oldest "
+                          "deferred request"));
+        ++budget->dropped_count;
+        cancel_send_entry(oldest_ptr, ANJAY_SEND_DEFERRED_ERROR);
+    }
+}
+#        endif // ANJAY_WITH_MEMORY_STATS
+
 static bool is_deferrable_condition(anjay_send_result_t condition) {
     return condition == ANJAY_SEND_ERR_OFFLINE
            || condition == ANJAY_SEND_ERR_BOOTSTRAP;
@@ -430,6 +536,11 @@ send_impl(anjay_unlocked_t *anjay,
             return ANJAY_SEND_ERR_INTERNAL;
         }
     }
+#        ifdef ANJAY_WITH_MEMORY_STATS
+    else {
+        enforce_memory_budget(anjay, *entry_ptr);
+    }
+#        endif // ANJAY_WITH_MEMORY_STATS
     return ANJAY_SEND_OK;
 }
 
@@ -705,12 +816,6 @@ void anjay_send_batch_release(anjay_send_batch_t **batch_ptr) {
     *batch_ptr = NULL;
 }
 
-static void cancel_send_entry(AVS_LIST(anjay_send_entry_t) *entry_ptr,
-                              int result) {
-    call_finished_handler(*entry_ptr, result);
-    delete_send_entry(entry_ptr);
-}
-
 void _anjay_send_interrupt(anjay_connection_ref_t ref) {
     assert(ref.server);
     avs_coap_ctx_t *coap = NULL;
@@ -805,8 +910,8 @@ bool _anjay_send_has_deferred(anjay_unlocked_t *anjay, anjay_ssid_t ssid) {
 
 int _anjay_send_sched_retry_deferred(anjay_unlocked_t *anjay,
                                      anjay_ssid_t ssid) {
-    int result = AVS_SCHED_NOW(anjay->sched, NULL, retry_deferred_job, &ssid,
-                               sizeof(ssid));
+    int result = ANJAY_SCHED_NOW(anjay->sched, NULL, retry_deferred_job, &ssid,
+                                 sizeof(ssid));
     if (result) {
         send_log(WARNING,
                  _("Could not schedule deferred retry for Send requests for "
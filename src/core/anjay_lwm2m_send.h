@@ -18,6 +18,10 @@ typedef struct anjay_send_entry anjay_send_entry_t;
 
 typedef struct {
     AVS_LIST(anjay_send_entry_t) entries;
+#ifdef ANJAY_WITH_MEMORY_STATS
+    // estimated heap usage of all entries, including their payload batches
+    size_t memory_usage;
+#endif // ANJAY_WITH_MEMORY_STATS
 } anjay_sender_t;
 
 void _anjay_send_interrupt(anjay_connection_ref_t ref);
@@ -29,6 +33,10 @@ bool _anjay_send_has_deferred(anjay_unlocked_t *anjay, anjay_ssid_t ssid);
 int _anjay_send_sched_retry_deferred(anjay_unlocked_t *anjay,
                                      anjay_ssid_t ssid);
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_send_memory_usage(const anjay_sender_t *sender);
+#endif // ANJAY_WITH_MEMORY_STATS
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* ANJAY_LWM2M_SEND_H */
@@ -9,6 +9,14 @@
 
 #include <anjay_init.h>
 
+#include <assert.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_memory.h>
+
+#include <anjay_modules/anjay_access_utils.h>
 #include <anjay_modules/anjay_dm_utils.h>
 #include <anjay_modules/anjay_notify.h>
 
@@ -47,8 +55,46 @@ static int observe_notify(anjay_unlocked_t *anjay,
     }
     return ret;
 }
+
+static bool may_affect_effective_attrs(anjay_notify_queue_t queue) {
+    AVS_LIST(anjay_notify_queue_object_entry_t) it;
+    AVS_LIST_FOREACH(it, queue) {
+        if (it->instance_set_changes.instance_set_changed) {
+            return true;
+        }
+        if (it->oid == ANJAY_DM_OID_SERVER) {
+            AVS_LIST(anjay_notify_queue_resource_entry_t) it2;
+            AVS_LIST_FOREACH(it2, it->resources_changed) {
+                if (it2->rid == ANJAY_DM_RID_SERVER_DEFAULT_PMIN
+                        || it2->rid == ANJAY_DM_RID_SERVER_DEFAULT_PMAX) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static void drop_pushed_values(anjay_unlocked_t *anjay,
+                               anjay_notify_queue_t queue) {
+    AVS_LIST(anjay_notify_queue_object_entry_t) it;
+    AVS_LIST_FOREACH(it, queue) {
+        if (it->instance_set_changes.instance_set_changed) {
+            _anjay_observe_drop_pushed_values(&anjay->observe,
+                                              &MAKE_OBJECT_PATH(it->oid));
+        } else {
+            AVS_LIST(anjay_notify_queue_resource_entry_t) it2;
+            AVS_LIST_FOREACH(it2, it->resources_changed) {
+                _anjay_observe_drop_pushed_values(
+                        &anjay->observe,
+                        &MAKE_RESOURCE_PATH(it->oid, it2->iid, it2->rid));
+            }
+        }
+    }
+}
 #else // ANJAY_WITH_OBSERVE
 #    define observe_notify(anjay, origin_ssid, queue) (0)
+#    define drop_pushed_values(anjay, queue) ((void) 0)
 #endif // ANJAY_WITH_OBSERVE
 
 static int
@@ -118,6 +164,25 @@ static int server_modified_notify(anjay_unlocked_t *anjay,
     return ret;
 }
 
+static void access_control_modified_notify(anjay_unlocked_t *anjay,
+                                           anjay_notify_queue_t queue) {
+    AVS_LIST(anjay_notify_queue_object_entry_t) ac = queue;
+    while (ac && ac->oid < ANJAY_DM_OID_ACCESS_CONTROL) {
+        ac = AVS_LIST_NEXT(ac);
+    }
+    if (!ac || ac->oid != ANJAY_DM_OID_ACCESS_CONTROL) {
+        return;
+    }
+    if (ac->instance_set_changes.instance_set_changed) {
+        _anjay_access_mask_cache_invalidate(anjay, ANJAY_ID_INVALID);
+        return;
+    }
+    AVS_LIST(anjay_notify_queue_resource_entry_t) it;
+    AVS_LIST_FOREACH(it, ac->resources_changed) {
+        _anjay_access_mask_cache_invalidate(anjay, it->iid);
+    }
+}
+
 static int anjay_notify_perform_impl(anjay_unlocked_t *anjay,
                                      anjay_ssid_t origin_ssid,
                                      anjay_notify_queue_t *queue_ptr,
@@ -126,6 +191,10 @@ static int anjay_notify_perform_impl(anjay_unlocked_t *anjay,
         return 0;
     }
     int ret = 0;
+    // _anjay_sync_access_control() relies on the Access Control cache, so it
+    // needs to be up to date; changes made during synchronization are applied
+    // to it when its transaction is committed
+    access_control_modified_notify(anjay, *queue_ptr);
     _anjay_update_ret(&ret, _anjay_sync_access_control(anjay, origin_ssid,
                                                        queue_ptr));
     AVS_LIST(anjay_notify_queue_object_entry_t) it;
@@ -138,6 +207,11 @@ static int anjay_notify_perform_impl(anjay_unlocked_t *anjay,
             _anjay_update_ret(&ret, server_modified_notify(anjay, it));
         }
     }
+#ifdef ANJAY_WITH_OBSERVE
+    if (may_affect_effective_attrs(*queue_ptr)) {
+        _anjay_observe_invalidate_attrs_cache(&anjay->observe);
+    }
+#endif // ANJAY_WITH_OBSERVE
     _anjay_update_ret(&ret, observe_notify(anjay, origin_ssid, *queue_ptr));
 #ifdef ANJAY_WITH_ATTR_STORAGE
     _anjay_update_ret(&ret, _anjay_attr_storage_notify(anjay, *queue_ptr));
@@ -156,12 +230,18 @@ static int anjay_notify_perform_impl(anjay_unlocked_t *anjay,
 int _anjay_notify_perform(anjay_unlocked_t *anjay,
                           anjay_ssid_t origin_ssid,
                           anjay_notify_queue_t *queue_ptr) {
+    if (queue_ptr) {
+        drop_pushed_values(anjay, *queue_ptr);
+    }
     return anjay_notify_perform_impl(anjay, origin_ssid, queue_ptr, true);
 }
 
 int _anjay_notify_perform_without_servers(anjay_unlocked_t *anjay,
                                           anjay_ssid_t origin_ssid,
                                           anjay_notify_queue_t *queue_ptr) {
+    if (queue_ptr) {
+        drop_pushed_values(anjay, *queue_ptr);
+    }
     return anjay_notify_perform_impl(anjay, origin_ssid, queue_ptr, false);
 }
 
@@ -333,12 +413,307 @@ void _anjay_notify_clear_queue(anjay_notify_queue_t *out_queue) {
     }
 }
 
+#define PENDING_CHANGES_INITIAL_CAPACITY 16
+
+static size_t
+pending_change_hash(anjay_oid_t oid, anjay_iid_t iid, anjay_rid_t rid) {
+    uint64_t key = ((uint64_t) oid << 32) | ((uint64_t) iid << 16) | rid;
+    // Fibonacci hashing; upper bits of the product are the best mixed ones
+    return (size_t) ((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+/**
+ * Returns the slot containing the specified change, or the empty slot that it
+ * shall be inserted into. @p capacity MUST be a power of two, and there MUST be
+ * at least one empty slot.
+ */
+static anjay_notify_pending_change_t *
+find_pending_change_slot(anjay_notify_pending_change_t *slots,
+                         size_t capacity,
+                         anjay_oid_t oid,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid) {
+    const size_t mask = capacity - 1;
+    size_t index = pending_change_hash(oid, iid, rid) & mask;
+    while (slots[index].used
+           && (slots[index].oid != oid || slots[index].iid != iid
+               || slots[index].rid != rid)) {
+        index = (index + 1) & mask;
+    }
+    return &slots[index];
+}
+
+static int grow_pending_changes(anjay_notify_pending_changes_t *changes) {
+    size_t new_capacity = changes->capacity ? 2 * changes->capacity
+                                            : PENDING_CHANGES_INITIAL_CAPACITY;
+    anjay_notify_pending_change_t *new_slots =
+            (anjay_notify_pending_change_t *) avs_calloc(new_capacity,
+                                                         sizeof(*new_slots));
+    if (!new_slots) {
+        return -1;
+    }
+    for (size_t i = 0; i < changes->capacity; ++i) {
+        if (changes->slots[i].used) {
+            *find_pending_change_slot(new_slots, new_capacity,
+                                      changes->slots[i].oid,
+                                      changes->slots[i].iid,
+                                      changes->slots[i].rid) =
+                    changes->slots[i];
+        }
+    }
+    avs_free(changes->slots);
+    changes->slots = new_slots;
+    changes->capacity = new_capacity;
+    return 0;
+}
+
+static int add_pending_change(anjay_notify_pending_changes_t *changes,
+                              anjay_oid_t oid,
+                              anjay_iid_t iid,
+                              anjay_rid_t rid) {
+    anjay_notify_pending_change_t *slot = NULL;
+    if (changes->capacity) {
+        slot = find_pending_change_slot(changes->slots, changes->capacity, oid,
+                                        iid, rid);
+        if (slot->used) {
+            // already pending
+            return 0;
+        }
+    }
+    // keep the load factor at most 1/2, so that probe sequences stay short
+    if (2 * (changes->size + 1) > changes->capacity) {
+        if (grow_pending_changes(changes)) {
+            anjay_log(ERROR, _("out of memory"));
+            return -1;
+        }
+        slot = find_pending_change_slot(changes->slots, changes->capacity, oid,
+                                        iid, rid);
+    }
+    *slot = (anjay_notify_pending_change_t) {
+        .oid = oid,
+        .iid = iid,
+        .rid = rid,
+        .used = true
+    };
+    ++changes->size;
+    return 0;
+}
+
+/**
+ * Empties the slot at @p index, moving entries that follow it back if they
+ * would otherwise become unreachable. Does not allocate memory.
+ */
+static void delete_pending_change_slot(anjay_notify_pending_changes_t *changes,
+                                       size_t index) {
+    const size_t mask = changes->capacity - 1;
+    assert(changes->slots[index].used);
+    changes->slots[index].used = false;
+    --changes->size;
+    for (size_t next = (index + 1) & mask; changes->slots[next].used;
+         next = (next + 1) & mask) {
+        const size_t home =
+                pending_change_hash(changes->slots[next].oid,
+                                    changes->slots[next].iid,
+                                    changes->slots[next].rid)
+                & mask;
+        // the entry may stay if its home slot lies cyclically in
+        // (index, next]; otherwise lookups would stop at the empty slot
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            changes->slots[index] = changes->slots[next];
+            changes->slots[next].used = false;
+            index = next;
+        }
+    }
+}
+
+static void
+remove_pending_changes_of_object(anjay_notify_pending_changes_t *changes,
+                                 anjay_oid_t oid) {
+    size_t index = 0;
+    while (index < changes->capacity) {
+        if (changes->slots[index].used && changes->slots[index].oid == oid) {
+            // another entry might have been moved into this slot, so check
+            // it again
+            delete_pending_change_slot(changes, index);
+        } else {
+            ++index;
+        }
+    }
+}
+
+static int compare_pending_changes(const void *left_, const void *right_) {
+    const anjay_notify_pending_change_t *left =
+            (const anjay_notify_pending_change_t *) left_;
+    const anjay_notify_pending_change_t *right =
+            (const anjay_notify_pending_change_t *) right_;
+    int result = left->oid - right->oid;
+    if (!result) {
+        result = left->iid - right->iid;
+    }
+    if (!result) {
+        result = left->rid - right->rid;
+    }
+    return result;
+}
+
+/**
+ * Rebuilds @p changes so that it only contains the @p count compacted entries
+ * starting at changes->slots[first].
+ */
+static int restore_pending_changes(anjay_notify_pending_changes_t *changes,
+                                   size_t first,
+                                   size_t count) {
+    anjay_notify_pending_change_t *new_slots =
+            (anjay_notify_pending_change_t *) avs_calloc(changes->capacity,
+                                                         sizeof(*new_slots));
+    if (!new_slots) {
+        memset(changes->slots, 0, changes->capacity * sizeof(*changes->slots));
+        changes->size = 0;
+        return -1;
+    }
+    for (size_t i = first; i < first + count; ++i) {
+        *find_pending_change_slot(new_slots, changes->capacity,
+                                  changes->slots[i].oid, changes->slots[i].iid,
+                                  changes->slots[i].rid) = changes->slots[i];
+    }
+    avs_free(changes->slots);
+    changes->slots = new_slots;
+    changes->size = count;
+    return 0;
+}
+
+/**
+ * Moves the changes from @p changes into @p out_queue. If that fails, the
+ * changes that could not be merged are left in @p changes.
+ */
+static int merge_pending_changes(anjay_notify_queue_t *out_queue,
+                                 anjay_notify_pending_changes_t *changes) {
+    if (!changes->size) {
+        return 0;
+    }
+    // compact the used slots at the beginning of the array and sort them, so
+    // that they can be merged with the queue in a single pass
+    size_t count = 0;
+    for (size_t i = 0; i < changes->capacity; ++i) {
+        if (changes->slots[i].used) {
+            changes->slots[count++] = changes->slots[i];
+        }
+    }
+    assert(count == changes->size);
+    qsort(changes->slots, count, sizeof(*changes->slots),
+          compare_pending_changes);
+
+    AVS_LIST(anjay_notify_queue_object_entry_t) *obj_entry_ptr = out_queue;
+    AVS_LIST(anjay_notify_queue_resource_entry_t) *res_entry_ptr = NULL;
+    size_t merged;
+    for (merged = 0; merged < count; ++merged) {
+        const anjay_notify_pending_change_t *change = &changes->slots[merged];
+        const anjay_notify_queue_resource_entry_t new_entry = {
+            .iid = change->iid,
+            .rid = change->rid
+        };
+        if (!res_entry_ptr || (*obj_entry_ptr)->oid != change->oid) {
+            // queue entries are sorted by OID, so there is no need to look
+            // before the previously used entry
+            AVS_LIST(anjay_notify_queue_object_entry_t) *new_obj_entry_ptr =
+                    find_or_create_object_entry(obj_entry_ptr, change->oid);
+            if (!new_obj_entry_ptr) {
+                break;
+            }
+            obj_entry_ptr = new_obj_entry_ptr;
+            res_entry_ptr = &(*obj_entry_ptr)->resources_changed;
+        }
+        int compare = -1;
+        while (*res_entry_ptr
+               && (compare = compare_resource_entries(*res_entry_ptr,
+                                                      &new_entry))
+                          < 0) {
+            AVS_LIST_ADVANCE_PTR(&res_entry_ptr);
+        }
+        if (*res_entry_ptr && compare == 0) {
+            continue;
+        }
+        if (!AVS_LIST_INSERT_NEW(anjay_notify_queue_resource_entry_t,
+                                 res_entry_ptr)) {
+            delete_notify_queue_object_entry_if_empty(obj_entry_ptr);
+            break;
+        }
+        **res_entry_ptr = new_entry;
+    }
+    if (merged < count) {
+        anjay_log(ERROR, _("out of memory"));
+        if (restore_pending_changes(changes, merged, count - merged)) {
+            anjay_log(ERROR, _("dropped ") "%lu" _(" pending changes"),
+                      (unsigned long) (count - merged));
+        }
+        return -1;
+    }
+    memset(changes->slots, 0, changes->capacity * sizeof(*changes->slots));
+    changes->size = 0;
+    return 0;
+}
+
+int _anjay_notify_merge_pending_changes(anjay_unlocked_t *anjay) {
+    return merge_pending_changes(&anjay->scheduled_notify.queue,
+                                 &anjay->scheduled_notify.pending_changes);
+}
+
+void _anjay_scheduled_notify_cleanup(anjay_scheduled_notify_t *notify) {
+    _anjay_notify_clear_queue(&notify->queue);
+    avs_free(notify->pending_changes.slots);
+    notify->pending_changes.slots = NULL;
+    notify->pending_changes.capacity = 0;
+    notify->pending_changes.size = 0;
+}
+
+// changes that could not be merged because of running out of memory are
+// retried with a delay, so that the scheduler does not spin while memory is
+// exhausted
+#define NOTIFY_RETRY_DELAY avs_time_duration_from_scalar(1, AVS_TIME_S)
+
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+static bool notify_ring_drain(anjay_unlocked_t *anjay);
+#else // ANJAY_WITH_LOCK_FREE_NOTIFY
+#    define notify_ring_drain(anjay) false
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
+
+#if defined(ANJAY_WITH_LOCK_FREE_NOTIFY) && defined(ANJAY_WITH_OBSERVE)
+static void update_pushed_values_flag(anjay_unlocked_t *anjay) {
+    atomic_store(&_anjay_get_from_sched(anjay->sched)
+                          ->atomic_fields.notify_ring.has_pushed_values,
+                 anjay->observe.pushed_values
+                         && AVS_SORTED_SET_FIRST(anjay->observe.pushed_values));
+}
+#else  // defined(ANJAY_WITH_LOCK_FREE_NOTIFY) && defined(ANJAY_WITH_OBSERVE)
+#    define update_pushed_values_flag(anjay) ((void) 0)
+#endif // defined(ANJAY_WITH_LOCK_FREE_NOTIFY) && defined(ANJAY_WITH_OBSERVE)
+
+static void notify_clb(avs_sched_t *sched, const void *dummy);
+
+static void perform_scheduled_notify(anjay_unlocked_t *anjay) {
+    // entries left in the lock-free ring would only be notified about by the
+    // next instance of the notification job otherwise
+    (void) notify_ring_drain(anjay);
+    if (_anjay_notify_merge_pending_changes(anjay)
+            && ANJAY_SCHED_DELAYED(anjay->sched,
+                                   &anjay->scheduled_notify.handle,
+                                   NOTIFY_RETRY_DELAY, notify_clb, NULL, 0)) {
+        anjay_log(ERROR, _("could not schedule retrying notifications"));
+    }
+    // Changes reported without a value already dropped the pushed values of
+    // their Resources when they were queued, so the remaining ones are still
+    // valid and _anjay_notify_perform() is bypassed not to drop them.
+    anjay_notify_perform_impl(anjay, ANJAY_SSID_BOOTSTRAP,
+                              &anjay->scheduled_notify.queue, true);
+    _anjay_notify_clear_queue(&anjay->scheduled_notify.queue);
+    update_pushed_values_flag(anjay);
+}
+
 static void notify_clb(avs_sched_t *sched, const void *dummy) {
     (void) dummy;
     anjay_t *anjay_locked = _anjay_get_from_sched(sched);
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
-    _anjay_notify_flush(anjay, ANJAY_SSID_BOOTSTRAP,
-                        &anjay->scheduled_notify.queue);
+    perform_scheduled_notify(anjay);
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
@@ -346,8 +721,15 @@ static int reschedule_notify(anjay_unlocked_t *anjay) {
     if (anjay->scheduled_notify.handle) {
         return 0;
     }
-    return AVS_SCHED_NOW(anjay->sched, &anjay->scheduled_notify.handle,
-                         notify_clb, NULL, 0);
+    return ANJAY_SCHED_NOW(anjay->sched, &anjay->scheduled_notify.handle,
+                           notify_clb, NULL, 0);
+}
+
+void _anjay_notify_remove_pending_changes(anjay_unlocked_t *anjay,
+                                          anjay_oid_t oid) {
+    (void) notify_ring_drain(anjay);
+    remove_pending_changes_of_object(&anjay->scheduled_notify.pending_changes,
+                                     oid);
 }
 
 int _anjay_notify_instance_created(anjay_unlocked_t *anjay,
@@ -360,21 +742,211 @@ int _anjay_notify_instance_created(anjay_unlocked_t *anjay,
     return retval;
 }
 
+static int queue_changed(anjay_unlocked_t *anjay,
+                         anjay_oid_t oid,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid) {
+    if (oid == ANJAY_DM_OID_ACCESS_CONTROL) {
+        _anjay_access_mask_cache_invalidate(anjay, iid);
+    }
+    // values shared by observations that are notified about before the
+    // scheduled notification job runs would be outdated otherwise
+    _anjay_observe_invalidate_read_cache(&anjay->observe);
+    _anjay_observe_drop_pushed_values(&anjay->observe,
+                                      &MAKE_RESOURCE_PATH(oid, iid, rid));
+    return add_pending_change(&anjay->scheduled_notify.pending_changes, oid,
+                              iid, rid);
+}
+
 int _anjay_notify_changed_unlocked(anjay_unlocked_t *anjay,
                                    anjay_oid_t oid,
                                    anjay_iid_t iid,
                                    anjay_rid_t rid) {
     int retval;
-    (void) ((retval = _anjay_notify_queue_resource_change(
-                     &anjay->scheduled_notify.queue, oid, iid, rid))
+    (void) ((retval = queue_changed(anjay, oid, iid, rid))
             || (retval = reschedule_notify(anjay)));
     return retval;
 }
 
+int _anjay_notify_changed_many_unlocked(anjay_unlocked_t *anjay,
+                                        const anjay_notify_path_t *paths,
+                                        size_t paths_count) {
+    assert(paths || !paths_count);
+    int retval = 0;
+    size_t queued = 0;
+    while (!retval && queued < paths_count) {
+        retval = queue_changed(anjay, paths[queued].oid, paths[queued].iid,
+                               paths[queued].rid);
+        if (!retval) {
+            ++queued;
+        }
+    }
+    // make sure that changes queued before a failure are processed, too
+    if (queued) {
+        _anjay_update_ret(&retval, reschedule_notify(anjay));
+    }
+    return retval;
+}
+
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+void _anjay_notify_ring_init(anjay_notify_ring_t *ring, avs_sched_t *sched) {
+    for (size_t i = 0; i < ANJAY_NOTIFY_RING_SIZE; ++i) {
+        atomic_init(&ring->cells[i].sequence, i);
+    }
+    atomic_init(&ring->enqueue_pos, 0);
+    ring->dequeue_pos = 0;
+    atomic_init(&ring->drain_scheduled, false);
+    atomic_init(&ring->has_pushed_values, false);
+    ring->sched = sched;
+}
+
+/**
+ * Returns false if the ring is full. May be called from any thread.
+ */
+static bool notify_ring_push(anjay_notify_ring_t *ring,
+                             anjay_oid_t oid,
+                             anjay_iid_t iid,
+                             anjay_rid_t rid) {
+    size_t pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+    anjay_notify_ring_cell_t *cell;
+    while (true) {
+        cell = &ring->cells[pos & (ANJAY_NOTIFY_RING_SIZE - 1)];
+        size_t sequence =
+                atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        if (sequence == pos) {
+            // cell is free; try to claim it
+            if (atomic_compare_exchange_weak_explicit(
+                        &ring->enqueue_pos, &pos, pos + 1,
+                        memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+            // pos has been updated by the failed CAS
+        } else if ((ptrdiff_t) (sequence - pos) < 0) {
+            // cell still holds an entry from the previous lap
+            return false;
+        } else {
+            // another producer claimed the cell in the meantime
+            pos = atomic_load_explicit(&ring->enqueue_pos,
+                                       memory_order_relaxed);
+        }
+    }
+    cell->oid = oid;
+    cell->iid = iid;
+    cell->rid = rid;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * Returns false if there are no more published entries. MUST only be called
+ * with the mutex held.
+ */
+static bool notify_ring_pop(anjay_notify_ring_t *ring,
+                            anjay_oid_t *out_oid,
+                            anjay_iid_t *out_iid,
+                            anjay_rid_t *out_rid) {
+    anjay_notify_ring_cell_t *cell =
+            &ring->cells[ring->dequeue_pos & (ANJAY_NOTIFY_RING_SIZE - 1)];
+    if (atomic_load_explicit(&cell->sequence, memory_order_acquire)
+            != ring->dequeue_pos + 1) {
+        return false;
+    }
+    *out_oid = cell->oid;
+    *out_iid = cell->iid;
+    *out_rid = cell->rid;
+    atomic_store_explicit(&cell->sequence,
+                          ring->dequeue_pos + ANJAY_NOTIFY_RING_SIZE,
+                          memory_order_release);
+    ++ring->dequeue_pos;
+    return true;
+}
+
+/**
+ * Moves all published entries from the ring to the pending changes. Returns
+ * true if any of them has been queued. MUST only be called with the mutex held.
+ */
+static bool notify_ring_drain(anjay_unlocked_t *anjay) {
+    anjay_notify_ring_t *ring =
+            &_anjay_get_from_sched(anjay->sched)->atomic_fields.notify_ring;
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    bool queued = false;
+    while (notify_ring_pop(ring, &oid, &iid, &rid)) {
+        if (queue_changed(anjay, oid, iid, rid)) {
+            anjay_log(WARNING,
+                      _("could not queue notification for /") "%" PRIu16 _(
+                              "/") "%" PRIu16 _("/") "%" PRIu16,
+                      oid, iid, rid);
+        } else {
+            queued = true;
+        }
+    }
+    update_pushed_values_flag(anjay);
+    return queued;
+}
+
+static void notify_ring_drain_clb(avs_sched_t *sched, const void *dummy) {
+    (void) dummy;
+    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
+    anjay_notify_ring_t *ring = &anjay_locked->atomic_fields.notify_ring;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    // producers publish their entries before checking this flag, so anything
+    // not drained below will be handled by another instance of this job; the
+    // fence keeps the loads of cell sequence numbers from being reordered
+    // before the store
+    atomic_store(&ring->drain_scheduled, false);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (notify_ring_drain(anjay)) {
+        // process the changes right away, just like the notification job
+        // would, so that they are not delayed by another scheduler run
+        avs_sched_del(&anjay->scheduled_notify.handle);
+        perform_scheduled_notify(anjay);
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+/**
+ * Returns false if the ring is full, in which case the change needs to be
+ * submitted with the mutex locked.
+ *
+ * Once pushed, the entry is never rejected. If the drain job cannot be
+ * scheduled, the entry stays in the ring until it is drained by the job
+ * scheduled by a subsequent call, or by the next notification job.
+ */
+static bool notify_ring_submit(anjay_notify_ring_t *ring,
+                               anjay_oid_t oid,
+                               anjay_iid_t iid,
+                               anjay_rid_t rid) {
+    if (!notify_ring_push(ring, oid, iid, rid)) {
+        return false;
+    }
+    if (!atomic_exchange(&ring->drain_scheduled, true)
+            && ANJAY_SCHED_NOW(ring->sched, NULL, notify_ring_drain_clb, NULL,
+                               0)) {
+        atomic_store(&ring->drain_scheduled, false);
+        anjay_log(WARNING, _("could not schedule notification queue drain, "
+                             "change will be handled later"));
+    }
+    return true;
+}
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
+
 int anjay_notify_changed(anjay_t *anjay_locked,
                          anjay_oid_t oid,
                          anjay_iid_t iid,
                          anjay_rid_t rid) {
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+    // changes to Access Control and ones that may invalidate pushed values
+    // have side effects that need to be visible as soon as this returns
+    if (anjay_locked && oid != ANJAY_DM_OID_ACCESS_CONTROL
+            && !atomic_load(&anjay_locked->atomic_fields.notify_ring
+                                     .has_pushed_values)
+            && notify_ring_submit(&anjay_locked->atomic_fields.notify_ring,
+                                  oid, iid, rid)) {
+        return 0;
+    }
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
     int retval = -1;
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
     retval = _anjay_notify_changed_unlocked(anjay, oid, iid, rid);
@@ -382,8 +954,177 @@ int anjay_notify_changed(anjay_t *anjay_locked,
     return retval;
 }
 
+int anjay_notify_changed_many(anjay_t *anjay_locked,
+                              const anjay_notify_path_t *paths,
+                              size_t paths_count) {
+    if (!paths && paths_count) {
+        anjay_log(ERROR, _("invalid paths array"));
+        return -1;
+    }
+    int retval = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    retval = _anjay_notify_changed_many_unlocked(anjay, paths, paths_count);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return retval;
+}
+
+typedef enum {
+    NOTIFY_VALUE_I64,
+    NOTIFY_VALUE_DOUBLE,
+    NOTIFY_VALUE_BOOL,
+    NOTIFY_VALUE_STRING
+} notify_value_type_t;
+
+typedef struct {
+    notify_value_type_t type;
+    union {
+        int64_t i64;
+        double d;
+        bool b;
+        const char *str;
+    } data;
+} notify_value_t;
+
+#ifdef ANJAY_WITH_OBSERVE
+static anjay_batch_t *make_value_batch(const anjay_uri_path_t *path,
+                                       const notify_value_t *value) {
+    anjay_batch_builder_t *builder = _anjay_batch_builder_new();
+    if (!builder) {
+        return NULL;
+    }
+    const avs_time_real_t timestamp = avs_time_real_now();
+    int result = -1;
+    switch (value->type) {
+    case NOTIFY_VALUE_I64:
+        result = _anjay_batch_add_int(builder, path, timestamp,
+                                      value->data.i64);
+        break;
+    case NOTIFY_VALUE_DOUBLE:
+        result = _anjay_batch_add_double(builder, path, timestamp,
+                                         value->data.d);
+        break;
+    case NOTIFY_VALUE_BOOL:
+        result = _anjay_batch_add_bool(builder, path, timestamp, value->data.b);
+        break;
+    case NOTIFY_VALUE_STRING:
+        result = _anjay_batch_add_string(builder, path, timestamp,
+                                         value->data.str);
+        break;
+    }
+    anjay_batch_t *batch = NULL;
+    if (!result) {
+        batch = _anjay_batch_builder_compile(&builder);
+    }
+    _anjay_batch_builder_cleanup(&builder);
+    return batch;
+}
+
+static void push_value(anjay_unlocked_t *anjay,
+                       const anjay_uri_path_t *path,
+                       const notify_value_t *value) {
+    // pushed values are only used when notifying about the Resource itself,
+    // not when reading the whole Object Instance or Object containing it
+    if (!_anjay_observe_path_observed_exactly(anjay, path)) {
+        return;
+    }
+    anjay_batch_t *batch = make_value_batch(path, value);
+    if (!batch || _anjay_observe_push_value(&anjay->observe, path, batch)) {
+        anjay_log(WARNING,
+                  _("could not store value of ") "%s" _(
+                          ", it will be read when notifying"),
+                  ANJAY_DEBUG_MAKE_PATH(path));
+        if (batch) {
+            _anjay_batch_release(&batch);
+        }
+    }
+    update_pushed_values_flag(anjay);
+}
+#endif // ANJAY_WITH_OBSERVE
+
+static int notify_value_changed(anjay_t *anjay_locked,
+                                anjay_oid_t oid,
+                                anjay_iid_t iid,
+                                anjay_rid_t rid,
+                                const notify_value_t *value) {
+    int retval = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    // changes submitted earlier without a value would otherwise drop the value
+    // pushed below when drained
+    (void) notify_ring_drain(anjay);
+    // queue_changed() drops the previously pushed value, so a failure below
+    // never leaves a stale one behind
+    if (!(retval = queue_changed(anjay, oid, iid, rid))) {
+#ifdef ANJAY_WITH_OBSERVE
+        push_value(anjay, &MAKE_RESOURCE_PATH(oid, iid, rid), value);
+#else  // ANJAY_WITH_OBSERVE
+        (void) value;
+#endif // ANJAY_WITH_OBSERVE
+        retval = reschedule_notify(anjay);
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return retval;
+}
+
+int anjay_notify_value_changed_i64(anjay_t *anjay,
+                                   anjay_oid_t oid,
+                                   anjay_iid_t iid,
+                                   anjay_rid_t rid,
+                                   int64_t value) {
+    return notify_value_changed(anjay, oid, iid, rid,
+                                &(const notify_value_t) {
+                                    .type = NOTIFY_VALUE_I64,
+                                    .data.i64 = value
+                                });
+}
+
+int anjay_notify_value_changed_double(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_rid_t rid,
+                                      double value) {
+    return notify_value_changed(anjay, oid, iid, rid,
+                                &(const notify_value_t) {
+                                    .type = NOTIFY_VALUE_DOUBLE,
+                                    .data.d = value
+                                });
+}
+
+int anjay_notify_value_changed_bool(anjay_t *anjay,
+                                    anjay_oid_t oid,
+                                    anjay_iid_t iid,
+                                    anjay_rid_t rid,
+                                    bool value) {
+    return notify_value_changed(anjay, oid, iid, rid,
+                                &(const notify_value_t) {
+                                    .type = NOTIFY_VALUE_BOOL,
+                                    .data.b = value
+                                });
+}
+
+int anjay_notify_value_changed_string(anjay_t *anjay,
+                                      anjay_oid_t oid,
+                                      anjay_iid_t iid,
+                                      anjay_rid_t rid,
+                                      const char *value) {
+    if (!value) {
+        anjay_log(ERROR, _("value must not be NULL"));
+        return -1;
+    }
+    return notify_value_changed(anjay, oid, iid, rid,
+                                &(const notify_value_t) {
+                                    .type = NOTIFY_VALUE_STRING,
+                                    .data.str = value
+                                });
+}
+
 int _anjay_notify_instances_changed_unlocked(anjay_unlocked_t *anjay,
                                              anjay_oid_t oid) {
+    _anjay_dm_layout_cache_invalidate(anjay, oid, ANJAY_ID_INVALID);
+    if (oid == ANJAY_DM_OID_ACCESS_CONTROL) {
+        _anjay_access_mask_cache_invalidate(anjay, ANJAY_ID_INVALID);
+    }
+    _anjay_observe_invalidate_read_cache(&anjay->observe);
+    _anjay_observe_drop_pushed_values(&anjay->observe, &MAKE_OBJECT_PATH(oid));
     int retval;
     (void) ((retval = _anjay_notify_queue_instance_set_unknown_change(
                      &anjay->scheduled_notify.queue, oid))
@@ -399,6 +1140,47 @@ int anjay_notify_instances_changed(anjay_t *anjay_locked, anjay_oid_t oid) {
     return retval;
 }
 
+int anjay_set_observe_attributes_caching(anjay_t *anjay_locked,
+                                         bool enabled) {
+    int retval = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+#ifdef ANJAY_WITH_OBSERVE
+    _anjay_observe_set_attrs_caching(&anjay->observe, enabled);
+    retval = 0;
+#else  // ANJAY_WITH_OBSERVE
+    (void) anjay;
+    (void) enabled;
+    anjay_log(ERROR, _("Observe support is not compiled in"));
+#endif // ANJAY_WITH_OBSERVE
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return retval;
+}
+
+int anjay_set_observe_read_sharing(anjay_t *anjay_locked, bool enabled) {
+    int retval = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+#ifdef ANJAY_WITH_OBSERVE
+    _anjay_observe_set_read_sharing(&anjay->observe, enabled);
+    retval = 0;
+#else  // ANJAY_WITH_OBSERVE
+    (void) anjay;
+    (void) enabled;
+    anjay_log(ERROR, _("Observe support is not compiled in"));
+#endif // ANJAY_WITH_OBSERVE
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return retval;
+}
+
+void anjay_notify_attributes_changed(anjay_t *anjay_locked) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+#ifdef ANJAY_WITH_OBSERVE
+    _anjay_observe_invalidate_attrs_cache(&anjay->observe);
+#else  // ANJAY_WITH_OBSERVE
+    (void) anjay;
+#endif // ANJAY_WITH_OBSERVE
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
 #ifdef ANJAY_WITH_OBSERVATION_STATUS
 anjay_resource_observation_status_t
 anjay_resource_observation_status(anjay_t *anjay_locked,
@@ -442,3 +1224,7 @@ anjay_resource_observation_status(anjay_t *anjay_locked,
     return retval;
 }
 #endif // ANJAY_WITH_OBSERVATION_STATUS
+
+#ifdef ANJAY_TEST
+#    include "tests/core/notify.c"
+#endif // ANJAY_TEST
@@ -9,6 +9,12 @@
 
 #include <anjay_init.h>
 
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_memory.h>
+
 #include <anjay/stats.h>
 #include <anjay_modules/anjay_dm_utils.h>
 
@@ -225,6 +231,419 @@ void _anjay_coap_ctx_cleanup(anjay_unlocked_t *anjay, avs_coap_ctx_t **ctx) {
 
 #endif // ANJAY_WITH_NET_STATS
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+
+static size_t time_to_histogram_bucket(uint64_t time_us) {
+    size_t bucket = 0;
+    while (time_us && bucket < ANJAY_OPERATION_STATS_HISTOGRAM_BUCKETS - 1) {
+        time_us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+static anjay_server_operation_stats_t *
+find_or_create_server_stats(anjay_unlocked_t *anjay, anjay_ssid_t ssid) {
+    AVS_LIST(anjay_server_operation_stats_t) *insert_ptr =
+            &anjay->operation_stats;
+    while (*insert_ptr && (*insert_ptr)->ssid < ssid) {
+        AVS_LIST_ADVANCE_PTR(&insert_ptr);
+    }
+    if (*insert_ptr && (*insert_ptr)->ssid == ssid) {
+        return *insert_ptr;
+    }
+    AVS_LIST(anjay_server_operation_stats_t) entry =
+            AVS_LIST_NEW_ELEMENT(anjay_server_operation_stats_t);
+    if (!entry) {
+        stats_log(ERROR, _("out of memory"));
+        return NULL;
+    }
+    entry->ssid = ssid;
+    AVS_LIST_INSERT(insert_ptr, entry);
+    return entry;
+}
+
+void _anjay_operation_stats_record(anjay_unlocked_t *anjay,
+                                   anjay_ssid_t ssid,
+                                   anjay_operation_t operation,
+                                   avs_time_monotonic_t start_time,
+                                   bool failed) {
+    assert((size_t) operation < ANJAY_OPERATIONS_COUNT);
+    anjay_server_operation_stats_t *server_stats =
+            find_or_create_server_stats(anjay, ssid);
+    if (!server_stats) {
+        return;
+    }
+    int64_t time_us;
+    if (avs_time_duration_to_scalar(
+                &time_us, AVS_TIME_US,
+                avs_time_monotonic_diff(avs_time_monotonic_now(), start_time))
+            || time_us < 0) {
+        time_us = 0;
+    }
+    anjay_operation_stats_t *stats = &server_stats->operations[operation];
+    ++stats->count;
+    if (failed) {
+        ++stats->error_count;
+    }
+    stats->total_time_us += (uint64_t) time_us;
+    if ((uint64_t) time_us > stats->max_time_us) {
+        stats->max_time_us = (uint64_t) time_us;
+    }
+    ++stats->time_histogram[time_to_histogram_bucket((uint64_t) time_us)];
+}
+
+void _anjay_operation_stats_cleanup(
+        AVS_LIST(anjay_server_operation_stats_t) *stats_ptr) {
+    AVS_LIST_CLEAR(stats_ptr);
+}
+
+static void merge_operation_stats(anjay_operation_stats_t *out,
+                                  const anjay_operation_stats_t *in) {
+    out->count += in->count;
+    out->error_count += in->error_count;
+    out->total_time_us += in->total_time_us;
+    if (in->max_time_us > out->max_time_us) {
+        out->max_time_us = in->max_time_us;
+    }
+    for (size_t i = 0; i < ANJAY_OPERATION_STATS_HISTOGRAM_BUCKETS; ++i) {
+        out->time_histogram[i] += in->time_histogram[i];
+    }
+}
+
+int anjay_get_operation_stats(anjay_t *anjay_locked,
+                              anjay_ssid_t ssid,
+                              anjay_operation_t operation,
+                              anjay_operation_stats_t *out_stats) {
+    if ((size_t) operation >= ANJAY_OPERATIONS_COUNT || !out_stats) {
+        stats_log(ERROR, _("invalid arguments"));
+        return -1;
+    }
+    memset(out_stats, 0, sizeof(*out_stats));
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    AVS_LIST(anjay_server_operation_stats_t) server_stats;
+    AVS_LIST_FOREACH(server_stats, anjay->operation_stats) {
+        if (ssid != ANJAY_SSID_ANY && server_stats->ssid > ssid) {
+            break;
+        }
+        if (ssid == ANJAY_SSID_ANY || server_stats->ssid == ssid) {
+            merge_operation_stats(out_stats,
+                                  &server_stats->operations[operation]);
+        }
+    }
+    result = 0;
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
+void anjay_reset_operation_stats(anjay_t *anjay_locked) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    _anjay_operation_stats_cleanup(&anjay->operation_stats);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+#else // ANJAY_WITH_OPERATION_STATS
+
+int anjay_get_operation_stats(anjay_t *anjay,
+                              anjay_ssid_t ssid,
+                              anjay_operation_t operation,
+                              anjay_operation_stats_t *out_stats) {
+    (void) anjay;
+    (void) ssid;
+    (void) operation;
+    (void) out_stats;
+    stats_log(ERROR,
+              _("OPERATION_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_OPERATION_STATS option."));
+    return -1;
+}
+
+void anjay_reset_operation_stats(anjay_t *anjay) {
+    (void) anjay;
+    stats_log(ERROR,
+              _("OPERATION_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_OPERATION_STATS option."));
+}
+
+#endif // ANJAY_WITH_OPERATION_STATS
+
+#ifdef ANJAY_WITH_MEMORY_STATS
+
+static size_t get_memory_usage(anjay_unlocked_t *anjay,
+                               anjay_memory_subsystem_t subsystem) {
+    switch (subsystem) {
+    case ANJAY_MEMORY_OBSERVE:
+#    ifdef ANJAY_WITH_OBSERVE
+        return _anjay_observe_memory_usage(&anjay->observe);
+#    else  // ANJAY_WITH_OBSERVE
+        return 0;
+#    endif // ANJAY_WITH_OBSERVE
+    case ANJAY_MEMORY_SEND:
+#    ifdef ANJAY_WITH_SEND
+        return _anjay_send_memory_usage(&anjay->sender);
+#    else  // ANJAY_WITH_SEND
+        return 0;
+#    endif // ANJAY_WITH_SEND
+    case ANJAY_MEMORY_ATTR_STORAGE:
+#    ifdef ANJAY_WITH_ATTR_STORAGE
+        return _anjay_attr_storage_memory_usage(&anjay->attr_storage);
+#    else  // ANJAY_WITH_ATTR_STORAGE
+        return 0;
+#    endif // ANJAY_WITH_ATTR_STORAGE
+    case ANJAY_MEMORY_MODULES:
+        return _anjay_dm_modules_memory_usage(anjay);
+    case ANJAY_MEMORY_DOWNLOADER:
+#    ifdef ANJAY_WITH_DOWNLOADER
+        return _anjay_downloader_memory_usage(&anjay->downloader);
+#    else  // ANJAY_WITH_DOWNLOADER
+        return 0;
+#    endif // ANJAY_WITH_DOWNLOADER
+    }
+    AVS_UNREACHABLE("invalid enum value");
+    return 0;
+}
+
+static bool memory_budget_supported(anjay_memory_subsystem_t subsystem) {
+    return subsystem == ANJAY_MEMORY_OBSERVE || subsystem == ANJAY_MEMORY_SEND;
+}
+
+int anjay_get_memory_stats(anjay_t *anjay_locked,
+                           anjay_memory_subsystem_t subsystem,
+                           anjay_memory_stats_t *out_stats) {
+    if ((size_t) subsystem >= ANJAY_MEMORY_SUBSYSTEMS_COUNT || !out_stats) {
+        stats_log(ERROR, _("invalid arguments"));
+        return -1;
+    }
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    out_stats->bytes_in_use = get_memory_usage(anjay, subsystem);
+    out_stats->budget = anjay->memory_budgets[subsystem].budget;
+    out_stats->dropped_count = anjay->memory_budgets[subsystem].dropped_count;
+    result = 0;
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
+int anjay_set_memory_budget(anjay_t *anjay_locked,
+                            anjay_memory_subsystem_t subsystem,
+                            size_t budget) {
+    if ((size_t) subsystem >= ANJAY_MEMORY_SUBSYSTEMS_COUNT) {
+        stats_log(ERROR, _("invalid arguments"));
+        return -1;
+    }
+    if (!memory_budget_supported(subsystem)) {
+        stats_log(ERROR,
+                  _("memory budgets are not supported for subsystem ") "%d",
+                  (int) subsystem);
+        return -1;
+    }
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    anjay->memory_budgets[subsystem].budget = budget;
+    result = 0;
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
+#else // ANJAY_WITH_MEMORY_STATS
+
+int anjay_get_memory_stats(anjay_t *anjay,
+                           anjay_memory_subsystem_t subsystem,
+                           anjay_memory_stats_t *out_stats) {
+    (void) anjay;
+    (void) subsystem;
+    (void) out_stats;
+    stats_log(ERROR,
+              _("MEMORY_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_MEMORY_STATS option."));
+    return -1;
+}
+
+int anjay_set_memory_budget(anjay_t *anjay,
+                            anjay_memory_subsystem_t subsystem,
+                            size_t budget) {
+    (void) anjay;
+    (void) subsystem;
+    (void) budget;
+    stats_log(ERROR,
+              _("MEMORY_STATS feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_MEMORY_STATS option."));
+    return -1;
+}
+
+#endif // ANJAY_WITH_MEMORY_STATS
+
+#ifdef ANJAY_WITH_SCHED_PROFILING
+
+typedef struct {
+    avs_sched_clb_t *clb;
+    const char *job_name;
+    avs_time_monotonic_t instant;
+    avs_max_align_t clb_data[];
+} profiled_job_t;
+
+/**
+ * Maximum size of callback data of a profiled job. Jobs posted by the library
+ * carry at most a few pointers or identifiers, so the wrapper can be built on
+ * the stack.
+ */
+#    define PROFILED_JOB_MAX_CLB_DATA_SIZE 64
+
+#    define PROFILED_JOB_BUFFER_ELEMENTS                                       \
+        ((offsetof(profiled_job_t, clb_data) + PROFILED_JOB_MAX_CLB_DATA_SIZE \
+          + sizeof(avs_max_align_t) - 1)                                      \
+         / sizeof(avs_max_align_t))
+
+static uint64_t duration_to_us(avs_time_duration_t duration) {
+    int64_t result_us;
+    if (avs_time_duration_to_scalar(&result_us, AVS_TIME_US, duration)
+            || result_us < 0) {
+        return 0;
+    }
+    return (uint64_t) result_us;
+}
+
+static anjay_sched_job_stats_t *
+find_or_create_job_stats(anjay_unlocked_t *anjay, const char *job_name) {
+    AVS_LIST(anjay_sched_job_stats_t) *entry_ptr = &anjay->sched_job_stats;
+    while (*entry_ptr) {
+        if ((*entry_ptr)->name == job_name
+                || !strcmp((*entry_ptr)->name, job_name)) {
+            return *entry_ptr;
+        }
+        AVS_LIST_ADVANCE_PTR(&entry_ptr);
+    }
+    AVS_LIST(anjay_sched_job_stats_t) entry =
+            AVS_LIST_NEW_ELEMENT(anjay_sched_job_stats_t);
+    if (!entry) {
+        stats_log(ERROR, _("out of memory"));
+        return NULL;
+    }
+    entry->name = job_name;
+    AVS_LIST_INSERT(entry_ptr, entry);
+    return entry;
+}
+
+static void record_job_stats(avs_sched_t *sched,
+                             const profiled_job_t *job,
+                             avs_time_monotonic_t start_time,
+                             avs_time_monotonic_t end_time) {
+    uint64_t lag_us =
+            duration_to_us(avs_time_monotonic_diff(start_time, job->instant));
+    uint64_t time_us =
+            duration_to_us(avs_time_monotonic_diff(end_time, start_time));
+    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    anjay_sched_job_stats_t *stats =
+            find_or_create_job_stats(anjay, job->job_name);
+    if (stats) {
+        ++stats->count;
+        stats->total_time_us += time_us;
+        if (time_us > stats->max_time_us) {
+            stats->max_time_us = time_us;
+        }
+        stats->total_lag_us += lag_us;
+        if (lag_us > stats->max_lag_us) {
+            stats->max_lag_us = lag_us;
+        }
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+static void profiled_job(avs_sched_t *sched, const void *job_) {
+    const profiled_job_t *job = (const profiled_job_t *) job_;
+    avs_time_monotonic_t start_time = avs_time_monotonic_now();
+    job->clb(sched, job->clb_data);
+    record_job_stats(sched, job, start_time, avs_time_monotonic_now());
+}
+
+int _anjay_sched_profiled_at(avs_sched_t *sched,
+                             avs_sched_handle_t *out_handle,
+                             avs_time_monotonic_t instant,
+                             const char *job_name,
+                             avs_sched_clb_t *clb,
+                             const void *clb_data,
+                             size_t clb_data_size) {
+    assert(job_name);
+    assert(clb);
+    if (clb_data_size > PROFILED_JOB_MAX_CLB_DATA_SIZE) {
+        AVS_UNREACHABLE("callback data too large for a profiled job");
+        stats_log(ERROR, _("callback data too large for job ") "%s", job_name);
+        return -1;
+    }
+    avs_max_align_t job_buffer[PROFILED_JOB_BUFFER_ELEMENTS];
+    const size_t job_size = offsetof(profiled_job_t, clb_data) + clb_data_size;
+    profiled_job_t *job = (profiled_job_t *) job_buffer;
+    job->clb = clb;
+    job->job_name = job_name;
+    job->instant = instant;
+    if (clb_data_size) {
+        memcpy(job->clb_data, clb_data, clb_data_size);
+    }
+    return AVS_SCHED_AT(sched, out_handle, instant, profiled_job, job,
+                        job_size);
+}
+
+void _anjay_sched_job_stats_cleanup(
+        AVS_LIST(anjay_sched_job_stats_t) *stats_ptr) {
+    AVS_LIST_CLEAR(stats_ptr);
+}
+
+int anjay_dump_sched_job_stats(anjay_t *anjay_locked,
+                               anjay_sched_job_stats_handler_t *handler,
+                               void *arg) {
+    if (!handler) {
+        stats_log(ERROR, _("invalid arguments"));
+        return -1;
+    }
+    AVS_LIST(anjay_sched_job_stats_t) snapshot = NULL;
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    if (!anjay->sched_job_stats
+            || (snapshot = AVS_LIST_SIMPLE_CLONE(anjay->sched_job_stats))) {
+        result = 0;
+    } else {
+        stats_log(ERROR, _("out of memory"));
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    AVS_LIST(const anjay_sched_job_stats_t) entry;
+    AVS_LIST_FOREACH(entry, snapshot) {
+        handler(entry, arg);
+    }
+    AVS_LIST_CLEAR(&snapshot);
+    return result;
+}
+
+void anjay_reset_sched_job_stats(anjay_t *anjay_locked) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    _anjay_sched_job_stats_cleanup(&anjay->sched_job_stats);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+#else // ANJAY_WITH_SCHED_PROFILING
+
+int anjay_dump_sched_job_stats(anjay_t *anjay,
+                               anjay_sched_job_stats_handler_t *handler,
+                               void *arg) {
+    (void) anjay;
+    (void) handler;
+    (void) arg;
+    stats_log(ERROR,
+              _("SCHED_PROFILING feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_SCHED_PROFILING option."));
+    return -1;
+}
+
+void anjay_reset_sched_job_stats(anjay_t *anjay) {
+    (void) anjay;
+    stats_log(ERROR,
+              _("SCHED_PROFILING feature disabled. Anjay was compiled without "
+                "ANJAY_WITH_SCHED_PROFILING option."));
+}
+
+#endif // ANJAY_WITH_SCHED_PROFILING
+
 avs_error_t _anjay_socket_cleanup(anjay_unlocked_t *anjay,
                                   avs_net_socket_t **socket) {
     assert(socket);
@@ -240,3 +659,7 @@ avs_error_t _anjay_socket_cleanup(anjay_unlocked_t *anjay,
     }
     return avs_net_socket_cleanup(socket);
 }
+
+#ifdef ANJAY_TEST
+#    include "tests/core/stats.c"
+#endif // ANJAY_TEST
@@ -15,8 +15,11 @@
 #include <stdint.h>
 
 #include <anjay/core.h>
+#include <anjay/stats.h>
 #include <avsystem/coap/ctx.h>
+#include <avsystem/commons/avs_list.h>
 #include <avsystem/commons/avs_socket.h>
+#include <avsystem/commons/avs_time.h>
 
 VISIBILITY_PRIVATE_HEADER_BEGIN
 
@@ -35,6 +38,61 @@ typedef struct {
 
 #endif // ANJAY_WITH_NET_STATS
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+
+#    define ANJAY_OPERATIONS_COUNT ((size_t) ANJAY_OPERATION_UPDATE + 1)
+
+/**
+ * Statistics of all operations performed with a single server. Stored in a
+ * list sorted by SSID, so that they survive reconnections and server
+ * reconfiguration.
+ */
+typedef struct {
+    anjay_ssid_t ssid;
+    anjay_operation_stats_t operations[ANJAY_OPERATIONS_COUNT];
+} anjay_server_operation_stats_t;
+
+/**
+ * Accounts for a single @p operation performed with server @p ssid, the
+ * handling of which started at @p start_time and finished now.
+ */
+void _anjay_operation_stats_record(anjay_unlocked_t *anjay,
+                                   anjay_ssid_t ssid,
+                                   anjay_operation_t operation,
+                                   avs_time_monotonic_t start_time,
+                                   bool failed);
+
+void _anjay_operation_stats_cleanup(
+        AVS_LIST(anjay_server_operation_stats_t) *stats_ptr);
+
+#endif // ANJAY_WITH_OPERATION_STATS
+
+#ifdef ANJAY_WITH_MEMORY_STATS
+
+#    define ANJAY_MEMORY_SUBSYSTEMS_COUNT ((size_t) ANJAY_MEMORY_DOWNLOADER + 1)
+
+typedef struct {
+    size_t budget;
+    uint64_t dropped_count;
+} anjay_memory_budget_t;
+
+/**
+ * Returns true if @p budget is set and @p bytes_in_use, calculated by the
+ * caller, is over it.
+ */
+static inline bool
+_anjay_memory_budget_exceeded(const anjay_memory_budget_t *budget,
+                              size_t bytes_in_use) {
+    return budget->budget && bytes_in_use > budget->budget;
+}
+
+#endif // ANJAY_WITH_MEMORY_STATS
+
+#ifdef ANJAY_WITH_SCHED_PROFILING
+void _anjay_sched_job_stats_cleanup(
+        AVS_LIST(anjay_sched_job_stats_t) *stats_ptr);
+#endif // ANJAY_WITH_SCHED_PROFILING
+
 void _anjay_coap_ctx_cleanup(anjay_unlocked_t *anjay, avs_coap_ctx_t **ctx);
 
 avs_error_t _anjay_socket_cleanup(anjay_unlocked_t *anjay,
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#ifdef ANJAY_WITH_TRACE_HOOKS
+
+#    include <assert.h>
+
+#    include <anjay/trace.h>
+
+#    include "anjay_core.h"
+#    include "anjay_trace.h"
+
+VISIBILITY_SOURCE_BEGIN
+
+void _anjay_trace_call_handler(const anjay_trace_hooks_t *hooks,
+                               anjay_trace_point_t point,
+                               anjay_ssid_t ssid,
+                               const anjay_uri_path_t *path,
+                               const char *name,
+                               int result) {
+    assert(hooks->handler);
+    anjay_trace_event_t event = {
+        .point = point,
+        .ssid = ssid,
+        .oid = path ? path->ids[ANJAY_ID_OID] : ANJAY_ID_INVALID,
+        .iid = path ? path->ids[ANJAY_ID_IID] : ANJAY_ID_INVALID,
+        .rid = path ? path->ids[ANJAY_ID_RID] : ANJAY_ID_INVALID,
+        .riid = path ? path->ids[ANJAY_ID_RIID] : ANJAY_ID_INVALID,
+        .name = name,
+        .result = result
+    };
+    hooks->handler(&event, hooks->arg);
+}
+
+void anjay_set_trace_handler(anjay_t *anjay_locked,
+                             anjay_trace_handler_t *handler,
+                             void *arg) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    anjay->trace_hooks.handler = handler;
+    anjay->trace_hooks.arg = arg;
+#    ifdef ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+    atomic_store(&anjay_locked->atomic_fields.trace_handler_set, !!handler);
+#    endif // ANJAY_WITH_ATOMIC_TRACE_HOOKS_FLAG
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+#endif // ANJAY_WITH_TRACE_HOOKS
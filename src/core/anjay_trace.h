@@ -0,0 +1,58 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_TRACE_H
+#define ANJAY_TRACE_H
+
+#include <anjay_init.h>
+
+#include <anjay/trace.h>
+
+#include <anjay_modules/anjay_dm_utils.h>
+
+VISIBILITY_PRIVATE_HEADER_BEGIN
+
+#ifdef ANJAY_WITH_TRACE_HOOKS
+
+typedef struct {
+    anjay_trace_handler_t *handler;
+    void *arg;
+} anjay_trace_hooks_t;
+
+void _anjay_trace_call_handler(const anjay_trace_hooks_t *hooks,
+                               anjay_trace_point_t point,
+                               anjay_ssid_t ssid,
+                               const anjay_uri_path_t *path,
+                               const char *name,
+                               int result);
+
+/**
+ * Calls the user-provided trace handler, if any. @p Path may be NULL.
+ *
+ * Arguments are only evaluated if a handler is set, and not at all if
+ * ANJAY_WITH_TRACE_HOOKS is disabled, so they MUST NOT have side effects.
+ */
+#    define _anjay_trace(Anjay, Point, Ssid, Path, Name, Result)          \
+        do {                                                              \
+            if ((Anjay)->trace_hooks.handler) {                           \
+                _anjay_trace_call_handler(&(Anjay)->trace_hooks, (Point), \
+                                          (Ssid), (Path), (Name),         \
+                                          (Result));                      \
+            }                                                             \
+        } while (0)
+
+#else // ANJAY_WITH_TRACE_HOOKS
+
+#    define _anjay_trace(Anjay, Point, Ssid, Path, Name, Result) ((void) 0)
+
+#endif // ANJAY_WITH_TRACE_HOOKS
+
+VISIBILITY_PRIVATE_HEADER_END
+
+#endif // ANJAY_TRACE_H
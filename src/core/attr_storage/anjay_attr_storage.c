@@ -16,7 +16,7 @@
 #    include <math.h>
 #    include <string.h>
 
-#    include <avsystem/commons/avs_stream_membuf.h>
+#    include <avsystem/commons/avs_memory.h>
 
 #    include <anjay_modules/anjay_dm_utils.h>
 #    include <anjay_modules/anjay_raw_buffer.h>
@@ -31,19 +31,20 @@ VISIBILITY_SOURCE_BEGIN
 
 //// LIFETIME AND OBJECT HANDLING //////////////////////////////////////////////
 
-int _anjay_attr_storage_init(anjay_unlocked_t *anjay) {
-    assert(anjay);
-    if (!(anjay->attr_storage.saved_state.persist_data =
-                  avs_stream_membuf_create())) {
-        return -1;
+static void saved_state_reset(anjay_attr_storage_t *as) {
+    while (as->saved_state.saved_objects) {
+        remove_object_entry(NULL, &as->saved_state.saved_objects);
     }
-    return 0;
+    AVS_LIST_CLEAR(&as->saved_state.created_oids);
+    as->saved_state.all_saved = false;
+    as->saved_state.in_transaction = false;
 }
 
 void _anjay_attr_storage_cleanup(anjay_attr_storage_t *as) {
     assert(as);
+    saved_state_reset(as);
     _anjay_attr_storage_clear(as);
-    avs_stream_cleanup(&as->saved_state.persist_data);
+    _anjay_attr_storage_invalidate_index(as);
 }
 
 bool anjay_attr_storage_is_modified(anjay_t *anjay_locked) {
@@ -54,7 +55,101 @@ bool anjay_attr_storage_is_modified(anjay_t *anjay_locked) {
     return result;
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+static size_t
+resource_entry_memory_usage(const as_resource_entry_t *resource) {
+    size_t result = ANJAY_LIST_ELEMENT_MEMORY(sizeof(*resource))
+                    + AVS_LIST_SIZE(resource->attrs)
+                              * ANJAY_LIST_ELEMENT_MEMORY(
+                                        sizeof(as_resource_attrs_t));
+#        ifdef ANJAY_WITH_LWM2M11
+    AVS_LIST(as_resource_instance_entry_t) resource_instance;
+    AVS_LIST_FOREACH(resource_instance, resource->resource_instances) {
+        result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*resource_instance))
+                  + AVS_LIST_SIZE(resource_instance->attrs)
+                            * ANJAY_LIST_ELEMENT_MEMORY(
+                                      sizeof(as_resource_attrs_t));
+    }
+#        endif // ANJAY_WITH_LWM2M11
+    return result;
+}
+
+static size_t
+objects_memory_usage(AVS_LIST(as_object_entry_t) objects) {
+    size_t result = 0;
+    AVS_LIST(as_object_entry_t) object;
+    AVS_LIST_FOREACH(object, objects) {
+        result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*object))
+                  + AVS_LIST_SIZE(object->default_attrs)
+                            * ANJAY_LIST_ELEMENT_MEMORY(
+                                      sizeof(as_default_attrs_t));
+        AVS_LIST(as_instance_entry_t) instance;
+        AVS_LIST_FOREACH(instance, object->instances) {
+            result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*instance))
+                      + AVS_LIST_SIZE(instance->default_attrs)
+                                * ANJAY_LIST_ELEMENT_MEMORY(
+                                          sizeof(as_default_attrs_t));
+            AVS_LIST(as_resource_entry_t) resource;
+            AVS_LIST_FOREACH(resource, instance->resources) {
+                result += resource_entry_memory_usage(resource);
+            }
+        }
+    }
+    return result;
+}
+
+size_t _anjay_attr_storage_memory_usage(const anjay_attr_storage_t *as) {
+    return objects_memory_usage(as->objects)
+           + objects_memory_usage(as->saved_state.saved_objects)
+           + AVS_LIST_SIZE(as->saved_state.created_oids)
+                     * ANJAY_LIST_ELEMENT_MEMORY(sizeof(anjay_oid_t))
+           + as->index.size * sizeof(as_index_entry_t);
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
+static AVS_LIST(as_object_entry_t) *
+find_saved_object_ptr(anjay_attr_storage_t *as, anjay_oid_t oid) {
+    AVS_LIST(as_object_entry_t) *it;
+    AVS_LIST_FOREACH_PTR(it, &as->saved_state.saved_objects) {
+        if ((*it)->oid >= oid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static bool is_object_saved(anjay_attr_storage_t *as, anjay_oid_t oid) {
+    AVS_LIST(as_object_entry_t) saved = *find_saved_object_ptr(as, oid);
+    if (saved && saved->oid == oid) {
+        return true;
+    }
+    AVS_LIST(anjay_oid_t) created_oid;
+    AVS_LIST_FOREACH(created_oid, as->saved_state.created_oids) {
+        if (*created_oid == oid) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void _anjay_attr_storage_clear(anjay_attr_storage_t *as) {
+    if (as->saved_state.in_transaction && !as->saved_state.all_saved) {
+        // Entries that have not been touched yet are still in their
+        // pre-transaction state - move them to the undo log instead of
+        // copying, so that they can be reinstated on rollback
+        AVS_LIST(as_object_entry_t) *object_ptr = &as->objects;
+        while (*object_ptr) {
+            if (is_object_saved(as, (*object_ptr)->oid)) {
+                AVS_LIST_ADVANCE_PTR(&object_ptr);
+            } else {
+                _anjay_attr_storage_mark_modified(as);
+                AVS_LIST_INSERT(find_saved_object_ptr(as, (*object_ptr)->oid),
+                                AVS_LIST_DETACH(object_ptr));
+            }
+        }
+        AVS_LIST_CLEAR(&as->saved_state.created_oids);
+        as->saved_state.all_saved = true;
+    }
     while (as->objects) {
         remove_object_entry(as, &as->objects);
     }
@@ -243,11 +338,66 @@ remove_attrs_for_servers_not_on_list(anjay_attr_storage_t *as,
     }
 }
 
-static void remove_servers_not_on_ssid_list(anjay_attr_storage_t *as,
-                                            AVS_LIST(anjay_ssid_t) ssid_list) {
+static bool
+has_attrs_for_servers_not_on_list(AVS_LIST(void) attrs,
+                                  AVS_LIST(anjay_ssid_t) ssid_list) {
+    AVS_LIST(anjay_ssid_t) ssid_ptr = ssid_list;
+    AVS_LIST(void) attrs_ptr;
+    AVS_LIST_FOREACH(attrs_ptr, attrs) {
+        while (ssid_ptr && *get_ssid_ptr(attrs_ptr) > *ssid_ptr) {
+            AVS_LIST_ADVANCE(&ssid_ptr);
+        }
+        if (!ssid_ptr || *get_ssid_ptr(attrs_ptr) != *ssid_ptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool
+object_has_servers_not_on_ssid_list(const as_object_entry_t *object,
+                                    AVS_LIST(anjay_ssid_t) ssid_list) {
+    if (has_attrs_for_servers_not_on_list(object->default_attrs, ssid_list)) {
+        return true;
+    }
+    AVS_LIST(as_instance_entry_t) instance;
+    AVS_LIST_FOREACH(instance, object->instances) {
+        if (has_attrs_for_servers_not_on_list(instance->default_attrs,
+                                              ssid_list)) {
+            return true;
+        }
+        AVS_LIST(as_resource_entry_t) res;
+        AVS_LIST_FOREACH(res, instance->resources) {
+            if (has_attrs_for_servers_not_on_list(res->attrs, ssid_list)) {
+                return true;
+            }
+#    ifdef ANJAY_WITH_LWM2M11
+            AVS_LIST(as_resource_instance_entry_t) res_instance;
+            AVS_LIST_FOREACH(res_instance, res->resource_instances) {
+                if (has_attrs_for_servers_not_on_list(res_instance->attrs,
+                                                      ssid_list)) {
+                    return true;
+                }
+            }
+#    endif // ANJAY_WITH_LWM2M11
+        }
+    }
+    return false;
+}
+
+static int remove_servers_not_on_ssid_list(anjay_attr_storage_t *as,
+                                           AVS_LIST(anjay_ssid_t) ssid_list) {
     AVS_LIST(as_object_entry_t) *object_ptr;
     AVS_LIST(as_object_entry_t) object_helper;
     AVS_LIST_DELETABLE_FOREACH_PTR(object_ptr, object_helper, &as->objects) {
+        // only objects that are actually modified are recorded in the undo log
+        if (!object_has_servers_not_on_ssid_list(*object_ptr, ssid_list)) {
+            continue;
+        }
+        int result = _anjay_attr_storage_save_object(as, (*object_ptr)->oid);
+        if (result) {
+            return result;
+        }
         remove_attrs_for_servers_not_on_list(
                 as, (AVS_LIST(void) *) &(*object_ptr)->default_attrs,
                 ssid_list);
@@ -283,6 +433,7 @@ static void remove_servers_not_on_ssid_list(anjay_attr_storage_t *as,
         }
         remove_object_if_empty(object_ptr);
     }
+    return 0;
 }
 
 int _anjay_attr_storage_remove_absent_instances_clb(
@@ -487,10 +638,11 @@ static int write_object_attrs(anjay_unlocked_t *anjay,
                               anjay_ssid_t ssid,
                               const anjay_dm_installed_object_t *obj_ptr,
                               const anjay_dm_oi_attributes_t *attrs) {
-    AVS_LIST(as_object_entry_t) *object_ptr =
-            find_or_create_object(&anjay->attr_storage,
-                                  _anjay_dm_installed_object_oid(obj_ptr));
-    if (!object_ptr) {
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(obj_ptr);
+    AVS_LIST(as_object_entry_t) *object_ptr = NULL;
+    if (_anjay_attr_storage_save_object(&anjay->attr_storage, oid)
+            || !(object_ptr = find_or_create_object(&anjay->attr_storage,
+                                                    oid))) {
         return -1;
     }
     int result =
@@ -509,8 +661,9 @@ static int write_instance_attrs(anjay_unlocked_t *anjay,
     int result = -1;
     AVS_LIST(as_object_entry_t) *object_ptr = NULL;
     AVS_LIST(as_instance_entry_t) *instance_ptr = NULL;
-    if ((object_ptr = find_or_create_object(
-                 &anjay->attr_storage, _anjay_dm_installed_object_oid(obj_ptr)))
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(obj_ptr);
+    if (!_anjay_attr_storage_save_object(&anjay->attr_storage, oid)
+            && (object_ptr = find_or_create_object(&anjay->attr_storage, oid))
             && (instance_ptr = find_or_create_instance(*object_ptr, iid))) {
         result = WRITE_ATTRS(&anjay->attr_storage,
                              &(*instance_ptr)->default_attrs,
@@ -537,8 +690,9 @@ static int write_resource_attrs(anjay_unlocked_t *anjay,
     AVS_LIST(as_object_entry_t) *object_ptr = NULL;
     AVS_LIST(as_instance_entry_t) *instance_ptr = NULL;
     AVS_LIST(as_resource_entry_t) *resource_ptr = NULL;
-    if ((object_ptr = find_or_create_object(
-                 &anjay->attr_storage, _anjay_dm_installed_object_oid(obj_ptr)))
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(obj_ptr);
+    if (!_anjay_attr_storage_save_object(&anjay->attr_storage, oid)
+            && (object_ptr = find_or_create_object(&anjay->attr_storage, oid))
             && (instance_ptr = find_or_create_instance(*object_ptr, iid))
             && (resource_ptr = find_or_create_resource(*instance_ptr, rid))) {
         result = WRITE_ATTRS(&anjay->attr_storage, &(*resource_ptr)->attrs,
@@ -573,8 +727,9 @@ write_resource_instance_attrs(anjay_unlocked_t *anjay,
     AVS_LIST(as_instance_entry_t) *instance_ptr = NULL;
     AVS_LIST(as_resource_entry_t) *resource_ptr = NULL;
     AVS_LIST(as_resource_instance_entry_t) *resource_instance_ptr = NULL;
-    if ((object_ptr = find_or_create_object(
-                 &anjay->attr_storage, _anjay_dm_installed_object_oid(obj_ptr)))
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(obj_ptr);
+    if (!_anjay_attr_storage_save_object(&anjay->attr_storage, oid)
+            && (object_ptr = find_or_create_object(&anjay->attr_storage, oid))
             && (instance_ptr = find_or_create_instance(*object_ptr, iid))
             && (resource_ptr = find_or_create_resource(*instance_ptr, rid))
             && (resource_instance_ptr = find_or_create_resource_instance(
@@ -600,6 +755,174 @@ write_resource_instance_attrs(anjay_unlocked_t *anjay,
 }
 #    endif // ANJAY_WITH_LWM2M11
 
+//// LOOKUP INDEX ////////////////////////////////////////////////////////////
+
+static inline uint64_t make_path_key(anjay_oid_t oid,
+                                     anjay_iid_t iid,
+                                     anjay_rid_t rid,
+                                     anjay_riid_t riid) {
+    return ((uint64_t) oid << 48) | ((uint64_t) iid << 32)
+           | ((uint64_t) rid << 16) | (uint64_t) riid;
+}
+
+void _anjay_attr_storage_invalidate_index(anjay_attr_storage_t *as) {
+    avs_free(as->index.entries);
+    as->index.entries = NULL;
+    as->index.size = 0;
+    as->index.valid = false;
+#    ifdef ANJAY_WITH_OBSERVE
+    // effective attributes cached by the observe code may be stale as well
+    _anjay_observe_invalidate_attrs_cache(
+            &AVS_CONTAINER_OF(as, anjay_unlocked_t, attr_storage)->observe);
+#    endif // ANJAY_WITH_OBSERVE
+}
+
+typedef struct {
+    // NULL when only counting the entries
+    as_index_entry_t *entries;
+    size_t size;
+} index_builder_t;
+
+static void index_add_attrs(index_builder_t *builder,
+                            uint64_t path_key,
+                            AVS_LIST(void) attrs,
+                            size_t attrs_field_offset) {
+    AVS_LIST_ITERATE(attrs) {
+        if (builder->entries) {
+            builder->entries[builder->size] = (as_index_entry_t) {
+                .path_key = path_key,
+                .ssid = *get_ssid_ptr(attrs),
+                .attrs = get_attrs_ptr(attrs, attrs_field_offset)
+            };
+        }
+        ++builder->size;
+    }
+}
+
+/**
+ * Visits the tree in post-order: as ANJAY_ID_INVALID is the largest possible
+ * ID, attributes of a parent path sort after those of all its children, so
+ * this yields entries already sorted by (path_key, ssid).
+ */
+static void index_walk(anjay_attr_storage_t *as, index_builder_t *builder) {
+    AVS_LIST(as_object_entry_t) object;
+    AVS_LIST_FOREACH(object, as->objects) {
+        AVS_LIST(as_instance_entry_t) instance;
+        AVS_LIST_FOREACH(instance, object->instances) {
+            AVS_LIST(as_resource_entry_t) resource;
+            AVS_LIST_FOREACH(resource, instance->resources) {
+#    ifdef ANJAY_WITH_LWM2M11
+                AVS_LIST(as_resource_instance_entry_t) resource_instance;
+                AVS_LIST_FOREACH(resource_instance,
+                                 resource->resource_instances) {
+                    index_add_attrs(builder,
+                                    make_path_key(object->oid, instance->iid,
+                                                  resource->rid,
+                                                  resource_instance->riid),
+                                    resource_instance->attrs,
+                                    offsetof(as_resource_attrs_t, attrs));
+                }
+#    endif // ANJAY_WITH_LWM2M11
+                index_add_attrs(builder,
+                                make_path_key(object->oid, instance->iid,
+                                              resource->rid, ANJAY_ID_INVALID),
+                                resource->attrs,
+                                offsetof(as_resource_attrs_t, attrs));
+            }
+            index_add_attrs(builder,
+                            make_path_key(object->oid, instance->iid,
+                                          ANJAY_ID_INVALID, ANJAY_ID_INVALID),
+                            instance->default_attrs,
+                            offsetof(as_default_attrs_t, attrs));
+        }
+        index_add_attrs(builder,
+                        make_path_key(object->oid, ANJAY_ID_INVALID,
+                                      ANJAY_ID_INVALID, ANJAY_ID_INVALID),
+                        object->default_attrs,
+                        offsetof(as_default_attrs_t, attrs));
+    }
+}
+
+static int ensure_index(anjay_attr_storage_t *as) {
+    if (as->index.valid) {
+        return 0;
+    }
+    assert(!as->index.entries);
+    index_builder_t builder = { NULL, 0 };
+    index_walk(as, &builder);
+    const size_t count = builder.size;
+    if (count
+            && !(builder.entries = (as_index_entry_t *) avs_malloc(
+                         count * sizeof(*builder.entries)))) {
+        as_log(DEBUG, _("out of memory, cannot build lookup index"));
+        return -1;
+    }
+    builder.size = 0;
+    index_walk(as, &builder);
+    assert(builder.size == count);
+    as->index.entries = builder.entries;
+    as->index.size = count;
+    as->index.valid = true;
+    return 0;
+}
+
+/**
+ * Returns index of the first entry not less than (path_key, ssid), or
+ * index->size if there is none.
+ */
+static size_t index_lower_bound(const as_index_t *index,
+                                uint64_t path_key,
+                                anjay_ssid_t ssid) {
+    size_t lo = 0;
+    size_t hi = index->size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const as_index_entry_t *entry = &index->entries[mid];
+        if (entry->path_key < path_key
+                || (entry->path_key == path_key && entry->ssid < ssid)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Looks up attributes using the index, building it if necessary.
+ *
+ * @returns 0 on success, in which case @p *out_attrs is set to the stored
+ *          attributes or NULL if there are none; negative value if the index
+ *          is not available and the tree needs to be searched directly.
+ */
+static int find_indexed_attrs(anjay_attr_storage_t *as,
+                              uint64_t path_key,
+                              anjay_ssid_t ssid,
+                              const void **out_attrs) {
+    if (ensure_index(as)) {
+        return -1;
+    }
+    size_t pos = index_lower_bound(&as->index, path_key, ssid);
+    *out_attrs = NULL;
+    if (pos < as->index.size && as->index.entries[pos].path_key == path_key
+            && as->index.entries[pos].ssid == ssid) {
+        *out_attrs = as->index.entries[pos].attrs;
+    }
+    return 0;
+}
+
+static void copy_default_attrs(const void *attrs,
+                               anjay_dm_oi_attributes_t *out) {
+    *out = attrs ? *(const anjay_dm_oi_attributes_t *) attrs
+                 : ANJAY_DM_OI_ATTRIBUTES_EMPTY;
+}
+
+static void copy_resource_attrs(const void *attrs,
+                                anjay_dm_r_attributes_t *out) {
+    *out = attrs ? *(const anjay_dm_r_attributes_t *) attrs
+                 : ANJAY_DM_R_ATTRIBUTES_EMPTY;
+}
+
 //// NOTIFICATION HANDLING /////////////////////////////////////////////////////
 
 typedef struct {
@@ -722,6 +1045,15 @@ int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
         if (!object_ptr && !is_ssid_reference_object(object_entry->oid)) {
             continue;
         }
+        if (object_ptr) {
+            int save_result =
+                    _anjay_attr_storage_save_object(&anjay->attr_storage,
+                                                    object_entry->oid);
+            if (save_result) {
+                _anjay_update_ret(&result, save_result);
+                continue;
+            }
+        }
         const anjay_dm_installed_object_t *def_ptr =
                 _anjay_dm_find_object_by_oid(anjay, object_entry->oid);
         if (!def_ptr && object_ptr) {
@@ -737,7 +1069,8 @@ int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
         }
         if (!partial_result && is_ssid_reference_object(object_entry->oid)) {
             AVS_LIST_SORT(&ssids, compare_u16ids);
-            remove_servers_not_on_ssid_list(&anjay->attr_storage, ssids);
+            partial_result =
+                    remove_servers_not_on_ssid_list(&anjay->attr_storage, ssids);
         }
         AVS_LIST_CLEAR(&ssids);
         if (!partial_result) {
@@ -760,9 +1093,17 @@ static int object_read_default_attrs(anjay_unlocked_t *anjay,
                                      const anjay_dm_installed_object_t obj_ptr,
                                      anjay_ssid_t ssid,
                                      anjay_dm_oi_attributes_t *out) {
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(&obj_ptr);
+    const void *attrs;
+    if (!find_indexed_attrs(&anjay->attr_storage,
+                            make_path_key(oid, ANJAY_ID_INVALID,
+                                          ANJAY_ID_INVALID, ANJAY_ID_INVALID),
+                            ssid, &attrs)) {
+        copy_default_attrs(attrs, out);
+        return 0;
+    }
     AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(&anjay->attr_storage,
-                        _anjay_dm_installed_object_oid(&obj_ptr));
+            find_object(&anjay->attr_storage, oid);
     read_default_attrs(object_ptr ? (*object_ptr)->default_attrs : NULL, ssid,
                        out);
     return 0;
@@ -782,9 +1123,17 @@ instance_read_default_attrs(anjay_unlocked_t *anjay,
                             anjay_iid_t iid,
                             anjay_ssid_t ssid,
                             anjay_dm_oi_attributes_t *out) {
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(&obj_ptr);
+    const void *attrs;
+    if (!find_indexed_attrs(&anjay->attr_storage,
+                            make_path_key(oid, iid, ANJAY_ID_INVALID,
+                                          ANJAY_ID_INVALID),
+                            ssid, &attrs)) {
+        copy_default_attrs(attrs, out);
+        return 0;
+    }
     AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(&anjay->attr_storage,
-                        _anjay_dm_installed_object_oid(&obj_ptr));
+            find_object(&anjay->attr_storage, oid);
     AVS_LIST(as_instance_entry_t) *instance_ptr =
             object_ptr ? find_instance(*object_ptr, iid) : NULL;
     read_default_attrs(instance_ptr ? (*instance_ptr)->default_attrs : NULL,
@@ -809,9 +1158,16 @@ static int resource_read_attrs(anjay_unlocked_t *anjay,
                                anjay_rid_t rid,
                                anjay_ssid_t ssid,
                                anjay_dm_r_attributes_t *out) {
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(&obj_ptr);
+    const void *attrs;
+    if (!find_indexed_attrs(&anjay->attr_storage,
+                            make_path_key(oid, iid, rid, ANJAY_ID_INVALID),
+                            ssid, &attrs)) {
+        copy_resource_attrs(attrs, out);
+        return 0;
+    }
     AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(&anjay->attr_storage,
-                        _anjay_dm_installed_object_oid(&obj_ptr));
+            find_object(&anjay->attr_storage, oid);
     AVS_LIST(as_instance_entry_t) *instance_ptr =
             object_ptr ? find_instance(*object_ptr, iid) : NULL;
     AVS_LIST(as_resource_entry_t) *res_ptr =
@@ -840,9 +1196,16 @@ resource_instance_read_attrs(anjay_unlocked_t *anjay,
                              anjay_riid_t riid,
                              anjay_ssid_t ssid,
                              anjay_dm_r_attributes_t *out) {
+    const anjay_oid_t oid = _anjay_dm_installed_object_oid(&obj_ptr);
+    const void *attrs;
+    if (!find_indexed_attrs(&anjay->attr_storage,
+                            make_path_key(oid, iid, rid, riid), ssid,
+                            &attrs)) {
+        copy_resource_attrs(attrs, out);
+        return 0;
+    }
     AVS_LIST(as_object_entry_t) *object_ptr =
-            find_object(&anjay->attr_storage,
-                        _anjay_dm_installed_object_oid(&obj_ptr));
+            find_object(&anjay->attr_storage, oid);
     AVS_LIST(as_instance_entry_t) *instance_ptr =
             object_ptr ? find_instance(*object_ptr, iid) : NULL;
     AVS_LIST(as_resource_entry_t) *res_ptr =
@@ -884,16 +1247,113 @@ const anjay_unlocked_dm_handlers_t _ANJAY_ATTR_STORAGE_HANDLERS = {
 
 //// ACTIVE PROXY HANDLERS /////////////////////////////////////////////////////
 
-static void saved_state_reset(anjay_attr_storage_t *as) {
-    avs_stream_reset(as->saved_state.persist_data);
-    avs_stream_membuf_fit(as->saved_state.persist_data);
+// AVS_LIST_SIMPLE_CLONE() returns NULL both on error and for empty lists
+#    define CLONE_ATTRS_LIST(Out, Src) \
+        (((Src) && !(*(Out) = AVS_LIST_SIMPLE_CLONE(Src))) ? -1 : 0)
+
+#    ifdef ANJAY_WITH_LWM2M11
+static int
+clone_resource_instances(AVS_LIST(as_resource_instance_entry_t) *out,
+                         AVS_LIST(as_resource_instance_entry_t) src) {
+    AVS_LIST_ITERATE(src) {
+        if (!(*out = AVS_LIST_NEW_ELEMENT(as_resource_instance_entry_t))) {
+            return -1;
+        }
+        (*out)->riid = src->riid;
+        if (CLONE_ATTRS_LIST(&(*out)->attrs, src->attrs)) {
+            return -1;
+        }
+        AVS_LIST_ADVANCE_PTR(&out);
+    }
+    return 0;
+}
+#    endif // ANJAY_WITH_LWM2M11
+
+static int clone_resources(AVS_LIST(as_resource_entry_t) *out,
+                           AVS_LIST(as_resource_entry_t) src) {
+    AVS_LIST_ITERATE(src) {
+        if (!(*out = AVS_LIST_NEW_ELEMENT(as_resource_entry_t))) {
+            return -1;
+        }
+        (*out)->rid = src->rid;
+        if (CLONE_ATTRS_LIST(&(*out)->attrs, src->attrs)
+#    ifdef ANJAY_WITH_LWM2M11
+                || clone_resource_instances(&(*out)->resource_instances,
+                                            src->resource_instances)
+#    endif // ANJAY_WITH_LWM2M11
+        ) {
+            return -1;
+        }
+        AVS_LIST_ADVANCE_PTR(&out);
+    }
+    return 0;
+}
+
+static int clone_instances(AVS_LIST(as_instance_entry_t) *out,
+                           AVS_LIST(as_instance_entry_t) src) {
+    AVS_LIST_ITERATE(src) {
+        if (!(*out = AVS_LIST_NEW_ELEMENT(as_instance_entry_t))) {
+            return -1;
+        }
+        (*out)->iid = src->iid;
+        if (CLONE_ATTRS_LIST(&(*out)->default_attrs, src->default_attrs)
+                || clone_resources(&(*out)->resources, src->resources)) {
+            return -1;
+        }
+        AVS_LIST_ADVANCE_PTR(&out);
+    }
+    return 0;
+}
+
+static AVS_LIST(as_object_entry_t) clone_object(const as_object_entry_t *src) {
+    AVS_LIST(as_object_entry_t) object = AVS_LIST_NEW_ELEMENT(as_object_entry_t);
+    if (object) {
+        object->oid = src->oid;
+        if (CLONE_ATTRS_LIST(&object->default_attrs, src->default_attrs)
+                || clone_instances(&object->instances, src->instances)) {
+            remove_object_entry(NULL, &object);
+        }
+    }
+    return object;
+}
+
+int _anjay_attr_storage_save_object(anjay_attr_storage_t *as,
+                                    anjay_oid_t oid) {
+    if (!as->saved_state.in_transaction || as->saved_state.all_saved
+            || is_object_saved(as, oid)) {
+        return 0;
+    }
+    AVS_LIST(as_object_entry_t) *object_ptr = find_object(as, oid);
+    if (object_ptr) {
+        AVS_LIST(as_object_entry_t) saved = clone_object(*object_ptr);
+        if (!saved) {
+            as_log(ERROR, _("out of memory"));
+            return ANJAY_ERR_INTERNAL;
+        }
+        AVS_LIST_INSERT(find_saved_object_ptr(as, oid), saved);
+    } else {
+        AVS_LIST(anjay_oid_t) created_oid = AVS_LIST_NEW_ELEMENT(anjay_oid_t);
+        if (!created_oid) {
+            as_log(ERROR, _("out of memory"));
+            return ANJAY_ERR_INTERNAL;
+        }
+        *created_oid = oid;
+        AVS_LIST_INSERT(&as->saved_state.created_oids, created_oid);
+    }
+    return 0;
 }
 
 avs_error_t _anjay_attr_storage_transaction_begin(anjay_unlocked_t *anjay) {
-    anjay->attr_storage.saved_state.modified_since_persist =
-            anjay->attr_storage.modified_since_persist;
-    return _anjay_attr_storage_persist_inner(
-            &anjay->attr_storage, anjay->attr_storage.saved_state.persist_data);
+    anjay_attr_storage_t *as = &anjay->attr_storage;
+    if (as->saved_state.in_transaction) {
+        as_log(ERROR, _("Attribute Storage transaction already in progress"));
+        return avs_errno(AVS_EBUSY);
+    }
+    assert(!as->saved_state.saved_objects);
+    assert(!as->saved_state.created_oids);
+    as->saved_state.modified_since_persist = as->modified_since_persist;
+    as->saved_state.in_transaction = true;
+    return AVS_OK;
 }
 
 void _anjay_attr_storage_transaction_commit(anjay_unlocked_t *anjay) {
@@ -901,17 +1361,41 @@ void _anjay_attr_storage_transaction_commit(anjay_unlocked_t *anjay) {
 }
 
 avs_error_t _anjay_attr_storage_transaction_rollback(anjay_unlocked_t *anjay) {
-    avs_error_t err;
-    if (avs_is_err((err = _anjay_attr_storage_restore_inner(
-                            anjay,
-                            anjay->attr_storage.saved_state.persist_data)))) {
-        anjay->attr_storage.modified_since_persist = true;
+    anjay_attr_storage_t *as = &anjay->attr_storage;
+    assert(as->saved_state.in_transaction);
+    if (as->saved_state.all_saved) {
+        while (as->objects) {
+            remove_object_entry(NULL, &as->objects);
+        }
+        as->objects = as->saved_state.saved_objects;
+        as->saved_state.saved_objects = NULL;
     } else {
-        anjay->attr_storage.modified_since_persist =
-                anjay->attr_storage.saved_state.modified_since_persist;
+        AVS_LIST_CLEAR(&as->saved_state.created_oids) {
+            AVS_LIST(as_object_entry_t) *object_ptr =
+                    find_object(as, *as->saved_state.created_oids);
+            if (object_ptr) {
+                remove_object_entry(NULL, object_ptr);
+            }
+        }
+        while (as->saved_state.saved_objects) {
+            AVS_LIST(as_object_entry_t) saved =
+                    AVS_LIST_DETACH(&as->saved_state.saved_objects);
+            AVS_LIST(as_object_entry_t) *object_ptr;
+            AVS_LIST_FOREACH_PTR(object_ptr, &as->objects) {
+                if ((*object_ptr)->oid >= saved->oid) {
+                    break;
+                }
+            }
+            if (*object_ptr && (*object_ptr)->oid == saved->oid) {
+                remove_object_entry(NULL, object_ptr);
+            }
+            AVS_LIST_INSERT(object_ptr, saved);
+        }
     }
-    saved_state_reset(&anjay->attr_storage);
-    return err;
+    as->modified_since_persist = as->saved_state.modified_since_persist;
+    saved_state_reset(as);
+    _anjay_attr_storage_invalidate_index(as);
+    return AVS_OK;
 }
 
 static const anjay_dm_installed_object_t *
@@ -20,14 +20,57 @@ VISIBILITY_PRIVATE_HEADER_BEGIN
 typedef struct as_object_entry as_object_entry_t;
 
 typedef struct {
-    avs_stream_t *persist_data;
+    bool in_transaction;
+    /**
+     * Pre-transaction copies of the Object entries that have been modified
+     * during the current transaction, sorted by OID.
+     */
+    AVS_LIST(as_object_entry_t) saved_objects;
+    /**
+     * OIDs of Object entries that have been modified during the current
+     * transaction, but did not exist before it began.
+     */
+    AVS_LIST(anjay_oid_t) created_oids;
+    /**
+     * True if @ref as_saved_state_t#saved_objects contains all Object entries
+     * that existed before the transaction began, i.e. the whole state shall be
+     * replaced on rollback.
+     */
+    bool all_saved;
     bool modified_since_persist;
 } as_saved_state_t;
 
+typedef struct {
+    /**
+     * (OID, IID, RID, RIID) packed into a single integer, most significant
+     * first. IDs of levels below the one the attributes are attached to are
+     * set to ANJAY_ID_INVALID.
+     */
+    uint64_t path_key;
+    anjay_ssid_t ssid;
+    /**
+     * Points to either anjay_dm_oi_attributes_t or anjay_dm_r_attributes_t
+     * stored in the main tree, depending on the level of @ref path_key.
+     */
+    const void *attrs;
+} as_index_entry_t;
+
+/**
+ * Flat array of all stored attribute sets, sorted by (path_key, ssid), used
+ * for lookups in the attribute read handlers. It is built lazily and dropped
+ * whenever the main tree is modified.
+ */
+typedef struct {
+    as_index_entry_t *entries;
+    size_t size;
+    bool valid;
+} as_index_t;
+
 typedef struct {
     AVS_LIST(as_object_entry_t) objects;
     bool modified_since_persist;
     as_saved_state_t saved_state;
+    as_index_t index;
 } anjay_attr_storage_t;
 
 static inline bool _anjay_dm_implements_any_object_default_attrs_handlers(
@@ -64,7 +107,6 @@ static inline bool _anjay_dm_implements_any_resource_instance_attrs_handlers(
 }
 #endif // ANJAY_WITH_LWM2M11
 
-int _anjay_attr_storage_init(anjay_unlocked_t *anjay);
 void _anjay_attr_storage_cleanup(anjay_attr_storage_t *as);
 
 avs_error_t _anjay_attr_storage_transaction_begin(anjay_unlocked_t *anjay);
@@ -74,6 +116,10 @@ avs_error_t _anjay_attr_storage_transaction_rollback(anjay_unlocked_t *anjay);
 int _anjay_attr_storage_notify(anjay_unlocked_t *anjay,
                                anjay_notify_queue_t queue);
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_attr_storage_memory_usage(const anjay_attr_storage_t *as);
+#endif // ANJAY_WITH_MEMORY_STATS
+
 extern const anjay_unlocked_dm_handlers_t _ANJAY_ATTR_STORAGE_HANDLERS;
 
 VISIBILITY_PRIVATE_HEADER_END
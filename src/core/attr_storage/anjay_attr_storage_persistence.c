@@ -407,6 +407,7 @@ avs_error_t _anjay_attr_storage_restore_inner(anjay_unlocked_t *anjay,
                                    anjay, &anjay->attr_storage)))) {
         _anjay_attr_storage_clear(&anjay->attr_storage);
     }
+    _anjay_attr_storage_invalidate_index(&anjay->attr_storage);
     return err;
 }
 
@@ -57,6 +57,16 @@ struct as_object_entry {
 
 void _anjay_attr_storage_clear(anjay_attr_storage_t *as);
 
+/**
+ * Records the current state of the Object entry for @p oid in the transaction
+ * undo log, unless it has already been recorded. Shall be called before
+ * modifying any data related to that Object. Does nothing if no transaction is
+ * in progress.
+ *
+ * @returns 0 on success, ANJAY_ERR_INTERNAL if out of memory.
+ */
+int _anjay_attr_storage_save_object(anjay_attr_storage_t *as, anjay_oid_t oid);
+
 /**
  * @param instance_ptr_ptr_
  * Conceptually of type AVS_LIST(as_instance_entry_t) **. Pointer to a variable
@@ -88,8 +98,20 @@ int _anjay_attr_storage_remove_absent_resource_instances(
         AVS_LIST(as_resource_entry_t) *resource_ptr);
 #endif // ANJAY_WITH_LWM2M11
 
+/**
+ * Drops the lookup index. Shall be called whenever the set of attribute
+ * entries in the main tree changes in a way that does not involve
+ * @ref _anjay_attr_storage_mark_modified.
+ */
+void _anjay_attr_storage_invalidate_index(anjay_attr_storage_t *as);
+
 static inline void _anjay_attr_storage_mark_modified(anjay_attr_storage_t *as) {
-    as->modified_since_persist = true;
+    // as is NULL when freeing entries that are not attached to the storage,
+    // e.g. ones held in the transaction undo log
+    if (as) {
+        as->modified_since_persist = true;
+        _anjay_attr_storage_invalidate_index(as);
+    }
 }
 
 #ifdef ANJAY_WITH_LWM2M11
@@ -11,6 +11,7 @@
 
 #include <avsystem/coap/code.h>
 
+#include <anjay_modules/anjay_access_utils.h>
 #include <anjay_modules/anjay_dm_utils.h>
 
 #include "../anjay_core.h"
@@ -464,6 +465,67 @@ static int unlocking_resource_instance_write_attrs(
 }
 #    endif // ANJAY_WITH_LWM2M11
 
+static int unlocking_instance_present(anjay_unlocked_t *anjay,
+                                      const anjay_dm_installed_object_t obj_def,
+                                      anjay_iid_t iid,
+                                      bool *out_present) {
+    assert(obj_def.type == ANJAY_DM_OBJECT_USER_PROVIDED);
+    assert(obj_def.impl.user_provided);
+    assert(*obj_def.impl.user_provided);
+    assert((*obj_def.impl.user_provided)->handlers.instance_present);
+    int result = -1;
+    ANJAY_MUTEX_UNLOCK_FOR_CALLBACK(anjay_locked, anjay);
+    result = (*obj_def.impl.user_provided)
+                     ->handlers.instance_present(anjay_locked,
+                                                 obj_def.impl.user_provided,
+                                                 iid, out_present);
+    ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
+    return result;
+}
+
+static int
+unlocking_resource_present(anjay_unlocked_t *anjay,
+                           const anjay_dm_installed_object_t obj_def,
+                           anjay_iid_t iid,
+                           anjay_rid_t rid,
+                           anjay_dm_resource_kind_t *out_kind,
+                           anjay_dm_resource_presence_t *out_presence) {
+    assert(obj_def.type == ANJAY_DM_OBJECT_USER_PROVIDED);
+    assert(obj_def.impl.user_provided);
+    assert(*obj_def.impl.user_provided);
+    assert((*obj_def.impl.user_provided)->handlers.resource_present);
+    int result = -1;
+    ANJAY_MUTEX_UNLOCK_FOR_CALLBACK(anjay_locked, anjay);
+    result = (*obj_def.impl.user_provided)
+                     ->handlers.resource_present(anjay_locked,
+                                                 obj_def.impl.user_provided,
+                                                 iid, rid, out_kind,
+                                                 out_presence);
+    ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
+    return result;
+}
+
+static int unlocking_instance_read(anjay_unlocked_t *anjay,
+                                   const anjay_dm_installed_object_t obj_def,
+                                   anjay_iid_t iid,
+                                   anjay_unlocked_output_ctx_t *ctx) {
+    assert(obj_def.type == ANJAY_DM_OBJECT_USER_PROVIDED);
+    assert(obj_def.impl.user_provided);
+    assert(*obj_def.impl.user_provided);
+    assert((*obj_def.impl.user_provided)->handlers.instance_read);
+    int result = -1;
+    ANJAY_MUTEX_UNLOCK_FOR_CALLBACK(anjay_locked, anjay);
+    result = (*obj_def.impl.user_provided)
+                     ->handlers.instance_read(anjay_locked,
+                                              obj_def.impl.user_provided, iid,
+                                              &(anjay_output_ctx_t) {
+                                                  .anjay_locked = anjay_locked,
+                                                  .unlocked_ctx = ctx
+                                              });
+    ANJAY_MUTEX_LOCK_AFTER_CALLBACK(anjay_locked);
+    return result;
+}
+
 static const anjay_unlocked_dm_handlers_t UNLOCKING_HANDLER_WRAPPERS = {
     unlocking_object_read_default_attrs,
     unlocking_object_write_default_attrs,
@@ -489,6 +551,9 @@ static const anjay_unlocked_dm_handlers_t UNLOCKING_HANDLER_WRAPPERS = {
     unlocking_resource_instance_read_attrs,
     unlocking_resource_instance_write_attrs,
 #    endif // ANJAY_WITH_LWM2M11
+    unlocking_instance_present,
+    unlocking_resource_present,
+    unlocking_instance_read,
 };
 
 static bool has_handler_locked(const anjay_dm_handlers_t *def,
@@ -522,6 +587,9 @@ static bool has_handler_locked(const anjay_dm_handlers_t *def,
         HANDLER_CASE(resource_instance_read_attrs);
         HANDLER_CASE(resource_instance_write_attrs);
 #    endif // ANJAY_WITH_LWM2M11
+        HANDLER_CASE(instance_present);
+        HANDLER_CASE(resource_present);
+        HANDLER_CASE(instance_read);
     }
 #    undef HANDLER_CASE
     AVS_UNREACHABLE("unknown handler type passed");
@@ -561,6 +629,9 @@ static bool has_handler_unlocked(const anjay_unlocked_dm_handlers_t *def,
         HANDLER_CASE(resource_instance_read_attrs);
         HANDLER_CASE(resource_instance_write_attrs);
 #endif // ANJAY_WITH_LWM2M11
+        HANDLER_CASE(instance_present);
+        HANDLER_CASE(resource_present);
+        HANDLER_CASE(instance_read);
     }
 #undef HANDLER_CASE
     AVS_UNREACHABLE("unknown handler type passed");
@@ -664,13 +735,22 @@ bool _anjay_dm_handler_implemented(const anjay_dm_installed_object_t *obj_ptr,
 #endif // ANJAY_WITH_THREAD_SAFETY
 }
 
+// NOTE: all callers are expected to have an anjay_unlocked_t *anjay in scope
 #define CHECKED_TAIL_CALL_HANDLER(ObjPtr, HandlerName, ...)                   \
     do {                                                                      \
         const anjay_unlocked_dm_handlers_t *handler =                         \
                 get_handler((ObjPtr), ANJAY_DM_HANDLER_##HandlerName);        \
         if (handler) {                                                        \
+            _anjay_trace(anjay, ANJAY_TRACE_DM_HANDLER_ENTER, ANJAY_SSID_ANY, \
+                         &MAKE_OBJECT_PATH(                                   \
+                                 _anjay_dm_installed_object_oid(ObjPtr)),     \
+                         #HandlerName, 0);                                    \
             int AVS_CONCAT(result, __LINE__) =                                \
                     handler->HandlerName(__VA_ARGS__);                        \
+            _anjay_trace(anjay, ANJAY_TRACE_DM_HANDLER_EXIT, ANJAY_SSID_ANY,  \
+                         &MAKE_OBJECT_PATH(                                   \
+                                 _anjay_dm_installed_object_oid(ObjPtr)),     \
+                         #HandlerName, AVS_CONCAT(result, __LINE__));         \
             if (AVS_CONCAT(result, __LINE__)) {                               \
                 dm_log(DEBUG, #HandlerName _(" failed with code ") "%d (%s)", \
                        AVS_CONCAT(result, __LINE__),                          \
@@ -786,6 +866,39 @@ int _anjay_dm_call_list_resources(anjay_unlocked_t *anjay,
                               ctx);
 }
 
+int _anjay_dm_call_instance_present(anjay_unlocked_t *anjay,
+                                    const anjay_dm_installed_object_t *obj_ptr,
+                                    anjay_iid_t iid,
+                                    bool *out_present) {
+    dm_log(TRACE, _("instance_present ") "/%u/%u",
+           _anjay_dm_installed_object_oid(obj_ptr), iid);
+    CHECKED_TAIL_CALL_HANDLER(obj_ptr, instance_present, anjay, *obj_ptr, iid,
+                              out_present);
+}
+
+int _anjay_dm_call_resource_present(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj_ptr,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        anjay_dm_resource_kind_t *out_kind,
+        anjay_dm_resource_presence_t *out_presence) {
+    dm_log(TRACE, _("resource_present ") "/%u/%u/%u",
+           _anjay_dm_installed_object_oid(obj_ptr), iid, rid);
+    CHECKED_TAIL_CALL_HANDLER(obj_ptr, resource_present, anjay, *obj_ptr, iid,
+                              rid, out_kind, out_presence);
+}
+
+int _anjay_dm_call_instance_read(anjay_unlocked_t *anjay,
+                                 const anjay_dm_installed_object_t *obj_ptr,
+                                 anjay_iid_t iid,
+                                 anjay_unlocked_output_ctx_t *ctx) {
+    dm_log(TRACE, _("instance_read ") "/%u/%u",
+           _anjay_dm_installed_object_oid(obj_ptr), iid);
+    CHECKED_TAIL_CALL_HANDLER(obj_ptr, instance_read, anjay, *obj_ptr, iid,
+                              ctx);
+}
+
 int _anjay_dm_call_resource_read(anjay_unlocked_t *anjay,
                                  const anjay_dm_installed_object_t *obj_ptr,
                                  anjay_iid_t iid,
@@ -951,7 +1064,10 @@ avs_error_t _anjay_dm_transaction_begin(anjay_unlocked_t *anjay) {
     dm_log(TRACE, _("transaction_begin"));
     avs_error_t err = AVS_OK;
 #ifdef ANJAY_WITH_ATTR_STORAGE
-    err = _anjay_attr_storage_transaction_begin(anjay);
+    if (!anjay->transaction_state.depth) {
+        // nested transactions are committed or rolled back as a whole
+        err = _anjay_attr_storage_transaction_begin(anjay);
+    }
 #endif // ANJAY_WITH_ATTR_STORAGE
     if (avs_is_ok(err)) {
         ++anjay->transaction_state.depth;
@@ -996,6 +1112,13 @@ int _anjay_dm_transaction_include_object(
 static int commit_or_rollback_object(anjay_unlocked_t *anjay,
                                      const anjay_dm_installed_object_t *obj,
                                      int predicate) {
+    // Both committing and rolling back may change the set of Resources
+    _anjay_dm_layout_cache_invalidate(anjay,
+                                      _anjay_dm_installed_object_oid(obj),
+                                      ANJAY_ID_INVALID);
+    if (_anjay_dm_installed_object_oid(obj) == ANJAY_DM_OID_ACCESS_CONTROL) {
+        _anjay_access_mask_cache_invalidate(anjay, ANJAY_ID_INVALID);
+    }
     int result;
     if (predicate) {
         if ((result = _anjay_dm_call_transaction_rollback(anjay, obj))) {
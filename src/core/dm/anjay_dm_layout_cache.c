@@ -0,0 +1,335 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_memory.h>
+
+#include "../anjay_core.h"
+
+#include "anjay_dm_layout_cache.h"
+
+VISIBILITY_SOURCE_BEGIN
+
+static int layout_cmp(const void *left, const void *right) {
+    anjay_iid_t left_iid =
+            ((const anjay_dm_cached_instance_layout_t *) left)->iid;
+    anjay_iid_t right_iid =
+            ((const anjay_dm_cached_instance_layout_t *) right)->iid;
+    return (int) left_iid - (int) right_iid;
+}
+
+static AVS_LIST(anjay_dm_resource_layout_cache_t) *
+find_cache_ptr(anjay_unlocked_t *anjay, anjay_oid_t oid) {
+    AVS_LIST(anjay_dm_resource_layout_cache_t) *it;
+    AVS_LIST_FOREACH_PTR(it, &anjay->dm.resource_layout_caches) {
+        if ((*it)->oid >= oid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static anjay_dm_resource_layout_cache_t *find_cache(anjay_unlocked_t *anjay,
+                                                   anjay_oid_t oid) {
+    AVS_LIST(anjay_dm_resource_layout_cache_t) *it =
+            find_cache_ptr(anjay, oid);
+    return (*it && (*it)->oid == oid) ? *it : NULL;
+}
+
+static AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t)
+find_layout(anjay_dm_resource_layout_cache_t *cache, anjay_iid_t iid) {
+    const anjay_dm_cached_instance_layout_t query = {
+        .iid = iid
+    };
+    return AVS_SORTED_SET_FIND(cache->instances, &query);
+}
+
+static void
+drop_layout(anjay_dm_resource_layout_cache_t *cache,
+            AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout) {
+    AVS_SORTED_SET_DETACH(cache->instances, layout);
+    if (layout->refcount) {
+        layout->detached = true;
+    } else {
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&layout);
+    }
+}
+
+static void drop_all_layouts(anjay_dm_resource_layout_cache_t *cache) {
+    AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout;
+    while ((layout = AVS_SORTED_SET_FIRST(cache->instances))) {
+        drop_layout(cache, layout);
+    }
+}
+
+void _anjay_dm_layout_cache_cleanup(
+        AVS_LIST(anjay_dm_resource_layout_cache_t) *caches_ptr) {
+    AVS_LIST_CLEAR(caches_ptr) {
+        drop_all_layouts(*caches_ptr);
+        AVS_SORTED_SET_DELETE(&(*caches_ptr)->instances);
+    }
+}
+
+void _anjay_dm_layout_cache_invalidate(anjay_unlocked_t *anjay,
+                                       anjay_oid_t oid,
+                                       anjay_iid_t iid) {
+    anjay_dm_resource_layout_cache_t *cache = find_cache(anjay, oid);
+    if (!cache) {
+        return;
+    }
+    ++cache->generation;
+    if (iid == ANJAY_ID_INVALID) {
+        drop_all_layouts(cache);
+    } else {
+        AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout =
+                find_layout(cache, iid);
+        if (layout) {
+            drop_layout(cache, layout);
+        }
+    }
+}
+
+void _anjay_dm_layout_cache_disable(anjay_unlocked_t *anjay, anjay_oid_t oid) {
+    AVS_LIST(anjay_dm_resource_layout_cache_t) *cache_ptr =
+            find_cache_ptr(anjay, oid);
+    if (*cache_ptr && (*cache_ptr)->oid == oid) {
+        drop_all_layouts(*cache_ptr);
+        AVS_SORTED_SET_DELETE(&(*cache_ptr)->instances);
+        AVS_LIST_DELETE(cache_ptr);
+    }
+}
+
+static int enable_cache(anjay_unlocked_t *anjay, anjay_oid_t oid) {
+    AVS_LIST(anjay_dm_resource_layout_cache_t) *cache_ptr =
+            find_cache_ptr(anjay, oid);
+    if (*cache_ptr && (*cache_ptr)->oid == oid) {
+        return 0;
+    }
+    AVS_LIST(anjay_dm_resource_layout_cache_t) new_cache =
+            AVS_LIST_NEW_ELEMENT(anjay_dm_resource_layout_cache_t);
+    if (!new_cache
+            || !(new_cache->instances =
+                         AVS_SORTED_SET_NEW(anjay_dm_cached_instance_layout_t,
+                                            layout_cmp))) {
+        dm_log(ERROR, _("out of memory"));
+        AVS_LIST_CLEAR(&new_cache);
+        return -1;
+    }
+    new_cache->oid = oid;
+    AVS_LIST_INSERT(cache_ptr, new_cache);
+    return 0;
+}
+
+static bool in_transaction(anjay_unlocked_t *anjay,
+                           const anjay_dm_installed_object_t *obj) {
+    if (!anjay->transaction_state.depth) {
+        return false;
+    }
+    AVS_LIST(const anjay_dm_installed_object_t *) it;
+    AVS_LIST_FOREACH(it, anjay->transaction_state.objs_in_transaction) {
+        if (*it >= obj) {
+            return *it == obj;
+        }
+    }
+    return false;
+}
+
+typedef struct {
+    AVS_LIST(anjay_dm_cached_resource_t) resources;
+    AVS_LIST(anjay_dm_cached_resource_t) *append_ptr;
+    size_t count;
+} collect_resources_args_t;
+
+static int collect_resources_clb(anjay_unlocked_t *anjay,
+                                 const anjay_dm_installed_object_t *obj,
+                                 anjay_iid_t iid,
+                                 anjay_rid_t rid,
+                                 anjay_dm_resource_kind_t kind,
+                                 anjay_dm_resource_presence_t presence,
+                                 void *args_) {
+    (void) anjay;
+    (void) obj;
+    (void) iid;
+    collect_resources_args_t *args = (collect_resources_args_t *) args_;
+    AVS_LIST(anjay_dm_cached_resource_t) entry =
+            AVS_LIST_NEW_ELEMENT(anjay_dm_cached_resource_t);
+    if (!entry) {
+        dm_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    entry->rid = rid;
+    entry->kind = kind;
+    entry->presence = presence;
+    AVS_LIST_INSERT(args->append_ptr, entry);
+    AVS_LIST_ADVANCE_PTR(&args->append_ptr);
+    ++args->count;
+    return 0;
+}
+
+static AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t)
+create_layout(anjay_iid_t iid, const collect_resources_args_t *args) {
+    AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout =
+            (AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t))
+                    AVS_SORTED_SET_ELEM_NEW_BUFFER(
+                            offsetof(anjay_dm_cached_instance_layout_t,
+                                     resources)
+                            + args->count
+                                      * sizeof(anjay_dm_cached_resource_t));
+    if (!layout) {
+        dm_log(ERROR, _("out of memory"));
+        return NULL;
+    }
+    layout->iid = iid;
+    layout->refcount = 0;
+    layout->detached = false;
+    layout->resources_count = args->count;
+    size_t i = 0;
+    AVS_LIST(anjay_dm_cached_resource_t) it;
+    AVS_LIST_FOREACH(it, args->resources) {
+        layout->resources[i++] = *it;
+    }
+    assert(i == args->count);
+    return layout;
+}
+
+static int populate_layout(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj,
+        anjay_iid_t iid,
+        unsigned generation,
+        AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) *out_layout) {
+    collect_resources_args_t args = {
+        .resources = NULL,
+        .count = 0
+    };
+    args.append_ptr = &args.resources;
+    int result = _anjay_dm_foreach_resource_uncached(
+            anjay, obj, iid, collect_resources_clb, &args);
+    if (result) {
+        AVS_LIST_CLEAR(&args.resources);
+        return result;
+    }
+
+    // The object might have been unlocked while calling list_resources, so
+    // anything could have changed in the meantime
+    anjay_dm_resource_layout_cache_t *cache =
+            find_cache(anjay, _anjay_dm_installed_object_oid(obj));
+    if (cache && cache->generation == generation
+            && (*out_layout = find_layout(cache, iid))) {
+        AVS_LIST_CLEAR(&args.resources);
+        return 0;
+    }
+    if ((*out_layout = create_layout(iid, &args))) {
+        if (cache && cache->generation == generation) {
+            AVS_SORTED_SET_INSERT(cache->instances, *out_layout);
+        } else {
+            // The cache has been invalidated in the meantime, so the result
+            // cannot be stored - but it is still the one the caller asked for.
+            // It will be freed when released.
+            (*out_layout)->detached = true;
+        }
+    }
+    AVS_LIST_CLEAR(&args.resources);
+    return 0;
+}
+
+int _anjay_dm_layout_cache_acquire(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj,
+        anjay_iid_t iid,
+        bool populate,
+        anjay_dm_cached_instance_layout_t **out_layout) {
+    *out_layout = NULL;
+    anjay_dm_resource_layout_cache_t *cache =
+            find_cache(anjay, _anjay_dm_installed_object_oid(obj));
+    if (!cache || in_transaction(anjay, obj)) {
+        return 0;
+    }
+    AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout =
+            find_layout(cache, iid);
+    if (!layout && populate) {
+        int result =
+                populate_layout(anjay, obj, iid, cache->generation, &layout);
+        if (result) {
+            return result;
+        }
+    }
+    if (layout) {
+        ++layout->refcount;
+        *out_layout = layout;
+    }
+    return 0;
+}
+
+void _anjay_dm_layout_cache_release(
+        anjay_dm_cached_instance_layout_t **layout_ptr) {
+    if (!*layout_ptr) {
+        return;
+    }
+    assert((*layout_ptr)->refcount);
+    if (!--(*layout_ptr)->refcount && (*layout_ptr)->detached) {
+        AVS_SORTED_SET_ELEM(anjay_dm_cached_instance_layout_t) layout =
+                *layout_ptr;
+        AVS_SORTED_SET_ELEM_DELETE_DETACHED(&layout);
+    }
+    *layout_ptr = NULL;
+}
+
+const anjay_dm_cached_resource_t *
+_anjay_dm_cached_layout_find_resource(
+        const anjay_dm_cached_instance_layout_t *layout, anjay_rid_t rid) {
+    size_t lo = 0;
+    size_t hi = layout->resources_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (layout->resources[mid].rid < rid) {
+            lo = mid + 1;
+        } else if (layout->resources[mid].rid > rid) {
+            hi = mid;
+        } else {
+            return &layout->resources[mid];
+        }
+    }
+    return NULL;
+}
+
+int anjay_set_resource_layout_caching(anjay_t *anjay_locked,
+                                      anjay_oid_t oid,
+                                      bool enabled) {
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    if (!_anjay_dm_find_object_by_oid(anjay, oid)) {
+        dm_log(ERROR, _("object ") "%" PRIu16 _(" is not currently registered"),
+               oid);
+    } else if (enabled) {
+        result = enable_cache(anjay, oid);
+    } else {
+        _anjay_dm_layout_cache_disable(anjay, oid);
+        result = 0;
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
+
+int anjay_notify_resources_layout_changed(anjay_t *anjay_locked,
+                                          anjay_oid_t oid,
+                                          anjay_iid_t iid) {
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    _anjay_dm_layout_cache_invalidate(anjay, oid, iid);
+    result = 0;
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+    return result;
+}
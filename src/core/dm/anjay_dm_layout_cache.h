@@ -0,0 +1,108 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_DM_LAYOUT_CACHE_H
+#define ANJAY_DM_LAYOUT_CACHE_H
+
+#include <avsystem/commons/avs_list.h>
+#include <avsystem/commons/avs_sorted_set.h>
+
+#include <anjay_modules/anjay_dm_utils.h>
+
+VISIBILITY_PRIVATE_HEADER_BEGIN
+
+typedef struct {
+    anjay_rid_t rid;
+    anjay_dm_resource_kind_t kind;
+    anjay_dm_resource_presence_t presence;
+} anjay_dm_cached_resource_t;
+
+/**
+ * Result of a single list_resources call, as stored in the layout cache.
+ * Entries are immutable once inserted; if an entry is invalidated while being
+ * iterated over (see @ref _anjay_dm_layout_cache_acquire), it is detached from
+ * the cache and freed only after the last reference is released.
+ */
+typedef struct {
+    anjay_iid_t iid;
+    unsigned refcount;
+    bool detached;
+    size_t resources_count;
+    /** Sorted by Resource ID. */
+    anjay_dm_cached_resource_t resources[];
+} anjay_dm_cached_instance_layout_t;
+
+typedef struct {
+    anjay_oid_t oid;
+    /**
+     * Incremented on every invalidation; used to detect changes that happened
+     * while populating an entry with the object unlocked.
+     */
+    unsigned generation;
+    AVS_SORTED_SET(anjay_dm_cached_instance_layout_t) instances;
+} anjay_dm_resource_layout_cache_t;
+
+void _anjay_dm_layout_cache_cleanup(
+        AVS_LIST(anjay_dm_resource_layout_cache_t) *caches_ptr);
+
+/**
+ * Drops cached layouts of Instance @p iid of Object @p oid, or of all its
+ * Instances if @p iid is @ref ANJAY_ID_INVALID. Does nothing if caching is not
+ * enabled for @p oid.
+ */
+void _anjay_dm_layout_cache_invalidate(anjay_unlocked_t *anjay,
+                                       anjay_oid_t oid,
+                                       anjay_iid_t iid);
+
+/**
+ * Disables caching for @p oid and frees all associated data, if any.
+ */
+void _anjay_dm_layout_cache_disable(anjay_unlocked_t *anjay, anjay_oid_t oid);
+
+/**
+ * Looks up the cached resource layout of a given Object Instance.
+ *
+ * @param populate If true and the layout is not cached yet, the list_resources
+ *                 handler is called to populate the cache.
+ *
+ * @param out_layout Set to the cached layout, or NULL if caching is not
+ *                   enabled for the object, the object is part of an ongoing
+ *                   transaction, or (if @p populate is false) the layout is
+ *                   not cached. In the latter case, the caller shall fall back
+ *                   to calling the handlers directly. If the cache is
+ *                   invalidated while it is being populated, the result of
+ *                   list_resources is returned as an entry already detached
+ *                   from the cache. On success, the returned entry is
+ *                   referenced and needs to be released using
+ *                   @ref _anjay_dm_layout_cache_release.
+ *
+ * @returns 0 on success, or the error code returned by list_resources.
+ */
+int _anjay_dm_layout_cache_acquire(
+        anjay_unlocked_t *anjay,
+        const anjay_dm_installed_object_t *obj,
+        anjay_iid_t iid,
+        bool populate,
+        anjay_dm_cached_instance_layout_t **out_layout);
+
+void _anjay_dm_layout_cache_release(
+        anjay_dm_cached_instance_layout_t **layout_ptr);
+
+/**
+ * Finds Resource @p rid in @p layout using binary search.
+ *
+ * @returns Pointer to the cached Resource entry, or NULL if not found.
+ */
+const anjay_dm_cached_resource_t *
+_anjay_dm_cached_layout_find_resource(
+        const anjay_dm_cached_instance_layout_t *layout, anjay_rid_t rid);
+
+VISIBILITY_PRIVATE_HEADER_END
+
+#endif // ANJAY_DM_LAYOUT_CACHE_H
@@ -179,24 +179,45 @@ static int read_instance_resource_clb(anjay_unlocked_t *anjay,
     return result;
 }
 
+static int read_instance_in_bulk(anjay_unlocked_t *anjay,
+                                 const anjay_dm_installed_object_t *obj,
+                                 const anjay_uri_path_t *instance_path,
+                                 anjay_unlocked_output_ctx_t *out_ctx) {
+    assert(!out_ctx->instance_read_path);
+    out_ctx->instance_read_path = instance_path;
+    out_ctx->instance_read_last_rid = -1;
+    out_ctx->instance_read_last_riid = -1;
+    int result = _anjay_dm_call_instance_read(
+            anjay, obj, instance_path->ids[ANJAY_ID_IID], out_ctx);
+    out_ctx->instance_read_path = NULL;
+    return result;
+}
+
 static int read_instance(anjay_unlocked_t *anjay,
                          const anjay_dm_installed_object_t *obj,
                          anjay_iid_t iid,
                          anjay_ssid_t requesting_ssid,
                          anjay_unlocked_output_ctx_t *out_ctx) {
+    const anjay_uri_path_t instance_path =
+            MAKE_INSTANCE_PATH(_anjay_dm_installed_object_oid(obj), iid);
     int result;
-    (void) ((result = _anjay_output_set_path(
-                     out_ctx,
-                     &MAKE_INSTANCE_PATH(_anjay_dm_installed_object_oid(obj),
-                                         iid)))
-            || (result = _anjay_output_start_aggregate(out_ctx))
-            || (result = _anjay_dm_foreach_resource(
-                        anjay, obj, iid, read_instance_resource_clb,
-                        &(read_instance_resource_clb_args_t) {
-                            .out_ctx = out_ctx,
-                            .requesting_ssid = requesting_ssid
-                        })));
-    return result;
+    if ((result = _anjay_output_set_path(out_ctx, &instance_path))
+            || (result = _anjay_output_start_aggregate(out_ctx))) {
+        return result;
+    }
+    // Bootstrap Server may also read non-readable Resources, so the
+    // per-Resource logic is always used for it
+    if (requesting_ssid != ANJAY_SSID_BOOTSTRAP
+            && _anjay_dm_handler_implemented(obj,
+                                             ANJAY_DM_HANDLER_instance_read)) {
+        return read_instance_in_bulk(anjay, obj, &instance_path, out_ctx);
+    }
+    return _anjay_dm_foreach_resource(
+            anjay, obj, iid, read_instance_resource_clb,
+            &(read_instance_resource_clb_args_t) {
+                .out_ctx = out_ctx,
+                .requesting_ssid = requesting_ssid
+            });
 }
 
 typedef struct {
@@ -245,6 +245,9 @@ int _anjay_dm_write_attributes(anjay_unlocked_t *anjay,
     }
 #ifdef ANJAY_WITH_OBSERVE
     if (!result) {
+        // attributes may come from the Object's own handlers, which do not
+        // invalidate the cache by themselves
+        _anjay_observe_invalidate_attrs_cache(&anjay->observe);
         // verify that new attributes are "seen" by the observe code
         result = _anjay_observe_notify(anjay, &request->uri, ssid, false);
     }
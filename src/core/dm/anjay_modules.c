@@ -69,3 +69,16 @@ void *_anjay_dm_module_get_arg(anjay_unlocked_t *anjay,
             _anjay_dm_module_find_ptr(anjay, module);
     return entry_ptr ? (*entry_ptr)->arg : NULL;
 }
+
+#ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_dm_modules_memory_usage(anjay_unlocked_t *anjay) {
+    size_t result = 0;
+    AVS_LIST(anjay_dm_installed_module_t) module;
+    AVS_LIST_FOREACH(module, anjay->dm.modules) {
+        if (module->def->memory_usage) {
+            result += module->def->memory_usage(module->arg);
+        }
+    }
+    return result;
+}
+#endif // ANJAY_WITH_MEMORY_STATS
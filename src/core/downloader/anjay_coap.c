@@ -118,8 +118,8 @@ static void cleanup_coap_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
          * of its internal fields.
          */
         if (!anjay->sched
-                || AVS_SCHED_NOW(anjay->sched, NULL, cleanup_coap_context,
-                                 &args, sizeof(args))) {
+                || ANJAY_SCHED_NOW(anjay->sched, NULL, cleanup_coap_context,
+                                   &args, sizeof(args))) {
             cleanup_coap_context_unlocked(NULL, args);
         }
     }
@@ -281,6 +281,13 @@ get_coap_socket_transport(anjay_download_ctx_t *ctx) {
     return ((anjay_coap_download_ctx_t *) ctx)->transport;
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+static size_t get_coap_memory_usage(anjay_download_ctx_t *ctx) {
+    (void) ctx;
+    return ANJAY_LIST_ELEMENT_MEMORY(sizeof(anjay_coap_download_ctx_t));
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 #    ifdef ANJAY_TEST
 #        include "tests/core/downloader/downloader_mock.h"
 #    endif // ANJAY_TEST
@@ -435,8 +442,8 @@ static void suspend_coap_transfer(anjay_download_ctx_t *ctx_) {
 
 static avs_error_t sched_download_resumption(anjay_coap_download_ctx_t *ctx) {
     anjay_unlocked_t *anjay = _anjay_downloader_get_anjay(ctx->common.dl);
-    if (AVS_SCHED_NOW(anjay->sched, &ctx->job_start, start_download_job,
-                      &ctx->common.id, sizeof(ctx->common.id))) {
+    if (ANJAY_SCHED_NOW(anjay->sched, &ctx->job_start, start_download_job,
+                        &ctx->common.id, sizeof(ctx->common.id))) {
         dl_log(WARNING,
                _("could not schedule resumption for download id "
                  "= ") "%" PRIuPTR,
@@ -536,7 +543,10 @@ _anjay_downloader_coap_ctx_new(anjay_downloader_t *dl,
         .cleanup = cleanup_coap_transfer,
         .suspend = suspend_coap_transfer,
         .reconnect = reconnect_coap_transfer,
-        .set_next_block_offset = set_next_coap_block_offset
+        .set_next_block_offset = set_next_coap_block_offset,
+#    ifdef ANJAY_WITH_MEMORY_STATS
+        .get_memory_usage = get_coap_memory_usage
+#    endif // ANJAY_WITH_MEMORY_STATS
     };
     ctx->common.vtable = &VTABLE;
 
@@ -678,8 +688,8 @@ _anjay_downloader_coap_ctx_new(anjay_downloader_t *dl,
         goto error;
     }
 
-    if (AVS_SCHED_NOW(anjay->sched, &ctx->job_start, start_download_job,
-                      &ctx->common.id, sizeof(ctx->common.id))) {
+    if (ANJAY_SCHED_NOW(anjay->sched, &ctx->job_start, start_download_job,
+                        &ctx->common.id, sizeof(ctx->common.id))) {
         dl_log(ERROR, _("could not schedule download job"));
         err = avs_errno(AVS_ENOMEM);
         goto error;
@@ -415,9 +415,9 @@ static void reconnect_job(avs_sched_t *sched, const void *id_ptr) {
 }
 
 static int schedule_reconnect(anjay_download_ctx_t *ctx) {
-    return AVS_SCHED_NOW(_anjay_downloader_get_anjay(ctx->common.dl)->sched,
-                         &ctx->common.reconnect_job_handle, reconnect_job,
-                         &ctx->common.id, sizeof(ctx->common.id));
+    return ANJAY_SCHED_NOW(_anjay_downloader_get_anjay(ctx->common.dl)->sched,
+                           &ctx->common.reconnect_job_handle, reconnect_job,
+                           &ctx->common.id, sizeof(ctx->common.id));
 }
 
 int _anjay_downloader_sched_reconnect(anjay_downloader_t *dl,
@@ -456,4 +456,16 @@ int _anjay_downloader_sync_online_transports(anjay_downloader_t *dl) {
     return result;
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_downloader_memory_usage(const anjay_downloader_t *dl) {
+    size_t result = 0;
+    AVS_LIST(anjay_download_ctx_t) ctx;
+    AVS_LIST_FOREACH(ctx, dl->downloads) {
+        assert(ctx->common.vtable);
+        result += ctx->common.vtable->get_memory_usage(ctx);
+    }
+    return result;
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 #endif // ANJAY_WITH_DOWNLOADER
@@ -106,6 +106,8 @@ static inline bool etag_matches(const anjay_etag_t *etag, const char *text) {
            && memcmp(etag->value, &text[1], etag->size) == 0;
 }
 
+static void timeout_job(avs_sched_t *sched, const void *id_ptr);
+
 static void
 handle_http_packet_with_locked_buffer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr,
                                       uint8_t *buffer) {
@@ -154,10 +156,18 @@ handle_http_packet_with_locked_buffer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr,
         }
         nonblock_read_ready = avs_stream_nonblock_read_ready(ctx->stream);
     } while (nonblock_read_ready);
-    int result = AVS_RESCHED_DELAYED(&ctx->next_action_job,
-                                     AVS_NET_SOCKET_DEFAULT_RECV_TIMEOUT);
-    assert(!result);
-    (void) result;
+    if (ANJAY_RESCHED_AT(&ctx->next_action_job,
+                         avs_time_monotonic_add(
+                                 avs_time_monotonic_now(),
+                                 AVS_NET_SOCKET_DEFAULT_RECV_TIMEOUT))
+            && ANJAY_SCHED_DELAYED(anjay->sched, &ctx->next_action_job,
+                                   AVS_NET_SOCKET_DEFAULT_RECV_TIMEOUT,
+                                   timeout_job, &ctx->common.id,
+                                   sizeof(ctx->common.id))) {
+        dl_log(ERROR, _("could not schedule timeout job"));
+        _anjay_downloader_abort_transfer(
+                ctx_ptr, _anjay_download_status_failed(avs_errno(AVS_ENOMEM)));
+    }
 }
 
 static void handle_http_packet(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
@@ -297,9 +307,9 @@ static void send_request_unlocked(anjay_unlocked_t *anjay, uintptr_t id) {
     }
     avs_http_set_header_storage(ctx->stream, NULL);
 
-    if (AVS_SCHED_DELAYED(anjay->sched, &ctx->next_action_job,
-                          AVS_NET_SOCKET_DEFAULT_RECV_TIMEOUT, timeout_job,
-                          &ctx->common.id, sizeof(ctx->common.id))) {
+    if (ANJAY_SCHED_DELAYED(anjay->sched, &ctx->next_action_job,
+                            AVS_NET_SOCKET_DEFAULT_RECV_TIMEOUT, timeout_job,
+                            &ctx->common.id, sizeof(ctx->common.id))) {
         dl_log(ERROR, _("could not schedule timeout job"));
         _anjay_downloader_abort_transfer(
                 ctx_ptr, _anjay_download_status_failed(avs_errno(AVS_ENOMEM)));
@@ -342,6 +352,18 @@ get_http_socket_transport(anjay_download_ctx_t *ctx) {
     return ANJAY_SOCKET_TRANSPORT_TCP;
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+static size_t get_http_memory_usage(anjay_download_ctx_t *ctx) {
+    const anjay_http_download_ctx_t *http_ctx =
+            (const anjay_http_download_ctx_t *) ctx;
+    size_t result = ANJAY_LIST_ELEMENT_MEMORY(sizeof(*http_ctx));
+    if (http_ctx->etag) {
+        result += offsetof(anjay_etag_t, value) + http_ctx->etag->size;
+    }
+    return result;
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 static void
 cleanup_http_stream_unlocked(AVS_LIST(anjay_download_ctx_t) detached_ctx) {
     anjay_http_download_ctx_t *ctx = (anjay_http_download_ctx_t *) detached_ctx;
@@ -377,8 +399,8 @@ static void cleanup_http_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
      * socket's file descriptor.
      */
     if (!anjay->sched
-            || AVS_SCHED_NOW(anjay->sched, NULL, cleanup_http_stream,
-                             &detached_ctx, sizeof(detached_ctx))) {
+            || ANJAY_SCHED_NOW(anjay->sched, NULL, cleanup_http_stream,
+                               &detached_ctx, sizeof(detached_ctx))) {
         cleanup_http_stream_unlocked(detached_ctx);
     }
 }
@@ -394,8 +416,8 @@ reconnect_http_transfer(AVS_LIST(anjay_download_ctx_t) *ctx_ptr) {
     anjay_http_download_ctx_t *ctx = (anjay_http_download_ctx_t *) *ctx_ptr;
     avs_stream_cleanup(&ctx->stream);
     anjay_unlocked_t *anjay = _anjay_downloader_get_anjay(ctx->common.dl);
-    if (AVS_SCHED_NOW(anjay->sched, &ctx->next_action_job, send_request,
-                      &ctx->common.id, sizeof(ctx->common.id))) {
+    if (ANJAY_SCHED_NOW(anjay->sched, &ctx->next_action_job, send_request,
+                        &ctx->common.id, sizeof(ctx->common.id))) {
         dl_log(ERROR, _("could not schedule download job"));
         return avs_errno(AVS_ENOMEM);
     }
@@ -554,7 +576,10 @@ _anjay_downloader_http_ctx_new(anjay_downloader_t *dl,
         .cleanup = cleanup_http_transfer,
         .suspend = suspend_http_transfer,
         .reconnect = reconnect_http_transfer,
-        .set_next_block_offset = set_next_http_block_offset
+        .set_next_block_offset = set_next_http_block_offset,
+#    ifdef ANJAY_WITH_MEMORY_STATS
+        .get_memory_usage = get_http_memory_usage
+#    endif // ANJAY_WITH_MEMORY_STATS
     };
     ctx->common.vtable = &VTABLE;
 
@@ -620,9 +645,9 @@ _anjay_downloader_http_ctx_new(anjay_downloader_t *dl,
         }
     }
 
-    if (AVS_SCHED_NOW(_anjay_downloader_get_anjay(dl)->sched,
-                      &ctx->next_action_job, send_request, &ctx->common.id,
-                      sizeof(ctx->common.id))) {
+    if (ANJAY_SCHED_NOW(_anjay_downloader_get_anjay(dl)->sched,
+                        &ctx->next_action_job, send_request, &ctx->common.id,
+                        sizeof(ctx->common.id))) {
         dl_log(ERROR, _("could not schedule download job"));
         err = avs_errno(AVS_ENOMEM);
         goto error;
@@ -30,6 +30,9 @@ typedef struct {
     avs_error_t (*reconnect)(AVS_LIST(anjay_download_ctx_t) *ctx_ptr);
     avs_error_t (*set_next_block_offset)(anjay_download_ctx_t *ctx,
                                          size_t next_block_offset);
+#ifdef ANJAY_WITH_MEMORY_STATS
+    size_t (*get_memory_usage)(anjay_download_ctx_t *ctx);
+#endif // ANJAY_WITH_MEMORY_STATS
 } anjay_download_ctx_vtable_t;
 
 typedef struct {
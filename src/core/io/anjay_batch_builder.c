@@ -50,6 +50,13 @@ typedef struct {
         struct {
             const void *data;
             size_t length;
+            /**
+             * NULL if data is owned by the batch and shall be freed using
+             * avs_free(); otherwise, data is a reference passed using
+             * anjay_ret_bytes_ref() and this callback releases it.
+             */
+            anjay_ret_bytes_ref_release_t *release;
+            void *release_arg;
         } bytes;
         const char *string;
         int64_t int_value;
@@ -130,7 +137,11 @@ static void batch_data_cleanup(anjay_batch_data_t *data) {
     if (data->type == ANJAY_BATCH_DATA_STRING) {
         avs_free((void *) (intptr_t) data->value.string);
     } else if (data->type == ANJAY_BATCH_DATA_BYTES) {
-        avs_free((void *) (intptr_t) data->value.bytes.data);
+        if (data->value.bytes.release) {
+            data->value.bytes.release(data->value.bytes.release_arg);
+        } else {
+            avs_free((void *) (intptr_t) data->value.bytes.data);
+        }
     }
 }
 
@@ -463,6 +474,43 @@ static int bytes_begin(anjay_unlocked_output_ctx_t *ctx_,
     return 0;
 }
 
+static void static_bytes_release(void *arg) {
+    (void) arg;
+}
+
+static int bytes_ref(anjay_unlocked_output_ctx_t *ctx_,
+                     const void *data,
+                     size_t length,
+                     anjay_ret_bytes_ref_release_t *release,
+                     void *release_arg) {
+    builder_out_ctx_t *ctx = (builder_out_ctx_t *) ctx_;
+    if (ctx->bytes.remaining_bytes) {
+        batch_log(ERROR, _("bytes already being returned"));
+    } else if (_anjay_uri_path_has(&ctx->path, ANJAY_ID_RID)
+               && (data || !length)) {
+        anjay_batch_data_t batch_data = {
+            .type = ANJAY_BATCH_DATA_BYTES,
+            .value.bytes = {
+                .data = data,
+                .length = length,
+                .release = release ? release : static_bytes_release,
+                .release_arg = release_arg
+            }
+        };
+        // batch_data_add() releases the reference itself on failure
+        int result = batch_data_add(ctx->builder, &ctx->path, ctx->timestamp,
+                                    batch_data);
+        if (!result) {
+            value_returned(ctx);
+        }
+        return result;
+    }
+    if (release) {
+        release(release_arg);
+    }
+    return -1;
+}
+
 static int ret_string(anjay_unlocked_output_ctx_t *ctx_, const char *str) {
     builder_out_ctx_t *ctx = (builder_out_ctx_t *) ctx_;
     int result = -1;
@@ -592,6 +640,7 @@ static int output_close(anjay_unlocked_output_ctx_t *ctx_) {
 
 static const anjay_output_ctx_vtable_t BUILDER_OUT_VTABLE = {
     .bytes_begin = bytes_begin,
+    .bytes_ref = bytes_ref,
     .string = ret_string,
     .integer = ret_integer,
 #    ifdef ANJAY_WITH_LWM2M11
@@ -904,6 +953,24 @@ avs_time_real_t _anjay_batch_get_compilation_time(const anjay_batch_t *batch) {
     return batch->compilation_time;
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_batch_memory_usage(const anjay_batch_t *batch) {
+    size_t result = sizeof(*batch);
+    AVS_LIST(anjay_batch_entry_t) entry;
+    AVS_LIST_FOREACH(entry, batch->list) {
+        result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*entry));
+        if (entry->data.type == ANJAY_BATCH_DATA_STRING) {
+            result += strlen(entry->data.value.string) + 1;
+        } else if (entry->data.type == ANJAY_BATCH_DATA_BYTES
+                   && !entry->data.value.bytes.release) {
+            // referenced data is owned by the user, so it is not counted
+            result += entry->data.value.bytes.length;
+        }
+    }
+    return result;
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 #    ifdef ANJAY_TEST
 #        include "tests/core/io/batch_builder.c"
 #        ifdef ANJAY_WITH_LWM2M11
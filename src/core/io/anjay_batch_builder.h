@@ -264,6 +264,15 @@ int _anjay_batch_data_boolean_value(const anjay_batch_t *batch,
  */
 avs_time_real_t _anjay_batch_get_compilation_time(const anjay_batch_t *batch);
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+/**
+ * Returns the estimated heap usage of the batch, including all its entries and
+ * the string and bytes values they hold. Batches shared between multiple
+ * holders are accounted for by each of them.
+ */
+size_t _anjay_batch_memory_usage(const anjay_batch_t *batch);
+#endif // ANJAY_WITH_MEMORY_STATS
+
 #ifdef ANJAY_WITH_LWM2M11
 void _anjay_batch_update_common_path_prefix(const anjay_uri_path_t **prefix_ptr,
                                             anjay_uri_path_t *prefix_buf,
@@ -44,6 +44,7 @@ typedef struct {
 
     bool is_bytes_ctx;
     anjay_io_cbor_bytes_ctx_t bytes_ctx;
+    void *view_chunk;
 } cbor_in_t;
 
 static int cbor_get_some_bytes(anjay_unlocked_input_ctx_t *ctx_,
@@ -84,6 +85,16 @@ static int cbor_get_some_bytes(anjay_unlocked_input_ctx_t *ctx_,
     return 0;
 }
 
+static int cbor_get_bytes_view(anjay_unlocked_input_ctx_t *ctx,
+                               const void **out_data,
+                               size_t *out_length,
+                               bool *out_msg_finished) {
+    return _anjay_input_bytes_view_chunked(ctx,
+                                           &((cbor_in_t *) ctx)->view_chunk,
+                                           out_data, out_length,
+                                           out_msg_finished);
+}
+
 static int cbor_get_string(anjay_unlocked_input_ctx_t *ctx_,
                            char *out_buf,
                            size_t buf_size) {
@@ -314,6 +325,7 @@ static int cbor_get_objlnk(anjay_unlocked_input_ctx_t *ctx_,
 static int cbor_in_close(anjay_unlocked_input_ctx_t *ctx_) {
     cbor_in_t *ctx = (cbor_in_t *) ctx_;
     _anjay_json_like_decoder_delete(&ctx->cbor_decoder);
+    avs_free(ctx->view_chunk);
     return 0;
 }
 
@@ -339,6 +351,7 @@ static int cbor_next_entry(anjay_unlocked_input_ctx_t *ctx) {
 
 static const anjay_input_ctx_vtable_t CBOR_IN_VTABLE = {
     .some_bytes = cbor_get_some_bytes,
+    .bytes_view = cbor_get_bytes_view,
     .string = cbor_get_string,
     .integer = cbor_get_integer,
     .uint = cbor_get_uint,
@@ -118,6 +118,7 @@ typedef struct {
     const anjay_input_ctx_vtable_t *vtable;
     avs_stream_t *stream;
     bool msg_finished;
+    void *view_chunk;
 
     anjay_uri_path_t request_uri;
 } opaque_in_t;
@@ -134,8 +135,18 @@ static int opaque_get_some_bytes(anjay_unlocked_input_ctx_t *ctx,
     return avs_is_ok(err) ? 0 : -1;
 }
 
+static int opaque_get_bytes_view(anjay_unlocked_input_ctx_t *ctx,
+                                 const void **out_data,
+                                 size_t *out_length,
+                                 bool *out_message_finished) {
+    return _anjay_input_bytes_view_chunked(ctx,
+                                           &((opaque_in_t *) ctx)->view_chunk,
+                                           out_data, out_length,
+                                           out_message_finished);
+}
+
 static int opaque_in_close(anjay_unlocked_input_ctx_t *ctx_) {
-    (void) ctx_;
+    avs_free(((opaque_in_t *) ctx_)->view_chunk);
     return 0;
 }
 
@@ -165,6 +176,7 @@ static int bad_request() {
 
 static const anjay_input_ctx_vtable_t OPAQUE_IN_VTABLE = {
     .some_bytes = opaque_get_some_bytes,
+    .bytes_view = opaque_get_bytes_view,
     .close = opaque_in_close,
     .string = (anjay_input_ctx_string_t) bad_request,
     .integer = (anjay_input_ctx_integer_t) bad_request,
@@ -170,6 +170,28 @@ static int senml_get_some_bytes(anjay_unlocked_input_ctx_t *ctx,
     return retval;
 }
 
+static int senml_get_bytes_view(anjay_unlocked_input_ctx_t *ctx,
+                                const void **out_data,
+                                size_t *out_length,
+                                bool *out_message_finished) {
+    senml_in_t *in = (senml_in_t *) ctx;
+    if (!can_return_value(in)) {
+        return -1;
+    }
+    if (in->entry->type != ANJAY_JSON_LIKE_VALUE_BYTE_STRING) {
+        return ANJAY_ERR_BAD_REQUEST;
+    }
+    /* the whole value is already cached, so return all of it at once */
+    *out_data = &((const uint8_t *) in->entry->value.bytes
+                          .data)[in->entry->value.bytes.bytes_read];
+    *out_length =
+            in->entry->value.bytes.size - in->entry->value.bytes.bytes_read;
+    in->entry->value.bytes.bytes_read = in->entry->value.bytes.size;
+    *out_message_finished = true;
+    in->value_read = true;
+    return 0;
+}
+
 static int senml_get_string(anjay_unlocked_input_ctx_t *ctx,
                             char *out_buf,
                             size_t buf_size) {
@@ -552,6 +574,7 @@ static int senml_close(anjay_unlocked_input_ctx_t *ctx) {
 
 static const anjay_input_ctx_vtable_t SENML_IN_VTABLE = {
     .some_bytes = senml_get_some_bytes,
+    .bytes_view = senml_get_bytes_view,
     .string = senml_get_string,
     .integer = senml_get_integer,
     .uint = senml_get_uint,
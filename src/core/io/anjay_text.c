@@ -211,6 +211,7 @@ typedef struct {
     uint8_t bytes_cached[3];
     size_t num_bytes_cached;
     bool msg_finished;
+    void *view_chunk;
 
     anjay_uri_path_t request_uri;
 } text_in_t;
@@ -400,8 +401,18 @@ static int text_get_objlnk(anjay_unlocked_input_ctx_t *ctx,
     return 0;
 }
 
+static int text_get_bytes_view(anjay_unlocked_input_ctx_t *ctx,
+                               const void **out_data,
+                               size_t *out_length,
+                               bool *out_message_finished) {
+    return _anjay_input_bytes_view_chunked(ctx,
+                                           &((text_in_t *) ctx)->view_chunk,
+                                           out_data, out_length,
+                                           out_message_finished);
+}
+
 static int text_in_close(anjay_unlocked_input_ctx_t *ctx_) {
-    (void) ctx_;
+    avs_free(((text_in_t *) ctx_)->view_chunk);
     return 0;
 }
 
@@ -427,6 +438,7 @@ static int text_next_entry(anjay_unlocked_input_ctx_t *ctx) {
 
 static const anjay_input_ctx_vtable_t TEXT_IN_VTABLE = {
     .some_bytes = text_get_some_bytes,
+    .bytes_view = text_get_bytes_view,
     .string = text_get_string,
     .integer = text_get_integer,
 #    ifdef ANJAY_WITH_LWM2M11
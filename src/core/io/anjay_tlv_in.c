@@ -45,6 +45,7 @@ typedef struct {
 
     AVS_LIST(tlv_entry_t) entries;
     bool finished;
+    void *view_chunk;
 } tlv_in_t;
 
 static tlv_entry_t *tlv_entry_push(tlv_in_t *ctx) {
@@ -93,6 +94,16 @@ static int tlv_get_some_bytes(anjay_unlocked_input_ctx_t *ctx_,
     return 0;
 }
 
+static int tlv_get_bytes_view(anjay_unlocked_input_ctx_t *ctx,
+                              const void **out_data,
+                              size_t *out_length,
+                              bool *out_message_finished) {
+    return _anjay_input_bytes_view_chunked(ctx,
+                                           &((tlv_in_t *) ctx)->view_chunk,
+                                           out_data, out_length,
+                                           out_message_finished);
+}
+
 static int tlv_read_to_end(anjay_unlocked_input_ctx_t *ctx,
                            size_t *out_bytes_read,
                            void *out_buf,
@@ -430,11 +441,13 @@ static int tlv_in_close(anjay_unlocked_input_ctx_t *ctx_) {
         LOG(DEBUG, _("input context is destroyed but not fully processed yet"));
     }
     AVS_LIST_CLEAR(&ctx->entries);
+    avs_free(ctx->view_chunk);
     return 0;
 }
 
 static const anjay_input_ctx_vtable_t TLV_IN_VTABLE = {
     .some_bytes = tlv_get_some_bytes,
+    .bytes_view = tlv_get_bytes_view,
     .string = tlv_get_string,
     .integer = tlv_get_integer,
 #    ifdef ANJAY_WITH_LWM2M11
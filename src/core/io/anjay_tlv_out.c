@@ -36,6 +36,14 @@ typedef struct {
 typedef struct {
     size_t data_length;
     tlv_id_t id;
+    /**
+     * Points either to the data buffer below, or to data referenced using
+     * anjay_ret_bytes_ref(), in which case release is called (if not NULL)
+     * when the entry is no longer needed.
+     */
+    const void *data_ptr;
+    anjay_ret_bytes_ref_release_t *release;
+    void *release_arg;
     char data[];
 } tlv_entry_t;
 
@@ -183,20 +191,35 @@ static int write_entry(avs_stream_t *stream,
     return 0;
 }
 
-static char *
-add_buffered_entry(tlv_out_t *ctx, tlv_id_type_t type, size_t length) {
-    tlv_entry_t *new_entry =
-            (tlv_entry_t *) AVS_LIST_NEW_BUFFER(sizeof(tlv_entry_t) + length);
+static void release_entry(tlv_entry_t *entry) {
+    if (entry->release) {
+        entry->release(entry->release_arg);
+    }
+}
+
+static tlv_entry_t *append_entry(tlv_out_t *ctx,
+                                 tlv_id_type_t type,
+                                 size_t length,
+                                 size_t buffer_size) {
+    tlv_entry_t *new_entry = (tlv_entry_t *) AVS_LIST_NEW_BUFFER(
+            sizeof(tlv_entry_t) + buffer_size);
     if (!new_entry) {
         return NULL;
     }
     new_entry->data_length = length;
     new_entry->id.type = type;
     new_entry->id.id = current_level(ctx)->next_id;
+    new_entry->data_ptr = new_entry->data;
     current_level(ctx)->next_id = ANJAY_ID_INVALID;
     *current_level(ctx)->next_entry_ptr = new_entry;
     AVS_LIST_ADVANCE_PTR(&current_level(ctx)->next_entry_ptr);
-    return new_entry->data;
+    return new_entry;
+}
+
+static char *
+add_buffered_entry(tlv_out_t *ctx, tlv_id_type_t type, size_t length) {
+    tlv_entry_t *new_entry = append_entry(ctx, type, length, length);
+    return new_entry ? new_entry->data : NULL;
 }
 
 static int streamed_bytes_append(anjay_unlocked_ret_bytes_ctx_t *ctx_,
@@ -280,6 +303,45 @@ add_entry(tlv_out_t *ctx, tlv_id_type_t type, size_t length) {
     return NULL;
 }
 
+/**
+ * Takes ownership of the reference, i.e. calls @p release regardless of the
+ * result. Nested entries are kept by reference until the enclosing entry is
+ * finished; top-level ones are streamed out immediately.
+ */
+static int add_referenced_entry(tlv_out_t *ctx,
+                                tlv_id_type_t type,
+                                const void *data,
+                                size_t length,
+                                anjay_ret_bytes_ref_release_t *release,
+                                void *release_arg) {
+    tlv_out_level_t *out_level = current_level(ctx);
+    tlv_out_level_id_t root_level;
+    int result = -1;
+    if (length <= TLV_MAX_LENGTH && !out_level->bytes_ctx.bytes_left
+            && !get_root_level(&ctx->root_path, &root_level)) {
+        if (ctx->level > root_level) {
+            tlv_entry_t *entry = append_entry(ctx, type, length, 0);
+            if (entry) {
+                entry->data_ptr = data;
+                entry->release = release;
+                entry->release_arg = release_arg;
+                return 0;
+            }
+        } else {
+            const tlv_id_t id = {
+                .type = type,
+                .id = out_level->next_id
+            };
+            out_level->next_id = ANJAY_ID_INVALID;
+            result = write_entry(ctx->stream, &id, data, length);
+        }
+    }
+    if (release) {
+        release(release_arg);
+    }
+    return result;
+}
+
 static int tlv_ret_bytes(anjay_unlocked_output_ctx_t *ctx_,
                          size_t length,
                          anjay_unlocked_ret_bytes_ctx_t **out_bytes_ctx) {
@@ -295,6 +357,24 @@ static int tlv_ret_bytes(anjay_unlocked_output_ctx_t *ctx_,
     return result;
 }
 
+static int tlv_ret_bytes_ref(anjay_unlocked_output_ctx_t *ctx_,
+                             const void *data,
+                             size_t length,
+                             anjay_ret_bytes_ref_release_t *release,
+                             void *release_arg) {
+    tlv_out_t *ctx = (tlv_out_t *) ctx_;
+    tlv_id_type_t current_level_value_type;
+    int result = get_current_level_value_type(ctx, &current_level_value_type);
+    if (result) {
+        if (release) {
+            release(release_arg);
+        }
+        return result;
+    }
+    return add_referenced_entry(ctx, current_level_value_type, data, length,
+                                release, release_arg);
+}
+
 static int tlv_ret_string(anjay_unlocked_output_ctx_t *ctx, const char *value) {
     return _anjay_ret_bytes_unlocked(ctx, value, strlen(value));
 }
@@ -369,6 +449,10 @@ static int tlv_ret_objlnk(anjay_unlocked_output_ctx_t *ctx,
 
 static void tlv_slave_start(tlv_out_t *ctx);
 
+static void release_buffer(void *buffer) {
+    avs_free(buffer);
+}
+
 static int tlv_slave_finish(tlv_out_t *ctx) {
     tlv_out_level_id_t root_level;
     if (get_root_level(&ctx->root_path, &root_level)
@@ -392,29 +476,32 @@ static int tlv_slave_finish(tlv_out_t *ctx) {
         if (!retval) {
             retval = write_entry((avs_stream_t *) &outbuf,
                                  &current_level(ctx)->entries->id,
-                                 current_level(ctx)->entries->data,
+                                 current_level(ctx)->entries->data_ptr,
                                  current_level(ctx)->entries->data_length);
         }
+        release_entry(current_level(ctx)->entries);
     }
     ctx->level = (tlv_out_level_id_t) (ctx->level - 1);
-    if (!retval) {
-        size_t length = avs_stream_outbuf_offset(&outbuf);
-        anjay_unlocked_ret_bytes_ctx_t *bytes = NULL;
-        switch (ctx->level) {
-        case TLV_OUT_LEVEL_RID:
-            bytes = add_entry(ctx, TLV_ID_RID_ARRAY, length);
-            break;
-        case TLV_OUT_LEVEL_IID:
-            bytes = add_entry(ctx, TLV_ID_IID, length);
-            break;
-        default:;
-        }
-        retval = !bytes ? -1
-                        : _anjay_ret_bytes_append_unlocked(bytes, buffer,
-                                                           length);
+    tlv_id_type_t type = TLV_ID_IID;
+    switch (ctx->level) {
+    case TLV_OUT_LEVEL_RID:
+        type = TLV_ID_RID_ARRAY;
+        break;
+    case TLV_OUT_LEVEL_IID:
+        type = TLV_ID_IID;
+        break;
+    default:
+        retval = -1;
     }
-    avs_free(buffer);
-    return retval;
+    if (retval) {
+        avs_free(buffer);
+        return retval;
+    }
+    // The serialized level is passed up by reference, so that it is not
+    // copied again if the parent level is also buffered
+    return add_referenced_entry(ctx, type, buffer,
+                                avs_stream_outbuf_offset(&outbuf),
+                                release_buffer, buffer);
 }
 
 static int tlv_start_aggregate(anjay_unlocked_output_ctx_t *ctx_) {
@@ -585,13 +672,16 @@ static int tlv_output_close(anjay_unlocked_output_ctx_t *ctx_) {
         }
     }
     for (uint8_t i = 0; i < AVS_ARRAY_SIZE(ctx->levels); ++i) {
-        AVS_LIST_CLEAR(&ctx->levels[i].entries);
+        AVS_LIST_CLEAR(&ctx->levels[i].entries) {
+            release_entry(ctx->levels[i].entries);
+        }
     }
     return result;
 }
 
 static const anjay_output_ctx_vtable_t TLV_OUT_VTABLE = {
     .bytes_begin = tlv_ret_bytes,
+    .bytes_ref = tlv_ret_bytes_ref,
     .string = tlv_ret_string,
     .integer = tlv_ret_i64,
 #    ifdef ANJAY_WITH_LWM2M11
@@ -27,6 +27,17 @@ typedef int (*anjay_output_ctx_bytes_begin_t)(
         anjay_unlocked_output_ctx_t *,
         size_t,
         anjay_unlocked_ret_bytes_ctx_t **);
+/**
+ * Optional; takes ownership of the reference, i.e. shall call @p release
+ * (if not NULL) exactly once, regardless of the result. If not implemented,
+ * the data is copied using bytes_begin and released immediately.
+ */
+typedef int (*anjay_output_ctx_bytes_ref_t)(
+        anjay_unlocked_output_ctx_t *,
+        const void *,
+        size_t,
+        anjay_ret_bytes_ref_release_t *release,
+        void *release_arg);
 typedef int (*anjay_output_ctx_string_t)(anjay_unlocked_output_ctx_t *,
                                          const char *);
 typedef int (*anjay_output_ctx_integer_t)(anjay_unlocked_output_ctx_t *,
@@ -57,6 +68,7 @@ typedef int (*anjay_output_ctx_close_t)(anjay_unlocked_output_ctx_t *);
 
 struct anjay_output_ctx_vtable_struct {
     anjay_output_ctx_bytes_begin_t bytes_begin;
+    anjay_output_ctx_bytes_ref_t bytes_ref;
     anjay_output_ctx_string_t string;
     anjay_output_ctx_integer_t integer;
 #ifdef ANJAY_WITH_LWM2M11
@@ -86,6 +98,15 @@ typedef struct {
 
 typedef int (*anjay_input_ctx_bytes_t)(
         anjay_unlocked_input_ctx_t *, size_t *, bool *, void *, size_t);
+/**
+ * Optional; sets the output pointer to the next chunk of the value, owned by
+ * the context and valid until the next call on the context. If not
+ * implemented, anjay_get_bytes_view() fails.
+ */
+typedef int (*anjay_input_ctx_bytes_view_t)(anjay_unlocked_input_ctx_t *,
+                                            const void **,
+                                            size_t *,
+                                            bool *);
 typedef int (*anjay_input_ctx_string_t)(anjay_unlocked_input_ctx_t *,
                                         char *,
                                         size_t);
@@ -111,6 +132,7 @@ typedef int (*anjay_input_ctx_update_root_path_t)(anjay_unlocked_input_ctx_t *,
 
 struct anjay_input_ctx_vtable_struct {
     anjay_input_ctx_bytes_t some_bytes;
+    anjay_input_ctx_bytes_view_t bytes_view;
     anjay_input_ctx_string_t string;
     anjay_input_ctx_integer_t integer;
 #ifdef ANJAY_WITH_LWM2M11
@@ -20,6 +20,7 @@
 
 #    include <anjay_modules/anjay_time_defs.h>
 
+#    include "../anjay_access_utils_private.h"
 #    include "../anjay_core.h"
 #    include "../anjay_io_core.h"
 #    include "../anjay_servers_utils.h"
@@ -73,6 +74,8 @@ void _anjay_observe_init(anjay_observe_state_t *observe,
                          size_t stored_notification_limit) {
     assert(!observe->connection_entries);
     observe->confirmable_notifications = confirmable_notifications;
+    // newly created path entries have cached_attrs_generation == 0
+    observe->attrs_cache_generation = 1;
 
     if (stored_notification_limit == 0) {
         observe->notify_queue_limit_mode = NOTIFY_QUEUE_UNLIMITED;
@@ -86,10 +89,68 @@ static inline bool is_error_value(const anjay_observation_value_t *value) {
     return _anjay_observe_is_error_details(&value->details);
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+#        define CONNECTION_MEMORY \
+            ANJAY_LIST_ELEMENT_MEMORY(sizeof(anjay_observe_connection_entry_t))
+#        define OBSERVATION_MEMORY(Observation)                    \
+            ANJAY_SORTED_SET_ELEMENT_MEMORY(                       \
+                    offsetof(anjay_observation_t, paths)           \
+                    + (Observation)->paths_count * sizeof(anjay_uri_path_t))
+#        define PATH_ENTRY_MEMORY \
+            ANJAY_SORTED_SET_ELEMENT_MEMORY(sizeof(anjay_observe_path_entry_t))
+#        define PATH_ENTRY_REF_MEMORY  \
+            ANJAY_LIST_ELEMENT_MEMORY( \
+                    sizeof(AVS_SORTED_SET_ELEM(anjay_observation_t)))
+#        define PATH_INDEX_ENTRY_MEMORY        \
+            ANJAY_SORTED_SET_ELEMENT_MEMORY(   \
+                    sizeof(anjay_observe_path_index_entry_t))
+#        define PATH_INDEX_REF_MEMORY \
+            ANJAY_LIST_ELEMENT_MEMORY(sizeof(anjay_observe_path_index_ref_t))
+#        define PUSHED_VALUE_MEMORY(Value)                 \
+            (ANJAY_SORTED_SET_ELEMENT_MEMORY(              \
+                     sizeof(anjay_observe_pushed_value_t)) \
+             + _anjay_batch_memory_usage(Value))
+#        define READ_CACHE_ENTRY_MEMORY(Value)                 \
+            (ANJAY_SORTED_SET_ELEMENT_MEMORY(                  \
+                     sizeof(anjay_observe_read_cache_entry_t)) \
+             + _anjay_batch_memory_usage(Value))
+
+static size_t value_memory_usage(const anjay_observation_value_t *value) {
+    const size_t values_count =
+            is_error_value(value) ? 0 : value->ref->paths_count;
+    size_t result = ANJAY_LIST_ELEMENT_MEMORY(
+            offsetof(anjay_observation_value_t, values)
+            + values_count * sizeof(anjay_batch_t *));
+    for (size_t i = 0; i < values_count; ++i) {
+        if (value->values[i]) {
+            result += _anjay_batch_memory_usage(value->values[i]);
+        }
+    }
+    return result;
+}
+
+static void memory_usage_add(anjay_observe_state_t *observe, size_t bytes) {
+    observe->memory_usage += bytes;
+}
+
+static void memory_usage_sub(anjay_observe_state_t *observe, size_t bytes) {
+    assert(observe->memory_usage >= bytes);
+    observe->memory_usage -= bytes;
+}
+#    else // ANJAY_WITH_MEMORY_STATS
+#        define memory_usage_add(Observe, Bytes) ((void) (Observe))
+#        define memory_usage_sub(Observe, Bytes) ((void) (Observe))
+#    endif // ANJAY_WITH_MEMORY_STATS
+
+static inline anjay_observe_state_t *
+conn_observe_state(anjay_observe_connection_entry_t *conn) {
+    return &_anjay_from_server(conn->conn_ref.server)->observe;
+}
+
 static void delete_value(anjay_unlocked_t *anjay,
                          AVS_LIST(anjay_observation_value_t) *value_ptr) {
-    (void) anjay;
     assert(value_ptr && *value_ptr);
+    memory_usage_sub(&anjay->observe, value_memory_usage(*value_ptr));
     if (!is_error_value(*value_ptr)) {
         for (size_t i = 0; i < (*value_ptr)->ref->paths_count; ++i) {
             if ((*value_ptr)->values[i]) {
@@ -105,6 +166,101 @@ path_entry_query(const anjay_uri_path_t *path) {
     return AVS_CONTAINER_OF(path, anjay_observe_path_entry_t, path);
 }
 
+static int path_index_entry_cmp(const void *left, const void *right) {
+    return _anjay_uri_path_compare(
+            &((const anjay_observe_path_index_entry_t *) left)->path,
+            &((const anjay_observe_path_index_entry_t *) right)->path);
+}
+
+static inline const anjay_observe_path_index_entry_t *
+path_index_query(const anjay_uri_path_t *path) {
+    return AVS_CONTAINER_OF(path, anjay_observe_path_index_entry_t, path);
+}
+
+static int
+add_to_path_index(anjay_observe_connection_entry_t *conn,
+                  AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry) {
+    anjay_observe_state_t *observe = conn_observe_state(conn);
+    if (!observe->path_index
+            && !(observe->path_index =
+                         AVS_SORTED_SET_NEW(anjay_observe_path_index_entry_t,
+                                            path_index_entry_cmp))) {
+        anjay_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) index_entry =
+            AVS_SORTED_SET_FIND(observe->path_index,
+                                path_index_query(&path_entry->path));
+    if (!index_entry) {
+        if (!(index_entry = AVS_SORTED_SET_ELEM_NEW(
+                      anjay_observe_path_index_entry_t))) {
+            anjay_log(ERROR, _("out of memory"));
+            return -1;
+        }
+        memcpy((void *) (intptr_t) (const void *) &index_entry->path,
+               &path_entry->path, sizeof(path_entry->path));
+        AVS_SORTED_SET_INSERT(observe->path_index, index_entry);
+        memory_usage_add(observe, PATH_INDEX_ENTRY_MEMORY);
+    }
+    AVS_LIST(anjay_observe_path_index_ref_t) *ref_ptr = &index_entry->refs;
+    while (*ref_ptr
+           && connection_ref_cmp(&(*ref_ptr)->connection->conn_ref,
+                                 &conn->conn_ref)
+                      < 0) {
+        AVS_LIST_ADVANCE_PTR(&ref_ptr);
+    }
+    if (!AVS_LIST_INSERT_NEW(anjay_observe_path_index_ref_t, ref_ptr)) {
+        anjay_log(ERROR, _("out of memory"));
+        if (!index_entry->refs) {
+            AVS_SORTED_SET_DELETE_ELEM(observe->path_index, &index_entry);
+            memory_usage_sub(observe, PATH_INDEX_ENTRY_MEMORY);
+        }
+        return -1;
+    }
+    (*ref_ptr)->connection = conn;
+    (*ref_ptr)->path_entry = path_entry;
+    memory_usage_add(observe, PATH_INDEX_REF_MEMORY);
+    return 0;
+}
+
+static void drop_pushed_value(anjay_observe_state_t *observe,
+                              const anjay_uri_path_t *path);
+
+static void remove_from_path_index(
+        anjay_observe_connection_entry_t *conn,
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry) {
+    anjay_observe_state_t *observe = conn_observe_state(conn);
+    assert(observe->path_index);
+    AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) index_entry =
+            AVS_SORTED_SET_FIND(observe->path_index,
+                                path_index_query(&path_entry->path));
+    assert(index_entry);
+    AVS_LIST(anjay_observe_path_index_ref_t) *ref_ptr;
+    AVS_LIST_FOREACH_PTR(ref_ptr, &index_entry->refs) {
+        if ((*ref_ptr)->path_entry == path_entry) {
+            AVS_LIST_DELETE(ref_ptr);
+            memory_usage_sub(observe, PATH_INDEX_REF_MEMORY);
+            if (!index_entry->refs) {
+                AVS_SORTED_SET_DELETE_ELEM(observe->path_index, &index_entry);
+                memory_usage_sub(observe, PATH_INDEX_ENTRY_MEMORY);
+                // pushed values are only used for paths observed exactly
+                drop_pushed_value(observe, &path_entry->path);
+            }
+            return;
+        }
+    }
+    AVS_UNREACHABLE("Path entry not attached to path index");
+}
+
+static void delete_observe_path_entry(
+        anjay_observe_connection_entry_t *conn,
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) *path_entry_ptr) {
+    assert(!(*path_entry_ptr)->refs);
+    remove_from_path_index(conn, *path_entry_ptr);
+    AVS_SORTED_SET_DELETE_ELEM(conn->observed_paths, path_entry_ptr);
+    memory_usage_sub(conn_observe_state(conn), PATH_ENTRY_MEMORY);
+}
+
 static AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t)
 find_or_create_observe_path_entry(anjay_observe_connection_entry_t *connection,
                                   const anjay_uri_path_t *path) {
@@ -123,6 +279,11 @@ find_or_create_observe_path_entry(anjay_observe_connection_entry_t *connection,
                sizeof(*path));
         entry = AVS_SORTED_SET_INSERT(connection->observed_paths, new_entry);
         assert(entry == new_entry);
+        if (add_to_path_index(connection, entry)) {
+            AVS_SORTED_SET_DELETE_ELEM(connection->observed_paths, &entry);
+            return NULL;
+        }
+        memory_usage_add(conn_observe_state(connection), PATH_ENTRY_MEMORY);
     }
     return entry;
 }
@@ -142,11 +303,12 @@ static int add_path_to_observed_paths(
     if (!entry) {
         anjay_log(ERROR, _("out of memory"));
         if (!observed_path->refs) {
-            AVS_SORTED_SET_DELETE_ELEM(conn->observed_paths, &observed_path);
+            delete_observe_path_entry(conn, &observed_path);
         }
         return -1;
     }
     *entry = observation;
+    memory_usage_add(conn_observe_state(conn), PATH_ENTRY_REF_MEMORY);
     return 0;
 }
 
@@ -161,9 +323,9 @@ static void remove_path_from_observed_paths(
     AVS_LIST_FOREACH_PTR(ref_ptr, &observed_path->refs) {
         if (**ref_ptr == observation) {
             AVS_LIST_DELETE(ref_ptr);
+            memory_usage_sub(conn_observe_state(conn), PATH_ENTRY_REF_MEMORY);
             if (!observed_path->refs) {
-                AVS_SORTED_SET_DELETE_ELEM(conn->observed_paths,
-                                           &observed_path);
+                delete_observe_path_entry(conn, &observed_path);
             }
             return;
         }
@@ -200,7 +362,8 @@ static void remove_from_observed_paths(
 static void clear_observation(anjay_observe_connection_entry_t *connection,
                               anjay_observation_t *observation) {
     anjay_unlocked_t *anjay = _anjay_from_server(connection->conn_ref.server);
-    avs_sched_del(&observation->notify_task);
+    _anjay_observe_wheel_disarm(&connection->trigger_wheel,
+                                &observation->trigger);
     while (observation->last_sent) {
         delete_value(anjay, &observation->last_sent);
     }
@@ -227,6 +390,7 @@ detach_observation(anjay_observe_connection_entry_t *conn,
                    AVS_SORTED_SET_ELEM(anjay_observation_t) observation) {
     AVS_SORTED_SET_DETACH(conn->observations, observation);
     remove_from_observed_paths(conn, observation);
+    memory_usage_sub(conn_observe_state(conn), OBSERVATION_MEMORY(observation));
 }
 
 void _anjay_observe_cleanup_connection(anjay_observe_connection_entry_t *conn) {
@@ -236,7 +400,10 @@ void _anjay_observe_cleanup_connection(anjay_observe_connection_entry_t *conn) {
     }
     AVS_SORTED_SET_DELETE(&conn->observations) {
         remove_from_observed_paths(conn, *conn->observations);
-        avs_sched_del(&(*conn->observations)->notify_task);
+        memory_usage_sub(&anjay->observe,
+                         OBSERVATION_MEMORY(*conn->observations));
+        _anjay_observe_wheel_disarm(&conn->trigger_wheel,
+                                    &(*conn->observations)->trigger);
         if ((*conn->observations)->last_sent) {
             delete_value(anjay, &(*conn->observations)->last_sent);
         }
@@ -249,12 +416,181 @@ void _anjay_observe_cleanup_connection(anjay_observe_connection_entry_t *conn) {
     if (conn->flush_task) {
         avs_sched_del(&conn->flush_task);
     }
+    avs_sched_del(&conn->trigger_job);
+    memory_usage_sub(&anjay->observe, CONNECTION_MEMORY);
+}
+
+static int pushed_value_cmp(const void *left, const void *right) {
+    return _anjay_uri_path_compare(
+            &((const anjay_observe_pushed_value_t *) left)->path,
+            &((const anjay_observe_pushed_value_t *) right)->path);
+}
+
+static inline const anjay_observe_pushed_value_t *
+pushed_value_query(const anjay_uri_path_t *path) {
+    return AVS_CONTAINER_OF(path, anjay_observe_pushed_value_t, path);
+}
+
+static void
+delete_pushed_value(anjay_observe_state_t *observe,
+                    AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) entry) {
+    memory_usage_sub(observe, PUSHED_VALUE_MEMORY(entry->value));
+    _anjay_batch_release(&entry->value);
+    AVS_SORTED_SET_DELETE_ELEM(observe->pushed_values, &entry);
+}
+
+static void drop_pushed_value(anjay_observe_state_t *observe,
+                              const anjay_uri_path_t *path) {
+    if (!observe->pushed_values) {
+        return;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) entry =
+            AVS_SORTED_SET_FIND(observe->pushed_values,
+                                pushed_value_query(path));
+    if (entry) {
+        delete_pushed_value(observe, entry);
+    }
+}
+
+int _anjay_observe_push_value(anjay_observe_state_t *observe,
+                              const anjay_uri_path_t *path,
+                              anjay_batch_t *value) {
+    assert(_anjay_uri_path_leaf_is(path, ANJAY_ID_RID));
+    assert(value);
+    if (!observe->pushed_values
+            && !(observe->pushed_values =
+                         AVS_SORTED_SET_NEW(anjay_observe_pushed_value_t,
+                                            pushed_value_cmp))) {
+        anjay_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) entry =
+            AVS_SORTED_SET_FIND(observe->pushed_values,
+                                pushed_value_query(path));
+    if (entry) {
+        memory_usage_sub(observe, _anjay_batch_memory_usage(entry->value));
+        _anjay_batch_release(&entry->value);
+        entry->value = value;
+        memory_usage_add(observe, _anjay_batch_memory_usage(value));
+        return 0;
+    }
+    if (!(entry = AVS_SORTED_SET_ELEM_NEW(anjay_observe_pushed_value_t))) {
+        anjay_log(ERROR, _("out of memory"));
+        return -1;
+    }
+    entry->path = *path;
+    entry->value = value;
+    AVS_SORTED_SET_INSERT(observe->pushed_values, entry);
+    memory_usage_add(observe, PUSHED_VALUE_MEMORY(value));
+    return 0;
+}
+
+void _anjay_observe_drop_pushed_values(anjay_observe_state_t *observe,
+                                       const anjay_uri_path_t *prefix) {
+    if (!observe->pushed_values) {
+        return;
+    }
+    anjay_uri_path_t lower_bound = *prefix;
+    for (size_t i = _anjay_uri_path_length(prefix);
+         i < _ANJAY_URI_PATH_MAX_LENGTH; ++i) {
+        lower_bound.ids[i] = 0;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) it =
+            AVS_SORTED_SET_LOWER_BOUND(observe->pushed_values,
+                                       pushed_value_query(&lower_bound));
+    while (it && !_anjay_uri_path_outside_base(&it->path, prefix)) {
+        AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) next =
+                AVS_SORTED_SET_ELEM_NEXT(it);
+        delete_pushed_value(observe, it);
+        it = next;
+    }
+}
+
+static const anjay_batch_t *
+find_pushed_value(anjay_unlocked_t *anjay,
+                  const anjay_dm_path_info_t *path_info,
+                  anjay_ssid_t connection_ssid) {
+    if (!anjay->observe.pushed_values
+            || !_anjay_uri_path_leaf_is(&path_info->uri, ANJAY_ID_RID)
+            || !path_info->is_present || !path_info->has_resource
+            || !_anjay_dm_res_kind_readable(path_info->kind)
+            || _anjay_dm_res_kind_multiple(path_info->kind)) {
+        return NULL;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) entry =
+            AVS_SORTED_SET_FIND(anjay->observe.pushed_values,
+                                pushed_value_query(&path_info->uri));
+    if (!entry) {
+        return NULL;
+    }
+    // if access is denied, let the regular read path report the error
+    const anjay_action_info_t action_info = {
+        .oid = path_info->uri.ids[ANJAY_ID_OID],
+        .iid = path_info->uri.ids[ANJAY_ID_IID],
+        .ssid = connection_ssid,
+        .action = ANJAY_ACTION_READ
+    };
+    if (!_anjay_instance_action_allowed(anjay, &action_info)) {
+        return NULL;
+    }
+    return entry->value;
+}
+
+static int read_cache_entry_cmp(const void *left_, const void *right_) {
+    const anjay_observe_read_cache_entry_t *left =
+            (const anjay_observe_read_cache_entry_t *) left_;
+    const anjay_observe_read_cache_entry_t *right =
+            (const anjay_observe_read_cache_entry_t *) right_;
+    int result = _anjay_uri_path_compare(&left->path, &right->path);
+    if (!result) {
+        result = (int) left->action - (int) right->action;
+    }
+    if (!result) {
+        result = (int) left->ssid - (int) right->ssid;
+    }
+    return result;
+}
+
+static void clear_read_cache(anjay_observe_state_t *observe) {
+    if (observe->read_cache) {
+        AVS_SORTED_SET_DELETE(&observe->read_cache) {
+            memory_usage_sub(observe,
+                             READ_CACHE_ENTRY_MEMORY(
+                                     (*observe->read_cache)->value));
+            _anjay_batch_release(&(*observe->read_cache)->value);
+        }
+    }
+    ++observe->read_cache_generation;
+    avs_sched_del(&observe->read_cache_clear_job);
+}
+
+void _anjay_observe_invalidate_read_cache(anjay_observe_state_t *observe) {
+    clear_read_cache(observe);
+}
+
+void _anjay_observe_set_read_sharing(anjay_observe_state_t *observe,
+                                     bool enabled) {
+    observe->read_sharing_enabled = enabled;
+    clear_read_cache(observe);
 }
 
 void _anjay_observe_cleanup(anjay_observe_state_t *observe) {
+    clear_read_cache(observe);
     AVS_LIST_CLEAR(&observe->connection_entries) {
         _anjay_observe_cleanup_connection(observe->connection_entries);
     }
+    if (observe->path_index) {
+        assert(!AVS_SORTED_SET_FIRST(observe->path_index));
+        AVS_SORTED_SET_DELETE(&observe->path_index);
+    }
+    if (observe->pushed_values) {
+        AVS_SORTED_SET_DELETE(&observe->pushed_values) {
+            memory_usage_sub(observe,
+                             PUSHED_VALUE_MEMORY(
+                                     (*observe->pushed_values)->value));
+            _anjay_batch_release(&(*observe->pushed_values)->value);
+        }
+    }
 }
 
 static void
@@ -273,12 +609,26 @@ static void delete_connection_if_empty(
     }
 }
 
-typedef struct {
-    anjay_observe_connection_entry_t *conn_state;
-    anjay_observation_t *observation;
-} trigger_observe_args_t;
+static void trigger_job(avs_sched_t *sched, const void *conn_ptr);
 
-static void trigger_observe(avs_sched_t *sched, const void *args_);
+/**
+ * Makes sure that trigger_job for @p conn runs not later than at @p instant.
+ * The job always runs at the earliest deadline in the trigger wheel, or
+ * earlier, so disarming triggers never requires rescheduling it.
+ */
+static int sched_trigger_job(anjay_observe_connection_entry_t *conn,
+                             avs_time_monotonic_t instant) {
+    if (!avs_time_monotonic_valid(instant)
+            || (conn->trigger_job
+                && !avs_time_monotonic_before(
+                           instant, avs_sched_time(&conn->trigger_job)))) {
+        return 0;
+    }
+    avs_sched_del(&conn->trigger_job);
+    return ANJAY_SCHED_AT(_anjay_from_server(conn->conn_ref.server)->sched,
+                          &conn->trigger_job, instant, trigger_job, &conn,
+                          sizeof(conn));
+}
 
 static const anjay_observation_value_t *
 newest_value(const anjay_observation_t *observation) {
@@ -313,23 +663,17 @@ static int schedule_trigger(anjay_observe_connection_entry_t *conn_state,
         trigger_instant_real = real_now;
     }
 
-    if (!avs_time_real_before(conn_state->next_trigger, trigger_instant_real)) {
-        conn_state->next_trigger = trigger_instant_real;
-    }
     if (period_type == SCHEDULE_PERIOD_MAX
             && !avs_time_real_before(observation->next_pmax_trigger,
                                      trigger_instant_real)) {
         observation->next_pmax_trigger = trigger_instant_real;
-        if (!avs_time_real_before(conn_state->next_pmax_trigger,
-                                  trigger_instant_real)) {
-            conn_state->next_pmax_trigger = trigger_instant_real;
-        }
     }
 
     avs_time_monotonic_t trigger_instant_monotonic = avs_time_monotonic_add(
             monotonic_now, avs_time_real_diff(trigger_instant_real, real_now));
-    if (avs_time_monotonic_before(avs_sched_time(&observation->notify_task),
-                                  trigger_instant_monotonic)) {
+    if (avs_time_monotonic_before(
+                _anjay_observe_wheel_node_deadline(&observation->trigger),
+                trigger_instant_monotonic)) {
         anjay_log(
                 LAZY_TRACE,
                 _("Notify for token ") "%s" _(" already scheduled earlier "
@@ -348,15 +692,9 @@ static int schedule_trigger(anjay_observe_connection_entry_t *conn_state,
             (long) trigger_instant_monotonic.since_monotonic_epoch.seconds,
             (long) trigger_instant_monotonic.since_monotonic_epoch.nanoseconds);
 
-    int retval =
-            AVS_SCHED_AT(_anjay_from_server(conn_state->conn_ref.server)->sched,
-                         &observation->notify_task, trigger_instant_monotonic,
-                         trigger_observe,
-                         (&(const trigger_observe_args_t) {
-                             .conn_state = conn_state,
-                             .observation = observation
-                         }),
-                         sizeof(trigger_observe_args_t));
+    _anjay_observe_wheel_arm(&conn_state->trigger_wheel, &observation->trigger,
+                             trigger_instant_monotonic);
+    int retval = sched_trigger_job(conn_state, trigger_instant_monotonic);
     if (retval) {
         anjay_log(ERROR,
                   _("Could not schedule automatic notification trigger, "
@@ -454,6 +792,13 @@ detach_first_unsent_value(anjay_observe_connection_entry_t *conn_state) {
     return result;
 }
 
+static void
+drop_first_queued_notification(anjay_unlocked_t *anjay,
+                               anjay_observe_connection_entry_t *conn_state) {
+    anjay_observation_value_t *entry = detach_first_unsent_value(conn_state);
+    delete_value(anjay, &entry);
+}
+
 static void drop_oldest_queued_notification(anjay_unlocked_t *anjay,
                                             anjay_observe_state_t *observe) {
     AVS_LIST(anjay_observe_connection_entry_t) oldest =
@@ -462,9 +807,32 @@ static void drop_oldest_queued_notification(anjay_unlocked_t *anjay,
     AVS_ASSERT(oldest, "function is not supposed to be called when there are "
                        "no queued notifications");
 
-    anjay_observation_value_t *entry = detach_first_unsent_value(oldest);
-    delete_value(anjay, &entry);
+    drop_first_queued_notification(anjay, oldest);
+}
+
+#    ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_observe_memory_usage(const anjay_observe_state_t *observe) {
+    return observe->memory_usage;
+}
+
+static void enforce_memory_budget(anjay_unlocked_t *anjay,
+                                  size_t new_value_size) {
+    anjay_memory_budget_t *budget =
+            &anjay->memory_budgets[ANJAY_MEMORY_OBSERVE];
+    while (_anjay_memory_budget_exceeded(budget, anjay->observe.memory_usage
+                                                         + new_value_size)) {
+        AVS_LIST(anjay_observe_connection_entry_t) oldest =
+                find_oldest_queued_notification(&anjay->observe);
+        if (!oldest) {
+            break;
+        }
+        anjay_log(DEBUG, _("observe memory budget exceeded, dropping oldest "
+                           "queued notification"));
+        drop_first_queued_notification(anjay, oldest);
+        ++budget->dropped_count;
+    }
 }
+#    endif // ANJAY_WITH_MEMORY_STATS
 
 static int insert_new_value(anjay_observe_connection_entry_t *conn_state,
                             anjay_observation_t *observation,
@@ -493,6 +861,11 @@ static int insert_new_value(anjay_observe_connection_entry_t *conn_state,
     if (!res_value) {
         return -1;
     }
+#    ifdef ANJAY_WITH_MEMORY_STATS
+    const size_t res_value_size = value_memory_usage(res_value);
+    enforce_memory_budget(anjay, res_value_size);
+    memory_usage_add(observe, res_value_size);
+#    endif // ANJAY_WITH_MEMORY_STATS
 
     AVS_LIST_APPEND(&conn_state->unsent_last, res_value);
     conn_state->unsent_last = res_value;
@@ -506,7 +879,8 @@ static int insert_new_value(anjay_observe_connection_entry_t *conn_state,
 static int insert_error(anjay_observe_connection_entry_t *conn_state,
                         anjay_observation_t *observation,
                         int outer_result) {
-    avs_sched_del(&observation->notify_task);
+    _anjay_observe_wheel_disarm(&conn_state->trigger_wheel,
+                                &observation->trigger);
     const anjay_msg_details_t details = {
         .msg_code = _anjay_make_error_response_code(outer_result),
         .format = AVS_COAP_FORMAT_NONE
@@ -562,6 +936,53 @@ static int get_effective_attrs(anjay_unlocked_t *anjay,
     return _anjay_dm_effective_attrs(anjay, &details, out_attrs);
 }
 
+void _anjay_observe_set_attrs_caching(anjay_observe_state_t *observe,
+                                      bool enabled) {
+    observe->attrs_cache_enabled = enabled;
+    // values cached before disabling the cache might have become stale since
+    _anjay_observe_invalidate_attrs_cache(observe);
+}
+
+static int
+get_path_entry_attrs(anjay_observe_connection_entry_t *conn_state,
+                     anjay_observe_path_entry_t *path_entry,
+                     anjay_dm_r_attributes_t *out_attrs) {
+    anjay_unlocked_t *anjay = _anjay_from_server(conn_state->conn_ref.server);
+    const uint64_t generation = anjay->observe.attrs_cache_generation;
+    if (anjay->observe.attrs_cache_enabled
+            && path_entry->cached_attrs_generation == generation) {
+        *out_attrs = path_entry->cached_attrs;
+        return 0;
+    }
+    int result =
+            get_effective_attrs(anjay, out_attrs, &path_entry->path,
+                                _anjay_server_ssid(conn_state->conn_ref.server));
+    if (!result && anjay->observe.attrs_cache_enabled) {
+        // if the cache got invalidated while the handlers were running,
+        // generation is already outdated, so the value will not be used
+        path_entry->cached_attrs = *out_attrs;
+        path_entry->cached_attrs_generation = generation;
+    }
+    return result;
+}
+
+static int
+get_observation_path_attrs(anjay_observe_connection_entry_t *conn_state,
+                           const anjay_uri_path_t *path,
+                           anjay_dm_r_attributes_t *out_attrs) {
+    anjay_unlocked_t *anjay = _anjay_from_server(conn_state->conn_ref.server);
+    if (anjay->observe.attrs_cache_enabled) {
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry =
+                AVS_SORTED_SET_FIND(conn_state->observed_paths,
+                                    path_entry_query(path));
+        if (path_entry) {
+            return get_path_entry_attrs(conn_state, path_entry, out_attrs);
+        }
+    }
+    return get_effective_attrs(anjay, out_attrs, path,
+                               _anjay_server_ssid(conn_state->conn_ref.server));
+}
+
 static inline bool is_pmax_valid(anjay_dm_oi_attributes_t attr) {
     if (attr.max_period < 0) {
         return false;
@@ -594,10 +1015,8 @@ int _anjay_observe_schedule_pmax_trigger(
 
     for (size_t i = 0; i < observation->paths_count; ++i) {
         anjay_dm_r_attributes_t attrs;
-        int result = get_effective_attrs(
-                _anjay_from_server(conn_state->conn_ref.server), &attrs,
-                &observation->paths[i],
-                _anjay_server_ssid(conn_state->conn_ref.server));
+        int result = get_observation_path_attrs(
+                conn_state, &observation->paths[i], &attrs);
         if (result) {
             anjay_log(DEBUG,
                       _("Could not get observe attributes, result: ") "%d",
@@ -630,10 +1049,13 @@ static int insert_initial_value(anjay_observe_connection_entry_t *conn_state,
     // even though we haven't actually sent it ourselves
     if ((observation->last_sent = create_observation_value(
                  details, AVS_COAP_NOTIFY_PREFER_NON_CONFIRMABLE, observation,
-                 timestamp, values))
-            && !(result = _anjay_observe_schedule_pmax_trigger(conn_state,
-                                                               observation))) {
-        observation->last_confirmable = now;
+                 timestamp, values))) {
+        memory_usage_add(conn_observe_state(conn_state),
+                         value_memory_usage(observation->last_sent));
+        if (!(result = _anjay_observe_schedule_pmax_trigger(conn_state,
+                                                            observation))) {
+            observation->last_confirmable = now;
+        }
     }
     return result;
 }
@@ -723,8 +1145,7 @@ find_or_create_connection_state(anjay_connection_ref_t ref) {
         }
         memcpy((void *) (intptr_t) (const void *) &(*conn_ptr)->conn_ref, &ref,
                sizeof(ref));
-        (*conn_ptr)->next_trigger = AVS_TIME_REAL_INVALID;
-        (*conn_ptr)->next_pmax_trigger = AVS_TIME_REAL_INVALID;
+        memory_usage_add(conn_observe_state(*conn_ptr), CONNECTION_MEMORY);
     }
     return conn_ptr;
 }
@@ -790,6 +1211,9 @@ attach_new_observation(anjay_observe_connection_entry_t *conn_state,
     int result = _anjay_observe_add_to_observed_paths(conn_state, observation);
     if (result) {
         AVS_SORTED_SET_DETACH(conn_state->observations, observation);
+    } else {
+        memory_usage_add(conn_observe_state(conn_state),
+                         OBSERVATION_MEMORY(observation));
     }
     return result;
 }
@@ -877,13 +1301,11 @@ static anjay_uri_path_t get_response_path(anjay_observation_value_t *value) {
     return observation->paths[0];
 }
 
-static int write_notify_payload(size_t payload_offset,
-                                void *payload_buf,
-                                size_t payload_buf_size,
-                                size_t *out_payload_chunk_size,
-                                void *conn_) {
-    anjay_observe_connection_entry_t *conn =
-            (anjay_observe_connection_entry_t *) conn_;
+static int write_notify_payload_chunk(anjay_observe_connection_entry_t *conn,
+                                      size_t payload_offset,
+                                      void *payload_buf,
+                                      size_t payload_buf_size,
+                                      size_t *out_payload_chunk_size) {
     if (payload_offset != conn->serialization_state.expected_offset) {
         anjay_log(DEBUG,
                   _("Server requested unexpected chunk of payload (expected "
@@ -936,6 +1358,26 @@ static int write_notify_payload(size_t payload_offset,
     return 0;
 }
 
+static int write_notify_payload(size_t payload_offset,
+                                void *payload_buf,
+                                size_t payload_buf_size,
+                                size_t *out_payload_chunk_size,
+                                void *conn_) {
+    anjay_observe_connection_entry_t *conn =
+            (anjay_observe_connection_entry_t *) conn_;
+    _anjay_trace(_anjay_from_server(conn->conn_ref.server),
+                 ANJAY_TRACE_NOTIFY_SERIALIZE_BEGIN,
+                 _anjay_server_ssid(conn->conn_ref.server), NULL, NULL, 0);
+    int result = write_notify_payload_chunk(conn, payload_offset, payload_buf,
+                                            payload_buf_size,
+                                            out_payload_chunk_size);
+    _anjay_trace(_anjay_from_server(conn->conn_ref.server),
+                 ANJAY_TRACE_NOTIFY_SERIALIZE_END,
+                 _anjay_server_ssid(conn->conn_ref.server), NULL, NULL,
+                 result);
+    return result;
+}
+
 static anjay_msg_details_t
 initial_response_details(anjay_unlocked_t *anjay,
                          const anjay_request_t *request,
@@ -1018,11 +1460,107 @@ static int read_observation_path(anjay_unlocked_t *anjay,
     if (_anjay_uri_path_has(path, ANJAY_ID_OID)) {
         obj = _anjay_dm_find_object_by_oid(anjay, path->ids[ANJAY_ID_OID]);
     }
-    int result;
     anjay_dm_path_info_t path_info;
-    (void) ((result = _anjay_dm_path_info(anjay, obj, path, &path_info))
-            || (result = read_as_batch(anjay, obj, &path_info, action,
-                                       connection_ssid, timestamp, out_batch)));
+    int result = _anjay_dm_path_info(anjay, obj, path, &path_info);
+    if (result) {
+        return result;
+    }
+    const anjay_batch_t *pushed_value =
+            find_pushed_value(anjay, &path_info, connection_ssid);
+    if (pushed_value) {
+        *out_batch = _anjay_batch_acquire(pushed_value);
+        return 0;
+    }
+    return read_as_batch(anjay, obj, &path_info, action, connection_ssid,
+                         timestamp, out_batch);
+}
+
+static void read_cache_clear_job(avs_sched_t *sched, const void *dummy) {
+    (void) dummy;
+    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    clear_read_cache(&anjay->observe);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+static void store_shared_value(anjay_unlocked_t *anjay,
+                               const anjay_observe_read_cache_entry_t *key,
+                               const anjay_batch_t *value) {
+    anjay_observe_state_t *observe = &anjay->observe;
+    if (!observe->read_cache
+            && !(observe->read_cache =
+                         AVS_SORTED_SET_NEW(anjay_observe_read_cache_entry_t,
+                                            read_cache_entry_cmp))) {
+        return;
+    }
+    AVS_SORTED_SET_ELEM(anjay_observe_read_cache_entry_t) entry =
+            AVS_SORTED_SET_ELEM_NEW(anjay_observe_read_cache_entry_t);
+    if (!entry) {
+        return;
+    }
+    *entry = *key;
+    entry->value = _anjay_batch_acquire(value);
+    AVS_SORTED_SET_INSERT(observe->read_cache, entry);
+    memory_usage_add(observe, READ_CACHE_ENTRY_MEMORY(entry->value));
+    // Values are shared only between triggers handled during the current
+    // scheduler run; if the cache cannot be cleared afterwards, do not use it
+    if (!observe->read_cache_clear_job
+            && ANJAY_SCHED_NOW(anjay->sched, &observe->read_cache_clear_job,
+                               read_cache_clear_job, NULL, 0)) {
+        clear_read_cache(observe);
+    }
+}
+
+/**
+ * Wrapper over read_observation_path() that reuses values already read for
+ * other observations of the same path if anjay_set_observe_read_sharing() is
+ * enabled.
+ */
+static int read_observation_path_shared(anjay_unlocked_t *anjay,
+                                        const anjay_uri_path_t *path,
+                                        anjay_request_action_t action,
+                                        anjay_ssid_t connection_ssid,
+                                        const avs_time_real_t *timestamp,
+                                        anjay_batch_t **out_batch) {
+    if (!anjay->observe.read_sharing_enabled) {
+        return read_observation_path(anjay, path, action, connection_ssid,
+                                     timestamp, out_batch);
+    }
+    // Reading a path that includes an Instance ID yields the same value for
+    // all Servers that are allowed to read it; reading whole Objects or the
+    // root path is filtered by access control, so cache those per Server
+    const bool has_iid = _anjay_uri_path_has(path, ANJAY_ID_IID);
+    const anjay_observe_read_cache_entry_t key = {
+        .path = *path,
+        .action = action,
+        .ssid = has_iid ? ANJAY_SSID_ANY : connection_ssid
+    };
+    AVS_SORTED_SET_ELEM(anjay_observe_read_cache_entry_t) entry = NULL;
+    if (anjay->observe.read_cache) {
+        entry = AVS_SORTED_SET_FIND(anjay->observe.read_cache, &key);
+    }
+    if (entry) {
+        // if access is denied, let the regular read path report the error
+        const anjay_action_info_t action_info = {
+            .oid = path->ids[ANJAY_ID_OID],
+            .iid = path->ids[ANJAY_ID_IID],
+            .ssid = connection_ssid,
+            .action = ANJAY_ACTION_READ
+        };
+        if (!has_iid || _anjay_instance_action_allowed(anjay, &action_info)) {
+            *out_batch = _anjay_batch_acquire(entry->value);
+            return 0;
+        }
+    }
+    const uint64_t generation = anjay->observe.read_cache_generation;
+    int result = read_observation_path(anjay, path, action, connection_ssid,
+                                       timestamp, out_batch);
+    // if the cache got cleared while the handlers were running, the value
+    // might have been read before the change that caused it
+    if (!result && !entry
+            && anjay->observe.read_cache_generation == generation) {
+        store_shared_value(anjay, &key, *out_batch);
+    }
     return result;
 }
 
@@ -1311,7 +1849,7 @@ static int schedule_all_triggers(anjay_observe_connection_entry_t *conn) {
     int result = 0;
     AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
     AVS_SORTED_SET_FOREACH(observation, conn->observations) {
-        if (!observation->notify_task) {
+        if (!_anjay_observe_wheel_node_armed(&observation->trigger)) {
             _anjay_update_ret(&result, _anjay_observe_schedule_pmax_trigger(
                                                conn, observation));
         }
@@ -1319,29 +1857,29 @@ static int schedule_all_triggers(anjay_observe_connection_entry_t *conn) {
     return result;
 }
 
-static void
-recalculate_conn_trigger_times(anjay_observe_connection_entry_t *conn) {
-    avs_time_monotonic_t monotonic_now = avs_time_monotonic_now();
-    avs_time_real_t real_now = avs_time_real_now();
-    conn->next_trigger = AVS_TIME_REAL_INVALID;
-    conn->next_pmax_trigger = AVS_TIME_REAL_INVALID;
+avs_time_real_t
+_anjay_observe_next_trigger(const anjay_observe_connection_entry_t *conn) {
+    return avs_time_real_add(
+            avs_time_real_now(),
+            avs_time_monotonic_diff(
+                    _anjay_observe_wheel_next_deadline(&conn->trigger_wheel),
+                    avs_time_monotonic_now()));
+}
+
+avs_time_real_t
+_anjay_observe_next_pmax_trigger(const anjay_observe_connection_entry_t *conn) {
+    // only called when the application asks for it, so it is not worth it to
+    // keep track of this on each trigger
+    avs_time_real_t result = AVS_TIME_REAL_INVALID;
     AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
     AVS_SORTED_SET_FOREACH(observation, conn->observations) {
         if (avs_time_real_valid(observation->next_pmax_trigger)
-                && !avs_time_real_before(conn->next_pmax_trigger,
+                && !avs_time_real_before(result,
                                          observation->next_pmax_trigger)) {
-            conn->next_pmax_trigger = observation->next_pmax_trigger;
-        }
-        avs_time_real_t next_trigger = avs_time_real_add(
-                real_now,
-                avs_time_monotonic_diff(avs_sched_time(
-                                                &observation->notify_task),
-                                        monotonic_now));
-        if (avs_time_real_valid(next_trigger)
-                && !avs_time_real_before(conn->next_trigger, next_trigger)) {
-            conn->next_trigger = next_trigger;
+            result = observation->next_pmax_trigger;
         }
     }
+    return result;
 }
 
 static bool connection_exists(anjay_unlocked_t *anjay,
@@ -1383,9 +1921,9 @@ sched_flush_send_queue(AVS_LIST(anjay_observe_connection_entry_t) conn) {
                            "already scheduled"));
         return 0;
     }
-    if (AVS_SCHED_NOW(_anjay_from_server(conn->conn_ref.server)->sched,
-                      &conn->flush_task, flush_send_queue_job, &conn,
-                      sizeof(conn))) {
+    if (ANJAY_SCHED_NOW(_anjay_from_server(conn->conn_ref.server)->sched,
+                        &conn->flush_task, flush_send_queue_job, &conn,
+                        sizeof(conn))) {
         anjay_log(WARNING, _("Could not schedule notification flush"));
         return -1;
     }
@@ -1534,10 +2072,17 @@ static void flush_next_unsent(anjay_observe_connection_entry_t *conn) {
                                     &response, conn->unsent->reliability_hint,
                                     payload_writer, conn,
                                     handle_notify_delivery, conn)))) {
+            _anjay_trace(anjay, ANJAY_TRACE_COAP_SEND,
+                         _anjay_server_ssid(conn_ref.server), NULL, "Notify",
+                         -1);
             if (connection_exists(anjay, conn)) {
                 cleanup_serialization_state(&conn->serialization_state);
                 on_entry_flushed(conn, err);
             }
+        } else {
+            _anjay_trace(anjay, ANJAY_TRACE_COAP_SEND,
+                         _anjay_server_ssid(conn_ref.server), NULL, "Notify",
+                         0);
         }
     }
     avs_coap_options_cleanup(&response.options);
@@ -1627,8 +2172,8 @@ update_notification_value(anjay_observe_connection_entry_t *conn_state,
     int result = 0;
     for (size_t i = 0; i < observation->paths_count; ++i) {
         anjay_dm_r_attributes_t attrs;
-        if ((result = get_effective_attrs(anjay, &attrs, &observation->paths[i],
-                                          ssid))) {
+        if ((result = get_observation_path_attrs(
+                     conn_state, &observation->paths[i], &attrs))) {
             anjay_log(ERROR, _("Could not get attributes of path ") "%s",
                       ANJAY_DEBUG_MAKE_PATH(&observation->paths[i]));
             goto finish;
@@ -1636,9 +2181,9 @@ update_notification_value(anjay_observe_connection_entry_t *conn_state,
 
         if (has_epmin_expired(newest_value(observation)->values[i],
                               &attrs.common)) {
-            if ((result = read_observation_path(anjay, &observation->paths[i],
-                                                observation->action, ssid,
-                                                &timestamp, &batches[i]))) {
+            if ((result = read_observation_path_shared(
+                         anjay, &observation->paths[i], observation->action,
+                         ssid, &timestamp, &batches[i]))) {
                 anjay_log(ERROR,
                           _("Could not read path ") "%s" _(" for notifying"),
                           ANJAY_DEBUG_MAKE_PATH(&observation->paths[i]));
@@ -1695,49 +2240,71 @@ finish:
     return result;
 }
 
-static void trigger_observe(avs_sched_t *sched, const void *args_) {
-    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
-    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
-    const trigger_observe_args_t *args = (const trigger_observe_args_t *) args_;
-    assert(args->conn_state);
-    assert(args->observation);
-    args->observation->next_pmax_trigger = AVS_TIME_REAL_INVALID;
-    recalculate_conn_trigger_times(args->conn_state);
+static void trigger_observe(anjay_observe_connection_entry_t *conn_state,
+                            anjay_observation_t *observation) {
+    anjay_unlocked_t *anjay = _anjay_from_server(conn_state->conn_ref.server);
+    _anjay_trace(anjay, ANJAY_TRACE_OBSERVE_TRIGGER,
+                 _anjay_server_ssid(conn_state->conn_ref.server),
+                 observation->paths_count ? &observation->paths[0] : NULL, NULL,
+                 0);
+    observation->next_pmax_trigger = AVS_TIME_REAL_INVALID;
     bool ready_for_notifying =
-            _anjay_connection_ready_for_outgoing_message(
-                    args->conn_state->conn_ref)
+            _anjay_connection_ready_for_outgoing_message(conn_state->conn_ref)
             && _anjay_socket_transport_is_online(
-                       _anjay_from_server(args->conn_state->conn_ref.server),
-                       _anjay_connection_transport(args->conn_state->conn_ref));
+                       anjay,
+                       _anjay_connection_transport(conn_state->conn_ref));
     if (ready_for_notifying
-            || notification_storing_enabled(args->conn_state->conn_ref)) {
-        int result =
-                update_notification_value(args->conn_state, args->observation);
+            || notification_storing_enabled(conn_state->conn_ref)) {
+        int result = update_notification_value(conn_state, observation);
         if (result) {
-            insert_error(args->conn_state, args->observation, result);
+            insert_error(conn_state, observation, result);
         }
     }
-    if (args->conn_state->unsent) {
+    if (conn_state->unsent) {
         if (ready_for_notifying
                 && !avs_coap_exchange_id_valid(
-                           args->conn_state->notify_exchange_id)) {
-            avs_sched_del(&args->conn_state->flush_task);
-            assert(!args->conn_state->flush_task);
-            if (_anjay_connection_get_online_socket(
-                        args->conn_state->conn_ref)) {
-                flush_next_unsent(args->conn_state);
+                           conn_state->notify_exchange_id)) {
+            avs_sched_del(&conn_state->flush_task);
+            assert(!conn_state->flush_task);
+            if (_anjay_connection_get_online_socket(conn_state->conn_ref)) {
+                flush_next_unsent(conn_state);
             } else if (_anjay_server_registration_info(
-                               args->conn_state->conn_ref.server)
+                               conn_state->conn_ref.server)
                                ->queue_mode) {
-                _anjay_connection_bring_online(args->conn_state->conn_ref);
+                _anjay_connection_bring_online(conn_state->conn_ref);
                 // once the connection is up, _anjay_observe_sched_flush()
                 // will be called; we're done here
-            } else if (!notification_storing_enabled(
-                               args->conn_state->conn_ref)) {
-                remove_all_unsent_values(args->conn_state);
+            } else if (!notification_storing_enabled(conn_state->conn_ref)) {
+                remove_all_unsent_values(conn_state);
             }
         }
     }
+}
+
+static void trigger_job(avs_sched_t *sched, const void *conn_ptr) {
+    anjay_t *anjay_locked = _anjay_get_from_sched(sched);
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    anjay_observe_connection_entry_t *conn =
+            *(anjay_observe_connection_entry_t *const *) conn_ptr;
+    // Only the triggers that are due now are handled in this run; triggers
+    // re-armed while handling them are handled by the next one
+    _anjay_observe_wheel_advance(&conn->trigger_wheel,
+                                 avs_time_monotonic_now());
+    bool conn_exists = true;
+    anjay_observe_wheel_node_t *node;
+    while (conn_exists
+           && (node = _anjay_observe_wheel_pop_expired(&conn->trigger_wheel))) {
+        trigger_observe(conn, AVS_CONTAINER_OF(node, anjay_observation_t,
+                                               trigger));
+        // the connection might have been deleted while sending notifications
+        conn_exists = connection_exists(anjay, conn);
+    }
+    if (conn_exists
+            && sched_trigger_job(conn, _anjay_observe_wheel_next_deadline(
+                                               &conn->trigger_wheel))) {
+        anjay_log(ERROR,
+                  _("Could not schedule automatic notification trigger"));
+    }
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
@@ -1745,9 +2312,7 @@ static anjay_dm_oi_attributes_t
 get_oi_attributes(anjay_observe_connection_entry_t *connection,
                   anjay_observe_path_entry_t *path_entry) {
     anjay_dm_r_attributes_t attrs = ANJAY_DM_R_ATTRIBUTES_EMPTY;
-    if (get_effective_attrs(_anjay_from_server(connection->conn_ref.server),
-                            &attrs, &path_entry->path,
-                            _anjay_server_ssid(connection->conn_ref.server))) {
+    if (get_path_entry_attrs(connection, path_entry, &attrs)) {
         return ANJAY_DM_OI_ATTRIBUTES_EMPTY;
     }
     return attrs.common;
@@ -1776,33 +2341,38 @@ observe_for_each_matching_clb_t(anjay_observe_connection_entry_t *connection,
                                 anjay_observe_path_entry_t *path_entry,
                                 void *arg);
 
-static int
-observe_for_each_in_bounds(anjay_observe_connection_entry_t *connection,
-                           const anjay_uri_path_t *lower_bound,
-                           const anjay_uri_path_t *upper_bound,
-                           observe_for_each_matching_clb_t *clb,
-                           void *clb_arg) {
+static int observe_for_each_in_bounds(anjay_observe_state_t *observe,
+                                      const anjay_uri_path_t *lower_bound,
+                                      const anjay_uri_path_t *upper_bound,
+                                      observe_for_each_matching_clb_t *clb,
+                                      void *clb_arg) {
+    if (!observe->path_index) {
+        return 0;
+    }
     int retval = 0;
-    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) it =
-            AVS_SORTED_SET_LOWER_BOUND(connection->observed_paths,
-                                       path_entry_query(lower_bound));
-    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) end =
-            AVS_SORTED_SET_UPPER_BOUND(connection->observed_paths,
-                                       path_entry_query(upper_bound));
+    AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) it =
+            AVS_SORTED_SET_LOWER_BOUND(observe->path_index,
+                                       path_index_query(lower_bound));
+    AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) end =
+            AVS_SORTED_SET_UPPER_BOUND(observe->path_index,
+                                       path_index_query(upper_bound));
     // if it == NULL, end must also be NULL
     assert(it || !end);
 
     for (; it != end; it = AVS_SORTED_SET_ELEM_NEXT(it)) {
         assert(it);
-        if ((retval = clb(connection, it, clb_arg))) {
-            return retval;
+        AVS_LIST(anjay_observe_path_index_ref_t) ref;
+        AVS_LIST_FOREACH(ref, it->refs) {
+            if ((retval = clb(ref->connection, ref->path_entry, clb_arg))) {
+                return retval;
+            }
         }
     }
     return 0;
 }
 
 static int
-observe_for_each_in_wildcard(anjay_observe_connection_entry_t *connection,
+observe_for_each_in_wildcard(anjay_observe_state_t *observe,
                              const anjay_uri_path_t *specimen_path,
                              anjay_id_type_t wildcard_level,
                              observe_for_each_matching_clb_t *clb,
@@ -1812,12 +2382,12 @@ observe_for_each_in_wildcard(anjay_observe_connection_entry_t *connection,
         path.ids[i] = ANJAY_ID_INVALID;
         path.ids[i] = ANJAY_ID_INVALID;
     }
-    return observe_for_each_in_bounds(connection, &path, &path, clb, clb_arg);
+    return observe_for_each_in_bounds(observe, &path, &path, clb, clb_arg);
 }
 
 /**
  * Calls <c>clb()</c> on all registered Observe path entries that match
- * <c>path</c>.
+ * <c>path</c>, on all connections.
  *
  * This is harder than may seem at the first glance, because both
  * <c>path</c> (the query) and keys of the registered Observe path entries
@@ -1834,10 +2404,12 @@ observe_for_each_in_wildcard(anjay_observe_connection_entry_t *connection,
  * Wildcard representation
  * -----------------------
  * A wildcard for any type of ID is represented as the number 65535. The
- * registered observation entries for any given connection are stored in a
- * sorted tree, with the sort key being (OID, IID, RID, RIID) - in
- * lexicographical order over all elements of that tuple - much like C++11's
- * <c>std::tuple</c> comparison operators.
+ * registered observation entries of all connections are indexed in a single
+ * sorted tree (anjay_observe_state_t::path_index), with the sort key being
+ * (OID, IID, RID, RIID) - in lexicographical order over all elements of that
+ * tuple - much like C++11's <c>std::tuple</c> comparison operators. Each node
+ * of that tree refers to the matching entries of all connections, so the
+ * number of searches does not depend on the number of connections.
  *
  * Example: querying for OID+IID
  * -----------------------------
@@ -1858,7 +2430,7 @@ observe_for_each_in_wildcard(anjay_observe_connection_entry_t *connection,
  * search term path.
  */
 static int
-observe_for_each_matching(anjay_observe_connection_entry_t *connection,
+observe_for_each_matching(anjay_observe_state_t *observe,
                           const anjay_uri_path_t *path,
                           observe_for_each_matching_clb_t *clb,
                           void *clb_arg) {
@@ -1869,7 +2441,7 @@ observe_for_each_matching(anjay_observe_connection_entry_t *connection,
     size_t path_length = _anjay_uri_path_length(path);
     for (size_t i = 0; i < path_length; ++i) {
         if ((retval = observe_for_each_in_wildcard(
-                     connection, path, (anjay_id_type_t) i, clb, clb_arg))) {
+                     observe, path, (anjay_id_type_t) i, clb, clb_arg))) {
             goto finish;
         }
     }
@@ -1879,36 +2451,54 @@ observe_for_each_matching(anjay_observe_connection_entry_t *connection,
         upper_bound.ids[i] = ANJAY_ID_INVALID;
     }
 
-    retval = observe_for_each_in_bounds(connection, &lower_bound, &upper_bound,
+    retval = observe_for_each_in_bounds(observe, &lower_bound, &upper_bound,
                                         clb, clb_arg);
 finish:
     return retval == ANJAY_FOREACH_BREAK ? 0 : retval;
 }
 
+typedef struct {
+    anjay_ssid_t ssid;
+    bool invert_server_match;
+    observe_for_each_matching_clb_t *clb;
+    int result;
+} observe_notify_args_t;
+
+static int observe_notify_clb(anjay_observe_connection_entry_t *connection,
+                              anjay_observe_path_entry_t *path_entry,
+                              void *args_) {
+    observe_notify_args_t *args = (observe_notify_args_t *) args_;
+    /* Some compilers complain about promotion of comparison result, so
+     * we're casting it to bool explicitly */
+    if ((bool) (_anjay_server_ssid(connection->conn_ref.server) == args->ssid)
+            == args->invert_server_match) {
+        return 0;
+    }
+    return args->clb(connection, path_entry, &args->result);
+}
+
 static int observe_notify_impl(anjay_unlocked_t *anjay,
                                const anjay_uri_path_t *path,
                                anjay_ssid_t ssid,
                                bool invert_server_match,
                                observe_for_each_matching_clb_t *clb) {
-    // iterate through all SSIDs we have
-    int result = 0;
-    AVS_LIST(anjay_observe_connection_entry_t) connection;
-    AVS_LIST_FOREACH(connection, anjay->observe.connection_entries) {
-        /* Some compilers complain about promotion of comparison result, so
-         * we're casting it to bool explicitly */
-        if ((bool) (_anjay_server_ssid(connection->conn_ref.server) == ssid)
-                == invert_server_match) {
-            continue;
-        }
-        observe_for_each_matching(connection, path, clb, &result);
-    }
-    return result;
+    observe_notify_args_t args = {
+        .ssid = ssid,
+        .invert_server_match = invert_server_match,
+        .clb = clb,
+        .result = 0
+    };
+    observe_for_each_matching(&anjay->observe, path, observe_notify_clb,
+                              &args);
+    return args.result;
 }
 
 int _anjay_observe_notify(anjay_unlocked_t *anjay,
                           const anjay_uri_path_t *path,
                           anjay_ssid_t ssid,
                           bool invert_ssid_match) {
+    // values read for other observations might be outdated now
+    clear_read_cache(&anjay->observe);
     // This extra level of indirection is required to be able to mock
     // notify_path_changed in unit tests.
     // Hopefully compilers will inline it in production builds.
@@ -1916,6 +2506,13 @@ int _anjay_observe_notify(anjay_unlocked_t *anjay,
                                notify_path_changed);
 }
 
+bool _anjay_observe_path_observed_exactly(anjay_unlocked_t *anjay,
+                                          const anjay_uri_path_t *path) {
+    return anjay->observe.path_index
+           && AVS_SORTED_SET_FIND(anjay->observe.path_index,
+                                  path_index_query(path));
+}
+
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
 static int get_observe_status(anjay_observe_connection_entry_t *connection,
                               anjay_observe_path_entry_t *entry,
@@ -1951,15 +2548,11 @@ _anjay_observe_status(anjay_unlocked_t *anjay,
         .min_period = ANJAY_ATTRIB_INTEGER_NONE,
         .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
     };
-    AVS_LIST(anjay_observe_connection_entry_t) connection;
-    AVS_LIST_FOREACH(connection, anjay->observe.connection_entries) {
-        int retval =
-                observe_for_each_matching(connection,
-                                          &MAKE_RESOURCE_PATH(oid, iid, rid),
-                                          get_observe_status, &result);
-        assert(!retval);
-        (void) retval;
-    }
+    int retval = observe_for_each_matching(&anjay->observe,
+                                           &MAKE_RESOURCE_PATH(oid, iid, rid),
+                                           get_observe_status, &result);
+    assert(!retval);
+    (void) retval;
     result.min_period = AVS_MAX(result.min_period, 0);
 
     return result;
@@ -22,18 +22,68 @@ VISIBILITY_PRIVATE_HEADER_BEGIN
 typedef struct anjay_observation_struct anjay_observation_t;
 typedef struct anjay_observe_connection_entry_struct
         anjay_observe_connection_entry_t;
+typedef struct anjay_observe_path_index_entry_struct
+        anjay_observe_path_index_entry_t;
+typedef struct anjay_observe_read_cache_entry_struct
+        anjay_observe_read_cache_entry_t;
 
 typedef enum {
     NOTIFY_QUEUE_UNLIMITED,
     NOTIFY_QUEUE_DROP_OLDEST
 } notify_queue_limit_mode_t;
 
+/**
+ * Value of a single-instance Resource passed by the user along with a change
+ * notification, using one of the anjay_notify_value_changed_*() functions.
+ */
+typedef struct {
+    anjay_uri_path_t path;
+    anjay_batch_t *value;
+} anjay_observe_pushed_value_t;
+
 typedef struct {
     AVS_LIST(anjay_observe_connection_entry_t) connection_entries;
+    // Paths observed on any of the connections, sorted by path. Allows finding
+    // all observations affected by a change with a single set of lookups,
+    // instead of searching observed_paths of each connection. Created lazily.
+    AVS_SORTED_SET(anjay_observe_path_index_entry_t) path_index;
     bool confirmable_notifications;
 
     notify_queue_limit_mode_t notify_queue_limit_mode;
     size_t notify_queue_limit;
+
+    // Enabled using anjay_set_observe_attributes_caching(). Entries cached in
+    // anjay_observe_path_entry_t are only valid if their generation number is
+    // equal to attrs_cache_generation, so incrementing it drops all of them.
+    bool attrs_cache_enabled;
+    uint64_t attrs_cache_generation;
+
+    // Enabled using anjay_set_observe_read_sharing(). Values read while
+    // handling notification triggers, shared by all observations that read the
+    // same path. Dropped by read_cache_clear_job, scheduled to run right after
+    // all triggers that are currently due, and whenever any change is queued
+    // for notification. Created lazily.
+    bool read_sharing_enabled;
+    AVS_SORTED_SET(anjay_observe_read_cache_entry_t) read_cache;
+    // incremented whenever read_cache is cleared, so that values read while
+    // the cache was being cleared are not stored in it
+    uint64_t read_cache_generation;
+    avs_sched_handle_t read_cache_clear_job;
+
+    // Values pushed with anjay_notify_value_changed_*(), used when notifying
+    // instead of calling the read handler. An entry is valid until the
+    // Resource is reported as changed by any other means, and is kept only
+    // while the Resource is observed by itself. Sorted by path, created
+    // lazily.
+    AVS_SORTED_SET(anjay_observe_pushed_value_t) pushed_values;
+
+#ifdef ANJAY_WITH_MEMORY_STATS
+    // Estimated heap usage of connection entries, observations, observed
+    // paths, notification values, pushed values and shared read values,
+    // updated whenever any of them is allocated or freed, so that the memory
+    // budget can be enforced without walking the whole state.
+    size_t memory_usage;
+#endif // ANJAY_WITH_MEMORY_STATS
 } anjay_observe_state_t;
 
 typedef struct {
@@ -80,6 +130,59 @@ int _anjay_observe_notify(anjay_unlocked_t *anjay,
                           anjay_ssid_t ssid,
                           bool invert_ssid_match);
 
+void _anjay_observe_set_attrs_caching(anjay_observe_state_t *observe,
+                                      bool enabled);
+
+void _anjay_observe_set_read_sharing(anjay_observe_state_t *observe,
+                                     bool enabled);
+
+/**
+ * Drops all effective attributes cached for observed paths. Shall be called
+ * whenever anything that attributes may be inherited from changes, i.e. the
+ * attributes themselves, the set of Instances of any Object or the Default
+ * Minimum/Maximum Period Resources of the Server Object.
+ */
+static inline void
+_anjay_observe_invalidate_attrs_cache(anjay_observe_state_t *observe) {
+    ++observe->attrs_cache_generation;
+}
+
+/**
+ * Drops all values shared between observations by the read sharing mechanism.
+ * Shall be called whenever any data model value may have changed, so that
+ * values read before the change are not used afterwards.
+ */
+void _anjay_observe_invalidate_read_cache(anjay_observe_state_t *observe);
+
+/**
+ * Checks whether @p path is observed by itself (and not only as part of an
+ * observation of an Object or Object Instance), on any connection.
+ */
+bool _anjay_observe_path_observed_exactly(anjay_unlocked_t *anjay,
+                                          const anjay_uri_path_t *path);
+
+/**
+ * Stores @p value as the current value of the single-instance Resource at
+ * @p path, replacing any value previously pushed for it.
+ *
+ * On success, ownership of @p value is taken over. On failure, the previously
+ * pushed value for @p path, if any, is dropped as well, and the caller remains
+ * responsible for @p value.
+ */
+int _anjay_observe_push_value(anjay_observe_state_t *observe,
+                              const anjay_uri_path_t *path,
+                              anjay_batch_t *value);
+
+/**
+ * Drops all pushed values of Resources at or below @p prefix.
+ */
+void _anjay_observe_drop_pushed_values(anjay_observe_state_t *observe,
+                                       const anjay_uri_path_t *prefix);
+
+#    ifdef ANJAY_WITH_MEMORY_STATS
+size_t _anjay_observe_memory_usage(const anjay_observe_state_t *observe);
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
 anjay_resource_observation_status_t
 _anjay_observe_status(anjay_unlocked_t *anjay,
@@ -96,6 +199,13 @@ _anjay_observe_status(anjay_unlocked_t *anjay,
 #    define _anjay_observe_interrupt(...) ((void) 0)
 #    define _anjay_observe_needs_flushing(...) false
 #    define _anjay_observe_sched_flush(...) 0
+#    define _anjay_observe_set_attrs_caching(...) ((void) 0)
+#    define _anjay_observe_set_read_sharing(...) ((void) 0)
+#    define _anjay_observe_invalidate_attrs_cache(...) ((void) 0)
+#    define _anjay_observe_invalidate_read_cache(...) ((void) 0)
+#    define _anjay_observe_path_observed_exactly(...) false
+#    define _anjay_observe_push_value(...) (-1)
+#    define _anjay_observe_drop_pushed_values(...) ((void) 0)
 
 #    ifdef ANJAY_WITH_OBSERVATION_STATUS
 #        define _anjay_observe_status(...)         \
@@ -11,6 +11,7 @@
 #define ANJAY_OBSERVE_INTERNAL_H
 
 #include "anjay_observe_core.h"
+#include "anjay_observe_wheel.h"
 
 #include <avsystem/coap/code.h>
 
@@ -23,7 +24,8 @@ struct anjay_observation_struct {
 
     const anjay_request_action_t action;
 
-    avs_sched_handle_t notify_task;
+    // armed in anjay_observe_connection_entry_t::trigger_wheel
+    anjay_observe_wheel_node_t trigger;
     avs_time_real_t last_confirmable;
     avs_time_real_t next_pmax_trigger;
 
@@ -49,8 +51,36 @@ typedef struct {
     // List of observations (pointers to elements inside
     // anjay_observe_connection_entry_t::observations) that include "path"
     AVS_LIST(AVS_SORTED_SET_ELEM(anjay_observation_t)) refs;
+
+    // Effective attributes of "path" for the SSID of the owning connection;
+    // valid only if cached_attrs_generation is equal to
+    // anjay_observe_state_t::attrs_cache_generation
+    anjay_dm_r_attributes_t cached_attrs;
+    uint64_t cached_attrs_generation;
 } anjay_observe_path_entry_t;
 
+typedef struct {
+    anjay_observe_connection_entry_t *connection;
+    AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry;
+} anjay_observe_path_index_ref_t;
+
+struct anjay_observe_path_index_entry_struct {
+    const anjay_uri_path_t path;
+
+    // One element for each connection that has "path" in its observed_paths,
+    // in the same order as anjay_observe_state_t::connection_entries
+    AVS_LIST(anjay_observe_path_index_ref_t) refs;
+};
+
+struct anjay_observe_read_cache_entry_struct {
+    anjay_uri_path_t path;
+    anjay_request_action_t action;
+    // ANJAY_SSID_ANY if "path" includes an Instance ID; the value does not
+    // depend on the reading server then, only access to it does
+    anjay_ssid_t ssid;
+    anjay_batch_t *value;
+};
+
 typedef struct {
     avs_stream_t *membuf_stream;
     anjay_unlocked_output_ctx_t *out_ctx;
@@ -68,8 +98,10 @@ struct anjay_observe_connection_entry_struct {
     avs_sched_handle_t flush_task;
     avs_coap_exchange_id_t notify_exchange_id;
     anjay_observation_serialization_state_t serialization_state;
-    avs_time_real_t next_trigger;
-    avs_time_real_t next_pmax_trigger;
+    // notification triggers of all observations; trigger_job is scheduled at
+    // the earliest deadline, or earlier
+    anjay_observe_wheel_t trigger_wheel;
+    avs_sched_handle_t trigger_job;
 
     AVS_LIST(anjay_observation_value_t) unsent;
     // pointer to the last element of unsent
@@ -103,6 +135,20 @@ int _anjay_observe_schedule_pmax_trigger(
         anjay_observe_connection_entry_t *conn_state,
         anjay_observation_t *entry);
 
+/**
+ * Returns the time of the earliest notification trigger of @p conn, or
+ * AVS_TIME_REAL_INVALID if there are none.
+ */
+avs_time_real_t
+_anjay_observe_next_trigger(const anjay_observe_connection_entry_t *conn);
+
+/**
+ * Returns the time of the earliest trigger of @p conn caused by pmax, or
+ * AVS_TIME_REAL_INVALID if there are none.
+ */
+avs_time_real_t
+_anjay_observe_next_pmax_trigger(const anjay_observe_connection_entry_t *conn);
+
 AVS_LIST(anjay_observe_connection_entry_t) *
 _anjay_observe_find_connection_state(anjay_connection_ref_t ref);
 
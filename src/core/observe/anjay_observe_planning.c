@@ -90,10 +90,16 @@ static int foreach_relevant_connection(anjay_unlocked_t *anjay,
         ((void) (Anjay), (void) (Ssid), (void) (ConnTypeMask),     \
          (void) (TransportSet))
 
+#    define _anjay_observe_next_trigger NULL
+#    define _anjay_observe_next_pmax_trigger NULL
+
 #endif // ANJAY_WITH_OBSERVE
 
+typedef avs_time_real_t
+next_trigger_getter_t(const anjay_observe_connection_entry_t *conn);
+
 typedef struct {
-    size_t trigger_field_offset;
+    next_trigger_getter_t *getter;
     avs_time_real_t result;
 } next_planned_trigger_cb_arg_t;
 
@@ -102,8 +108,7 @@ static int
 next_planned_trigger_cb(AVS_LIST(anjay_observe_connection_entry_t) *conn_ptr,
                         void *arg_) {
     next_planned_trigger_cb_arg_t *arg = (next_planned_trigger_cb_arg_t *) arg_;
-    avs_time_real_t trigger_time = *AVS_APPLY_OFFSET(avs_time_real_t, *conn_ptr,
-                                                     arg->trigger_field_offset);
+    avs_time_real_t trigger_time = arg->getter(*conn_ptr);
     if (!avs_time_real_valid(arg->result)
             || avs_time_real_before(trigger_time, arg->result)) {
         arg->result = trigger_time;
@@ -116,9 +121,9 @@ static avs_time_real_t next_planned_trigger(anjay_t *anjay_locked,
                                             anjay_ssid_t ssid,
                                             unsigned conn_type_mask,
                                             anjay_transport_set_t transport_set,
-                                            size_t trigger_field_offset) {
+                                            next_trigger_getter_t *getter) {
     next_planned_trigger_cb_arg_t arg = {
-        .trigger_field_offset = trigger_field_offset,
+        .getter = getter,
         .result = AVS_TIME_REAL_INVALID
     };
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
@@ -132,14 +137,14 @@ avs_time_real_t anjay_next_planned_notify_trigger(anjay_t *anjay,
                                                   anjay_ssid_t ssid) {
     return next_planned_trigger(
             anjay, ssid, 1 << ANJAY_CONNECTION_PRIMARY, ANJAY_TRANSPORT_SET_ALL,
-            offsetof(anjay_observe_connection_entry_t, next_trigger));
+            _anjay_observe_next_trigger);
 }
 
 avs_time_real_t anjay_next_planned_pmax_notify_trigger(anjay_t *anjay,
                                                        anjay_ssid_t ssid) {
     return next_planned_trigger(
             anjay, ssid, 1 << ANJAY_CONNECTION_PRIMARY, ANJAY_TRANSPORT_SET_ALL,
-            offsetof(anjay_observe_connection_entry_t, next_pmax_trigger));
+            _anjay_observe_next_pmax_trigger);
 }
 
 avs_time_real_t anjay_transport_next_planned_notify_trigger(
@@ -147,7 +152,7 @@ avs_time_real_t anjay_transport_next_planned_notify_trigger(
     return next_planned_trigger(
             anjay, ANJAY_SSID_ANY, (1 << ANJAY_CONNECTION_LIMIT_) - 1,
             transport_set,
-            offsetof(anjay_observe_connection_entry_t, next_trigger));
+            _anjay_observe_next_trigger);
 }
 
 avs_time_real_t anjay_transport_next_planned_pmax_notify_trigger(
@@ -155,7 +160,7 @@ avs_time_real_t anjay_transport_next_planned_pmax_notify_trigger(
     return next_planned_trigger(
             anjay, ANJAY_SSID_ANY, (1 << ANJAY_CONNECTION_LIMIT_) - 1,
             transport_set,
-            offsetof(anjay_observe_connection_entry_t, next_pmax_trigger));
+            _anjay_observe_next_pmax_trigger);
 }
 
 #ifdef ANJAY_WITH_OBSERVE
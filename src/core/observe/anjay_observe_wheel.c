@@ -0,0 +1,290 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#ifdef ANJAY_WITH_OBSERVE
+
+#    include <assert.h>
+
+#    include "anjay_observe_wheel.h"
+
+VISIBILITY_SOURCE_BEGIN
+
+#    define SLOT_MASK ((uint64_t) ANJAY_OBSERVE_WHEEL_SLOTS - 1)
+
+static inline int64_t tick_of(avs_time_monotonic_t time) {
+    return time.since_monotonic_epoch.seconds;
+}
+
+static inline unsigned level_shift(int level) {
+    return (unsigned) level * ANJAY_OBSERVE_WHEEL_LEVEL_BITS;
+}
+
+static inline size_t slot_index(int64_t tick, int level) {
+    return (size_t) (((uint64_t) tick >> level_shift(level)) & SLOT_MASK);
+}
+
+static bool slots_empty(const anjay_observe_wheel_t *wheel) {
+    for (int level = 0; level < ANJAY_OBSERVE_WHEEL_LEVELS; ++level) {
+        if (wheel->level_count[level]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void link_node(anjay_observe_wheel_node_t **head_ptr,
+                      anjay_observe_wheel_node_t *node) {
+    node->next = *head_ptr;
+    if (node->next) {
+        node->next->pprev = &node->next;
+    }
+    node->pprev = head_ptr;
+    *head_ptr = node;
+}
+
+static void unlink_node(anjay_observe_wheel_node_t *node) {
+    *node->pprev = node->next;
+    if (node->next) {
+        node->next->pprev = node->pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+static void place_node(anjay_observe_wheel_t *wheel,
+                       anjay_observe_wheel_node_t *node) {
+    int64_t tick = tick_of(node->deadline);
+    if (tick < wheel->current_tick) {
+        // already due; will be collected by the next advance
+        tick = wheel->current_tick;
+    }
+    const int64_t delta = tick - wheel->current_tick;
+    int level = 0;
+    while (level < ANJAY_OBSERVE_WHEEL_LEVELS - 1
+           && delta >= ((int64_t) 1 << level_shift(level + 1))) {
+        ++level;
+    }
+    const int64_t span = (int64_t) 1 << level_shift(ANJAY_OBSERVE_WHEEL_LEVELS);
+    if (delta >= span) {
+        // beyond the range of the wheel - keep in the farthest slot, the node
+        // will be placed again when that slot is cascaded
+        tick = wheel->current_tick + span - 1;
+    }
+    node->level = (int8_t) level;
+    ++wheel->level_count[level];
+    link_node(&wheel->slots[level][slot_index(tick, level)], node);
+}
+
+void _anjay_observe_wheel_disarm(anjay_observe_wheel_t *wheel,
+                                 anjay_observe_wheel_node_t *node) {
+    if (!_anjay_observe_wheel_node_armed(node)) {
+        return;
+    }
+    if (node->level != ANJAY_OBSERVE_WHEEL_LEVEL_EXPIRED) {
+        assert(wheel->level_count[node->level]);
+        --wheel->level_count[node->level];
+    }
+    unlink_node(node);
+}
+
+void _anjay_observe_wheel_arm(anjay_observe_wheel_t *wheel,
+                              anjay_observe_wheel_node_t *node,
+                              avs_time_monotonic_t deadline) {
+    assert(avs_time_monotonic_valid(deadline));
+    _anjay_observe_wheel_disarm(wheel, node);
+    if (slots_empty(wheel)) {
+        // nothing to cascade, so the wheel may skip the idle period at once
+        const int64_t now_tick = tick_of(avs_time_monotonic_now());
+        if (now_tick > wheel->current_tick) {
+            wheel->current_tick = now_tick;
+        }
+    }
+    node->deadline = deadline;
+    node->seq = wheel->next_seq++;
+    place_node(wheel, node);
+}
+
+static void cascade(anjay_observe_wheel_t *wheel, int level) {
+    anjay_observe_wheel_node_t **head_ptr =
+            &wheel->slots[level][slot_index(wheel->current_tick, level)];
+    anjay_observe_wheel_node_t *node = *head_ptr;
+    *head_ptr = NULL;
+    while (node) {
+        anjay_observe_wheel_node_t *next = node->next;
+        --wheel->level_count[level];
+        place_node(wheel, node);
+        node = next;
+    }
+}
+
+static void collect_due(anjay_observe_wheel_t *wheel,
+                        avs_time_monotonic_t now,
+                        anjay_observe_wheel_node_t **batch_ptr) {
+    anjay_observe_wheel_node_t *node =
+            wheel->slots[0][slot_index(wheel->current_tick, 0)];
+    while (node) {
+        anjay_observe_wheel_node_t *next = node->next;
+        if (!avs_time_monotonic_before(now, node->deadline)) {
+            --wheel->level_count[0];
+            unlink_node(node);
+            node->next = *batch_ptr;
+            *batch_ptr = node;
+        }
+        node = next;
+    }
+}
+
+static bool node_before(const anjay_observe_wheel_node_t *left,
+                        const anjay_observe_wheel_node_t *right) {
+    if (avs_time_monotonic_before(left->deadline, right->deadline)) {
+        return true;
+    } else if (avs_time_monotonic_before(right->deadline, left->deadline)) {
+        return false;
+    }
+    return left->seq < right->seq;
+}
+
+static anjay_observe_wheel_node_t *
+merge_nodes(anjay_observe_wheel_node_t *left,
+            anjay_observe_wheel_node_t *right) {
+    anjay_observe_wheel_node_t *result = NULL;
+    anjay_observe_wheel_node_t **tail_ptr = &result;
+    while (left && right) {
+        if (node_before(right, left)) {
+            *tail_ptr = right;
+            right = right->next;
+        } else {
+            *tail_ptr = left;
+            left = left->next;
+        }
+        tail_ptr = &(*tail_ptr)->next;
+    }
+    *tail_ptr = left ? left : right;
+    return result;
+}
+
+static anjay_observe_wheel_node_t *
+sort_nodes(anjay_observe_wheel_node_t *list) {
+    if (!list || !list->next) {
+        return list;
+    }
+    anjay_observe_wheel_node_t *middle = list;
+    anjay_observe_wheel_node_t *fast = list->next;
+    while (fast && fast->next) {
+        middle = middle->next;
+        fast = fast->next->next;
+    }
+    anjay_observe_wheel_node_t *second_half = middle->next;
+    middle->next = NULL;
+    return merge_nodes(sort_nodes(list), sort_nodes(second_half));
+}
+
+void _anjay_observe_wheel_advance(anjay_observe_wheel_t *wheel,
+                                  avs_time_monotonic_t now) {
+    const int64_t now_tick = tick_of(now);
+    anjay_observe_wheel_node_t *batch = NULL;
+    while (true) {
+        collect_due(wheel, now, &batch);
+        if (wheel->current_tick >= now_tick) {
+            break;
+        }
+        if (slots_empty(wheel)) {
+            wheel->current_tick = now_tick;
+            break;
+        }
+        if (wheel->level_count[0]) {
+            ++wheel->current_tick;
+        } else {
+            // skip straight to the next cascade of level 1
+            wheel->current_tick = AVS_MIN(
+                    (int64_t) ((uint64_t) wheel->current_tick | SLOT_MASK) + 1,
+                    now_tick);
+        }
+        for (int level = 1; level < ANJAY_OBSERVE_WHEEL_LEVELS
+                            && !slot_index(wheel->current_tick, level - 1);
+             ++level) {
+            cascade(wheel, level);
+        }
+    }
+
+    if (!batch) {
+        return;
+    }
+    // merge with nodes left over from the previous advance, if any
+    while (wheel->expired) {
+        anjay_observe_wheel_node_t *node = wheel->expired;
+        unlink_node(node);
+        node->next = batch;
+        batch = node;
+    }
+    wheel->expired = sort_nodes(batch);
+    anjay_observe_wheel_node_t **pprev = &wheel->expired;
+    for (anjay_observe_wheel_node_t *node = wheel->expired; node;
+         node = node->next) {
+        node->pprev = pprev;
+        node->level = ANJAY_OBSERVE_WHEEL_LEVEL_EXPIRED;
+        pprev = &node->next;
+    }
+}
+
+anjay_observe_wheel_node_t *
+_anjay_observe_wheel_pop_expired(anjay_observe_wheel_t *wheel) {
+    anjay_observe_wheel_node_t *node = wheel->expired;
+    if (node) {
+        unlink_node(node);
+    }
+    return node;
+}
+
+avs_time_monotonic_t
+_anjay_observe_wheel_next_deadline(const anjay_observe_wheel_t *wheel) {
+    if (wheel->expired) {
+        return wheel->expired->deadline;
+    }
+    avs_time_monotonic_t result = AVS_TIME_MONOTONIC_INVALID;
+    for (int level = 0; level < ANJAY_OBSERVE_WHEEL_LEVELS; ++level) {
+        if (!wheel->level_count[level]) {
+            continue;
+        }
+        // slots of level 0 start at the current tick; the slot of higher
+        // levels that includes the current tick has already been cascaded
+        const int64_t first_block =
+                (int64_t) ((uint64_t) wheel->current_tick >> level_shift(level))
+                + (level ? 1 : 0);
+        for (int64_t block = first_block;
+             block < first_block + ANJAY_OBSERVE_WHEEL_SLOTS; ++block) {
+            // all nodes in a slot expire no earlier than the block it stands
+            // for starts - except for the already due ones in the current
+            // slot of level 0, which is always checked first
+            if (avs_time_monotonic_valid(result)
+                    && tick_of(result) < block * ((int64_t) 1
+                                                  << level_shift(level))) {
+                break;
+            }
+            for (const anjay_observe_wheel_node_t *node =
+                         wheel->slots[level][(uint64_t) block & SLOT_MASK];
+                 node;
+                 node = node->next) {
+                if (!avs_time_monotonic_valid(result)
+                        || avs_time_monotonic_before(node->deadline, result)) {
+                    result = node->deadline;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+#    ifdef ANJAY_TEST
+#        include "tests/core/observe/wheel.c"
+#    endif // ANJAY_TEST
+
+#endif // ANJAY_WITH_OBSERVE
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_OBSERVE_WHEEL_H
+#define ANJAY_OBSERVE_WHEEL_H
+
+#include <stdint.h>
+
+#include <avsystem/commons/avs_time.h>
+
+VISIBILITY_PRIVATE_HEADER_BEGIN
+
+#define ANJAY_OBSERVE_WHEEL_LEVEL_BITS 5
+#define ANJAY_OBSERVE_WHEEL_SLOTS (1 << ANJAY_OBSERVE_WHEEL_LEVEL_BITS)
+#define ANJAY_OBSERVE_WHEEL_LEVELS 4
+
+/**
+ * Level of nodes that are already due, see anjay_observe_wheel_t::expired.
+ */
+#define ANJAY_OBSERVE_WHEEL_LEVEL_EXPIRED (-1)
+
+typedef struct anjay_observe_wheel_node_struct anjay_observe_wheel_node_t;
+
+/**
+ * Timer that can be armed in an anjay_observe_wheel_t. Meant to be embedded in
+ * the structure it triggers, and retrieved using AVS_CONTAINER_OF(). A zeroed
+ * node is valid and not armed.
+ */
+struct anjay_observe_wheel_node_struct {
+    anjay_observe_wheel_node_t *next;
+    // address of the pointer that points to this node; NULL if not armed
+    anjay_observe_wheel_node_t **pprev;
+    avs_time_monotonic_t deadline;
+    // order of arming, used to expire nodes with equal deadlines in the same
+    // order avs_sched would run the corresponding jobs
+    uint64_t seq;
+    int8_t level;
+};
+
+/**
+ * Hierarchical timing wheel that holds notification triggers of a single
+ * connection.
+ *
+ * Time is divided into ticks of one second. Level 0 has a slot for each of the
+ * next ANJAY_OBSERVE_WHEEL_SLOTS ticks, and each slot of level N covers as
+ * many ticks as the whole level N-1. Nodes in higher levels are cascaded to
+ * lower ones as the wheel advances. Nodes further in the future than the whole
+ * wheel spans are kept in the last slot of the highest level, and placed again
+ * when that slot is cascaded.
+ *
+ * Exact deadlines are stored in the nodes, so ticks only determine the slot a
+ * node is kept in - nodes never expire early or late because of them.
+ */
+typedef struct {
+    int64_t current_tick;
+    uint64_t next_seq;
+    size_t level_count[ANJAY_OBSERVE_WHEEL_LEVELS];
+    anjay_observe_wheel_node_t *slots[ANJAY_OBSERVE_WHEEL_LEVELS]
+                                     [ANJAY_OBSERVE_WHEEL_SLOTS];
+    // nodes collected by _anjay_observe_wheel_advance() that were not popped
+    // yet, sorted by deadline and seq
+    anjay_observe_wheel_node_t *expired;
+} anjay_observe_wheel_t;
+
+static inline bool
+_anjay_observe_wheel_node_armed(const anjay_observe_wheel_node_t *node) {
+    return node->pprev;
+}
+
+/**
+ * Returns the deadline a node is armed for, or AVS_TIME_MONOTONIC_INVALID if
+ * it is not armed.
+ */
+static inline avs_time_monotonic_t
+_anjay_observe_wheel_node_deadline(const anjay_observe_wheel_node_t *node) {
+    return _anjay_observe_wheel_node_armed(node) ? node->deadline
+                                                 : AVS_TIME_MONOTONIC_INVALID;
+}
+
+/**
+ * Arms @p node to expire at @p deadline, disarming it first if necessary.
+ * O(1).
+ */
+void _anjay_observe_wheel_arm(anjay_observe_wheel_t *wheel,
+                              anjay_observe_wheel_node_t *node,
+                              avs_time_monotonic_t deadline);
+
+/**
+ * Disarms @p node, if armed. O(1).
+ */
+void _anjay_observe_wheel_disarm(anjay_observe_wheel_t *wheel,
+                                 anjay_observe_wheel_node_t *node);
+
+/**
+ * Advances the wheel up to @p now, collecting all nodes with deadlines not
+ * later than @p now, so that they can be retrieved using
+ * _anjay_observe_wheel_pop_expired().
+ */
+void _anjay_observe_wheel_advance(anjay_observe_wheel_t *wheel,
+                                  avs_time_monotonic_t now);
+
+/**
+ * Disarms and returns the earliest node collected by the last call to
+ * _anjay_observe_wheel_advance(), or NULL if there are none left.
+ */
+anjay_observe_wheel_node_t *
+_anjay_observe_wheel_pop_expired(anjay_observe_wheel_t *wheel);
+
+/**
+ * Returns the earliest deadline of all armed nodes, or
+ * AVS_TIME_MONOTONIC_INVALID if there are none. Scans the slots of each
+ * non-empty level in order, until one that starts after the earliest deadline
+ * found so far.
+ */
+avs_time_monotonic_t
+_anjay_observe_wheel_next_deadline(const anjay_observe_wheel_t *wheel);
+
+VISIBILITY_PRIVATE_HEADER_END
+
+#endif /* ANJAY_OBSERVE_WHEEL_H */
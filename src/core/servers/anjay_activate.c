@@ -174,9 +174,9 @@ void _anjay_server_on_server_communication_error(anjay_server_info_t *server,
                                                  avs_error_t err) {
     assert(avs_is_err(err));
     avs_sched_del(&server->next_action_handle);
-    if (AVS_SCHED_NOW(server->anjay->sched, &server->next_action_handle,
-                      server_communication_error_job, &server,
-                      sizeof(server))) {
+    if (ANJAY_SCHED_NOW(server->anjay->sched, &server->next_action_handle,
+                        server_communication_error_job, &server,
+                        sizeof(server))) {
         anjay_log(ERROR,
                   _("could not schedule server_communication_error_job"));
         server->refresh_failed = true;
@@ -548,8 +548,8 @@ int anjay_disable_server(anjay_t *anjay_locked, anjay_ssid_t ssid) {
     anjay_server_info_t *server = _anjay_servers_find_active(anjay, ssid);
     if (server) {
         avs_sched_del(&server->next_action_handle);
-        if (AVS_SCHED_NOW(anjay->sched, &server->next_action_handle,
-                          disable_server_job, &ssid, sizeof(ssid))) {
+        if (ANJAY_SCHED_NOW(anjay->sched, &server->next_action_handle,
+                            disable_server_job, &ssid, sizeof(ssid))) {
             anjay_log(ERROR, _("could not schedule disable_server_job"));
         } else {
             result = 0;
@@ -603,8 +603,8 @@ int _anjay_disable_server_with_timeout_unlocked(anjay_unlocked_t *anjay,
     };
 
     avs_sched_del(&server->next_action_handle);
-    if (AVS_SCHED_NOW(anjay->sched, &server->next_action_handle,
-                      disable_server_with_timeout_job, &data, sizeof(data))) {
+    if (ANJAY_SCHED_NOW(anjay->sched, &server->next_action_handle,
+                        disable_server_with_timeout_job, &data, sizeof(data))) {
         anjay_log(ERROR,
                   _("could not schedule disable_server_with_timeout_job"));
         return -1;
@@ -88,9 +88,10 @@ static int schedule_update(anjay_server_info_t *server,
     anjay_log(DEBUG, _("scheduling update for SSID ") "%u" _(" after ") "%s",
               server->ssid, AVS_TIME_DURATION_AS_STRING(delay));
 
-    return AVS_SCHED_DELAYED(server->anjay->sched, &server->next_action_handle,
-                             delay, send_update_sched_job, &server->ssid,
-                             sizeof(server->ssid));
+    return ANJAY_SCHED_DELAYED(server->anjay->sched,
+                               &server->next_action_handle, delay,
+                               send_update_sched_job, &server->ssid,
+                               sizeof(server->ssid));
 }
 
 static avs_time_real_t time_of_next_update(anjay_server_info_t *server) {
@@ -576,6 +577,28 @@ check_register_response(const avs_coap_response_header_t *response,
     return ANJAY_REGISTRATION_SUCCESS;
 }
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+static void record_registration_stats(anjay_server_info_t *server,
+                                      anjay_operation_t operation,
+                                      anjay_registration_result_t result) {
+    _anjay_operation_stats_record(
+            server->anjay, server->ssid, operation,
+            server->registration_exchange_state.send_time,
+            result != ANJAY_REGISTRATION_SUCCESS);
+}
+
+/**
+ * Accounts for a Register or Update that could not even be sent, so no
+ * response handler will ever be called for it.
+ */
+static void record_registration_send_failure(anjay_server_info_t *server,
+                                             anjay_operation_t operation,
+                                             avs_time_monotonic_t start_time) {
+    _anjay_operation_stats_record(server->anjay, server->ssid, operation,
+                                  start_time, true);
+}
+#endif // ANJAY_WITH_OPERATION_STATS
+
 static void register_with_version(anjay_server_info_t *server,
                                   anjay_lwm2m_version_t lwm2m_version,
                                   anjay_update_parameters_t *move_params);
@@ -665,9 +688,13 @@ receive_register_response(avs_coap_ctx_t *coap,
         return;
     }
 
-    handle_register_response(AVS_CONTAINER_OF(state, anjay_server_info_t,
-                                              registration_exchange_state),
-                             state->attempted_version, &endpoint_path,
+    anjay_server_info_t *server =
+            AVS_CONTAINER_OF(state, anjay_server_info_t,
+                             registration_exchange_state);
+#ifdef ANJAY_WITH_OPERATION_STATS
+    record_registration_stats(server, ANJAY_OPERATION_REGISTER, result);
+#endif // ANJAY_WITH_OPERATION_STATS
+    handle_register_response(server, state->attempted_version, &endpoint_path,
                              &state->new_params, result, err);
     assert(!endpoint_path);
 }
@@ -707,6 +734,9 @@ static void send_register(anjay_server_info_t *server,
     get_binding_mode_for_version(server, lwm2m_version,
                                  &move_params->binding_mode);
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+    const avs_time_monotonic_t start_time = avs_time_monotonic_now();
+#endif // ANJAY_WITH_OPERATION_STATS
     avs_error_t err;
     if (avs_is_err((err = avs_coap_options_dynamic_init(&request.options)))
             || avs_is_err((err = setup_register_request_options(
@@ -715,6 +745,10 @@ static void send_register(anjay_server_info_t *server,
                                    connection_uri, lwm2m11_queue_mode,
                                    move_params->lifetime_s,
                                    &move_params->binding_mode)))) {
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_REGISTER,
+                                         start_time);
+#endif // ANJAY_WITH_OPERATION_STATS
         _anjay_server_on_updated_registration(
                 server, ANJAY_REGISTRATION_ERROR_OTHER, err);
         goto cleanup;
@@ -733,6 +767,9 @@ static void send_register(anjay_server_info_t *server,
     server->registration_exchange_state.attempted_version = lwm2m_version;
     move_assign_update_params(&server->registration_exchange_state.new_params,
                               move_params);
+#ifdef ANJAY_WITH_OPERATION_STATS
+    server->registration_exchange_state.send_time = start_time;
+#endif // ANJAY_WITH_OPERATION_STATS
     if (avs_is_err(
                 (err = avs_coap_client_send_async_request(
                          coap, &server->registration_exchange_state.exchange_id,
@@ -742,9 +779,17 @@ static void send_register(anjay_server_info_t *server,
                          &server->registration_exchange_state)))) {
         anjay_log(ERROR, _("could not send Register: ") "%s",
                   AVS_COAP_STRERROR(err));
+        _anjay_trace(server->anjay, ANJAY_TRACE_COAP_SEND, server->ssid, NULL,
+                     "Register", -1);
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_REGISTER,
+                                         start_time);
+#endif // ANJAY_WITH_OPERATION_STATS
         _anjay_server_on_updated_registration(server, map_coap_error(err), err);
     } else {
         anjay_log(INFO, _("Register sent"));
+        _anjay_trace(server->anjay, ANJAY_TRACE_COAP_SEND, server->ssid, NULL,
+                     "Register", 0);
     }
 cleanup:
     avs_coap_options_cleanup(&request.options);
@@ -759,6 +804,10 @@ static void register_with_version(anjay_server_info_t *server,
     };
     if (!_anjay_connection_get_online_socket(connection)) {
         anjay_log(ERROR, _("server connection is not online"));
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_REGISTER,
+                                         avs_time_monotonic_now());
+#endif // ANJAY_WITH_OPERATION_STATS
         _anjay_server_on_updated_registration(
                 server, ANJAY_REGISTRATION_ERROR_OTHER, avs_errno(AVS_EBADF));
     } else {
@@ -958,9 +1007,13 @@ receive_update_response(avs_coap_ctx_t *coap,
         return;
     }
 
-    on_registration_update_result(AVS_CONTAINER_OF(state, anjay_server_info_t,
-                                                   registration_exchange_state),
-                                  &state->new_params, result, err);
+    anjay_server_info_t *server =
+            AVS_CONTAINER_OF(state, anjay_server_info_t,
+                             registration_exchange_state);
+#ifdef ANJAY_WITH_OPERATION_STATS
+    record_registration_stats(server, ANJAY_OPERATION_UPDATE, result);
+#endif // ANJAY_WITH_OPERATION_STATS
+    on_registration_update_result(server, &state->new_params, result, err);
 }
 
 static void send_update(anjay_server_info_t *server,
@@ -973,6 +1026,9 @@ static void send_update(anjay_server_info_t *server,
     };
     bool dm_changed_since_last_update;
 
+#ifdef ANJAY_WITH_OPERATION_STATS
+    const avs_time_monotonic_t start_time = avs_time_monotonic_now();
+#endif // ANJAY_WITH_OPERATION_STATS
     avs_error_t err;
     if (avs_is_err((err = avs_coap_options_dynamic_init(&request.options)))
             || avs_is_err((err = setup_update_request_options(
@@ -981,6 +1037,10 @@ static void send_update(anjay_server_info_t *server,
                                    &old_info->last_update_params, move_params,
                                    &dm_changed_since_last_update)))) {
         anjay_log(ERROR, _("could not setup update request"));
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_UPDATE,
+                                         start_time);
+#endif // ANJAY_WITH_OPERATION_STATS
         on_registration_update_result(server, move_params,
                                       ANJAY_REGISTRATION_ERROR_OTHER, err);
         goto end;
@@ -999,6 +1059,9 @@ static void send_update(anjay_server_info_t *server,
             old_info->lwm2m_version;
     move_assign_update_params(&server->registration_exchange_state.new_params,
                               move_params);
+#ifdef ANJAY_WITH_OPERATION_STATS
+    server->registration_exchange_state.send_time = start_time;
+#endif // ANJAY_WITH_OPERATION_STATS
     if (avs_is_err((
                 err = avs_coap_client_send_async_request(
                         coap, &server->registration_exchange_state.exchange_id,
@@ -1009,10 +1072,18 @@ static void send_update(anjay_server_info_t *server,
                         &server->registration_exchange_state)))) {
         anjay_log(ERROR, _("could not send Update: ") "%s",
                   AVS_COAP_STRERROR(err));
+        _anjay_trace(server->anjay, ANJAY_TRACE_COAP_SEND, server->ssid, NULL,
+                     "Update", -1);
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_UPDATE,
+                                         start_time);
+#endif // ANJAY_WITH_OPERATION_STATS
         on_registration_update_result(server, move_params, map_coap_error(err),
                                       err);
     } else {
         anjay_log(INFO, _("Update sent"));
+        _anjay_trace(server->anjay, ANJAY_TRACE_COAP_SEND, server->ssid, NULL,
+                     "Update", 0);
     }
 end:
     avs_coap_options_cleanup(&request.options);
@@ -1039,6 +1110,10 @@ static void update_registration(anjay_server_info_t *server,
     };
     if (!_anjay_connection_get_online_socket(connection)) {
         anjay_log(ERROR, _("server connection is not online"));
+#ifdef ANJAY_WITH_OPERATION_STATS
+        record_registration_send_failure(server, ANJAY_OPERATION_UPDATE,
+                                         avs_time_monotonic_now());
+#endif // ANJAY_WITH_OPERATION_STATS
         on_registration_update_result(server, move_params,
                                       ANJAY_REGISTRATION_ERROR_OTHER,
                                       avs_errno(AVS_EBADF));
@@ -184,7 +184,7 @@ static void reload_servers_sched_job(avs_sched_t *sched, const void *unused) {
 static int schedule_reload_servers(anjay_unlocked_t *anjay, bool delayed) {
     static const long RELOAD_DELAY_S = 5;
     if (!anjay->sched
-            || AVS_SCHED_DELAYED(
+            || ANJAY_SCHED_DELAYED(
                        anjay->sched, &anjay->reload_servers_sched_job_handle,
                        avs_time_duration_from_scalar(
                                delayed ? RELOAD_DELAY_S : 0, AVS_TIME_S),
@@ -205,8 +205,9 @@ int _anjay_schedule_delayed_reload_servers(anjay_unlocked_t *anjay) {
 
 int _anjay_schedule_refresh_server(anjay_server_info_t *server,
                                    avs_time_duration_t delay) {
-    if (AVS_SCHED_DELAYED(server->anjay->sched, &server->next_action_handle,
-                          delay, refresh_server_job, &server, sizeof(server))) {
+    if (ANJAY_SCHED_DELAYED(server->anjay->sched, &server->next_action_handle,
+                            delay, refresh_server_job, &server,
+                            sizeof(server))) {
         anjay_log(ERROR, _("could not schedule refresh_server_job"));
         return -1;
     }
@@ -445,9 +445,9 @@ void _anjay_connection_schedule_queue_mode_close(anjay_connection_ref_t ref) {
                                                    connection->transport);
 
     // see comment on field declaration for logic summary
-    if (AVS_SCHED_DELAYED(ref.server->anjay->sched,
-                          &connection->queue_mode_close_socket_clb, delay,
-                          queue_mode_close_socket, &ref, sizeof(ref))) {
+    if (ANJAY_SCHED_DELAYED(ref.server->anjay->sched,
+                            &connection->queue_mode_close_socket_clb, delay,
+                            queue_mode_close_socket, &ref, sizeof(ref))) {
         anjay_log(ERROR, _("could not schedule queue mode operations"));
     }
 }
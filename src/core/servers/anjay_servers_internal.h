@@ -26,6 +26,9 @@ typedef struct {
     avs_coap_exchange_id_t exchange_id;
     anjay_lwm2m_version_t attempted_version;
     anjay_update_parameters_t new_params;
+#ifdef ANJAY_WITH_OPERATION_STATS
+    avs_time_monotonic_t send_time;
+#endif // ANJAY_WITH_OPERATION_STATS
 } anjay_registration_async_exchange_state_t;
 
 /**
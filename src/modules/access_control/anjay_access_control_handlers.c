@@ -65,6 +65,12 @@ ac_instance_reset(anjay_unlocked_t *anjay, obj_ptr_t obj_ptr, anjay_iid_t iid) {
     if (!inst) {
         return ANJAY_ERR_NOT_FOUND;
     }
+    int result =
+            _anjay_access_control_transaction_save_instance(access_control,
+                                                            iid);
+    if (result) {
+        return result;
+    }
     AVS_LIST_CLEAR(&inst->acl);
     inst->has_acl = false;
     inst->owner = 0;
@@ -79,6 +85,12 @@ static int ac_instance_create(anjay_unlocked_t *anjay,
     (void) anjay;
     access_control_t *access_control =
             _anjay_access_control_from_obj_ptr(obj_ptr);
+    int retval =
+            _anjay_access_control_transaction_save_instance(access_control,
+                                                            iid);
+    if (retval) {
+        return retval;
+    }
     AVS_LIST(access_control_instance_t) new_instance =
             AVS_LIST_NEW_ELEMENT(access_control_instance_t);
     if (!new_instance) {
@@ -95,8 +107,8 @@ static int ac_instance_create(anjay_unlocked_t *anjay,
         .has_acl = false,
         .acl = NULL
     };
-    int retval = _anjay_access_control_add_instance(access_control,
-                                                    new_instance, NULL);
+    retval = _anjay_access_control_add_instance(access_control, new_instance,
+                                                NULL);
     if (retval) {
         AVS_LIST_CLEAR(&new_instance);
     }
@@ -111,6 +123,12 @@ static int ac_instance_remove(anjay_unlocked_t *anjay,
     (void) anjay;
     access_control_t *access_control =
             _anjay_access_control_from_obj_ptr(obj_ptr);
+    int result =
+            _anjay_access_control_transaction_save_instance(access_control,
+                                                            iid);
+    if (result) {
+        return result;
+    }
     AVS_LIST(access_control_instance_t) *it;
     AVS_LIST_FOREACH_PTR(it, &access_control->current.instances) {
         if ((*it)->iid == iid) {
@@ -236,6 +254,12 @@ static int ac_resource_write(anjay_unlocked_t *anjay,
     if (!inst) {
         return ANJAY_ERR_NOT_FOUND;
     }
+    int result =
+            _anjay_access_control_transaction_save_instance(access_control,
+                                                            iid);
+    if (result) {
+        return result;
+    }
 
     switch (rid) {
     case ANJAY_DM_RID_ACCESS_CONTROL_OID: {
@@ -306,6 +330,12 @@ static int ac_resource_reset(anjay_unlocked_t *anjay,
     if (!inst) {
         return ANJAY_ERR_NOT_FOUND;
     }
+    int result =
+            _anjay_access_control_transaction_save_instance(access_control,
+                                                            iid);
+    if (result) {
+        return result;
+    }
 
     assert(rid == ANJAY_DM_RID_ACCESS_CONTROL_ACL);
     (void) rid;
@@ -344,14 +374,103 @@ static int ac_list_resource_instances(anjay_unlocked_t *anjay,
     }
 }
 
+static AVS_LIST(access_control_undo_entry_t) *
+find_undo_entry_ptr(access_control_t *ac, anjay_iid_t iid) {
+    AVS_LIST(access_control_undo_entry_t) *it;
+    AVS_LIST_FOREACH_PTR(it, &ac->undo_log) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static AVS_LIST(access_control_instance_t) *
+find_instance_ptr(AVS_LIST(access_control_instance_t) *instances,
+                  anjay_iid_t iid) {
+    AVS_LIST(access_control_instance_t) *it;
+    AVS_LIST_FOREACH_PTR(it, instances) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+int _anjay_access_control_transaction_save_instance(access_control_t *ac,
+                                                    anjay_iid_t iid) {
+    if (!ac->in_transaction || ac->has_saved_state) {
+        return 0;
+    }
+    AVS_LIST(access_control_undo_entry_t) *entry_ptr =
+            find_undo_entry_ptr(ac, iid);
+    if (*entry_ptr && (*entry_ptr)->iid == iid) {
+        return 0;
+    }
+    AVS_LIST(access_control_undo_entry_t) entry =
+            AVS_LIST_NEW_ELEMENT(access_control_undo_entry_t);
+    if (!entry) {
+        ac_log(ERROR, _("out of memory"));
+        return ANJAY_ERR_INTERNAL;
+    }
+    entry->iid = iid;
+    AVS_LIST(access_control_instance_t) instance =
+            *find_instance_ptr(&ac->current.instances, iid);
+    if (instance && instance->iid == iid
+            && !(entry->saved =
+                         _anjay_access_control_clone_instance(instance))) {
+        AVS_LIST_CLEAR(&entry);
+        return ANJAY_ERR_INTERNAL;
+    }
+    AVS_LIST_INSERT(entry_ptr, entry);
+    return 0;
+}
+
+int _anjay_access_control_transaction_save_all(access_control_t *ac) {
+    if (!ac->in_transaction || ac->has_saved_state) {
+        return 0;
+    }
+    assert(!ac->saved_state.instances);
+    // copy the instances that have not been touched yet...
+    AVS_LIST(access_control_instance_t) *tail = &ac->saved_state.instances;
+    AVS_LIST(access_control_instance_t) it;
+    AVS_LIST_FOREACH(it, ac->current.instances) {
+        AVS_LIST(access_control_undo_entry_t) entry =
+                *find_undo_entry_ptr(ac, it->iid);
+        if (entry && entry->iid == it->iid) {
+            continue;
+        }
+        if (!(*tail = _anjay_access_control_clone_instance(it))) {
+            const bool modified = ac->saved_state.modified_since_persist;
+            _anjay_access_control_clear_state(&ac->saved_state);
+            ac->saved_state.modified_since_persist = modified;
+            return ANJAY_ERR_INTERNAL;
+        }
+        AVS_LIST_ADVANCE_PTR(&tail);
+    }
+    // ...and move the saved versions of the touched ones
+    AVS_LIST(access_control_undo_entry_t) entry;
+    AVS_LIST_FOREACH(entry, ac->undo_log) {
+        if (entry->saved) {
+            AVS_LIST_INSERT(find_instance_ptr(&ac->saved_state.instances,
+                                              entry->iid),
+                            entry->saved);
+            entry->saved = NULL;
+        }
+    }
+    _anjay_access_control_clear_undo_log(ac);
+    ac->has_saved_state = true;
+    return 0;
+}
+
 static int ac_transaction_begin(anjay_unlocked_t *anjay, obj_ptr_t obj_ptr) {
     (void) anjay;
     access_control_t *ac = _anjay_access_control_from_obj_ptr(obj_ptr);
     assert(!ac->in_transaction);
-    if (_anjay_access_control_clone_state(&ac->saved_state, &ac->current)) {
-        ac_log(ERROR, _("out of memory"));
-        return ANJAY_ERR_INTERNAL;
-    }
+    assert(!ac->saved_state.instances);
+    assert(!ac->undo_log);
+    ac->saved_state.modified_since_persist =
+            ac->current.modified_since_persist;
     ac->in_transaction = true;
     return 0;
 }
@@ -448,7 +567,9 @@ static int ac_transaction_commit(anjay_unlocked_t *anjay, obj_ptr_t obj_ptr) {
     (void) anjay;
     access_control_t *ac = _anjay_access_control_from_obj_ptr(obj_ptr);
     assert(ac->in_transaction);
+    _anjay_access_control_clear_undo_log(ac);
     _anjay_access_control_clear_state(&ac->saved_state);
+    ac->has_saved_state = false;
     ac->needs_validation = false;
     ac->in_transaction = false;
     return 0;
@@ -458,8 +579,28 @@ static int ac_transaction_rollback(anjay_unlocked_t *anjay, obj_ptr_t obj_ptr) {
     (void) anjay;
     access_control_t *ac = _anjay_access_control_from_obj_ptr(obj_ptr);
     assert(ac->in_transaction);
-    _anjay_access_control_clear_state(&ac->current);
-    ac->current = ac->saved_state;
+    if (ac->has_saved_state) {
+        _anjay_access_control_clear_state(&ac->current);
+        ac->current = ac->saved_state;
+        ac->has_saved_state = false;
+    } else {
+        AVS_LIST(access_control_undo_entry_t) entry;
+        AVS_LIST_FOREACH(entry, ac->undo_log) {
+            AVS_LIST(access_control_instance_t) *ptr =
+                    find_instance_ptr(&ac->current.instances, entry->iid);
+            if (*ptr && (*ptr)->iid == entry->iid) {
+                AVS_LIST_CLEAR(&(*ptr)->acl);
+                AVS_LIST_DELETE(ptr);
+            }
+            if (entry->saved) {
+                AVS_LIST_INSERT(ptr, entry->saved);
+                entry->saved = NULL;
+            }
+        }
+        _anjay_access_control_clear_undo_log(ac);
+        ac->current.modified_since_persist =
+                ac->saved_state.modified_since_persist;
+    }
     memset(&ac->saved_state, 0, sizeof(ac->saved_state));
     ac->needs_validation = false;
     ac->in_transaction = false;
@@ -470,16 +611,52 @@ static int ac_transaction_rollback(anjay_unlocked_t *anjay, obj_ptr_t obj_ptr) {
 static void ac_delete(void *access_control_) {
     access_control_t *access_control = (access_control_t *) access_control_;
     _anjay_access_control_clear_state(&access_control->current);
+    _anjay_access_control_clear_undo_log(access_control);
     _anjay_access_control_clear_state(&access_control->saved_state);
     // NOTE: access_control itself will be freed when cleaning the objects list
 }
 
+#    ifdef ANJAY_WITH_MEMORY_STATS
+static size_t state_memory_usage(const access_control_state_t *state) {
+    size_t result = 0;
+    AVS_LIST(access_control_instance_t) instance;
+    AVS_LIST_FOREACH(instance, state->instances) {
+        result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*instance))
+                  + AVS_LIST_SIZE(instance->acl)
+                            * ANJAY_LIST_ELEMENT_MEMORY(sizeof(acl_entry_t));
+    }
+    return result;
+}
+
+static size_t ac_memory_usage(void *access_control_) {
+    access_control_t *access_control = (access_control_t *) access_control_;
+    size_t result = ANJAY_LIST_ELEMENT_MEMORY(sizeof(*access_control))
+                    + state_memory_usage(&access_control->current);
+    if (access_control->in_transaction) {
+        result += state_memory_usage(&access_control->saved_state);
+    }
+    AVS_LIST(access_control_undo_entry_t) entry;
+    AVS_LIST_FOREACH(entry, access_control->undo_log) {
+        result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*entry));
+        if (entry->saved) {
+            result += ANJAY_LIST_ELEMENT_MEMORY(sizeof(*entry->saved))
+                      + AVS_LIST_SIZE(entry->saved->acl)
+                                * ANJAY_LIST_ELEMENT_MEMORY(
+                                          sizeof(acl_entry_t));
+        }
+    }
+    return result;
+}
+#    endif // ANJAY_WITH_MEMORY_STATS
+
 void anjay_access_control_purge(anjay_t *anjay_locked) {
     assert(anjay_locked);
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
     access_control_t *ac = _anjay_access_control_get(anjay);
     if (!ac) {
         ac_log(ERROR, _("Access Control object is not registered"));
+    } else if (_anjay_access_control_transaction_save_all(ac)) {
+        ac_log(ERROR, _("Could not purge Access Control object"));
     } else {
         _anjay_access_control_clear_state(&ac->current);
         _anjay_access_control_mark_modified(ac);
@@ -511,7 +688,10 @@ bool anjay_access_control_is_modified(anjay_t *anjay_locked) {
 }
 
 static const anjay_dm_module_t ACCESS_CONTROL_MODULE = {
-    .deleter = ac_delete
+    .deleter = ac_delete,
+#    ifdef ANJAY_WITH_MEMORY_STATS
+    .memory_usage = ac_memory_usage
+#    endif // ANJAY_WITH_MEMORY_STATS
 };
 
 static const anjay_unlocked_dm_object_def_t ACCESS_CONTROL = {
@@ -16,6 +16,7 @@
 #    endif // AVS_COMMONS_WITH_AVS_PERSISTENCE
 
 #    include <anjay/access_control.h>
+#    include <anjay_modules/anjay_access_utils.h>
 
 #    include "anjay_mod_access_control.h"
 
@@ -156,6 +157,8 @@ avs_error_t anjay_access_control_persist(anjay_t *anjay_locked,
     if (!ac) {
         ac_log(ERROR, _("Access Control not installed in this Anjay object"));
         err = avs_errno(AVS_EBADF);
+    } else if (_anjay_access_control_transaction_save_all(ac)) {
+        err = avs_errno(AVS_ENOMEM);
     } else if (avs_is_ok((err = avs_stream_write(out, MAGIC, sizeof(MAGIC))))) {
         avs_persistence_context_t ctx =
                 avs_persistence_store_context_create(out);
@@ -193,6 +196,7 @@ avs_error_t anjay_access_control_restore(anjay_t *anjay_locked,
         ac_log(WARNING, _("header magic constant mismatch"));
         err = avs_errno(AVS_EBADMSG);
     } else if (avs_is_ok((err = restore(anjay, ac, in)))) {
+        _anjay_access_mask_cache_invalidate(anjay, ANJAY_ID_INVALID);
         _anjay_access_control_clear_modified(ac);
         ac_log(INFO, _("Access Control state restored"));
     }
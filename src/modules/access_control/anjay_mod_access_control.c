@@ -35,38 +35,26 @@ void _anjay_access_control_clear_state(access_control_state_t *state) {
     state->modified_since_persist = false;
 }
 
-int _anjay_access_control_clone_state(access_control_state_t *dest,
-                                      const access_control_state_t *src) {
-    assert(!dest->instances);
-    AVS_LIST(access_control_instance_t) *dest_tail = &dest->instances;
-    AVS_LIST(access_control_instance_t) src_inst;
-    AVS_LIST_FOREACH(src_inst, src->instances) {
-        AVS_LIST(access_control_instance_t) dest_inst =
-                AVS_LIST_NEW_ELEMENT(access_control_instance_t);
-        if (!dest_inst) {
-            goto error;
-        }
-        AVS_LIST_INSERT(dest_tail, dest_inst);
-        AVS_LIST_ADVANCE_PTR(&dest_tail);
-        *dest_inst = *src_inst;
-        dest_inst->acl = NULL;
-        AVS_LIST(acl_entry_t) *dest_acl_tail = &dest_inst->acl;
-        AVS_LIST(acl_entry_t) src_acl;
-        AVS_LIST_FOREACH(src_acl, src_inst->acl) {
-            AVS_LIST(acl_entry_t) dest_acl = AVS_LIST_NEW_ELEMENT(acl_entry_t);
-            if (!dest_acl) {
-                goto error;
-            }
-            AVS_LIST_INSERT(dest_acl_tail, dest_acl);
-            AVS_LIST_ADVANCE_PTR(&dest_acl_tail);
-            *dest_acl = *src_acl;
-        }
+AVS_LIST(access_control_instance_t)
+_anjay_access_control_clone_instance(const access_control_instance_t *src) {
+    AVS_LIST(access_control_instance_t) dest =
+            AVS_LIST_NEW_ELEMENT(access_control_instance_t);
+    if (!dest) {
+        ac_log(ERROR, _("out of memory"));
+        return NULL;
+    }
+    *dest = *src;
+    if (src->acl && !(dest->acl = AVS_LIST_SIMPLE_CLONE(src->acl))) {
+        ac_log(ERROR, _("out of memory"));
+        AVS_LIST_CLEAR(&dest);
+    }
+    return dest;
+}
+
+void _anjay_access_control_clear_undo_log(access_control_t *ac) {
+    AVS_LIST_CLEAR(&ac->undo_log) {
+        ac_instances_cleanup(&ac->undo_log->saved);
     }
-    dest->modified_since_persist = src->modified_since_persist;
-    return 0;
-error:
-    _anjay_access_control_clear_state(dest);
-    return -1;
 }
 
 static int add_instances_without_iids(
@@ -271,6 +259,9 @@ static int set_acl(anjay_unlocked_t *anjay,
                    anjay_iid_t iid,
                    anjay_ssid_t ssid,
                    anjay_access_mask_t access_mask) {
+    if (_anjay_access_control_transaction_save_all(ac)) {
+        return -1;
+    }
     bool ac_instance_needs_inserting = false;
     AVS_LIST(access_control_instance_t) ac_instance =
             find_ac_instance(ac, oid, iid);
@@ -345,6 +336,9 @@ static int ac_set_owner_unlocked(anjay_unlocked_t *anjay,
         ac_log(ERROR, _("Cannot set ACL owner: SSID = 0 is a reserved value"));
         return -1;
     }
+    if (_anjay_access_control_transaction_save_all(ac)) {
+        return -1;
+    }
 
     bool ac_instance_needs_inserting = false;
     AVS_LIST(access_control_instance_t) ac_instance =
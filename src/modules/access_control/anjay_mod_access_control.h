@@ -47,11 +47,27 @@ typedef struct {
     bool modified_since_persist;
 } access_control_state_t;
 
+typedef struct {
+    anjay_iid_t iid;
+    /* state of the instance before the transaction, NULL if it didn't exist */
+    AVS_LIST(access_control_instance_t) saved;
+} access_control_undo_entry_t;
+
 typedef struct {
     anjay_dm_installed_object_t obj_def_ptr;
     const anjay_unlocked_dm_object_def_t *obj_def;
     access_control_state_t current;
+    /**
+     * Instances touched during the current transaction, sorted by IID. Only
+     * used while has_saved_state is false.
+     */
+    AVS_LIST(access_control_undo_entry_t) undo_log;
+    /**
+     * Full copy of the state before the current transaction. Only created on
+     * demand, see _anjay_access_control_transaction_save_all().
+     */
     access_control_state_t saved_state;
+    bool has_saved_state;
     bool in_transaction;
     access_control_instance_t *last_accessed_instance;
     bool needs_validation;
@@ -76,8 +92,25 @@ access_control_t *_anjay_access_control_get(anjay_unlocked_t *anjay);
 
 void _anjay_access_control_clear_state(access_control_state_t *state);
 
-int _anjay_access_control_clone_state(access_control_state_t *dest,
-                                      const access_control_state_t *src);
+AVS_LIST(access_control_instance_t)
+_anjay_access_control_clone_instance(const access_control_instance_t *src);
+
+void _anjay_access_control_clear_undo_log(access_control_t *ac);
+
+/**
+ * Saves the current state of the instance @p iid (or the fact that it does not
+ * exist) so that it can be restored on rollback. Shall be called before each
+ * modification of the instance set or instance contents. Does nothing if not
+ * in transaction or if the instance has already been saved.
+ */
+int _anjay_access_control_transaction_save_instance(access_control_t *ac,
+                                                    anjay_iid_t iid);
+
+/**
+ * Makes repr->saved_state contain the full state of the object from before
+ * the current transaction. Does nothing if not in transaction.
+ */
+int _anjay_access_control_transaction_save_all(access_control_t *ac);
 
 int _anjay_access_control_validate_ssid(anjay_unlocked_t *anjay,
                                         anjay_ssid_t ssid);
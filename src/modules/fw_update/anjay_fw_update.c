@@ -735,10 +735,10 @@ static void resume_download_job(avs_sched_t *sched, const void *args_) {
     } else {
         fw_log(DEBUG,
                _("ongoing registration exists, delaying download resumption"));
-        if (AVS_SCHED_DELAYED(sched, &args->fw->resume_download_job,
-                              avs_time_duration_from_scalar(1, AVS_TIME_S),
-                              resume_download_job, args,
-                              schedule_download_args_size(args->etag.size))) {
+        if (ANJAY_SCHED_DELAYED(sched, &args->fw->resume_download_job,
+                                avs_time_duration_from_scalar(1, AVS_TIME_S),
+                                resume_download_job, args,
+                                schedule_download_args_size(args->etag.size))) {
             fw_log(WARNING, _("could not schedule another resumption attempt"));
             reset_user_state(anjay, args->fw);
             update_state_and_update_result(
@@ -768,9 +768,9 @@ static int schedule_background_anjay_download(anjay_unlocked_t *anjay,
             fw->resume_download_deadline = avs_time_monotonic_add(
                     avs_time_monotonic_now(),
                     avs_time_duration_from_scalar(5, AVS_TIME_MIN));
-            if (!AVS_SCHED_NOW(sched, &fw->resume_download_job,
-                               resume_download_job, args,
-                               schedule_download_args_size(etag->size))) {
+            if (!ANJAY_SCHED_NOW(sched, &fw->resume_download_job,
+                                 resume_download_job, args,
+                                 schedule_download_args_size(etag->size))) {
                 fw_log(DEBUG,
                        _("same socket download initiated, waiting for "
                          "server registrations to settle down"));
@@ -1091,9 +1091,9 @@ static int fw_on_notify(anjay_unlocked_t *anjay,
     // fw->user_state.state will be set to UPDATING.
     if (!fw->update_job && fw->state == UPDATE_STATE_UPDATING
             && fw->user_state.state != UPDATE_STATE_UPDATING
-            && AVS_SCHED_NOW(_anjay_get_scheduler_unlocked(anjay),
-                             &fw->update_job, perform_upgrade, &fw,
-                             sizeof(fw))) {
+            && ANJAY_SCHED_NOW(_anjay_get_scheduler_unlocked(anjay),
+                               &fw->update_job, perform_upgrade, &fw,
+                               sizeof(fw))) {
         // we don't need to reschedule notifying,
         // we're already in the middle of it
         fw->state = UPDATE_STATE_DOWNLOADED;
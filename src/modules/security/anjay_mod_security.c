@@ -493,8 +493,11 @@ static int sec_write(anjay_unlocked_t *anjay,
 #    endif // ANJAY_WITH_LWM2M11
     sec_repr_t *repr = _anjay_sec_get(obj_ptr);
     sec_instance_t *inst = find_instance(repr, iid);
-    int retval;
     assert(inst);
+    int retval = _anjay_sec_transaction_save_instance(repr, iid);
+    if (retval) {
+        return retval;
+    }
 
     _anjay_sec_mark_modified(repr);
 
@@ -597,8 +600,13 @@ static int sec_resource_reset(anjay_unlocked_t *anjay,
     assert(rid == SEC_RES_DTLS_TLS_CIPHERSUITE);
     (void) rid;
 
-    const sec_instance_t *inst = find_instance(_anjay_sec_get(obj_ptr), iid);
+    sec_repr_t *repr = _anjay_sec_get(obj_ptr);
+    const sec_instance_t *inst = find_instance(repr, iid);
     assert(inst);
+    int result = _anjay_sec_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
 
     AVS_LIST_CLEAR(&inst->enabled_ciphersuites);
     return 0;
@@ -625,6 +633,10 @@ static int sec_instance_create(anjay_unlocked_t *anjay,
     (void) anjay;
     sec_repr_t *repr = _anjay_sec_get(obj_ptr);
     assert(iid != ANJAY_ID_INVALID);
+    int result = _anjay_sec_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
 
     AVS_LIST(sec_instance_t) created = AVS_LIST_NEW_ELEMENT(sec_instance_t);
     if (!created) {
@@ -649,7 +661,12 @@ static int sec_instance_remove(anjay_unlocked_t *anjay,
                                const anjay_dm_installed_object_t obj_ptr,
                                anjay_iid_t iid) {
     (void) anjay;
-    return del_instance(_anjay_sec_get(obj_ptr), iid);
+    sec_repr_t *repr = _anjay_sec_get(obj_ptr);
+    int result = _anjay_sec_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
+    return del_instance(repr, iid);
 }
 
 static int sec_transaction_begin(anjay_unlocked_t *anjay,
@@ -680,8 +697,13 @@ static int sec_instance_reset(anjay_unlocked_t *anjay,
                               const anjay_dm_installed_object_t obj_ptr,
                               anjay_iid_t iid) {
     (void) anjay;
-    sec_instance_t *inst = find_instance(_anjay_sec_get(obj_ptr), iid);
+    sec_repr_t *repr = _anjay_sec_get(obj_ptr);
+    sec_instance_t *inst = find_instance(repr, iid);
     assert(inst);
+    int result = _anjay_sec_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
 
     _anjay_sec_destroy_instance_fields(inst, true);
     init_instance(inst, iid);
@@ -731,7 +753,7 @@ int anjay_security_object_add_instance(
     if (!repr) {
         security_log(ERROR, _("Security object is not registered"));
         retval = -1;
-    } else {
+    } else if (!(retval = _anjay_sec_transaction_save_all(repr))) {
         const bool modified_since_persist = repr->modified_since_persist;
         if (!(retval = add_instance(repr, instance, inout_iid))
                 && (retval = _anjay_sec_object_validate_and_process_keys(
@@ -757,10 +779,13 @@ static void security_delete(void *repr_) {
     sec_repr_t *repr = (sec_repr_t *) repr_;
     if (repr->in_transaction) {
         _anjay_sec_destroy_instances(&repr->instances, true);
+        _anjay_sec_transaction_clear_undo_log(
+                repr, repr->saved_modified_since_persist);
         _anjay_sec_destroy_instances(&repr->saved_instances,
                                      repr->saved_modified_since_persist);
     } else {
         assert(!repr->saved_instances);
+        assert(!repr->undo_log);
         _anjay_sec_destroy_instances(&repr->instances,
                                      repr->modified_since_persist);
     }
@@ -780,8 +805,10 @@ void anjay_security_object_purge(anjay_t *anjay_locked) {
         if (repr->instances) {
             _anjay_sec_mark_modified(repr);
         }
+        _anjay_sec_transaction_clear_undo_log(repr, true);
         _anjay_sec_destroy_instances(&repr->saved_instances, true);
         _anjay_sec_destroy_instances(&repr->instances, true);
+        repr->has_saved_instances = repr->in_transaction;
         if (_anjay_notify_instances_changed_unlocked(anjay, SECURITY.oid)) {
             security_log(WARNING, _("Could not schedule socket reload"));
         }
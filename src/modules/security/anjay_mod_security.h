@@ -119,11 +119,27 @@ typedef struct {
 #endif // ANJAY_WITH_LWM2M11
 } sec_instance_t;
 
+typedef struct {
+    anjay_iid_t iid;
+    /* state of the instance before the transaction, NULL if it didn't exist */
+    AVS_LIST(sec_instance_t) saved;
+} sec_undo_entry_t;
+
 typedef struct {
     anjay_dm_installed_object_t def_ptr;
     const anjay_unlocked_dm_object_def_t *def;
     AVS_LIST(sec_instance_t) instances;
+    /**
+     * Instances touched during the current transaction, sorted by IID. Only
+     * used while has_saved_instances is false.
+     */
+    AVS_LIST(sec_undo_entry_t) undo_log;
+    /**
+     * Full copy of the state before the current transaction. Only created on
+     * demand, see _anjay_sec_transaction_save_all().
+     */
     AVS_LIST(sec_instance_t) saved_instances;
+    bool has_saved_instances;
     bool modified_since_persist;
     bool saved_modified_since_persist;
     bool in_transaction;
@@ -475,6 +475,8 @@ avs_error_t anjay_security_object_persist(anjay_t *anjay_locked,
     sec_repr_t *repr = sec_obj ? _anjay_sec_get(*sec_obj) : NULL;
     if (!repr) {
         err = avs_errno(AVS_EBADF);
+    } else if (_anjay_sec_transaction_save_all(repr)) {
+        err = avs_errno(AVS_ENOMEM);
     } else if (avs_is_ok((err = avs_stream_write(out_stream, MAGIC_V5,
                                                  sizeof(MAGIC_V5))))) {
         avs_persistence_context_t ctx =
@@ -218,13 +218,99 @@ int _anjay_sec_object_validate_and_process_keys(anjay_unlocked_t *anjay,
     return result;
 }
 
+static AVS_LIST(sec_undo_entry_t) *find_undo_entry_ptr(sec_repr_t *repr,
+                                                       anjay_iid_t iid) {
+    AVS_LIST(sec_undo_entry_t) *it;
+    AVS_LIST_FOREACH_PTR(it, &repr->undo_log) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static AVS_LIST(sec_instance_t) *
+find_instance_ptr(AVS_LIST(sec_instance_t) *instances, anjay_iid_t iid) {
+    AVS_LIST(sec_instance_t) *it;
+    AVS_LIST_FOREACH_PTR(it, instances) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+void _anjay_sec_transaction_clear_undo_log(sec_repr_t *repr,
+                                           bool remove_from_engine) {
+    AVS_LIST_CLEAR(&repr->undo_log) {
+        _anjay_sec_destroy_instances(&repr->undo_log->saved,
+                                     remove_from_engine);
+    }
+}
+
+int _anjay_sec_transaction_save_instance(sec_repr_t *repr, anjay_iid_t iid) {
+    if (!repr->in_transaction || repr->has_saved_instances) {
+        return 0;
+    }
+    AVS_LIST(sec_undo_entry_t) *entry_ptr = find_undo_entry_ptr(repr, iid);
+    if (*entry_ptr && (*entry_ptr)->iid == iid) {
+        return 0;
+    }
+    AVS_LIST(sec_undo_entry_t) entry = AVS_LIST_NEW_ELEMENT(sec_undo_entry_t);
+    if (!entry) {
+        security_log(ERROR, _("out of memory"));
+        return ANJAY_ERR_INTERNAL;
+    }
+    entry->iid = iid;
+    AVS_LIST(sec_instance_t) instance =
+            *find_instance_ptr(&repr->instances, iid);
+    if (instance && instance->iid == iid
+            && !(entry->saved = _anjay_sec_clone_instance(instance))) {
+        AVS_LIST_CLEAR(&entry);
+        return ANJAY_ERR_INTERNAL;
+    }
+    AVS_LIST_INSERT(entry_ptr, entry);
+    return 0;
+}
+
+int _anjay_sec_transaction_save_all(sec_repr_t *repr) {
+    if (!repr->in_transaction || repr->has_saved_instances) {
+        return 0;
+    }
+    assert(!repr->saved_instances);
+    // copy the instances that have not been touched yet...
+    AVS_LIST(sec_instance_t) *tail = &repr->saved_instances;
+    AVS_LIST(sec_instance_t) it;
+    AVS_LIST_FOREACH(it, repr->instances) {
+        AVS_LIST(sec_undo_entry_t) entry = *find_undo_entry_ptr(repr, it->iid);
+        if (entry && entry->iid == it->iid) {
+            continue;
+        }
+        if (!(*tail = _anjay_sec_clone_instance(it))) {
+            _anjay_sec_destroy_instances(&repr->saved_instances, false);
+            return ANJAY_ERR_INTERNAL;
+        }
+        AVS_LIST_ADVANCE_PTR(&tail);
+    }
+    // ...and move the saved versions of the touched ones
+    AVS_LIST(sec_undo_entry_t) entry;
+    AVS_LIST_FOREACH(entry, repr->undo_log) {
+        if (entry->saved) {
+            AVS_LIST_INSERT(find_instance_ptr(&repr->saved_instances,
+                                              entry->iid),
+                            entry->saved);
+            entry->saved = NULL;
+        }
+    }
+    _anjay_sec_transaction_clear_undo_log(repr, false);
+    repr->has_saved_instances = true;
+    return 0;
+}
+
 int _anjay_sec_transaction_begin_impl(sec_repr_t *repr) {
     assert(!repr->saved_instances);
+    assert(!repr->undo_log);
     assert(!repr->in_transaction);
-    repr->saved_instances = _anjay_sec_clone_instances(repr);
-    if (!repr->saved_instances && repr->instances) {
-        return ANJAY_ERR_INTERNAL;
-    }
     repr->saved_modified_since_persist = repr->modified_since_persist;
     repr->in_transaction = true;
     return 0;
@@ -232,7 +318,9 @@ int _anjay_sec_transaction_begin_impl(sec_repr_t *repr) {
 
 int _anjay_sec_transaction_commit_impl(sec_repr_t *repr) {
     assert(repr->in_transaction);
+    _anjay_sec_transaction_clear_undo_log(repr, true);
     _anjay_sec_destroy_instances(&repr->saved_instances, true);
+    repr->has_saved_instances = false;
     repr->in_transaction = false;
     return 0;
 }
@@ -245,9 +333,27 @@ int _anjay_sec_transaction_validate_impl(anjay_unlocked_t *anjay,
 
 int _anjay_sec_transaction_rollback_impl(sec_repr_t *repr) {
     assert(repr->in_transaction);
-    _anjay_sec_destroy_instances(&repr->instances, true);
-    repr->instances = repr->saved_instances;
-    repr->saved_instances = NULL;
+    if (repr->has_saved_instances) {
+        _anjay_sec_destroy_instances(&repr->instances, true);
+        repr->instances = repr->saved_instances;
+        repr->saved_instances = NULL;
+        repr->has_saved_instances = false;
+    } else {
+        AVS_LIST(sec_undo_entry_t) entry;
+        AVS_LIST_FOREACH(entry, repr->undo_log) {
+            AVS_LIST(sec_instance_t) *ptr =
+                    find_instance_ptr(&repr->instances, entry->iid);
+            if (*ptr && (*ptr)->iid == entry->iid) {
+                AVS_LIST(sec_instance_t) modified = AVS_LIST_DETACH(ptr);
+                _anjay_sec_destroy_instances(&modified, true);
+            }
+            if (entry->saved) {
+                AVS_LIST_INSERT(ptr, entry->saved);
+                entry->saved = NULL;
+            }
+        }
+        _anjay_sec_transaction_clear_undo_log(repr, true);
+    }
     repr->modified_since_persist = repr->saved_modified_since_persist;
     repr->in_transaction = false;
     return 0;
@@ -24,6 +24,26 @@ int _anjay_sec_transaction_validate_impl(anjay_unlocked_t *anjay,
                                          sec_repr_t *repr);
 int _anjay_sec_transaction_rollback_impl(sec_repr_t *repr);
 
+/**
+ * Saves the current state of the instance @p iid (or the fact that it does not
+ * exist) so that it can be restored on rollback. Shall be called before each
+ * modification of the instance set or instance contents. Does nothing if not
+ * in transaction or if the instance has already been saved.
+ */
+int _anjay_sec_transaction_save_instance(sec_repr_t *repr, anjay_iid_t iid);
+
+/**
+ * Makes repr->saved_instances contain the full state of the object from
+ * before the current transaction. Does nothing if not in transaction.
+ */
+int _anjay_sec_transaction_save_all(sec_repr_t *repr);
+
+/**
+ * Frees the undo log of the current transaction.
+ */
+void _anjay_sec_transaction_clear_undo_log(sec_repr_t *repr,
+                                           bool remove_from_engine);
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* SECURITY_TRANSACTION_H */
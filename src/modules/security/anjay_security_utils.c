@@ -218,9 +218,21 @@ static void sec_key_or_data_create_ref(sec_key_or_data_t *dest,
     src->next_ref = dest;
 }
 
-static int _anjay_sec_clone_instance(sec_instance_t *dest,
-                                     sec_instance_t *src) {
+static int clone_instance_fields(sec_instance_t *dest, sec_instance_t *src) {
     *dest = *src;
+    // make sure that dest does not refer to any of the buffers owned by src,
+    // so that it can be safely destroyed if something fails
+    dest->server_uri = NULL;
+    dest->server_public_key = ANJAY_RAW_BUFFER_EMPTY;
+#    ifdef ANJAY_WITH_LWM2M11
+    dest->server_name_indication = NULL;
+    dest->enabled_ciphersuites = NULL;
+#    endif // ANJAY_WITH_LWM2M11
+
+    sec_key_or_data_create_ref(&dest->public_cert_or_psk_identity,
+                               &src->public_cert_or_psk_identity);
+    sec_key_or_data_create_ref(&dest->private_cert_or_psk_key,
+                               &src->private_cert_or_psk_key);
 
     assert(src->server_uri);
     dest->server_uri = avs_strdup(src->server_uri);
@@ -229,12 +241,6 @@ static int _anjay_sec_clone_instance(sec_instance_t *dest,
         return -1;
     }
 
-    sec_key_or_data_create_ref(&dest->public_cert_or_psk_identity,
-                               &src->public_cert_or_psk_identity);
-    sec_key_or_data_create_ref(&dest->private_cert_or_psk_key,
-                               &src->private_cert_or_psk_key);
-
-    dest->server_public_key = ANJAY_RAW_BUFFER_EMPTY;
     if (_anjay_raw_buffer_clone(&dest->server_public_key,
                                 &src->server_public_key)) {
         security_log(ERROR, _("Cannot clone Server Public Key resource"));
@@ -242,18 +248,35 @@ static int _anjay_sec_clone_instance(sec_instance_t *dest,
     }
 
 #    ifdef ANJAY_WITH_LWM2M11
-    dest->server_name_indication = NULL;
     if (src->server_name_indication
             && !(dest->server_name_indication =
                          avs_strdup(src->server_name_indication))) {
         security_log(ERROR, _("Cannot clone SNI resource"));
         return -1;
     }
+    if (src->enabled_ciphersuites
+            && !(dest->enabled_ciphersuites =
+                         AVS_LIST_SIMPLE_CLONE(src->enabled_ciphersuites))) {
+        security_log(ERROR, _("Cannot clone DTLS/TLS Ciphersuite resource"));
+        return -1;
+    }
 #    endif // ANJAY_WITH_LWM2M11
 
     return 0;
 }
 
+AVS_LIST(sec_instance_t) _anjay_sec_clone_instance(sec_instance_t *src) {
+    AVS_LIST(sec_instance_t) clone = AVS_LIST_NEW_ELEMENT(sec_instance_t);
+    if (!clone) {
+        security_log(ERROR, _("out of memory"));
+        return NULL;
+    }
+    if (clone_instance_fields(clone, src)) {
+        _anjay_sec_destroy_instances(&clone, false);
+    }
+    return clone;
+}
+
 AVS_LIST(sec_instance_t) _anjay_sec_clone_instances(const sec_repr_t *repr) {
     AVS_LIST(sec_instance_t) retval = NULL;
     AVS_LIST(sec_instance_t) current;
@@ -261,15 +284,12 @@ AVS_LIST(sec_instance_t) _anjay_sec_clone_instances(const sec_repr_t *repr) {
     last = &retval;
 
     AVS_LIST_FOREACH(current, repr->instances) {
-        if (AVS_LIST_INSERT_NEW(sec_instance_t, last)) {
-            if (_anjay_sec_clone_instance(*last, current)) {
-                security_log(ERROR,
-                             _("Cannot clone Security Object Instances"));
-                _anjay_sec_destroy_instances(&retval, false);
-                return NULL;
-            }
-            AVS_LIST_ADVANCE_PTR(&last);
+        if (!(*last = _anjay_sec_clone_instance(current))) {
+            security_log(ERROR, _("Cannot clone Security Object Instances"));
+            _anjay_sec_destroy_instances(&retval, false);
+            return NULL;
         }
+        AVS_LIST_ADVANCE_PTR(&last);
     }
     return retval;
 }
@@ -82,6 +82,13 @@ void _anjay_sec_destroy_instance_fields(sec_instance_t *instance,
 void _anjay_sec_destroy_instances(AVS_LIST(sec_instance_t) *instances_ptr,
                                   bool remove_from_engine);
 
+/**
+ * Clones a single instance @p src into a newly allocated list element. Buffers
+ * of the key resources are shared by reference, everything else is copied.
+ * Returns NULL on error.
+ */
+AVS_LIST(sec_instance_t) _anjay_sec_clone_instance(sec_instance_t *src);
+
 /**
  * Clones all instances of the given Security Object @p repr . Return NULL
  * if either there was nothing to clone or an error has occurred.
@@ -307,6 +307,10 @@ static int serv_instance_create(anjay_unlocked_t *anjay,
     (void) anjay;
     server_repr_t *repr = _anjay_serv_get(obj_ptr);
     assert(iid != ANJAY_ID_INVALID);
+    int result = _anjay_serv_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
     AVS_LIST(server_instance_t) created =
             AVS_LIST_NEW_ELEMENT(server_instance_t);
     if (!created) {
@@ -323,15 +327,25 @@ static int serv_instance_remove(anjay_unlocked_t *anjay,
                                 const anjay_dm_installed_object_t obj_ptr,
                                 anjay_iid_t iid) {
     (void) anjay;
-    return del_instance(_anjay_serv_get(obj_ptr), iid);
+    server_repr_t *repr = _anjay_serv_get(obj_ptr);
+    int result = _anjay_serv_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
+    return del_instance(repr, iid);
 }
 
 static int serv_instance_reset(anjay_unlocked_t *anjay,
                                const anjay_dm_installed_object_t obj_ptr,
                                anjay_iid_t iid) {
     (void) anjay;
-    server_instance_t *inst = find_instance(_anjay_serv_get(obj_ptr), iid);
+    server_repr_t *repr = _anjay_serv_get(obj_ptr);
+    server_instance_t *inst = find_instance(repr, iid);
     assert(inst);
+    int result = _anjay_serv_transaction_save_instance(repr, iid);
+    if (result) {
+        return result;
+    }
 
     anjay_ssid_t ssid = inst->ssid;
     _anjay_serv_reset_instance(inst);
@@ -444,7 +458,10 @@ static int serv_write(anjay_unlocked_t *anjay,
     server_repr_t *repr = _anjay_serv_get(obj_ptr);
     server_instance_t *inst = find_instance(repr, iid);
     assert(inst);
-    int retval;
+    int retval = _anjay_serv_transaction_save_instance(repr, iid);
+    if (retval) {
+        return retval;
+    }
 
     _anjay_serv_mark_modified(repr);
 
@@ -647,7 +664,7 @@ int anjay_server_object_add_instance(anjay_t *anjay_locked,
     if (!repr) {
         server_log(ERROR, _("Server object is not registered"));
         retval = -1;
-    } else {
+    } else if (!(retval = _anjay_serv_transaction_save_all(repr))) {
         const bool modified_since_persist = repr->modified_since_persist;
         if (!(retval = add_instance(repr, instance, inout_iid))
                 && (retval = _anjay_serv_object_validate(repr))) {
@@ -674,6 +691,10 @@ static void server_purge(server_repr_t *repr) {
     }
     _anjay_serv_destroy_instances(&repr->instances);
     _anjay_serv_destroy_instances(&repr->saved_instances);
+    AVS_LIST_CLEAR(&repr->undo_log) {
+        _anjay_serv_destroy_instances(&repr->undo_log->saved);
+    }
+    repr->has_saved_instances = repr->in_transaction;
 }
 
 static void server_delete(void *repr) {
@@ -707,7 +728,15 @@ AVS_LIST(const anjay_ssid_t) anjay_server_get_ssids(anjay_t *anjay_locked) {
             _anjay_dm_find_object_by_oid(anjay, SERVER.oid);
     server_repr_t *repr = _anjay_serv_get(*server_obj);
     if (_anjay_dm_transaction_object_included(anjay, server_obj)) {
-        source = repr->saved_instances;
+        if (!repr->has_saved_instances && !repr->undo_log) {
+            // nothing has been modified yet
+            source = repr->instances;
+        } else if (_anjay_serv_transaction_save_all(repr)) {
+            server_log(ERROR, _("could not determine SSIDs of committed "
+                                "Server Object Instances"));
+        } else {
+            source = repr->saved_instances;
+        }
     } else {
         source = repr->instances;
     }
@@ -788,7 +817,7 @@ int anjay_server_object_set_lifetime(anjay_t *anjay_locked,
     const anjay_dm_installed_object_t *server_obj =
             _anjay_dm_find_object_by_oid(anjay, SERVER.oid);
     server_repr_t *repr = _anjay_serv_get(*server_obj);
-    if (repr->saved_instances) {
+    if (repr->in_transaction) {
         server_log(ERROR, _("cannot set Lifetime while some transaction is "
                             "started on the Server Object"));
     } else {
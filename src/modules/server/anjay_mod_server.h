@@ -76,11 +76,27 @@ typedef struct {
     bool present_resources[_SERV_RES_COUNT];
 } server_instance_t;
 
+typedef struct {
+    anjay_iid_t iid;
+    /* state of the instance before the transaction, NULL if it didn't exist */
+    AVS_LIST(server_instance_t) saved;
+} server_undo_entry_t;
+
 typedef struct {
     anjay_dm_installed_object_t def_ptr;
     const anjay_unlocked_dm_object_def_t *def;
     AVS_LIST(server_instance_t) instances;
+    /**
+     * Instances touched during the current transaction, sorted by IID. Only
+     * used while has_saved_instances is false.
+     */
+    AVS_LIST(server_undo_entry_t) undo_log;
+    /**
+     * Full copy of the state before the current transaction. Only created on
+     * demand, see _anjay_serv_transaction_save_all().
+     */
     AVS_LIST(server_instance_t) saved_instances;
+    bool has_saved_instances;
     bool modified_since_persist;
     bool saved_modified_since_persist;
     bool in_transaction;
@@ -419,6 +419,8 @@ avs_error_t anjay_server_object_persist(anjay_t *anjay_locked,
     server_repr_t *repr = server_obj ? _anjay_serv_get(*server_obj) : NULL;
     if (!repr) {
         err = avs_errno(AVS_EBADF);
+    } else if (_anjay_serv_transaction_save_all(repr)) {
+        err = avs_errno(AVS_ENOMEM);
     } else {
         avs_persistence_context_t persist_ctx =
                 avs_persistence_store_context_create(out_stream);
@@ -162,13 +162,105 @@ int _anjay_serv_object_validate(server_repr_t *repr) {
     return result;
 }
 
+static AVS_LIST(server_undo_entry_t) *
+find_undo_entry_ptr(server_repr_t *repr, anjay_iid_t iid) {
+    AVS_LIST(server_undo_entry_t) *it;
+    AVS_LIST_FOREACH_PTR(it, &repr->undo_log) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static AVS_LIST(server_instance_t) *
+find_instance_ptr(AVS_LIST(server_instance_t) *instances, anjay_iid_t iid) {
+    AVS_LIST(server_instance_t) *it;
+    AVS_LIST_FOREACH_PTR(it, instances) {
+        if ((*it)->iid >= iid) {
+            break;
+        }
+    }
+    return it;
+}
+
+static void clear_undo_log(server_repr_t *repr) {
+    AVS_LIST_CLEAR(&repr->undo_log) {
+        _anjay_serv_destroy_instances(&repr->undo_log->saved);
+    }
+}
+
+int _anjay_serv_transaction_save_instance(server_repr_t *repr,
+                                          anjay_iid_t iid) {
+    if (!repr->in_transaction || repr->has_saved_instances) {
+        return 0;
+    }
+    AVS_LIST(server_undo_entry_t) *entry_ptr = find_undo_entry_ptr(repr, iid);
+    if (*entry_ptr && (*entry_ptr)->iid == iid) {
+        return 0;
+    }
+    AVS_LIST(server_undo_entry_t) entry =
+            AVS_LIST_NEW_ELEMENT(server_undo_entry_t);
+    if (!entry) {
+        server_log(ERROR, _("out of memory"));
+        return ANJAY_ERR_INTERNAL;
+    }
+    entry->iid = iid;
+    AVS_LIST(server_instance_t) instance =
+            *find_instance_ptr(&repr->instances, iid);
+    if (instance && instance->iid == iid) {
+        if (!(entry->saved = AVS_LIST_NEW_ELEMENT(server_instance_t))) {
+            server_log(ERROR, _("out of memory"));
+            AVS_LIST_CLEAR(&entry);
+            return ANJAY_ERR_INTERNAL;
+        }
+        *entry->saved = *instance;
+    }
+    AVS_LIST_INSERT(entry_ptr, entry);
+    return 0;
+}
+
+int _anjay_serv_transaction_save_all(server_repr_t *repr) {
+    if (!repr->in_transaction || repr->has_saved_instances) {
+        return 0;
+    }
+    assert(!repr->saved_instances);
+    // copy the instances that have not been touched yet...
+    AVS_LIST(server_instance_t) *tail = &repr->saved_instances;
+    AVS_LIST(server_instance_t) it;
+    AVS_LIST_FOREACH(it, repr->instances) {
+        AVS_LIST(server_undo_entry_t) entry =
+                *find_undo_entry_ptr(repr, it->iid);
+        if (entry && entry->iid == it->iid) {
+            continue;
+        }
+        if (!(*tail = AVS_LIST_NEW_ELEMENT(server_instance_t))) {
+            server_log(ERROR, _("out of memory"));
+            _anjay_serv_destroy_instances(&repr->saved_instances);
+            return ANJAY_ERR_INTERNAL;
+        }
+        **tail = *it;
+        AVS_LIST_ADVANCE_PTR(&tail);
+    }
+    // ...and move the saved versions of the touched ones
+    AVS_LIST(server_undo_entry_t) entry;
+    AVS_LIST_FOREACH(entry, repr->undo_log) {
+        if (entry->saved) {
+            AVS_LIST_INSERT(find_instance_ptr(&repr->saved_instances,
+                                              entry->iid),
+                            entry->saved);
+            entry->saved = NULL;
+        }
+    }
+    clear_undo_log(repr);
+    repr->has_saved_instances = true;
+    return 0;
+}
+
 int _anjay_serv_transaction_begin_impl(server_repr_t *repr) {
     assert(!repr->saved_instances);
+    assert(!repr->undo_log);
     assert(!repr->in_transaction);
-    repr->saved_instances = _anjay_serv_clone_instances(repr);
-    if (!repr->saved_instances && repr->instances) {
-        return ANJAY_ERR_INTERNAL;
-    }
     repr->saved_modified_since_persist = repr->modified_since_persist;
     repr->in_transaction = true;
     return 0;
@@ -176,7 +268,9 @@ int _anjay_serv_transaction_begin_impl(server_repr_t *repr) {
 
 int _anjay_serv_transaction_commit_impl(server_repr_t *repr) {
     assert(repr->in_transaction);
+    clear_undo_log(repr);
     _anjay_serv_destroy_instances(&repr->saved_instances);
+    repr->has_saved_instances = false;
     repr->in_transaction = false;
     return 0;
 }
@@ -188,10 +282,27 @@ int _anjay_serv_transaction_validate_impl(server_repr_t *repr) {
 
 int _anjay_serv_transaction_rollback_impl(server_repr_t *repr) {
     assert(repr->in_transaction);
-    _anjay_serv_destroy_instances(&repr->instances);
+    if (repr->has_saved_instances) {
+        _anjay_serv_destroy_instances(&repr->instances);
+        repr->instances = repr->saved_instances;
+        repr->saved_instances = NULL;
+        repr->has_saved_instances = false;
+    } else {
+        AVS_LIST(server_undo_entry_t) entry;
+        AVS_LIST_FOREACH(entry, repr->undo_log) {
+            AVS_LIST(server_instance_t) *ptr =
+                    find_instance_ptr(&repr->instances, entry->iid);
+            if (*ptr && (*ptr)->iid == entry->iid) {
+                AVS_LIST_DELETE(ptr);
+            }
+            if (entry->saved) {
+                AVS_LIST_INSERT(ptr, entry->saved);
+                entry->saved = NULL;
+            }
+        }
+        clear_undo_log(repr);
+    }
     repr->modified_since_persist = repr->saved_modified_since_persist;
-    repr->instances = repr->saved_instances;
-    repr->saved_instances = NULL;
     repr->in_transaction = false;
     return 0;
 }
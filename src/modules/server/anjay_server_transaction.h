@@ -22,6 +22,21 @@ int _anjay_serv_transaction_commit_impl(server_repr_t *repr);
 int _anjay_serv_transaction_validate_impl(server_repr_t *repr);
 int _anjay_serv_transaction_rollback_impl(server_repr_t *repr);
 
+/**
+ * Saves the current state of the instance @p iid (or the fact that it does not
+ * exist) so that it can be restored on rollback. Shall be called before each
+ * modification of the instance set or instance contents. Does nothing if not
+ * in transaction or if the instance has already been saved.
+ */
+int _anjay_serv_transaction_save_instance(server_repr_t *repr,
+                                          anjay_iid_t iid);
+
+/**
+ * Makes repr->saved_instances contain the full state of the object from
+ * before the current transaction. Does nothing if not in transaction.
+ */
+int _anjay_serv_transaction_save_all(server_repr_t *repr);
+
 VISIBILITY_PRIVATE_HEADER_END
 
 #endif /* SERVER_TRANSACTION_H */
@@ -50,11 +50,6 @@ int _anjay_serv_fetch_binding(anjay_unlocked_input_ctx_t *ctx,
                                                        : ANJAY_ERR_BAD_REQUEST;
 }
 
-AVS_LIST(server_instance_t)
-_anjay_serv_clone_instances(const server_repr_t *repr) {
-    return AVS_LIST_SIMPLE_CLONE(repr->instances);
-}
-
 void _anjay_serv_destroy_instances(AVS_LIST(server_instance_t) *instances) {
     AVS_LIST_CLEAR(instances);
 }
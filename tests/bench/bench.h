@@ -0,0 +1,93 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#ifndef ANJAY_TEST_BENCH_H
+#define ANJAY_TEST_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avsystem/commons/avs_time.h>
+
+typedef struct {
+    /** Number of avs_malloc/avs_calloc/avs_realloc calls that succeeded. */
+    uint64_t allocations;
+    /** Number of bytes currently allocated through avs_* allocators. */
+    size_t bytes_in_use;
+    /** High-water mark of bytes_in_use since the last reset. */
+    size_t peak_bytes_in_use;
+} bench_heap_stats_t;
+
+/**
+ * @returns true if allocations are actually being counted, i.e. the benchmark
+ *          executable has been linked with avs_malloc() & co. wrapped.
+ */
+bool bench_heap_tracking_enabled(void);
+
+bench_heap_stats_t bench_heap_stats(void);
+
+/** Resets peak_bytes_in_use to the current bytes_in_use value. */
+void bench_heap_reset_peak(void);
+
+static inline int64_t bench_elapsed_ns(avs_time_monotonic_t since) {
+    int64_t result;
+    if (avs_time_duration_to_scalar(
+                &result, AVS_TIME_NS,
+                avs_time_monotonic_diff(avs_time_monotonic_now(), since))) {
+        return -1;
+    }
+    return result;
+}
+
+typedef struct {
+    /** Number of payloads (codec) or value changes (observe) to process. */
+    size_t iterations;
+    /**
+     * Number of Resources in the Object Instance encoded by hierarchical
+     * formats in the codec benchmark.
+     */
+    size_t resources;
+    /** Number of observations established by the observe benchmark. */
+    size_t observations;
+    /** Rate at which the observe benchmark pumps value changes. */
+    size_t changes_per_second;
+    /** Drive the observe benchmark with virtual instead of wall clock time. */
+    bool virtual_time;
+} bench_config_t;
+
+/**
+ * Makes all clock_gettime() calls return virtual time, starting at @p t. Every
+ * call advances the virtual clock by 1ns, so that it stays strictly monotonic -
+ * just like tests/utils/mock_clock.c, which cannot be reused here as it
+ * depends on the avs_unit runner.
+ */
+void bench_clock_start(avs_time_monotonic_t t);
+void bench_clock_advance(avs_time_duration_t t);
+void bench_clock_finish(void);
+
+/**
+ * Runs encode and decode microbenchmarks for every content format enabled in
+ * the current configuration and prints the results to stdout.
+ *
+ * @returns 0 on success, -1 if any codec operation failed.
+ */
+int bench_codec(const bench_config_t *config);
+
+/**
+ * Establishes config->observations observations from an in-process LwM2M
+ * server peer over loopback UDP, pumps config->iterations value changes at
+ * config->changes_per_second and prints notification throughput,
+ * change-to-wire latency percentiles and peak heap usage.
+ *
+ * @returns 0 on success, -1 in case of error.
+ */
+int bench_observe(const bench_config_t *config);
+
+#endif /* ANJAY_TEST_BENCH_H */
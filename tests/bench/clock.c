@@ -0,0 +1,55 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#define _GNU_SOURCE // for RTLD_NEXT
+#include <anjay_init.h>
+
+#include <assert.h>
+#include <dlfcn.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tests/bench/bench.h"
+
+static avs_time_monotonic_t VIRTUAL_CLOCK = { { 0, -1 } };
+
+void bench_clock_start(avs_time_monotonic_t t) {
+    assert(!avs_time_monotonic_valid(VIRTUAL_CLOCK));
+    assert(avs_time_monotonic_valid(t));
+    VIRTUAL_CLOCK = t;
+}
+
+void bench_clock_advance(avs_time_duration_t t) {
+    assert(avs_time_monotonic_valid(VIRTUAL_CLOCK));
+    VIRTUAL_CLOCK = avs_time_monotonic_add(VIRTUAL_CLOCK, t);
+}
+
+void bench_clock_finish(void) {
+    VIRTUAL_CLOCK = AVS_TIME_MONOTONIC_INVALID;
+}
+
+int clock_gettime(clockid_t clock, struct timespec *t);
+int clock_gettime(clockid_t clock, struct timespec *t) {
+    if (avs_time_monotonic_valid(VIRTUAL_CLOCK)) {
+        // all clocks are equivalent for our purposes, so ignore clock
+        t->tv_sec = (time_t) VIRTUAL_CLOCK.since_monotonic_epoch.seconds;
+        t->tv_nsec = VIRTUAL_CLOCK.since_monotonic_epoch.nanoseconds;
+        VIRTUAL_CLOCK = avs_time_monotonic_add(
+                VIRTUAL_CLOCK, avs_time_duration_from_scalar(1, AVS_TIME_NS));
+        return 0;
+    }
+
+    typedef int (*clock_gettime_t)(clockid_t, struct timespec *);
+    static clock_gettime_t orig_clock_gettime;
+    if (!orig_clock_gettime) {
+        orig_clock_gettime =
+                (clock_gettime_t) (intptr_t) dlsym(RTLD_NEXT, "clock_gettime");
+    }
+    return orig_clock_gettime(clock, t);
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_stream_inbuf.h>
+#include <avsystem/commons/avs_stream_outbuf.h>
+
+#include <avsystem/coap/code.h>
+
+#include "src/core/anjay_io_core.h"
+
+#include "tests/bench/bench.h"
+
+#define BENCH_OID 42
+#define BENCH_IID 0
+/**
+ * Upper bound of the size of a single encoded Resource; the largest ones are
+ * SenML JSON records with the string value and a full path as the name.
+ */
+#define BENCH_BYTES_PER_RESOURCE 128
+#define BENCH_BUFFER_OVERHEAD 256
+
+typedef enum {
+    VALUE_BYTES,
+    VALUE_STRING,
+    VALUE_INT,
+    VALUE_DOUBLE,
+    VALUE_BOOL,
+    VALUE_OBJLNK
+} value_type_t;
+
+/**
+ * Pattern repeated to generate the layout of the Object Instance encoded by
+ * hierarchical formats. The mix roughly resembles a typical sensor / device
+ * object.
+ */
+static const value_type_t LAYOUT_PATTERN[] = {
+    VALUE_STRING, VALUE_STRING, VALUE_INT,    VALUE_INT,
+    VALUE_DOUBLE, VALUE_DOUBLE, VALUE_DOUBLE, VALUE_DOUBLE,
+    VALUE_BOOL,   VALUE_BOOL,   VALUE_INT,    VALUE_INT,
+    VALUE_OBJLNK, VALUE_STRING, VALUE_BYTES,  VALUE_INT
+};
+
+static const char STRING_VALUE[] = "Lorem ipsum dolor sit amet";
+static const uint8_t BYTES_VALUE[32] = { 0xDE, 0xAD, 0xBE, 0xEF };
+
+/**
+ * Layout of the Object Instance encoded by hierarchical formats; Resource ID is
+ * the index in the types array.
+ */
+typedef struct {
+    value_type_t *types;
+    size_t count;
+} instance_layout_t;
+
+typedef struct {
+    const char *name;
+    uint16_t format;
+    /**
+     * VALUE_* type of the single value written for simple formats; ignored for
+     * hierarchical ones, which encode a whole instance_layout_t.
+     */
+    value_type_t simple_type;
+    bool hierarchical;
+    bool decodable;
+} codec_def_t;
+
+static const codec_def_t CODECS[] = {
+    { "opaque", AVS_COAP_FORMAT_OCTET_STREAM, VALUE_BYTES, false, true },
+#ifndef ANJAY_WITHOUT_PLAINTEXT
+    { "text", AVS_COAP_FORMAT_PLAINTEXT, VALUE_INT, false, true },
+#endif // ANJAY_WITHOUT_PLAINTEXT
+#ifdef ANJAY_WITH_CBOR
+    { "cbor", AVS_COAP_FORMAT_CBOR, VALUE_DOUBLE, false, true },
+#endif // ANJAY_WITH_CBOR
+#ifndef ANJAY_WITHOUT_TLV
+    { "tlv", AVS_COAP_FORMAT_OMA_LWM2M_TLV, VALUE_INT, true, true },
+#endif // ANJAY_WITHOUT_TLV
+#ifdef ANJAY_WITH_LWM2M_JSON
+    { "lwm2m-json", AVS_COAP_FORMAT_OMA_LWM2M_JSON, VALUE_INT, true, false },
+#endif // ANJAY_WITH_LWM2M_JSON
+#ifdef ANJAY_WITH_SENML_JSON
+    { "senml-json", AVS_COAP_FORMAT_SENML_JSON, VALUE_INT, true, true },
+#endif // ANJAY_WITH_SENML_JSON
+#ifdef ANJAY_WITH_CBOR
+    { "senml-cbor", AVS_COAP_FORMAT_SENML_CBOR, VALUE_INT, true, true },
+#endif // ANJAY_WITH_CBOR
+};
+
+static int encode_value(anjay_unlocked_output_ctx_t *out, value_type_t type) {
+    switch (type) {
+    case VALUE_BYTES:
+        return _anjay_ret_bytes_unlocked(out, BYTES_VALUE, sizeof(BYTES_VALUE));
+    case VALUE_STRING:
+        return _anjay_ret_string_unlocked(out, STRING_VALUE);
+    case VALUE_INT:
+        return _anjay_ret_i64_unlocked(out, 1234567);
+    case VALUE_DOUBLE:
+        return _anjay_ret_double_unlocked(out, 21.375);
+    case VALUE_BOOL:
+        return _anjay_ret_bool_unlocked(out, true);
+    case VALUE_OBJLNK:
+        return _anjay_ret_objlnk_unlocked(out, 3, 0);
+    }
+    return -1;
+}
+
+static int decode_value(anjay_unlocked_input_ctx_t *in, value_type_t type) {
+    switch (type) {
+    case VALUE_BYTES: {
+        uint8_t buf[sizeof(BYTES_VALUE)];
+        size_t bytes_read;
+        bool message_finished = false;
+        int result = 0;
+        while (!result && !message_finished) {
+            result = _anjay_get_bytes_unlocked(in, &bytes_read,
+                                               &message_finished, buf,
+                                               sizeof(buf));
+        }
+        return result;
+    }
+    case VALUE_STRING: {
+        char buf[sizeof(STRING_VALUE)];
+        return _anjay_get_string_unlocked(in, buf, sizeof(buf));
+    }
+    case VALUE_INT: {
+        int64_t value;
+        return _anjay_get_i64_unlocked(in, &value);
+    }
+    case VALUE_DOUBLE: {
+        double value;
+        return _anjay_get_double_unlocked(in, &value);
+    }
+    case VALUE_BOOL: {
+        bool value;
+        return _anjay_get_bool_unlocked(in, &value);
+    }
+    case VALUE_OBJLNK: {
+        anjay_oid_t oid;
+        anjay_iid_t iid;
+        return _anjay_get_objlnk_unlocked(in, &oid, &iid);
+    }
+    }
+    return -1;
+}
+
+static anjay_uri_path_t root_path(const codec_def_t *codec) {
+    return codec->hierarchical
+                   ? MAKE_INSTANCE_PATH(BENCH_OID, BENCH_IID)
+                   : MAKE_RESOURCE_PATH(BENCH_OID, BENCH_IID, 0);
+}
+
+static size_t values_per_payload(const codec_def_t *codec,
+                                 const instance_layout_t *layout) {
+    return codec->hierarchical ? layout->count : 1;
+}
+
+static int encode_payload(const codec_def_t *codec,
+                          const instance_layout_t *layout,
+                          char *buf,
+                          size_t buf_size,
+                          size_t *out_size) {
+    const anjay_uri_path_t uri = root_path(codec);
+    avs_stream_outbuf_t outbuf = AVS_STREAM_OUTBUF_STATIC_INITIALIZER;
+    avs_stream_outbuf_set_buffer(&outbuf, buf, buf_size);
+    anjay_unlocked_output_ctx_t *out = NULL;
+    int result = _anjay_output_dynamic_construct(&out, (avs_stream_t *) &outbuf,
+                                                 &uri, codec->format,
+                                                 ANJAY_ACTION_READ);
+    if (result) {
+        return result;
+    }
+    if (codec->hierarchical) {
+        for (size_t i = 0; !result && i < layout->count; ++i) {
+            (void) ((result = _anjay_output_set_path(
+                             out, &MAKE_RESOURCE_PATH(BENCH_OID, BENCH_IID,
+                                                      (anjay_rid_t) i)))
+                    || (result = encode_value(out, layout->types[i])));
+        }
+    } else {
+        (void) ((result = _anjay_output_set_path(out, &uri))
+                || (result = encode_value(out, codec->simple_type)));
+    }
+    result = _anjay_output_ctx_destroy_and_process_result(&out, result);
+    *out_size = avs_stream_outbuf_offset(&outbuf);
+    return result;
+}
+
+static int decode_hierarchical(anjay_unlocked_input_ctx_t *in,
+                               const instance_layout_t *layout) {
+    while (true) {
+        anjay_uri_path_t path;
+        int result = _anjay_input_get_path(in, &path, NULL);
+        if (result == ANJAY_GET_PATH_END) {
+            return 0;
+        } else if (result) {
+            return result;
+        }
+        if (!_anjay_uri_path_has(&path, ANJAY_ID_RID)
+                || path.ids[ANJAY_ID_RID] >= layout->count) {
+            return -1;
+        }
+        if ((result = decode_value(in, layout->types[path.ids[ANJAY_ID_RID]]))
+                || (result = _anjay_input_next_entry(in))) {
+            return result;
+        }
+    }
+}
+
+static int decode_payload(const codec_def_t *codec,
+                          const instance_layout_t *layout,
+                          const char *buf,
+                          size_t size) {
+    const anjay_uri_path_t uri = root_path(codec);
+    avs_stream_inbuf_t inbuf = AVS_STREAM_INBUF_STATIC_INITIALIZER;
+    avs_stream_inbuf_set_buffer(&inbuf, buf, size);
+    anjay_unlocked_input_ctx_t *in = NULL;
+    int result = _anjay_input_dynamic_construct_raw(&in, (avs_stream_t *) &inbuf,
+                                                    codec->format,
+                                                    ANJAY_ACTION_WRITE, &uri);
+    if (result) {
+        return result;
+    }
+    if (codec->hierarchical) {
+        result = decode_hierarchical(in, layout);
+    } else {
+        result = decode_value(in, codec->simple_type);
+    }
+    int destroy_result = _anjay_input_ctx_destroy(&in);
+    return result ? result : destroy_result;
+}
+
+static void print_result(const codec_def_t *codec,
+                         const instance_layout_t *layout,
+                         const char *direction,
+                         size_t iterations,
+                         size_t payload_size,
+                         int64_t elapsed_ns,
+                         uint64_t allocations) {
+    double values =
+            (double) iterations * (double) values_per_payload(codec, layout);
+    double seconds = (double) elapsed_ns / 1e9;
+    printf("%-12s %-6s %6" PRIu32 " B %10.1f ns/value %14.0f B/s ",
+           codec->name, direction, (uint32_t) payload_size,
+           (double) elapsed_ns / values,
+           seconds > 0.0 ? (double) payload_size * (double) iterations
+                                   / seconds
+                         : 0.0);
+    if (bench_heap_tracking_enabled()) {
+        printf("%8.2f allocs/payload\n",
+               (double) allocations / (double) iterations);
+    } else {
+        printf("%8s allocs/payload\n", "n/a");
+    }
+}
+
+static int bench_single_codec(const codec_def_t *codec,
+                              const instance_layout_t *layout,
+                              char *buf,
+                              size_t buf_size,
+                              size_t iterations) {
+    size_t payload_size = 0;
+    avs_time_monotonic_t start = avs_time_monotonic_now();
+    uint64_t allocations = bench_heap_stats().allocations;
+    for (size_t i = 0; i < iterations; ++i) {
+        if (encode_payload(codec, layout, buf, buf_size, &payload_size)) {
+            fprintf(stderr, "%s: encoding failed\n", codec->name);
+            return -1;
+        }
+    }
+    print_result(codec, layout, "encode", iterations, payload_size,
+                 bench_elapsed_ns(start),
+                 bench_heap_stats().allocations - allocations);
+
+    if (!codec->decodable) {
+        return 0;
+    }
+    start = avs_time_monotonic_now();
+    allocations = bench_heap_stats().allocations;
+    for (size_t i = 0; i < iterations; ++i) {
+        if (decode_payload(codec, layout, buf, payload_size)) {
+            fprintf(stderr, "%s: decoding failed\n", codec->name);
+            return -1;
+        }
+    }
+    print_result(codec, layout, "decode", iterations, payload_size,
+                 bench_elapsed_ns(start),
+                 bench_heap_stats().allocations - allocations);
+    return 0;
+}
+
+int bench_codec(const bench_config_t *config) {
+    const size_t iterations = config->iterations;
+    // plain malloc(), so that the setup does not show up in heap statistics
+    instance_layout_t layout = {
+        .types = (value_type_t *) malloc(config->resources
+                                         * sizeof(*layout.types)),
+        .count = config->resources
+    };
+    const size_t buf_size = BENCH_BUFFER_OVERHEAD
+                            + config->resources * BENCH_BYTES_PER_RESOURCE;
+    char *buf = (char *) malloc(buf_size);
+    int result = 0;
+    if (!layout.types || !buf) {
+        fprintf(stderr, "codec: out of memory\n");
+        result = -1;
+        goto finish;
+    }
+    for (size_t i = 0; i < layout.count; ++i) {
+        layout.types[i] = LAYOUT_PATTERN[i % AVS_ARRAY_SIZE(LAYOUT_PATTERN)];
+    }
+    printf("# codec benchmark: %" PRIu32 " iterations per format, %" PRIu32
+           " resources per instance\n",
+           (uint32_t) iterations, (uint32_t) layout.count);
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(CODECS); ++i) {
+        if (bench_single_codec(&CODECS[i], &layout, buf, buf_size,
+                               iterations)) {
+            result = -1;
+        }
+    }
+finish:
+    free(buf);
+    free(layout.types);
+    return result;
+}
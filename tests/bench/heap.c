@@ -0,0 +1,99 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <avsystem/commons/avs_defs.h>
+
+#include "tests/bench/bench.h"
+
+static bench_heap_stats_t HEAP_STATS;
+
+#ifdef ANJAY_BENCH_WITH_HEAP_TRACKING
+
+#    include <malloc.h>
+
+/*
+ * The anjay_bench executable is linked with
+ * -Wl,--wrap=avs_malloc,--wrap=avs_calloc,--wrap=avs_realloc,--wrap=avs_free
+ * so that every allocation made by the library goes through the functions
+ * below. Sizes are taken from malloc_usable_size(), so that no header needs to
+ * be prepended to the allocated blocks - this keeps the accounting harmless
+ * even for blocks allocated by code that has not been wrapped (e.g. inside
+ * shared avs_commons libraries).
+ */
+
+void *__real_avs_malloc(size_t size);
+void *__real_avs_calloc(size_t nmemb, size_t size);
+void *__real_avs_realloc(void *ptr, size_t size);
+void __real_avs_free(void *ptr);
+
+static void account_alloc(void *ptr) {
+    if (ptr) {
+        ++HEAP_STATS.allocations;
+        HEAP_STATS.bytes_in_use += malloc_usable_size(ptr);
+        if (HEAP_STATS.bytes_in_use > HEAP_STATS.peak_bytes_in_use) {
+            HEAP_STATS.peak_bytes_in_use = HEAP_STATS.bytes_in_use;
+        }
+    }
+}
+
+static void account_free(void *ptr) {
+    if (ptr) {
+        size_t size = malloc_usable_size(ptr);
+        HEAP_STATS.bytes_in_use -= AVS_MIN(size, HEAP_STATS.bytes_in_use);
+    }
+}
+
+void *__wrap_avs_malloc(size_t size) {
+    void *result = __real_avs_malloc(size);
+    account_alloc(result);
+    return result;
+}
+
+void *__wrap_avs_calloc(size_t nmemb, size_t size) {
+    void *result = __real_avs_calloc(nmemb, size);
+    account_alloc(result);
+    return result;
+}
+
+void *__wrap_avs_realloc(void *ptr, size_t size) {
+    size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void *result = __real_avs_realloc(ptr, size);
+    if (result || !size) {
+        HEAP_STATS.bytes_in_use -= AVS_MIN(old_size, HEAP_STATS.bytes_in_use);
+        account_alloc(result);
+    }
+    return result;
+}
+
+void __wrap_avs_free(void *ptr) {
+    account_free(ptr);
+    __real_avs_free(ptr);
+}
+
+bool bench_heap_tracking_enabled(void) {
+    return true;
+}
+
+#else // ANJAY_BENCH_WITH_HEAP_TRACKING
+
+bool bench_heap_tracking_enabled(void) {
+    return false;
+}
+
+#endif // ANJAY_BENCH_WITH_HEAP_TRACKING
+
+bench_heap_stats_t bench_heap_stats(void) {
+    return HEAP_STATS;
+}
+
+void bench_heap_reset_peak(void) {
+    HEAP_STATS.peak_bytes_in_use = HEAP_STATS.bytes_in_use;
+}
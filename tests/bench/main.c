@@ -0,0 +1,141 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#if !defined(_POSIX_C_SOURCE) && !defined(__APPLE__)
+#    define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <anjay_init.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <avsystem/commons/avs_defs.h>
+
+#include "tests/bench/bench.h"
+
+#define DEFAULT_ITERATIONS 100000
+#define DEFAULT_RESOURCES 16
+#define MAX_RESOURCES 10000
+#define DEFAULT_OBSERVATIONS 1000
+#define DEFAULT_CHANGES_PER_SECOND 10000
+
+typedef struct {
+    const char *name;
+    int (*run)(const bench_config_t *config);
+} bench_def_t;
+
+static const bench_def_t BENCHMARKS[] = {
+    { "codec", bench_codec },
+    { "observe", bench_observe }
+};
+
+static void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n iterations] [-s resources] [-o observations] "
+            "[-r changes/s] [-v] [benchmark...]\n"
+            "  -n  number of payloads (codec) or value changes (observe); "
+            "default: %d\n"
+            "  -s  number of resources per instance, 1-%d (codec); "
+            "default: %d\n"
+            "  -o  number of observations (observe); default: %d\n"
+            "  -r  value changes per second (observe); default: %d\n"
+            "  -v  use virtual time instead of wall clock time (observe)\n",
+            argv0, DEFAULT_ITERATIONS, MAX_RESOURCES, DEFAULT_RESOURCES,
+            DEFAULT_OBSERVATIONS,
+            DEFAULT_CHANGES_PER_SECOND);
+    fprintf(stderr, "Available benchmarks:");
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(BENCHMARKS); ++i) {
+        fprintf(stderr, " %s", BENCHMARKS[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+static int parse_size(const char *str, size_t *out) {
+    char *endptr = NULL;
+    unsigned long value = strtoul(str, &endptr, 10);
+    if (!*str || *endptr || !value) {
+        return -1;
+    }
+    *out = (size_t) value;
+    return 0;
+}
+
+static bool is_selected(const bench_def_t *bench, int argc, char **argv) {
+    if (optind >= argc) {
+        return true;
+    }
+    for (int i = optind; i < argc; ++i) {
+        if (!strcmp(argv[i], bench->name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    bench_config_t config = {
+        .iterations = DEFAULT_ITERATIONS,
+        .resources = DEFAULT_RESOURCES,
+        .observations = DEFAULT_OBSERVATIONS,
+        .changes_per_second = DEFAULT_CHANGES_PER_SECOND
+    };
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:o:r:vh")) != -1) {
+        switch (opt) {
+        case 'n':
+            if (parse_size(optarg, &config.iterations)) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 's':
+            if (parse_size(optarg, &config.resources)
+                    || config.resources > MAX_RESOURCES) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'o':
+            if (parse_size(optarg, &config.observations)) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'r':
+            if (parse_size(optarg, &config.changes_per_second)) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'v':
+            config.virtual_time = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+#ifdef AVS_COMMONS_WITH_AVS_LOG
+    // logging from within the measured loops would only measure avs_log
+    avs_log_set_default_level(AVS_LOG_QUIET);
+#endif // AVS_COMMONS_WITH_AVS_LOG
+
+    int result = EXIT_SUCCESS;
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(BENCHMARKS); ++i) {
+        if (is_selected(&BENCHMARKS[i], argc, argv)
+                && BENCHMARKS[i].run(&config)) {
+            result = EXIT_FAILURE;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,593 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#if !defined(_POSIX_C_SOURCE) && !defined(__APPLE__)
+#    define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <anjay_init.h>
+
+#include <assert.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_list.h>
+#include <avsystem/commons/avs_socket.h>
+
+#include <avsystem/coap/udp.h>
+
+#include <anjay/anjay.h>
+
+#include "src/core/anjay_core.h"
+
+// HACK to enable _anjay_server_cleanup, as in tests/utils/dm.c
+#define ANJAY_SERVERS_INTERNALS
+#include "src/core/servers/anjay_server_connections.h"
+#include "src/core/servers/anjay_servers_internal.h"
+#undef ANJAY_SERVERS_INTERNALS
+
+#include "tests/bench/bench.h"
+
+#if defined(ANJAY_WITH_OBSERVE) && defined(WITH_AVS_COAP_UDP)
+
+#    define BENCH_OID 42
+#    define BENCH_SSID 1
+#    define RESOURCES_PER_INSTANCE 10
+#    define VALUE_STEP 3.0
+
+#    define COAP_TYPE_CON 0
+#    define COAP_CODE_GET 0x01
+#    define COAP_CODE_CONTENT 0x45
+#    define COAP_OPTION_OBSERVE 6
+#    define COAP_OPTION_URI_PATH 11
+#    define TOKEN_SIZE 4
+
+/** Virtual time step used between event loop iterations. */
+#    define VIRTUAL_TICK_MS 1
+/**
+ * Time allowed for pending notifications to be flushed after the last change;
+ * needs to be greater than any pmin used in resource_read_attrs().
+ */
+#    define DRAIN_PERIOD_S 2
+#    define RECV_BUFFER_SIZE 1500
+
+typedef struct {
+    const anjay_dm_object_def_t *def;
+    size_t num_observations;
+    double *values;
+} bench_object_t;
+
+typedef struct {
+    /** Time of the earliest change not yet reflected in a notification. */
+    avs_time_monotonic_t pending_since;
+    bool established;
+} bench_observation_t;
+
+typedef struct {
+    anjay_t *anjay;
+    bench_object_t object;
+    bench_observation_t *observations;
+    size_t established_count;
+
+    /** Socket used by the client, owned by the installed server entry. */
+    avs_net_socket_t *client_socket;
+    /** Socket of the in-process LwM2M server peer. */
+    avs_net_socket_t *peer_socket;
+    uint16_t next_msg_id;
+
+    uint64_t notifications;
+    int64_t *latencies_ns;
+    size_t num_latencies;
+    size_t latencies_capacity;
+    uint64_t prng_state;
+} bench_observe_t;
+
+static inline bench_object_t *
+get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
+    return AVS_CONTAINER_OF(obj_ptr, bench_object_t, def);
+}
+
+static inline size_t observation_index(anjay_iid_t iid, anjay_rid_t rid) {
+    return (size_t) iid * RESOURCES_PER_INSTANCE + rid;
+}
+
+static int list_instances(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_dm_list_ctx_t *ctx) {
+    (void) anjay;
+    const bench_object_t *obj = get_obj(obj_ptr);
+    for (size_t i = 0; i < obj->num_observations;
+         i += RESOURCES_PER_INSTANCE) {
+        anjay_dm_emit(ctx, (anjay_iid_t) (i / RESOURCES_PER_INSTANCE));
+    }
+    return 0;
+}
+
+static int list_resources(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_iid_t iid,
+                          anjay_dm_resource_list_ctx_t *ctx) {
+    (void) anjay;
+    const bench_object_t *obj = get_obj(obj_ptr);
+    for (anjay_rid_t rid = 0; rid < RESOURCES_PER_INSTANCE
+                              && observation_index(iid, rid)
+                                         < obj->num_observations;
+         ++rid) {
+        anjay_dm_emit_res(ctx, rid, ANJAY_DM_RES_R, ANJAY_DM_RES_PRESENT);
+    }
+    return 0;
+}
+
+static int resource_read(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid,
+                         anjay_riid_t riid,
+                         anjay_output_ctx_t *ctx) {
+    (void) anjay;
+    (void) riid;
+    const bench_object_t *obj = get_obj(obj_ptr);
+    return anjay_ret_double(ctx, obj->values[observation_index(iid, rid)]);
+}
+
+/**
+ * Spreads a few typical attribute sets over the observed Resources, so that
+ * both the time-based and the value-based notification logic is exercised.
+ */
+static int resource_read_attrs(anjay_t *anjay,
+                               const anjay_dm_object_def_t *const *obj_ptr,
+                               anjay_iid_t iid,
+                               anjay_rid_t rid,
+                               anjay_ssid_t ssid,
+                               anjay_dm_r_attributes_t *out) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+    (void) ssid;
+    *out = ANJAY_DM_R_ATTRIBUTES_EMPTY;
+    switch (rid % 5) {
+    case 1:
+        out->common.min_period = 1;
+        break;
+    case 2:
+        out->common.max_period = 5;
+        break;
+    case 3:
+        out->greater_than = 60.0;
+        out->less_than = 40.0;
+        break;
+    case 4:
+        out->step = VALUE_STEP - 1.0;
+        break;
+    default:
+        break;
+    }
+    return 0;
+}
+
+static const anjay_dm_object_def_t OBJECT_DEF = {
+    .oid = BENCH_OID,
+    .handlers = {
+        .list_instances = list_instances,
+        .list_resources = list_resources,
+        .resource_read = resource_read,
+        .resource_read_attrs = resource_read_attrs
+    }
+};
+
+static uint64_t next_random(bench_observe_t *bench) {
+    bench->prng_state = bench->prng_state * 6364136223846793005ULL
+                        + 1442695040888963407ULL;
+    return bench->prng_state >> 33;
+}
+
+static int get_fd(avs_net_socket_t *socket) {
+    const void *fd_ptr = avs_net_socket_get_system(socket);
+    return fd_ptr ? *(const int *) fd_ptr : -1;
+}
+
+static bool socket_readable(avs_net_socket_t *socket, int timeout_ms) {
+    struct pollfd pfd = {
+        .fd = get_fd(socket),
+        .events = POLLIN
+    };
+    return pfd.fd >= 0 && poll(&pfd, 1, timeout_ms) > 0
+           && (pfd.revents & POLLIN);
+}
+
+static avs_net_socket_t *create_loopback_socket(void) {
+    avs_net_socket_t *socket = NULL;
+    if (avs_is_err(avs_net_udp_socket_create(
+                &socket, &(const avs_net_socket_configuration_t) {
+                             .address_family = AVS_NET_AF_INET4
+                         }))
+            || avs_is_err(avs_net_socket_bind(socket, "127.0.0.1", "0"))) {
+        avs_net_socket_cleanup(&socket);
+    }
+    return socket;
+}
+
+static int connect_sockets(avs_net_socket_t *a, avs_net_socket_t *b) {
+    char a_port[8];
+    char b_port[8];
+    if (avs_is_err(avs_net_socket_get_local_port(a, a_port, sizeof(a_port)))
+            || avs_is_err(avs_net_socket_get_local_port(b, b_port,
+                                                        sizeof(b_port)))
+            || avs_is_err(avs_net_socket_connect(a, "127.0.0.1", b_port))
+            || avs_is_err(avs_net_socket_connect(b, "127.0.0.1", a_port))) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Installs an already registered server entry, just like
+ * _anjay_test_dm_install_socket() does, but with a real loopback socket, so
+ * that no Security/Server objects nor Register exchange are necessary.
+ */
+static int install_server(bench_observe_t *bench) {
+    int result = -1;
+    ANJAY_MUTEX_LOCK(anjay, bench->anjay);
+    avs_sched_del(&anjay->reload_servers_sched_job_handle);
+    if (!AVS_LIST_INSERT_NEW(anjay_server_info_t, &anjay->servers)) {
+        avs_net_socket_cleanup(&bench->client_socket);
+        goto finish;
+    }
+    anjay->servers->anjay = anjay;
+    anjay->servers->ssid = BENCH_SSID;
+    anjay->servers->registration_info.expire_time.since_real_epoch.seconds =
+            INT64_MAX;
+    anjay_server_connection_t *connection =
+            _anjay_get_server_connection((const anjay_connection_ref_t) {
+                .server = anjay->servers,
+                .conn_type = ANJAY_CONNECTION_PRIMARY
+            });
+    if (!connection) {
+        avs_net_socket_cleanup(&bench->client_socket);
+        goto finish;
+    }
+    connection->conn_socket_ = bench->client_socket;
+    connection->coap_ctx = avs_coap_udp_ctx_create(
+            _anjay_get_coap_sched(anjay), &AVS_COAP_DEFAULT_UDP_TX_PARAMS,
+            anjay->in_shared_buffer, anjay->out_shared_buffer,
+            anjay->udp_response_cache, anjay->prng_ctx.ctx);
+    if (connection->coap_ctx
+            && avs_is_ok(avs_coap_ctx_set_socket(connection->coap_ctx,
+                                                 bench->client_socket))) {
+        result = 0;
+    }
+finish:;
+    ANJAY_MUTEX_UNLOCK(bench->anjay);
+    return result;
+}
+
+static void uninstall_servers(anjay_t *anjay_locked) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    AVS_LIST_CLEAR(&anjay->servers) {
+        _anjay_server_cleanup(anjay->servers);
+    }
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
+static size_t
+add_option(uint8_t *buf, uint8_t delta, const char *value, size_t length) {
+    assert(delta < 13 && length < 13);
+    buf[0] = (uint8_t) ((delta << 4) | length);
+    memcpy(&buf[1], value, length);
+    return length + 1;
+}
+
+static int send_observe_request(bench_observe_t *bench, size_t index) {
+    uint8_t buf[64];
+    char iid[8];
+    char rid[8];
+    snprintf(iid, sizeof(iid), "%u",
+             (unsigned) (index / RESOURCES_PER_INSTANCE));
+    snprintf(rid, sizeof(rid), "%u",
+             (unsigned) (index % RESOURCES_PER_INSTANCE));
+
+    const uint16_t msg_id = bench->next_msg_id++;
+    size_t size = 0;
+    buf[size++] = (uint8_t) (0x40 | (COAP_TYPE_CON << 4) | TOKEN_SIZE);
+    buf[size++] = COAP_CODE_GET;
+    buf[size++] = (uint8_t) (msg_id >> 8);
+    buf[size++] = (uint8_t) msg_id;
+    for (size_t i = 0; i < TOKEN_SIZE; ++i) {
+        buf[size++] = (uint8_t) (index >> (8 * (TOKEN_SIZE - 1 - i)));
+    }
+    size += add_option(&buf[size], COAP_OPTION_OBSERVE, "", 0);
+    size += add_option(&buf[size], COAP_OPTION_URI_PATH - COAP_OPTION_OBSERVE,
+                       AVS_QUOTE_MACRO(BENCH_OID),
+                       strlen(AVS_QUOTE_MACRO(BENCH_OID)));
+    size += add_option(&buf[size], 0, iid, strlen(iid));
+    size += add_option(&buf[size], 0, rid, strlen(rid));
+    return avs_is_ok(avs_net_socket_send(bench->peer_socket, buf, size)) ? 0
+                                                                         : -1;
+}
+
+static void handle_peer_message(bench_observe_t *bench,
+                                const uint8_t *msg,
+                                size_t size) {
+    if (size < 4 || (msg[0] >> 6) != 1) {
+        return;
+    }
+    const uint8_t type = (uint8_t) ((msg[0] >> 4) & 3);
+    const size_t token_size = msg[0] & 0x0F;
+    if (type == COAP_TYPE_CON) {
+        // ACK any confirmable notification
+        const uint8_t ack[] = { 0x60, 0x00, msg[2], msg[3] };
+        (void) avs_net_socket_send(bench->peer_socket, ack, sizeof(ack));
+    }
+    if (msg[1] != COAP_CODE_CONTENT || token_size != TOKEN_SIZE
+            || size < 4 + TOKEN_SIZE) {
+        return;
+    }
+    size_t index = 0;
+    for (size_t i = 0; i < TOKEN_SIZE; ++i) {
+        index = (index << 8) | msg[4 + i];
+    }
+    if (index >= bench->object.num_observations) {
+        return;
+    }
+    bench_observation_t *observation = &bench->observations[index];
+    if (!observation->established) {
+        observation->established = true;
+        ++bench->established_count;
+        return;
+    }
+    ++bench->notifications;
+    if (avs_time_monotonic_valid(observation->pending_since)) {
+        if (bench->num_latencies < bench->latencies_capacity) {
+            bench->latencies_ns[bench->num_latencies++] =
+                    bench_elapsed_ns(observation->pending_since);
+        }
+        observation->pending_since = AVS_TIME_MONOTONIC_INVALID;
+    }
+}
+
+static void drain_peer(bench_observe_t *bench) {
+    uint8_t buf[RECV_BUFFER_SIZE];
+    while (socket_readable(bench->peer_socket, 0)) {
+        size_t size = 0;
+        if (avs_is_err(avs_net_socket_receive(bench->peer_socket, &size, buf,
+                                              sizeof(buf)))) {
+            break;
+        }
+        handle_peer_message(bench, buf, size);
+    }
+}
+
+static void serve_client(bench_observe_t *bench) {
+    while (socket_readable(bench->client_socket, 0)) {
+        if (anjay_serve(bench->anjay, bench->client_socket)) {
+            break;
+        }
+    }
+}
+
+static void run_once(bench_observe_t *bench, const bench_config_t *config) {
+    anjay_sched_run(bench->anjay);
+    serve_client(bench);
+    drain_peer(bench);
+    if (config->virtual_time) {
+        bench_clock_advance(
+                avs_time_duration_from_scalar(VIRTUAL_TICK_MS, AVS_TIME_MS));
+    }
+}
+
+static int establish_observations(bench_observe_t *bench,
+                                  const bench_config_t *config) {
+    for (size_t i = 0; i < bench->object.num_observations; ++i) {
+        if (send_observe_request(bench, i)) {
+            return -1;
+        }
+        serve_client(bench);
+        drain_peer(bench);
+    }
+    for (int retries = 0;
+         bench->established_count < bench->object.num_observations
+         && retries < 1000;
+         ++retries) {
+        run_once(bench, config);
+    }
+    return bench->established_count == bench->object.num_observations ? 0
+                                                                        : -1;
+}
+
+static void apply_change(bench_observe_t *bench, avs_time_monotonic_t now) {
+    const size_t index = next_random(bench) % bench->object.num_observations;
+    bench->object.values[index] +=
+            (next_random(bench) & 1) ? VALUE_STEP : -VALUE_STEP;
+    if (!avs_time_monotonic_valid(bench->observations[index].pending_since)) {
+        bench->observations[index].pending_since = now;
+    }
+    (void) anjay_notify_changed(bench->anjay, BENCH_OID,
+                                (anjay_iid_t) (index / RESOURCES_PER_INSTANCE),
+                                (anjay_rid_t) (index % RESOURCES_PER_INSTANCE));
+}
+
+static void pump_changes(bench_observe_t *bench, const bench_config_t *config) {
+    const avs_time_monotonic_t start = avs_time_monotonic_now();
+    const int64_t changes_ns = (int64_t) ((double) config->iterations * 1e9
+                                          / (double) config->changes_per_second);
+    const int64_t end_ns =
+            changes_ns + (int64_t) DRAIN_PERIOD_S * 1000 * 1000 * 1000;
+    size_t issued = 0;
+
+    int64_t elapsed_ns;
+    while ((elapsed_ns = bench_elapsed_ns(start)) < end_ns) {
+        size_t due = (size_t) ((double) elapsed_ns
+                               * (double) config->changes_per_second / 1e9);
+        if (due > config->iterations) {
+            due = config->iterations;
+        }
+        const avs_time_monotonic_t now = avs_time_monotonic_now();
+        while (issued < due) {
+            apply_change(bench, now);
+            ++issued;
+        }
+        run_once(bench, config);
+        if (!config->virtual_time) {
+            struct pollfd pfds[] = {
+                { .fd = get_fd(bench->client_socket), .events = POLLIN },
+                { .fd = get_fd(bench->peer_socket), .events = POLLIN }
+            };
+            (void) poll(pfds, AVS_ARRAY_SIZE(pfds), VIRTUAL_TICK_MS);
+        }
+    }
+}
+
+static int compare_i64(const void *a, const void *b) {
+    const int64_t left = *(const int64_t *) a;
+    const int64_t right = *(const int64_t *) b;
+    return (left > right) - (left < right);
+}
+
+static double percentile_us(const bench_observe_t *bench, unsigned percent) {
+    if (!bench->num_latencies) {
+        return 0.0;
+    }
+    return (double) bench->latencies_ns[(bench->num_latencies - 1) * percent
+                                        / 100]
+           / 1e3;
+}
+
+static void print_results(bench_observe_t *bench,
+                          const bench_config_t *config,
+                          int64_t run_ns,
+                          double cpu_s,
+                          size_t setup_heap) {
+    qsort(bench->latencies_ns, bench->num_latencies, sizeof(int64_t),
+          compare_i64);
+    const bench_heap_stats_t heap = bench_heap_stats();
+    printf("notifications: %" PRIu64 ", %.1f/s (%s time), %.1f/s (CPU "
+           "time)\n",
+           bench->notifications,
+           (double) bench->notifications * 1e9 / (double) run_ns,
+           config->virtual_time ? "virtual" : "wall clock",
+           cpu_s > 0.0 ? (double) bench->notifications / cpu_s : 0.0);
+    printf("change-to-wire latency: p50 %.1f us, p99 %.1f us (%" PRIu32
+           " samples)\n",
+           percentile_us(bench, 50), percentile_us(bench, 99),
+           (uint32_t) bench->num_latencies);
+    if (bench_heap_tracking_enabled()) {
+        printf("heap: %" PRIu32 " B after setup, peak %" PRIu32 " B\n",
+               (uint32_t) setup_heap, (uint32_t) heap.peak_bytes_in_use);
+    } else {
+        printf("heap: n/a\n");
+    }
+}
+
+int bench_observe(const bench_config_t *config) {
+    if (!config->observations || !config->changes_per_second
+            || config->observations
+                           > (size_t) UINT16_MAX * RESOURCES_PER_INSTANCE) {
+        fprintf(stderr, "observe: invalid configuration\n");
+        return -1;
+    }
+    printf("# observe benchmark: %" PRIu32 " observations, %" PRIu32
+           " changes at %" PRIu32 "/s, %s time\n",
+           (uint32_t) config->observations, (uint32_t) config->iterations,
+           (uint32_t) config->changes_per_second,
+           config->virtual_time ? "virtual" : "wall clock");
+
+    int result = -1;
+    bench_observe_t bench = {
+        .object = {
+            .def = &OBJECT_DEF,
+            .num_observations = config->observations
+        },
+        .latencies_capacity = config->iterations,
+        .prng_state = 0x5EED
+    };
+    // bookkeeping is allocated with plain malloc() so that it does not
+    // affect the heap statistics of the library
+    bench.object.values =
+            (double *) calloc(config->observations, sizeof(double));
+    bench.observations = (bench_observation_t *) calloc(
+            config->observations, sizeof(bench_observation_t));
+    bench.latencies_ns =
+            (int64_t *) calloc(AVS_MAX(config->iterations, 1), sizeof(int64_t));
+    if (!bench.object.values || !bench.observations || !bench.latencies_ns) {
+        goto finish;
+    }
+    for (size_t i = 0; i < config->observations; ++i) {
+        bench.object.values[i] = 50.0;
+        bench.observations[i].pending_since = AVS_TIME_MONOTONIC_INVALID;
+    }
+
+    if (config->virtual_time) {
+        bench_clock_start(avs_time_monotonic_from_scalar(1000, AVS_TIME_S));
+    }
+    bench_heap_reset_peak();
+
+    const anjay_configuration_t anjay_config = {
+        .endpoint_name = "urn:dev:os:anjay-bench",
+        .in_buffer_size = 4096,
+        .out_buffer_size = 4096
+    };
+    if (!(bench.anjay = anjay_new(&anjay_config))
+            || !(bench.client_socket = create_loopback_socket())
+            || !(bench.peer_socket = create_loopback_socket())
+            || connect_sockets(bench.client_socket, bench.peer_socket)
+            || anjay_register_object(bench.anjay, &bench.object.def)) {
+        fprintf(stderr, "observe: could not initialize\n");
+        avs_net_socket_cleanup(&bench.client_socket);
+        goto finish;
+    }
+    if (install_server(&bench)) {
+        fprintf(stderr, "observe: could not install server connection\n");
+        goto finish;
+    }
+    if (establish_observations(&bench, config)) {
+        fprintf(stderr, "observe: could not establish observations\n");
+        goto finish;
+    }
+    const size_t setup_heap = bench_heap_stats().bytes_in_use;
+
+    // clock() is not affected by the virtual clock, so it allows relating the
+    // throughput to actual CPU usage in both modes
+    const clock_t cpu_start = clock();
+    const avs_time_monotonic_t run_start = avs_time_monotonic_now();
+    pump_changes(&bench, config);
+    const int64_t run_ns = bench_elapsed_ns(run_start);
+    print_results(&bench, config, run_ns,
+                  (double) (clock() - cpu_start) / CLOCKS_PER_SEC, setup_heap);
+    result = 0;
+
+finish:
+    if (config->virtual_time) {
+        bench_clock_finish();
+    }
+    if (bench.anjay) {
+        uninstall_servers(bench.anjay);
+        anjay_delete(bench.anjay);
+    }
+    avs_net_socket_cleanup(&bench.peer_socket);
+    free(bench.latencies_ns);
+    free(bench.observations);
+    free(bench.object.values);
+    return result;
+}
+
+#else // defined(ANJAY_WITH_OBSERVE) && defined(WITH_AVS_COAP_UDP)
+
+int bench_observe(const bench_config_t *config) {
+    (void) config;
+    printf("# observe benchmark: skipped, requires Observe and CoAP/UDP "
+           "support\n");
+    return 0;
+}
+
+#endif // defined(ANJAY_WITH_OBSERVE) && defined(WITH_AVS_COAP_UDP)
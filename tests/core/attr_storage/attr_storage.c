@@ -909,6 +909,151 @@ AVS_UNIT_TEST(attr_storage, object_default_attrs) {
     DM_ATTR_STORAGE_TEST_FINISH;
 }
 
+AVS_UNIT_TEST(attr_storage, rollback_restores_only_modified_objects) {
+    DM_ATTR_STORAGE_TEST_INIT;
+    AVS_LIST_APPEND(&anjay_unlocked->attr_storage.objects,
+                    test_object_entry(42,
+                                      test_default_attrlist(
+                                              test_default_attrs(
+                                                      1, 5, 6,
+                                                      ANJAY_ATTRIB_INTEGER_NONE,
+                                                      ANJAY_ATTRIB_INTEGER_NONE,
+                                                      ANJAY_DM_CON_ATTR_NONE),
+                                              NULL),
+                                      NULL));
+
+    // OBJ implements its own attribute handlers, so call Attribute Storage
+    // logic directly
+    AVS_UNIT_ASSERT_SUCCESS(write_object_attrs(anjay_unlocked, 1,
+                                               WRAP_OBJ_PTR(&OBJ),
+                                               &ANJAY_DM_OI_ATTRIBUTES_EMPTY));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_write_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 1,
+            &(const anjay_dm_oi_attributes_t) {
+                .min_period = 7,
+                .max_period = ANJAY_ATTRIB_INTEGER_NONE,
+                .min_eval_period = ANJAY_ATTRIB_INTEGER_NONE,
+                .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
+#ifdef ANJAY_WITH_CON_ATTR
+                ,
+                .con = ANJAY_DM_CON_ATTR_NONE
+#endif // ANJAY_WITH_CON_ATTR
+            }));
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(anjay_unlocked->attr_storage.objects),
+                          1);
+    AVS_UNIT_ASSERT_EQUAL(anjay_unlocked->attr_storage.objects->oid, 69);
+    AVS_UNIT_ASSERT_EQUAL(
+            AVS_LIST_SIZE(anjay_unlocked->attr_storage.saved_state.saved_objects),
+            1);
+    AVS_UNIT_ASSERT_EQUAL(
+            AVS_LIST_SIZE(anjay_unlocked->attr_storage.saved_state.created_oids),
+            1);
+
+    AVS_UNIT_ASSERT_FAILED(_anjay_dm_transaction_finish(anjay_unlocked, -1));
+    AVS_UNIT_ASSERT_FALSE(anjay_unlocked->attr_storage.modified_since_persist);
+    AVS_UNIT_ASSERT_NULL(anjay_unlocked->attr_storage.saved_state.saved_objects);
+    AVS_UNIT_ASSERT_NULL(anjay_unlocked->attr_storage.saved_state.created_oids);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(anjay_unlocked->attr_storage.objects),
+                          1);
+    assert_object_equal(anjay_unlocked->attr_storage.objects,
+                        test_object_entry(42,
+                                          test_default_attrlist(
+                                                  test_default_attrs(
+                                                          1, 5, 6,
+                                                          ANJAY_ATTRIB_INTEGER_NONE,
+                                                          ANJAY_ATTRIB_INTEGER_NONE,
+                                                          ANJAY_DM_CON_ATTR_NONE),
+                                                  NULL),
+                                          NULL));
+    (void) mocksocks;
+    ANJAY_MUTEX_UNLOCK(anjay);
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(attr_storage, lookup_index) {
+    DM_ATTR_STORAGE_TEST_INIT;
+    AVS_LIST_APPEND(
+            &anjay_unlocked->attr_storage.objects,
+            test_object_entry(
+                    69,
+                    test_default_attrlist(
+                            test_default_attrs(1, 11,
+                                               ANJAY_ATTRIB_INTEGER_NONE,
+                                               ANJAY_ATTRIB_INTEGER_NONE,
+                                               ANJAY_ATTRIB_INTEGER_NONE,
+                                               ANJAY_DM_CON_ATTR_NONE),
+                            NULL),
+                    test_instance_entry(
+                            3,
+                            test_default_attrlist(
+                                    test_default_attrs(
+                                            1, 22, ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_DM_CON_ATTR_NONE),
+                                    test_default_attrs(
+                                            2, 23, ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_DM_CON_ATTR_NONE),
+                                    NULL),
+                            test_resource_entry(
+                                    5,
+                                    test_resource_attrs(
+                                            2, 33, ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_INTEGER_NONE,
+                                            ANJAY_ATTRIB_DOUBLE_NONE,
+                                            ANJAY_ATTRIB_DOUBLE_NONE,
+                                            ANJAY_ATTRIB_DOUBLE_NONE,
+                                            ANJAY_DM_CON_ATTR_NONE),
+                                    NULL),
+                            NULL),
+                    NULL));
+
+    AVS_UNIT_ASSERT_SUCCESS(ensure_index(&anjay_unlocked->attr_storage));
+    const as_index_t *index = &anjay_unlocked->attr_storage.index;
+    AVS_UNIT_ASSERT_EQUAL(index->size, 4);
+    for (size_t i = 1; i < index->size; ++i) {
+        AVS_UNIT_ASSERT_TRUE(
+                index->entries[i - 1].path_key < index->entries[i].path_key
+                || (index->entries[i - 1].path_key == index->entries[i].path_key
+                    && index->entries[i - 1].ssid < index->entries[i].ssid));
+    }
+
+    anjay_dm_oi_attributes_t oi_attrs;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 1, &oi_attrs));
+    AVS_UNIT_ASSERT_EQUAL(oi_attrs.min_period, 11);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 2, &oi_attrs));
+    AVS_UNIT_ASSERT_EQUAL(oi_attrs.min_period, 23);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 4, 2, &oi_attrs));
+    assert_attrs_equal(&oi_attrs, &ANJAY_DM_OI_ATTRIBUTES_EMPTY);
+
+    anjay_dm_r_attributes_t r_attrs;
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 5, 2, &r_attrs));
+    AVS_UNIT_ASSERT_EQUAL(r_attrs.common.min_period, 33);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_resource_read_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 3, 5, 1, &r_attrs));
+    assert_res_attrs_equal(&r_attrs, &ANJAY_DM_R_ATTRIBUTES_EMPTY);
+
+    // any modification drops the index
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_write_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 1,
+            &ANJAY_DM_OI_ATTRIBUTES_EMPTY));
+    AVS_UNIT_ASSERT_FALSE(index->valid);
+    AVS_UNIT_ASSERT_NULL(index->entries);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_object_read_default_attrs(
+            anjay_unlocked, WRAP_OBJ_PTR(&OBJ2), 1, &oi_attrs));
+    assert_attrs_equal(&oi_attrs, &ANJAY_DM_OI_ATTRIBUTES_EMPTY);
+    AVS_UNIT_ASSERT_EQUAL(index->size, 3);
+
+    DM_ATTR_STORAGE_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(attr_storage, read_instance_default_attrs_proxy) {
     DM_ATTR_STORAGE_TEST_INIT;
 
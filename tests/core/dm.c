@@ -238,6 +238,106 @@ AVS_UNIT_TEST(dm_read, resource_not_found_because_not_present) {
     DM_TEST_FINISH;
 }
 
+static const anjay_dm_object_def_t *const OBJ_WITH_PRESENCE_HANDLERS =
+        &(const anjay_dm_object_def_t) {
+            .oid = 42,
+            .handlers = { ANJAY_MOCK_DM_HANDLERS,
+                          .instance_present = _anjay_mock_dm_instance_present,
+                          .resource_present = _anjay_mock_dm_resource_present }
+        };
+
+AVS_UNIT_TEST(dm_read, resource_with_presence_handlers) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_PRESENCE_HANDLERS, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "69", "4"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_instance_present(anjay, &OBJ_WITH_PRESENCE_HANDLERS,
+                                           69, 0, true);
+    _anjay_mock_dm_expect_resource_present(anjay, &OBJ_WITH_PRESENCE_HANDLERS,
+                                           69, 4, 0, ANJAY_DM_RES_RW,
+                                           ANJAY_DM_RES_PRESENT);
+    _anjay_mock_dm_expect_resource_read(anjay, &OBJ_WITH_PRESENCE_HANDLERS, 69,
+                                        4, ANJAY_ID_INVALID, 0,
+                                        ANJAY_MOCK_DM_INT(0, 514));
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID(0xFA3E),
+                            CONTENT_FORMAT(PLAINTEXT), PAYLOAD("514"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(dm_read, instance_not_found_with_presence_handlers) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_PRESENCE_HANDLERS, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13", "4"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_instance_present(anjay, &OBJ_WITH_PRESENCE_HANDLERS,
+                                           13, 0, false);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, NOT_FOUND, ID(0xFA3E),
+                            NO_PAYLOAD);
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(dm_read, resource_not_found_with_presence_handlers) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_PRESENCE_HANDLERS, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "69", "7"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_instance_present(anjay, &OBJ_WITH_PRESENCE_HANDLERS,
+                                           69, 0, true);
+    _anjay_mock_dm_expect_resource_present(anjay, &OBJ_WITH_PRESENCE_HANDLERS,
+                                           69, 7, 0, ANJAY_DM_RES_RW,
+                                           ANJAY_DM_RES_ABSENT);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, NOT_FOUND, ID(0xFA3E),
+                            NO_PAYLOAD);
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+static void expect_cached_read(anjay_t *anjay,
+                               avs_net_socket_t *mocksock,
+                               uint16_t msg_id,
+                               bool expect_list_resources) {
+    DM_TEST_REQUEST(mocksock, CON, GET, ID(msg_id), PATH("42", "69", "4"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ, 0,
+            (const anjay_iid_t[]) { 14, 42, 69, ANJAY_ID_INVALID });
+    if (expect_list_resources) {
+        _anjay_mock_dm_expect_list_resources(
+                anjay, &OBJ, 69, 0,
+                (const anjay_mock_dm_res_entry_t[]) {
+                        { 0, ANJAY_DM_RES_RW, ANJAY_DM_RES_ABSENT },
+                        { 4, ANJAY_DM_RES_RW, ANJAY_DM_RES_PRESENT },
+                        ANJAY_MOCK_DM_RES_END });
+    }
+    _anjay_mock_dm_expect_resource_read(anjay, &OBJ, 69, 4, ANJAY_ID_INVALID, 0,
+                                        ANJAY_MOCK_DM_INT(0, 514));
+    DM_TEST_EXPECT_RESPONSE(mocksock, ACK, CONTENT, ID(msg_id),
+                            CONTENT_FORMAT(PLAINTEXT), PAYLOAD("514"));
+    expect_has_buffered_data_check(mocksock, false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksock));
+}
+
+AVS_UNIT_TEST(dm_read, resource_with_layout_cache) {
+    DM_TEST_INIT;
+    AVS_UNIT_ASSERT_SUCCESS(anjay_set_resource_layout_caching(anjay, 42, true));
+    expect_cached_read(anjay, mocksocks[0], 0xFA3E, true);
+    // second read is served from the cache
+    expect_cached_read(anjay, mocksocks[0], 0xFA3F, false);
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_resources_layout_changed(anjay, 42, 69));
+    expect_cached_read(anjay, mocksocks[0], 0xFA40, true);
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_set_resource_layout_caching(anjay, 42, false));
+    expect_cached_read(anjay, mocksocks[0], 0xFA41, true);
+    expect_cached_read(anjay, mocksocks[0], 0xFA42, true);
+    DM_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(dm_read, instance_empty) {
     DM_TEST_INIT;
     DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
@@ -293,6 +393,105 @@ AVS_UNIT_TEST(dm_read, instance_some) {
     DM_TEST_FINISH;
 }
 
+static const anjay_dm_object_def_t *const OBJ_WITH_INSTANCE_READ =
+        &(const anjay_dm_object_def_t) {
+            .oid = 42,
+            .handlers = { ANJAY_MOCK_DM_HANDLERS,
+                          .instance_read = _anjay_mock_dm_instance_read }
+        };
+
+AVS_UNIT_TEST(dm_read, instance_with_instance_read) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_INSTANCE_READ, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_WITH_INSTANCE_READ, 0,
+            (const anjay_iid_t[]) { 13, 14, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_instance_read(
+            anjay, &OBJ_WITH_INSTANCE_READ, 13, 0,
+            (const anjay_mock_dm_res_value_t[]) {
+                    { 0, ANJAY_MOCK_DM_INT(0, 69) },
+                    { 6, ANJAY_MOCK_DM_STRING(0, "Hello") },
+                    ANJAY_MOCK_DM_RES_VALUES_END });
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID(0xFA3E),
+                            CONTENT_FORMAT(OMA_LWM2M_TLV),
+                            PAYLOAD("\xc1\x00\x45"
+                                    "\xc5\x06"
+                                    "Hello"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(dm_read, instance_read_multiple_resources) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_INSTANCE_READ, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_WITH_INSTANCE_READ, 0,
+            (const anjay_iid_t[]) { 13, 14, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_instance_read(
+            anjay, &OBJ_WITH_INSTANCE_READ, 13, 0,
+            (const anjay_mock_dm_res_value_t[]) {
+                    { 0, ANJAY_MOCK_DM_INT(0, 69) },
+                    { 1, ANJAY_MOCK_DM_INT(0, 1) },
+                    { 3, ANJAY_MOCK_DM_INT(0, 7) },
+                    { 6, ANJAY_MOCK_DM_STRING(0, "Hello") },
+                    ANJAY_MOCK_DM_RES_VALUES_END });
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID(0xFA3E),
+                            CONTENT_FORMAT(OMA_LWM2M_TLV),
+                            PAYLOAD("\xc1\x00\x45"
+                                    "\xc1\x01\x01"
+                                    "\xc1\x03\x07"
+                                    "\xc5\x06"
+                                    "Hello"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(dm_read, instance_read_not_ascending) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_INSTANCE_READ, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_WITH_INSTANCE_READ, 0,
+            (const anjay_iid_t[]) { 13, 14, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_instance_read(
+            anjay, &OBJ_WITH_INSTANCE_READ, 13, ANJAY_ERR_INTERNAL,
+            (const anjay_mock_dm_res_value_t[]) {
+                    { 3, ANJAY_MOCK_DM_INT(0, 7) },
+                    { 1, ANJAY_MOCK_DM_INT(0, 1) },
+                    ANJAY_MOCK_DM_RES_VALUES_END });
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, INTERNAL_SERVER_ERROR,
+                            ID(0xFA3E), NO_PAYLOAD);
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(dm_read, instance_read_err) {
+    DM_TEST_INIT_WITH_OBJECTS(&OBJ_WITH_INSTANCE_READ, &FAKE_SECURITY,
+                              &FAKE_SERVER);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
+                    NO_PAYLOAD);
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &OBJ_WITH_INSTANCE_READ, 0,
+            (const anjay_iid_t[]) { 13, 14, ANJAY_ID_INVALID });
+    _anjay_mock_dm_expect_instance_read(
+            anjay, &OBJ_WITH_INSTANCE_READ, 13, ANJAY_ERR_INTERNAL,
+            (const anjay_mock_dm_res_value_t[]) {
+                    ANJAY_MOCK_DM_RES_VALUES_END });
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, INTERNAL_SERVER_ERROR,
+                            ID(0xFA3E), NO_PAYLOAD);
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    DM_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(dm_read, instance_resource_not_found) {
     DM_TEST_INIT;
     DM_TEST_REQUEST(mocksocks[0], CON, GET, ID(0xFA3E), PATH("42", "13"),
@@ -3849,3 +4048,31 @@ AVS_UNIT_TEST(dm_res_read, u64_array_multiple_elements) {
     DM_TEST_FINISH;
 }
 #endif // ANJAY_WITH_LWM2M11
+
+AVS_UNIT_TEST(dm_find_object, by_oid) {
+    DM_TEST_INIT;
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(obj_defs); ++i) {
+        const anjay_dm_installed_object_t *obj =
+                _anjay_dm_find_object_by_oid(anjay_unlocked,
+                                             (*obj_defs[i])->oid);
+        AVS_UNIT_ASSERT_NOT_NULL(obj);
+        AVS_UNIT_ASSERT_EQUAL(_anjay_dm_installed_object_oid(obj),
+                              (*obj_defs[i])->oid);
+    }
+    AVS_UNIT_ASSERT_NULL(_anjay_dm_find_object_by_oid(anjay_unlocked, 2));
+    AVS_UNIT_ASSERT_NULL(_anjay_dm_find_object_by_oid(anjay_unlocked, 65534));
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    AVS_UNIT_ASSERT_SUCCESS(anjay_unregister_object(
+            anjay, (const anjay_dm_object_def_t *const *) &EXECUTE_OBJ));
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    AVS_UNIT_ASSERT_NULL(
+            _anjay_dm_find_object_by_oid(anjay_unlocked, EXECUTE_OBJ->oid));
+    AVS_UNIT_ASSERT_NOT_NULL(
+            _anjay_dm_find_object_by_oid(anjay_unlocked, OBJ->oid));
+    AVS_UNIT_ASSERT_NOT_NULL(
+            _anjay_dm_find_object_by_oid(anjay_unlocked, OBJ_WITH_RESET->oid));
+    ANJAY_MUTEX_UNLOCK(anjay);
+    DM_TEST_FINISH;
+}
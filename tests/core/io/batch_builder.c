@@ -133,6 +133,37 @@ AVS_UNIT_TEST(batch_builder, empty_bytes) {
 }
 #endif // ANJAY_WITH_LWM2M11
 
+static void count_release(void *counter) {
+    ++*(int *) counter;
+}
+
+AVS_UNIT_TEST(batch_builder, bytes_ref) {
+    static const char DATA[] = "raz dwa trzy";
+    int released = 0;
+    anjay_batch_builder_t *builder = builder_setup();
+
+    builder_out_ctx_t ctx =
+            builder_out_ctx_new(builder, &MAKE_INSTANCE_PATH(0, 0), NULL);
+    anjay_unlocked_output_ctx_t *out = (anjay_unlocked_output_ctx_t *) &ctx;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_output_set_path(out, &MAKE_RESOURCE_PATH(0, 0, 0)));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, sizeof(DATA) - 1, count_release, &released));
+    AVS_UNIT_ASSERT_SUCCESS(output_close(out));
+
+    // The data shall be referenced, not copied
+    AVS_LIST(anjay_batch_entry_t) entry = AVS_LIST_TAIL(builder->list);
+    AVS_UNIT_ASSERT_TRUE(entry->data.value.bytes.data == DATA);
+    AVS_UNIT_ASSERT_EQUAL(entry->data.value.bytes.length, sizeof(DATA) - 1);
+    AVS_UNIT_ASSERT_EQUAL(released, 0);
+
+    anjay_batch_t *batch = _anjay_batch_builder_compile(&builder);
+    AVS_UNIT_ASSERT_NOT_NULL(batch);
+    AVS_UNIT_ASSERT_EQUAL(released, 0);
+    _anjay_batch_release(&batch);
+    AVS_UNIT_ASSERT_EQUAL(released, 1);
+}
+
 AVS_UNIT_TEST(batch_builder, compile) {
     anjay_batch_builder_t *builder = builder_setup();
 
@@ -150,3 +181,25 @@ AVS_UNIT_TEST(batch_builder, compile) {
     _anjay_batch_release(&batch);
     AVS_UNIT_ASSERT_NULL(batch);
 }
+
+#ifdef ANJAY_WITH_MEMORY_STATS
+AVS_UNIT_TEST(batch_builder, memory_usage) {
+    anjay_batch_builder_t *builder = builder_setup();
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_batch_add_int(
+            builder, &MAKE_RESOURCE_PATH(0, 0, 0), AVS_TIME_REAL_INVALID, 0));
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_batch_add_string(builder, &MAKE_RESOURCE_PATH(0, 0, 1),
+                                    AVS_TIME_REAL_INVALID, "raz dwa trzy"));
+
+    anjay_batch_t *batch = _anjay_batch_builder_compile(&builder);
+    AVS_UNIT_ASSERT_NOT_NULL(batch);
+    AVS_UNIT_ASSERT_EQUAL(_anjay_batch_memory_usage(batch),
+                          sizeof(anjay_batch_t)
+                                  + 2 * ANJAY_LIST_ELEMENT_MEMORY(
+                                                sizeof(anjay_batch_entry_t))
+                                  + sizeof("raz dwa trzy"));
+
+    _anjay_batch_release(&batch);
+}
+#endif // ANJAY_WITH_MEMORY_STATS
@@ -379,6 +379,26 @@ AVS_UNIT_TEST(json_in_value, bytes_with_too_short_buffer) {
     TEST_TEARDOWN(OK);
 }
 
+AVS_UNIT_TEST(json_in_value, bytes_view) {
+    TEST_VALUE_ENV("\"vd\": \"Zm9vYmFy\""); // base64(foobar)
+
+    char ch;
+    size_t bytes_read;
+    bool message_finished;
+    ASSERT_OK(_anjay_get_bytes_unlocked(in, &bytes_read, &message_finished,
+                                        &ch, 1));
+    ASSERT_EQ(ch, 'f');
+
+    const void *view;
+    ASSERT_OK(_anjay_get_bytes_view_unlocked(in, &view, &bytes_read,
+                                             &message_finished));
+    ASSERT_EQ(bytes_read, 5);
+    ASSERT_TRUE(message_finished);
+    ASSERT_EQ_BYTES_SIZED(view, "oobar", 5);
+
+    TEST_TEARDOWN(OK);
+}
+
 AVS_UNIT_TEST(json_in_value, double_as_i64_when_convertible) {
     TEST_VALUE_ENV("\"v\": 3");
 
@@ -160,6 +160,30 @@ AVS_UNIT_TEST(tlv_in_bytes, partial_read) {
     TEST_TEARDOWN;
 }
 
+AVS_UNIT_TEST(tlv_in_bytes, view) {
+    TEST_ENV(16, MAKE_INSTANCE_PATH(3, 4));
+    static const char DATA[] = "\xC7\x2A"
+                               "0123456";
+    ASSERT_OK(avs_stream_write(stream, DATA, sizeof(DATA) - 1));
+
+    TLV_BYTES_TEST_PATH(MAKE_RESOURCE_PATH(3, 4, 42));
+    char ch;
+    size_t bytes_read;
+    bool message_finished;
+    ASSERT_OK(_anjay_get_bytes_unlocked(in, &bytes_read, &message_finished,
+                                        &ch, 1));
+    ASSERT_EQ(ch, '0');
+
+    const void *view;
+    ASSERT_OK(_anjay_get_bytes_view_unlocked(in, &view, &bytes_read,
+                                             &message_finished));
+    ASSERT_EQ(bytes_read, 6);
+    ASSERT_TRUE(message_finished);
+    ASSERT_EQ_BYTES_SIZED(view, "123456", 6);
+
+    TEST_TEARDOWN;
+}
+
 AVS_UNIT_TEST(tlv_in_bytes, short_read_get_id) {
     TEST_ENV(64, MAKE_INSTANCE_PATH(3, 4));
     ASSERT_OK(avs_stream_write_f(stream, "%s",
@@ -319,6 +319,63 @@ AVS_UNIT_TEST(tlv_out_array, array_index) {
     AVS_UNIT_ASSERT_SUCCESS(_anjay_output_ctx_destroy(&out));
 }
 
+static void count_release(void *counter) {
+    ++*(int *) counter;
+}
+
+AVS_UNIT_TEST(tlv_out_array, bytes_ref) {
+    static const char DATA[] = "1234567";
+    int released = 0;
+    TEST_ENV(512, &MAKE_INSTANCE_PATH(0, 0));
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_set_path(
+            out, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 1, 1)));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, sizeof(DATA) - 1, count_release, &released));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_set_path(
+            out, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 1, 2)));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, 3, count_release, &released));
+    // nested entries are kept by reference until the array is finished
+    AVS_UNIT_ASSERT_EQUAL(released, 0);
+
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_output_set_path(out, &MAKE_RESOURCE_PATH(0, 0, 2)));
+    AVS_UNIT_ASSERT_EQUAL(released, 2);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, 1, count_release, &released));
+    AVS_UNIT_ASSERT_EQUAL(released, 3);
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_ctx_destroy(&out));
+
+    VERIFY_BYTES("\x88\x01\x0E"      // array
+                 "\x47\x01"          // first entry
+                 "1234567"           //
+                 "\x43\x02"          // second entry
+                 "123"               //
+                 "\xC1\x02"          // another entry
+                 "1");
+}
+
+AVS_UNIT_TEST(tlv_out_array, bytes_ref_released_on_error) {
+    static const char DATA[] = "1234567";
+    int released = 0;
+    TEST_ENV(512, &MAKE_INSTANCE_PATH(0, 0));
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_set_path(
+            out, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 1, 1)));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, sizeof(DATA) - 1, count_release, &released));
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_output_set_path(
+            out, &MAKE_RESOURCE_INSTANCE_PATH(0, 0, 1, 2)));
+    AVS_UNIT_ASSERT_FAILED(_anjay_ret_bytes_ref_unlocked(
+            out, DATA, TLV_MAX_LENGTH + 1, count_release, &released));
+    AVS_UNIT_ASSERT_EQUAL(released, 1);
+
+    AVS_UNIT_ASSERT_FAILED(_anjay_output_ctx_destroy(&out));
+    AVS_UNIT_ASSERT_EQUAL(released, 2);
+}
+
 AVS_UNIT_TEST(tlv_out, object_with_empty_bytes) {
     TEST_ENV(512, &MAKE_OBJECT_PATH(0));
 
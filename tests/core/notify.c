@@ -0,0 +1,381 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <avsystem/commons/avs_unit_test.h>
+
+#include "tests/utils/dm.h"
+
+static void assert_resource_entries(
+        AVS_LIST(anjay_notify_queue_resource_entry_t) entries,
+        const anjay_notify_queue_resource_entry_t *expected,
+        size_t expected_count) {
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(entries), expected_count);
+    for (size_t i = 0; i < expected_count; ++i) {
+        AVS_UNIT_ASSERT_EQUAL(entries->iid, expected[i].iid);
+        AVS_UNIT_ASSERT_EQUAL(entries->rid, expected[i].rid);
+        entries = AVS_LIST_NEXT(entries);
+    }
+}
+
+AVS_UNIT_TEST(notify_queue, pending_changes_coalesced) {
+    anjay_notify_pending_changes_t changes = { NULL, 0, 0 };
+    for (int i = 0; i < 3; ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 1, 2));
+    }
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 1);
+
+    // force a few rehashes
+    for (anjay_rid_t rid = 0; rid < 100; ++rid) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 3, rid));
+    }
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 101);
+    AVS_UNIT_ASSERT_TRUE(changes.capacity >= 2 * changes.size);
+    for (anjay_rid_t rid = 0; rid < 100; ++rid) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 3, rid));
+    }
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 101);
+    avs_free(changes.slots);
+}
+
+AVS_UNIT_TEST(notify_queue, pending_changes_merged_in_order) {
+    anjay_notify_queue_t queue = NULL;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_notify_queue_resource_change(&queue, 5, 1, 1));
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_notify_queue_resource_change(&queue, 5, 3, 0));
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_notify_queue_instance_created(&queue, 7, 0));
+
+    anjay_notify_pending_changes_t changes = { NULL, 0, 0 };
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 9, 0, 0));
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 5, 3, 0));
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 5, 2, 4));
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 5, 0, 1));
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 3, 1, 1));
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 7, 0, 1));
+    AVS_UNIT_ASSERT_SUCCESS(merge_pending_changes(&queue, &changes));
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 0);
+
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(queue), 4);
+    AVS_LIST(anjay_notify_queue_object_entry_t) entry = queue;
+    AVS_UNIT_ASSERT_EQUAL(entry->oid, 3);
+    assert_resource_entries(entry->resources_changed,
+                            (const anjay_notify_queue_resource_entry_t[]) {
+                                { 1, 1 } },
+                            1);
+    entry = AVS_LIST_NEXT(entry);
+    AVS_UNIT_ASSERT_EQUAL(entry->oid, 5);
+    assert_resource_entries(entry->resources_changed,
+                            (const anjay_notify_queue_resource_entry_t[]) {
+                                { 0, 1 }, { 1, 1 }, { 2, 4 }, { 3, 0 } },
+                            4);
+    entry = AVS_LIST_NEXT(entry);
+    AVS_UNIT_ASSERT_EQUAL(entry->oid, 7);
+    AVS_UNIT_ASSERT_TRUE(entry->instance_set_changes.instance_set_changed);
+    assert_resource_entries(entry->resources_changed,
+                            (const anjay_notify_queue_resource_entry_t[]) {
+                                { 0, 1 } },
+                            1);
+    entry = AVS_LIST_NEXT(entry);
+    AVS_UNIT_ASSERT_EQUAL(entry->oid, 9);
+    assert_resource_entries(entry->resources_changed,
+                            (const anjay_notify_queue_resource_entry_t[]) {
+                                { 0, 0 } },
+                            1);
+
+    // the set is reusable after merging
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 5, 3, 0));
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 1);
+
+    avs_free(changes.slots);
+    _anjay_notify_clear_queue(&queue);
+}
+
+AVS_UNIT_TEST(notify_queue, unmerged_pending_changes_restored) {
+    anjay_notify_pending_changes_t changes = { NULL, 0, 0 };
+    for (anjay_rid_t rid = 0; rid < 4; ++rid) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 0, rid));
+    }
+    // simulate merge_pending_changes() having compacted the entries and
+    // failing after merging the first one
+    size_t count = 0;
+    for (size_t i = 0; i < changes.capacity; ++i) {
+        if (changes.slots[i].used) {
+            changes.slots[count++] = changes.slots[i];
+        }
+    }
+    qsort(changes.slots, count, sizeof(*changes.slots),
+          compare_pending_changes);
+    AVS_UNIT_ASSERT_SUCCESS(restore_pending_changes(&changes, 1, count - 1));
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 3);
+
+    // the unmerged entries are found in the set...
+    for (anjay_rid_t rid = 1; rid < 4; ++rid) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 0, rid));
+    }
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 3);
+    // ...and the merged one is not
+    AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 0, 0));
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 4);
+    avs_free(changes.slots);
+}
+
+AVS_UNIT_TEST(notify_queue, pending_changes_of_object_removed) {
+    anjay_notify_pending_changes_t changes = { NULL, 0, 0 };
+    for (anjay_rid_t rid = 0; rid < 100; ++rid) {
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 42, 0, rid));
+        AVS_UNIT_ASSERT_SUCCESS(add_pending_change(&changes, 43, 0, rid));
+    }
+    const size_t capacity = changes.capacity;
+    remove_pending_changes_of_object(&changes, 42);
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 100);
+    AVS_UNIT_ASSERT_EQUAL(changes.capacity, capacity);
+
+    // entries of the other Object are still reachable, removed ones are not
+    for (anjay_rid_t rid = 0; rid < 100; ++rid) {
+        AVS_UNIT_ASSERT_TRUE(find_pending_change_slot(changes.slots,
+                                                      changes.capacity, 43, 0,
+                                                      rid)
+                                     ->used);
+        AVS_UNIT_ASSERT_FALSE(find_pending_change_slot(changes.slots,
+                                                       changes.capacity, 42, 0,
+                                                       rid)
+                                      ->used);
+    }
+    remove_pending_changes_of_object(&changes, 43);
+    AVS_UNIT_ASSERT_EQUAL(changes.size, 0);
+    for (size_t i = 0; i < changes.capacity; ++i) {
+        AVS_UNIT_ASSERT_FALSE(changes.slots[i].used);
+    }
+    avs_free(changes.slots);
+}
+
+AVS_UNIT_TEST(notify_queue, changed_many) {
+    DM_TEST_INIT;
+    static const anjay_notify_path_t paths[] = {
+        { 42, 3, 1 }, { 42, 1, 2 }, { 42, 3, 1 }, { 43, 0, 0 }
+    };
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_changed_many(anjay, paths, AVS_ARRAY_SIZE(paths)));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed_many(anjay, NULL, 0));
+    AVS_UNIT_ASSERT_FAILED(anjay_notify_changed_many(anjay, NULL, 1));
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 3);
+        AVS_UNIT_ASSERT_NOT_NULL(anjay_unlocked->scheduled_notify.handle);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    DM_TEST_FINISH;
+}
+
+#ifdef ANJAY_WITH_LOCK_FREE_NOTIFY
+AVS_UNIT_TEST(notify_ring, push_pop_order) {
+    anjay_notify_ring_t ring;
+    _anjay_notify_ring_init(&ring, NULL);
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    AVS_UNIT_ASSERT_FALSE(notify_ring_pop(&ring, &oid, &iid, &rid));
+
+    // go around the ring a few times to check wrapping of the positions
+    for (anjay_rid_t lap = 0; lap < 3; ++lap) {
+        for (anjay_iid_t i = 0; i < 10; ++i) {
+            AVS_UNIT_ASSERT_TRUE(notify_ring_push(&ring, 42, i, lap));
+        }
+        for (anjay_iid_t i = 0; i < 10; ++i) {
+            AVS_UNIT_ASSERT_TRUE(notify_ring_pop(&ring, &oid, &iid, &rid));
+            AVS_UNIT_ASSERT_EQUAL(oid, 42);
+            AVS_UNIT_ASSERT_EQUAL(iid, i);
+            AVS_UNIT_ASSERT_EQUAL(rid, lap);
+        }
+        AVS_UNIT_ASSERT_FALSE(notify_ring_pop(&ring, &oid, &iid, &rid));
+    }
+}
+
+AVS_UNIT_TEST(notify_ring, full) {
+    anjay_notify_ring_t ring;
+    _anjay_notify_ring_init(&ring, NULL);
+    for (size_t i = 0; i < ANJAY_NOTIFY_RING_SIZE; ++i) {
+        AVS_UNIT_ASSERT_TRUE(notify_ring_push(&ring, 42, 0, (anjay_rid_t) i));
+    }
+    AVS_UNIT_ASSERT_FALSE(notify_ring_push(&ring, 42, 0, 0));
+
+    // popping a single entry makes room for exactly one more
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    AVS_UNIT_ASSERT_TRUE(notify_ring_pop(&ring, &oid, &iid, &rid));
+    AVS_UNIT_ASSERT_EQUAL(rid, 0);
+    AVS_UNIT_ASSERT_TRUE(notify_ring_push(&ring, 43, 0, 0));
+    AVS_UNIT_ASSERT_FALSE(notify_ring_push(&ring, 43, 0, 1));
+}
+
+AVS_UNIT_TEST(notify_ring, full_ring_falls_back_to_locking) {
+    DM_TEST_INIT;
+    anjay_notify_ring_t *ring = &anjay->atomic_fields.notify_ring;
+    for (size_t i = 0; i < ANJAY_NOTIFY_RING_SIZE; ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(
+                anjay_notify_changed(anjay, 42, 0, (anjay_rid_t) i));
+    }
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 0);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 1, 0));
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 1);
+        AVS_UNIT_ASSERT_NOT_NULL(anjay_unlocked->scheduled_notify.handle);
+
+        AVS_UNIT_ASSERT_TRUE(notify_ring_drain(anjay_unlocked));
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size,
+                ANJAY_NOTIFY_RING_SIZE + 1);
+        AVS_UNIT_ASSERT_FALSE(notify_ring_drain(anjay_unlocked));
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    AVS_UNIT_ASSERT_TRUE(atomic_load(&ring->drain_scheduled));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(notify_ring, drain_scheduled_flag) {
+    DM_TEST_INIT;
+    anjay_notify_ring_t *ring = &anjay->atomic_fields.notify_ring;
+    AVS_UNIT_ASSERT_FALSE(atomic_load(&ring->drain_scheduled));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 0, 1));
+    AVS_UNIT_ASSERT_TRUE(atomic_load(&ring->drain_scheduled));
+    // no second job is needed while the first one has not run yet
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 0, 2));
+    AVS_UNIT_ASSERT_TRUE(atomic_load(&ring->drain_scheduled));
+
+    notify_ring_drain_clb(ring->sched, NULL);
+    AVS_UNIT_ASSERT_FALSE(atomic_load(&ring->drain_scheduled));
+    {
+        // drained changes are processed without scheduling another job
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 0);
+        AVS_UNIT_ASSERT_NULL(anjay_unlocked->scheduled_notify.handle);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 0, 3));
+    AVS_UNIT_ASSERT_TRUE(atomic_load(&ring->drain_scheduled));
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(notify_ring, access_control_changes_not_deferred) {
+    DM_TEST_INIT;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_changed(anjay, ANJAY_DM_OID_ACCESS_CONTROL, 0, 0));
+    AVS_UNIT_ASSERT_FALSE(
+            atomic_load(&anjay->atomic_fields.notify_ring.drain_scheduled));
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 1);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(notify_ring, not_deferred_while_values_pushed) {
+    DM_TEST_INIT;
+    anjay_notify_ring_t *ring = &anjay->atomic_fields.notify_ring;
+    atomic_store(&ring->has_pushed_values, true);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 0, 1));
+    AVS_UNIT_ASSERT_FALSE(atomic_load(&ring->drain_scheduled));
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                anjay_unlocked->scheduled_notify.pending_changes.size, 1);
+        // the flag is recalculated whenever the stored values may change
+        notify_ring_drain(anjay_unlocked);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+#    ifdef ANJAY_WITH_OBSERVE
+    AVS_UNIT_ASSERT_FALSE(atomic_load(&ring->has_pushed_values));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 0, 2));
+    AVS_UNIT_ASSERT_TRUE(atomic_load(&ring->drain_scheduled));
+#    endif // ANJAY_WITH_OBSERVE
+    DM_TEST_FINISH;
+}
+
+#    ifdef AVS_COMMONS_COMPAT_THREADING_WITH_PTHREAD
+#        include <pthread.h>
+#        include <sched.h>
+
+#        define STRESS_PRODUCERS 4
+#        define STRESS_ENTRIES_PER_PRODUCER 20000
+
+typedef struct {
+    anjay_notify_ring_t *ring;
+    anjay_oid_t producer;
+} stress_producer_args_t;
+
+static void *stress_producer(void *args_) {
+    const stress_producer_args_t *args = (const stress_producer_args_t *) args_;
+    for (uint32_t i = 0; i < STRESS_ENTRIES_PER_PRODUCER; ++i) {
+        while (!notify_ring_push(args->ring, args->producer,
+                                 (anjay_iid_t) (i >> 16),
+                                 (anjay_rid_t) (i & 0xFFFF))) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+AVS_UNIT_TEST(notify_ring, multiple_producers) {
+    static anjay_notify_ring_t ring;
+    _anjay_notify_ring_init(&ring, NULL);
+    pthread_t threads[STRESS_PRODUCERS];
+    stress_producer_args_t args[STRESS_PRODUCERS];
+    for (anjay_oid_t i = 0; i < STRESS_PRODUCERS; ++i) {
+        args[i] = (stress_producer_args_t) {
+            .ring = &ring,
+            .producer = i
+        };
+        AVS_UNIT_ASSERT_SUCCESS(
+                pthread_create(&threads[i], NULL, stress_producer, &args[i]));
+    }
+
+    // entries of each producer shall be received exactly once, in order
+    uint32_t next_expected[STRESS_PRODUCERS] = { 0 };
+    size_t received = 0;
+    while (received < STRESS_PRODUCERS * STRESS_ENTRIES_PER_PRODUCER) {
+        anjay_oid_t oid;
+        anjay_iid_t iid;
+        anjay_rid_t rid;
+        if (!notify_ring_pop(&ring, &oid, &iid, &rid)) {
+            sched_yield();
+            continue;
+        }
+        AVS_UNIT_ASSERT_TRUE(oid < STRESS_PRODUCERS);
+        AVS_UNIT_ASSERT_EQUAL(((uint32_t) iid << 16) | rid,
+                              next_expected[oid]);
+        ++next_expected[oid];
+        ++received;
+    }
+    for (size_t i = 0; i < STRESS_PRODUCERS; ++i) {
+        AVS_UNIT_ASSERT_SUCCESS(pthread_join(threads[i], NULL));
+        AVS_UNIT_ASSERT_EQUAL(next_expected[i], STRESS_ENTRIES_PER_PRODUCER);
+    }
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+    AVS_UNIT_ASSERT_FALSE(notify_ring_pop(&ring, &oid, &iid, &rid));
+}
+#    endif // AVS_COMMONS_COMPAT_THREADING_WITH_PTHREAD
+#endif // ANJAY_WITH_LOCK_FREE_NOTIFY
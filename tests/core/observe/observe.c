@@ -14,6 +14,8 @@
 
 #include <avsystem/commons/avs_unit_test.h>
 
+#include <anjay_modules/anjay_notify.h>
+
 #include "src/core/anjay_core.h"
 #include "src/core/servers/anjay_server_connections.h"
 #include "src/core/servers/anjay_servers_internal.h"
@@ -24,8 +26,57 @@
 
 #define MSG_ID_BASE 0x0000
 
+#ifdef ANJAY_WITH_MEMORY_STATS
+static size_t recalculate_memory_usage(const anjay_observe_state_t *observe) {
+    size_t result = 0;
+    AVS_LIST(anjay_observe_connection_entry_t) conn;
+    AVS_LIST_FOREACH(conn, observe->connection_entries) {
+        result += CONNECTION_MEMORY;
+        AVS_SORTED_SET_ELEM(anjay_observation_t) observation;
+        AVS_SORTED_SET_FOREACH(observation, conn->observations) {
+            result += OBSERVATION_MEMORY(observation);
+            AVS_LIST(anjay_observation_value_t) value;
+            AVS_LIST_FOREACH(value, observation->last_sent) {
+                result += value_memory_usage(value);
+            }
+        }
+        AVS_SORTED_SET_ELEM(anjay_observe_path_entry_t) path_entry;
+        AVS_SORTED_SET_FOREACH(path_entry, conn->observed_paths) {
+            result += PATH_ENTRY_MEMORY
+                      + AVS_LIST_SIZE(path_entry->refs) * PATH_ENTRY_REF_MEMORY;
+        }
+        AVS_LIST(anjay_observation_value_t) value;
+        AVS_LIST_FOREACH(value, conn->unsent) {
+            result += value_memory_usage(value);
+        }
+    }
+    if (observe->path_index) {
+        AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) index_entry;
+        AVS_SORTED_SET_FOREACH(index_entry, observe->path_index) {
+            result += PATH_INDEX_ENTRY_MEMORY
+                      + AVS_LIST_SIZE(index_entry->refs)
+                                * PATH_INDEX_REF_MEMORY;
+        }
+    }
+    if (observe->pushed_values) {
+        AVS_SORTED_SET_ELEM(anjay_observe_pushed_value_t) pushed_value;
+        AVS_SORTED_SET_FOREACH(pushed_value, observe->pushed_values) {
+            result += PUSHED_VALUE_MEMORY(pushed_value->value);
+        }
+    }
+    if (observe->read_cache) {
+        AVS_SORTED_SET_ELEM(anjay_observe_read_cache_entry_t) cache_entry;
+        AVS_SORTED_SET_FOREACH(cache_entry, observe->read_cache) {
+            result += READ_CACHE_ENTRY_MEMORY(cache_entry->value);
+        }
+    }
+    return result;
+}
+#endif // ANJAY_WITH_MEMORY_STATS
+
 static void assert_observe_consistency(anjay_t *anjay_locked) {
     ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    size_t observed_paths_count = 0;
     AVS_LIST(anjay_observe_connection_entry_t) conn;
     AVS_LIST_FOREACH(conn, anjay->observe.connection_entries) {
         size_t path_refs_in_observations = 0;
@@ -56,7 +107,32 @@ static void assert_observe_consistency(anjay_t *anjay_locked) {
             }
         }
         AVS_UNIT_ASSERT_EQUAL(path_refs_in_observations, path_refs);
+        observed_paths_count += AVS_SORTED_SET_SIZE(conn->observed_paths);
     }
+
+    size_t index_refs = 0;
+    if (anjay->observe.path_index) {
+        AVS_SORTED_SET_ELEM(anjay_observe_path_index_entry_t) index_entry;
+        AVS_SORTED_SET_FOREACH(index_entry, anjay->observe.path_index) {
+            AVS_UNIT_ASSERT_NOT_NULL(index_entry->refs);
+            AVS_LIST(anjay_observe_path_index_ref_t) ref;
+            AVS_LIST_FOREACH(ref, index_entry->refs) {
+                ++index_refs;
+                AVS_UNIT_ASSERT_TRUE(
+                        AVS_SORTED_SET_FIND(ref->connection->observed_paths,
+                                            ref->path_entry)
+                        == ref->path_entry);
+                AVS_UNIT_ASSERT_TRUE(_anjay_uri_path_equal(
+                        &ref->path_entry->path, &index_entry->path));
+            }
+        }
+    }
+    AVS_UNIT_ASSERT_EQUAL(index_refs, observed_paths_count);
+#ifdef ANJAY_WITH_MEMORY_STATS
+    // the running counter shall match the state it accounts for
+    AVS_UNIT_ASSERT_EQUAL(anjay->observe.memory_usage,
+                          recalculate_memory_usage(&anjay->observe));
+#endif // ANJAY_WITH_MEMORY_STATS
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
@@ -73,6 +149,16 @@ static void assert_observe_size(anjay_t *anjay_locked, size_t sz) {
     ANJAY_MUTEX_UNLOCK(anjay_locked);
 }
 
+static void assert_pushed_values_count(anjay_t *anjay_locked, size_t count) {
+    ANJAY_MUTEX_LOCK(anjay, anjay_locked);
+    AVS_UNIT_ASSERT_EQUAL(anjay->observe.pushed_values
+                                  ? AVS_SORTED_SET_SIZE(
+                                            anjay->observe.pushed_values)
+                                  : 0,
+                          count);
+    ANJAY_MUTEX_UNLOCK(anjay_locked);
+}
+
 static void assert_msg_details_equal(const anjay_msg_details_t *a,
                                      const anjay_msg_details_t *b) {
     AVS_UNIT_ASSERT_EQUAL(a->msg_code, b->msg_code);
@@ -476,6 +562,9 @@ AVS_UNIT_TEST(observe, cancel_deregister) {
     AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_value_changed_i64(anjay, 42, 69, 4, 1337));
+    assert_pushed_values_count(anjay, 1);
     DM_TEST_REQUEST(mocksocks[0], CON, GET, ID_TOKEN(0xFA3E, "SuccsTkn"),
                     OBSERVE(0x01), PATH("42", "69", "4"));
     _anjay_mock_dm_expect_list_instances(
@@ -501,6 +590,8 @@ AVS_UNIT_TEST(observe, cancel_deregister) {
     AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 0);
+    // the value is useless once the Resource is no longer observed
+    assert_pushed_values_count(anjay, 0);
     DM_TEST_FINISH;
 }
 
@@ -682,11 +773,10 @@ static void expect_read_res_attrs(anjay_t *anjay,
     }
 }
 
-static void expect_read_res(anjay_t *anjay,
-                            const anjay_dm_object_def_t *const *obj_ptr,
-                            anjay_iid_t iid,
-                            anjay_rid_t rid,
-                            const anjay_mock_dm_data_t *data) {
+static void expect_res_present(anjay_t *anjay,
+                               const anjay_dm_object_def_t *const *obj_ptr,
+                               anjay_iid_t iid,
+                               anjay_rid_t rid) {
     _anjay_mock_dm_expect_list_instances(
             anjay, obj_ptr, 0, (const anjay_iid_t[]) { iid, ANJAY_ID_INVALID });
     anjay_mock_dm_res_entry_t resources[] = {
@@ -708,6 +798,14 @@ static void expect_read_res(anjay_t *anjay,
     }
     AVS_UNIT_ASSERT_TRUE(i < AVS_ARRAY_SIZE(resources));
     _anjay_mock_dm_expect_list_resources(anjay, obj_ptr, iid, 0, resources);
+}
+
+static void expect_read_res(anjay_t *anjay,
+                            const anjay_dm_object_def_t *const *obj_ptr,
+                            anjay_iid_t iid,
+                            anjay_rid_t rid,
+                            const anjay_mock_dm_data_t *data) {
+    expect_res_present(anjay, obj_ptr, iid, rid);
     _anjay_mock_dm_expect_resource_read(anjay, obj_ptr, iid, rid,
                                         ANJAY_ID_INVALID, 0, data);
 }
@@ -780,10 +878,10 @@ static void notify_max_period_test(const char *con_notify_ack,
                    "Hello", 5);
 
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     AVS_UNIT_ASSERT_EQUAL(
             AVS_SORTED_SET_FIRST(
                     anjay_unlocked->observe.connection_entries->observations)
@@ -918,15 +1016,147 @@ AVS_UNIT_TEST(notify, min_period) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
 }
 
+AVS_UNIT_TEST(notify, value_changed) {
+    static const anjay_dm_r_attributes_t ATTRS = {
+        .common = {
+            .min_period = 10,
+            .max_period = 365 * 24 * 60 * 60 /* a year */,
+            .min_eval_period = ANJAY_ATTRIB_INTEGER_NONE,
+            .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
+        },
+        .greater_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .less_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .step = ANJAY_ATTRIB_DOUBLE_NONE
+    };
+
+    ////// INITIALIZATION //////
+    DM_TEST_INIT_WITH_SSIDS(14);
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID_TOKEN(0x69ED, "Res4"),
+                    OBSERVE(0), PATH("42", "69", "4"));
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_INT(0, 514));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT,
+                            ID_TOKEN(0x69ED, "Res4"), CONTENT_FORMAT(PLAINTEXT),
+                            OBSERVE(0), PAYLOAD("514"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+
+    assert_observe_size(anjay, 1);
+
+    ////// PUSHED VALUE, READ HANDLER NOT CALLED //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_value_changed_i64(anjay, 42, 69, 4, 1337));
+    // not observed by itself, so the value would never be used
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_notify_value_changed_i64(anjay, 42, 69, 5, 7));
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        AVS_UNIT_ASSERT_EQUAL(
+                AVS_SORTED_SET_SIZE(anjay_unlocked->observe.pushed_values), 1);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    assert_observe_consistency(anjay);
+    anjay_sched_run(anjay);
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    expect_res_present(anjay, &OBJ, 69, 4);
+    const coap_test_msg_t *notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE, "Res4"), OBSERVE(1),
+                     CONTENT_FORMAT(PLAINTEXT), PAYLOAD("1337"));
+    avs_unit_mocksock_expect_output(mocksocks[0], notify_response->content,
+                                    notify_response->length);
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+
+    ////// CHANGE WITHOUT A VALUE, READ HANDLER CALLED //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 69, 4));
+    anjay_sched_run(anjay);
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_INT(0, 42));
+    notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE + 1, "Res4"),
+                     OBSERVE(2), CONTENT_FORMAT(PLAINTEXT), PAYLOAD("42"));
+    avs_unit_mocksock_expect_output(mocksocks[0], notify_response->content,
+                                    notify_response->length);
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+    assert_observe_size(anjay, 1);
+
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(notify, cached_attrs) {
+    static const anjay_dm_r_attributes_t ATTRS = {
+        .common = {
+            .min_period = 10,
+            .max_period = 365 * 24 * 60 * 60 /* a year */,
+            .min_eval_period = ANJAY_ATTRIB_INTEGER_NONE,
+            .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
+        },
+        .greater_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .less_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .step = ANJAY_ATTRIB_DOUBLE_NONE
+    };
+
+    ////// INITIALIZATION //////
+    DM_TEST_INIT_WITH_SSIDS(14);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_set_observe_attributes_caching(anjay, true));
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID_TOKEN(0x69ED, "Res4"),
+                    OBSERVE(0), PATH("42", "69", "4"));
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_FLOAT(0, 514.0));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT,
+                            ID_TOKEN(0x69ED, "Res4"), CONTENT_FORMAT(PLAINTEXT),
+                            OBSERVE(0), PAYLOAD("514"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+
+    assert_observe_size(anjay, 1);
+
+    ////// PMIN NOT REACHED, ATTRIBUTES NOT READ AGAIN //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(5, AVS_TIME_S));
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 69, 4));
+    anjay_sched_run(anjay);
+    anjay_sched_run(anjay);
+
+    ////// PMIN REACHED //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(5, AVS_TIME_S));
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_STRING(0, "Hi!"));
+    const coap_test_msg_t *notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE, "Res4"), OBSERVE(1),
+                     CONTENT_FORMAT(PLAINTEXT), PAYLOAD("Hi!"));
+    avs_unit_mocksock_expect_output(mocksocks[0], notify_response->content,
+                                    notify_response->length);
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+    assert_observe_size(anjay, 1);
+
+    ////// CACHE INVALIDATED //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    anjay_notify_attributes_changed(anjay);
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_notify_changed(anjay, 42, 69, 4));
+    anjay_sched_run(anjay);
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_STRING(0, "Hi!"));
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+    assert_observe_size(anjay, 1);
+
+    DM_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(notify, epmin_greater_than_pmax) {
     static const anjay_dm_r_attributes_t ATTRS = {
         .common = {
@@ -1135,10 +1365,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// EVEN LESS //////
@@ -1151,10 +1381,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// IN BETWEEN //////
@@ -1172,10 +1402,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// EQUAL - STILL NOT CROSSING //////
@@ -1188,10 +1418,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER //////
@@ -1209,10 +1439,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// STILL GREATER //////
@@ -1225,10 +1455,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS AGAIN //////
@@ -1246,10 +1476,10 @@ AVS_UNIT_TEST(notify, extremes) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1292,10 +1522,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS //////
@@ -1313,10 +1543,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER AGAIN //////
@@ -1334,10 +1564,10 @@ AVS_UNIT_TEST(notify, greater_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1385,10 +1615,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// STILL LESS //////
@@ -1401,10 +1631,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// GREATER //////
@@ -1422,10 +1652,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// LESS AGAIN //////
@@ -1443,10 +1673,10 @@ AVS_UNIT_TEST(notify, less_only) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1488,10 +1718,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY EXACTLY stp //////
@@ -1509,10 +1739,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY OVER stp //////
@@ -1530,10 +1760,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// NON-NUMERIC VALUE //////
@@ -1551,10 +1781,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// BACK TO NUMBERS //////
@@ -1572,10 +1802,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// TOO LITTLE DECREASE //////
@@ -1588,10 +1818,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// DECREASE BY EXACTLY stp //////
@@ -1609,10 +1839,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// DECREASE BY MORE THAN stp //////
@@ -1630,10 +1860,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     ////// INCREASE BY EXACTLY stp //////
@@ -1651,10 +1881,10 @@ AVS_UNIT_TEST(notify, step) {
     assert_observe_consistency(anjay);
     assert_observe_size(anjay, 1);
     ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
-    AVS_UNIT_ASSERT_NOT_NULL(
-            AVS_SORTED_SET_FIRST(
-                    anjay_unlocked->observe.connection_entries->observations)
-                    ->notify_task);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_node_armed(
+            &AVS_SORTED_SET_FIRST(
+                     anjay_unlocked->observe.connection_entries->observations)
+                     ->trigger));
     ANJAY_MUTEX_UNLOCK(anjay);
 
     DM_TEST_FINISH;
@@ -1778,6 +2008,108 @@ AVS_UNIT_TEST(notify, multiple_formats) {
     DM_TEST_FINISH;
 }
 
+AVS_UNIT_TEST(notify, read_sharing) {
+    static const anjay_dm_r_attributes_t ATTRS = {
+        .common = {
+            .min_period = 1,
+            .max_period = 10,
+            .min_eval_period = ANJAY_ATTRIB_INTEGER_NONE,
+            .max_eval_period = ANJAY_ATTRIB_INTEGER_NONE
+        },
+        .greater_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .less_than = ANJAY_ATTRIB_DOUBLE_NONE,
+        .step = ANJAY_ATTRIB_DOUBLE_NONE
+    };
+
+    ////// INITIALIZATION //////
+    DM_TEST_INIT_WITH_SSIDS(14);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_set_observe_read_sharing(anjay, true));
+    // Token: P
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID_TOKEN(0x69ED, "P"), OBSERVE(0),
+                    ACCEPT(AVS_COAP_FORMAT_PLAINTEXT), PATH("42", "69", "4"));
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_FLOAT(0, 514.0));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID_TOKEN(0x69ED, "P"),
+                            CONTENT_FORMAT(PLAINTEXT), OBSERVE(0),
+                            PAYLOAD("514"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+    // Token: T
+    DM_TEST_REQUEST(mocksocks[0], CON, GET, ID_TOKEN(0x69ED, "T"),
+                    ACCEPT(AVS_COAP_FORMAT_OMA_LWM2M_TLV), OBSERVE(0),
+                    PATH("42", "69", "4"));
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_FLOAT(0, 514.0));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    DM_TEST_EXPECT_RESPONSE(mocksocks[0], ACK, CONTENT, ID_TOKEN(0x69ED, "T"),
+                            CONTENT_FORMAT(OMA_LWM2M_TLV), OBSERVE(0),
+                            PAYLOAD("\xC4\x04\x44\x00\x80\x00"));
+    expect_has_buffered_data_check(mocksocks[0], false);
+    AVS_UNIT_ASSERT_SUCCESS(anjay_serve(anjay, mocksocks[0]));
+
+    assert_observe_size(anjay, 2);
+
+    ////// NOTIFICATION //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    // plaintext
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_STRING(0, "Hello"));
+    const coap_test_msg_t *p_notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE, "P"), OBSERVE(1),
+                     CONTENT_FORMAT(PLAINTEXT), PAYLOAD("Hello"));
+    avs_unit_mocksock_expect_output(mocksocks[0], p_notify_response->content,
+                                    p_notify_response->length);
+    // TLV - value read for the previous observation is reused
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    const coap_test_msg_t *t_notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE + 1, "T"), OBSERVE(1),
+                     CONTENT_FORMAT(OMA_LWM2M_TLV),
+                     PAYLOAD("\xc5\x04"
+                             "Hello"));
+    avs_unit_mocksock_expect_output(mocksocks[0], t_notify_response->content,
+                                    t_notify_response->length);
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+
+    ////// NEXT NOTIFICATION - VALUES NOT SHARED ACROSS SCHEDULER RUNS //////
+    _anjay_mock_clock_advance(avs_time_duration_from_scalar(10, AVS_TIME_S));
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    expect_read_res(anjay, &OBJ, 69, 4, ANJAY_MOCK_DM_STRING(0, "World"));
+    p_notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE + 2, "P"), OBSERVE(2),
+                     CONTENT_FORMAT(PLAINTEXT), PAYLOAD("World"));
+    avs_unit_mocksock_expect_output(mocksocks[0], p_notify_response->content,
+                                    p_notify_response->length);
+    expect_read_res_attrs(anjay, &OBJ, 14, 69, 4, &ATTRS);
+    t_notify_response =
+            COAP_MSG(NON, CONTENT, ID_TOKEN(MSG_ID_BASE + 3, "T"), OBSERVE(2),
+                     CONTENT_FORMAT(OMA_LWM2M_TLV),
+                     PAYLOAD("\xc5\x04"
+                             "World"));
+    avs_unit_mocksock_expect_output(mocksocks[0], t_notify_response->content,
+                                    t_notify_response->length);
+    anjay_sched_run(anjay);
+    assert_observe_consistency(anjay);
+    assert_observe_size(anjay, 2);
+
+    ////// SHARED VALUES DROPPED AS SOON AS A CHANGE IS QUEUED //////
+    {
+        ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+        uint64_t generation = anjay_unlocked->observe.read_cache_generation;
+        AVS_UNIT_ASSERT_SUCCESS(
+                _anjay_notify_changed_unlocked(anjay_unlocked, 42, 69, 4));
+        AVS_UNIT_ASSERT_TRUE(anjay_unlocked->observe.read_cache_generation
+                             > generation);
+        generation = anjay_unlocked->observe.read_cache_generation;
+        AVS_UNIT_ASSERT_SUCCESS(
+                _anjay_notify_instances_changed_unlocked(anjay_unlocked, 42));
+        AVS_UNIT_ASSERT_TRUE(anjay_unlocked->observe.read_cache_generation
+                             > generation);
+        AVS_UNIT_ASSERT_NULL(anjay_unlocked->observe.read_cache_clear_job);
+        ANJAY_MUTEX_UNLOCK(anjay);
+    }
+    DM_TEST_FINISH;
+}
+
 AVS_UNIT_TEST(notify, storing_when_inactive) {
     SUCCESS_TEST(14, 34);
     anjay_server_connection_t *connection;
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <string.h>
+
+#include <avsystem/commons/avs_unit_test.h>
+
+#include "tests/utils/mock_clock.h"
+
+static avs_time_monotonic_t at(int64_t seconds, int32_t milliseconds) {
+    return avs_time_monotonic_add(
+            avs_time_monotonic_from_scalar(seconds, AVS_TIME_S),
+            avs_time_duration_from_scalar(milliseconds, AVS_TIME_MS));
+}
+
+static void assert_expires(anjay_observe_wheel_t *wheel,
+                           avs_time_monotonic_t now,
+                           anjay_observe_wheel_node_t *const *expected,
+                           size_t expected_count) {
+    _anjay_observe_wheel_advance(wheel, now);
+    for (size_t i = 0; i < expected_count; ++i) {
+        AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_pop_expired(wheel)
+                             == expected[i]);
+        AVS_UNIT_ASSERT_FALSE(_anjay_observe_wheel_node_armed(expected[i]));
+    }
+    AVS_UNIT_ASSERT_NULL(_anjay_observe_wheel_pop_expired(wheel));
+}
+
+AVS_UNIT_TEST(observe_wheel, expiry_order) {
+    _anjay_mock_clock_start(at(1000, 0));
+    anjay_observe_wheel_t wheel;
+    memset(&wheel, 0, sizeof(wheel));
+    anjay_observe_wheel_node_t nodes[4];
+    memset(nodes, 0, sizeof(nodes));
+
+    _anjay_observe_wheel_arm(&wheel, &nodes[0], at(1005, 500));
+    _anjay_observe_wheel_arm(&wheel, &nodes[1], at(1005, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[2], at(1005, 500));
+    _anjay_observe_wheel_arm(&wheel, &nodes[3], at(1003, 0));
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_equal(
+            _anjay_observe_wheel_next_deadline(&wheel), at(1003, 0)));
+
+    assert_expires(&wheel, at(1002, 999), NULL, 0);
+    assert_expires(&wheel, at(1005, 200),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[3],
+                                                           &nodes[1] },
+                   2);
+    // the rest of the tick is left in the wheel
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_equal(
+            _anjay_observe_wheel_next_deadline(&wheel), at(1005, 500)));
+    // equal deadlines expire in the order of arming
+    assert_expires(&wheel, at(1005, 500),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[0],
+                                                           &nodes[2] },
+                   2);
+    AVS_UNIT_ASSERT_FALSE(avs_time_monotonic_valid(
+            _anjay_observe_wheel_next_deadline(&wheel)));
+    _anjay_mock_clock_finish();
+}
+
+AVS_UNIT_TEST(observe_wheel, cascading) {
+    _anjay_mock_clock_start(at(1000, 0));
+    anjay_observe_wheel_t wheel;
+    memset(&wheel, 0, sizeof(wheel));
+    anjay_observe_wheel_node_t nodes[4];
+    memset(nodes, 0, sizeof(nodes));
+
+    // one node per level, the last one beyond the range of the whole wheel
+    _anjay_observe_wheel_arm(&wheel, &nodes[0], at(1010, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[1], at(1100, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[2], at(21000, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[3], at(1000 + 86400 * 30, 0));
+    for (int level = 0; level < ANJAY_OBSERVE_WHEEL_LEVELS; ++level) {
+        AVS_UNIT_ASSERT_EQUAL(wheel.level_count[level], 1);
+    }
+
+    assert_expires(&wheel, at(1099, 999),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[0] }, 1);
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_equal(
+            _anjay_observe_wheel_next_deadline(&wheel), at(1100, 0)));
+    assert_expires(&wheel, at(1100, 0),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[1] }, 1);
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_equal(
+            _anjay_observe_wheel_next_deadline(&wheel), at(21000, 0)));
+    assert_expires(&wheel, at(1000 + 86400 * 30 - 1, 0),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[2] }, 1);
+    assert_expires(&wheel, at(1000 + 86400 * 30, 0),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[3] }, 1);
+    _anjay_mock_clock_finish();
+}
+
+AVS_UNIT_TEST(observe_wheel, disarm) {
+    _anjay_mock_clock_start(at(1000, 0));
+    anjay_observe_wheel_t wheel;
+    memset(&wheel, 0, sizeof(wheel));
+    anjay_observe_wheel_node_t nodes[3];
+    memset(nodes, 0, sizeof(nodes));
+
+    _anjay_observe_wheel_arm(&wheel, &nodes[0], at(1001, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[1], at(1001, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[2], at(1500, 0));
+    _anjay_observe_wheel_disarm(&wheel, &nodes[2]);
+    AVS_UNIT_ASSERT_FALSE(_anjay_observe_wheel_node_armed(&nodes[2]));
+    // disarming a node that is not armed is a no-op
+    _anjay_observe_wheel_disarm(&wheel, &nodes[2]);
+
+    // nodes already collected as expired may be disarmed as well
+    _anjay_observe_wheel_advance(&wheel, at(1001, 0));
+    _anjay_observe_wheel_disarm(&wheel, &nodes[0]);
+    AVS_UNIT_ASSERT_TRUE(_anjay_observe_wheel_pop_expired(&wheel)
+                         == &nodes[1]);
+    AVS_UNIT_ASSERT_NULL(_anjay_observe_wheel_pop_expired(&wheel));
+
+    // re-arming moves the node
+    _anjay_observe_wheel_arm(&wheel, &nodes[1], at(1010, 0));
+    _anjay_observe_wheel_arm(&wheel, &nodes[1], at(1005, 0));
+    AVS_UNIT_ASSERT_TRUE(avs_time_monotonic_equal(
+            _anjay_observe_wheel_next_deadline(&wheel), at(1005, 0)));
+    assert_expires(&wheel, at(1020, 0),
+                   (anjay_observe_wheel_node_t *const[]) { &nodes[1] }, 1);
+    for (int level = 0; level < ANJAY_OBSERVE_WHEEL_LEVELS; ++level) {
+        AVS_UNIT_ASSERT_EQUAL(wheel.level_count[level], 0);
+    }
+    _anjay_mock_clock_finish();
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2017-2022 AVSystem <avsystem@avsystem.com>
+ * AVSystem Anjay LwM2M SDK
+ * All rights reserved.
+ *
+ * Licensed under the AVSystem-5-clause License.
+ * See the attached LICENSE file for details.
+ */
+
+#include <anjay_init.h>
+
+#include <avsystem/commons/avs_unit_test.h>
+
+#include "tests/utils/mock_clock.h"
+
+#ifdef ANJAY_WITH_OPERATION_STATS
+
+AVS_UNIT_TEST(operation_stats, histogram_buckets) {
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(0), 0);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(1), 1);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(2), 2);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(3), 2);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(4), 3);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(1000), 10);
+    AVS_UNIT_ASSERT_EQUAL(time_to_histogram_bucket(UINT64_MAX),
+                          ANJAY_OPERATION_STATS_HISTOGRAM_BUCKETS - 1);
+}
+
+static void record_operation(anjay_unlocked_t *anjay,
+                             anjay_ssid_t ssid,
+                             anjay_operation_t operation,
+                             int64_t time_us,
+                             bool failed) {
+    avs_time_monotonic_t start_time = avs_time_monotonic_now();
+    _anjay_mock_clock_advance(
+            avs_time_duration_from_scalar(time_us, AVS_TIME_US));
+    _anjay_operation_stats_record(anjay, ssid, operation, start_time, failed);
+}
+
+static const anjay_operation_stats_t *
+get_stats(anjay_unlocked_t *anjay,
+          anjay_ssid_t ssid,
+          anjay_operation_t operation) {
+    AVS_LIST(anjay_server_operation_stats_t) it;
+    AVS_LIST_FOREACH(it, anjay->operation_stats) {
+        if (it->ssid == ssid) {
+            return &it->operations[operation];
+        }
+    }
+    return NULL;
+}
+
+AVS_UNIT_TEST(operation_stats, record) {
+    anjay_unlocked_t anjay;
+    memset(&anjay, 0, sizeof(anjay));
+    _anjay_mock_clock_start(avs_time_monotonic_from_scalar(1, AVS_TIME_S));
+
+    record_operation(&anjay, 2, ANJAY_OPERATION_READ, 100, false);
+    record_operation(&anjay, 1, ANJAY_OPERATION_READ, 3, true);
+    record_operation(&anjay, 2, ANJAY_OPERATION_READ, 5000, false);
+    record_operation(&anjay, 2, ANJAY_OPERATION_REGISTER, 20000, true);
+
+    // list is sorted by SSID
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(anjay.operation_stats), 2);
+    AVS_UNIT_ASSERT_EQUAL(anjay.operation_stats->ssid, 1);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(anjay.operation_stats)->ssid, 2);
+
+    const anjay_operation_stats_t *stats =
+            get_stats(&anjay, 2, ANJAY_OPERATION_READ);
+    AVS_UNIT_ASSERT_NOT_NULL(stats);
+    AVS_UNIT_ASSERT_EQUAL(stats->count, 2);
+    AVS_UNIT_ASSERT_EQUAL(stats->error_count, 0);
+    AVS_UNIT_ASSERT_EQUAL(stats->total_time_us, 5100);
+    AVS_UNIT_ASSERT_EQUAL(stats->max_time_us, 5000);
+    AVS_UNIT_ASSERT_EQUAL(stats->time_histogram[7], 1);
+    AVS_UNIT_ASSERT_EQUAL(stats->time_histogram[13], 1);
+
+    stats = get_stats(&anjay, 1, ANJAY_OPERATION_READ);
+    AVS_UNIT_ASSERT_NOT_NULL(stats);
+    AVS_UNIT_ASSERT_EQUAL(stats->count, 1);
+    AVS_UNIT_ASSERT_EQUAL(stats->error_count, 1);
+    AVS_UNIT_ASSERT_EQUAL(stats->time_histogram[2], 1);
+
+    stats = get_stats(&anjay, 2, ANJAY_OPERATION_REGISTER);
+    AVS_UNIT_ASSERT_NOT_NULL(stats);
+    AVS_UNIT_ASSERT_EQUAL(stats->count, 1);
+    AVS_UNIT_ASSERT_EQUAL(stats->error_count, 1);
+    AVS_UNIT_ASSERT_EQUAL(stats->max_time_us, 20000);
+
+    stats = get_stats(&anjay, 2, ANJAY_OPERATION_WRITE);
+    AVS_UNIT_ASSERT_NOT_NULL(stats);
+    AVS_UNIT_ASSERT_EQUAL(stats->count, 0);
+
+    _anjay_operation_stats_cleanup(&anjay.operation_stats);
+    AVS_UNIT_ASSERT_NULL(anjay.operation_stats);
+    _anjay_mock_clock_finish();
+}
+
+#endif // ANJAY_WITH_OPERATION_STATS
+
+#ifdef ANJAY_WITH_SCHED_PROFILING
+
+AVS_UNIT_TEST(sched_profiling, job_stats_keyed_by_name) {
+    anjay_unlocked_t anjay;
+    memset(&anjay, 0, sizeof(anjay));
+    // names coming from different translation units may not be deduplicated
+    char other_name[] = "first_job";
+
+    anjay_sched_job_stats_t *first =
+            find_or_create_job_stats(&anjay, "first_job");
+    AVS_UNIT_ASSERT_NOT_NULL(first);
+    anjay_sched_job_stats_t *second =
+            find_or_create_job_stats(&anjay, "second_job");
+    AVS_UNIT_ASSERT_NOT_NULL(second);
+    AVS_UNIT_ASSERT_TRUE(first != second);
+    AVS_UNIT_ASSERT_TRUE(find_or_create_job_stats(&anjay, other_name)
+                         == first);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(anjay.sched_job_stats), 2);
+
+    _anjay_sched_job_stats_cleanup(&anjay.sched_job_stats);
+    AVS_UNIT_ASSERT_NULL(anjay.sched_job_stats);
+}
+
+AVS_UNIT_TEST(sched_profiling, duration_to_us) {
+    AVS_UNIT_ASSERT_EQUAL(duration_to_us(avs_time_duration_from_scalar(
+                                  1500, AVS_TIME_US)),
+                          1500);
+    AVS_UNIT_ASSERT_EQUAL(duration_to_us(avs_time_duration_from_scalar(
+                                  -1, AVS_TIME_S)),
+                          0);
+    AVS_UNIT_ASSERT_EQUAL(duration_to_us(AVS_TIME_DURATION_INVALID), 0);
+}
+
+#endif // ANJAY_WITH_SCHED_PROFILING
@@ -14,8 +14,11 @@
 #include <anjay/access_control.h>
 #include <anjay/core.h>
 
+#include <anjay_modules/anjay_access_utils.h>
+#include <anjay_modules/anjay_notify.h>
 #include <anjay_modules/dm/anjay_execute.h>
 
+#include "src/core/anjay_access_utils_private.h"
 #include "src/core/anjay_core.h"
 #include "src/core/servers/anjay_servers_internal.h"
 #include "src/modules/access_control/anjay_mod_access_control.h"
@@ -316,3 +319,187 @@ AVS_UNIT_TEST(access_control, set_owner) {
 
     DM_TEST_FINISH;
 }
+
+static bool action_allowed(anjay_unlocked_t *anjay,
+                           anjay_ssid_t ssid,
+                           anjay_request_action_t action) {
+    return _anjay_instance_action_allowed(
+            anjay, &(const anjay_action_info_t) {
+                       .oid = TEST_OID,
+                       .iid = 1,
+                       .ssid = ssid,
+                       .action = action
+                   });
+}
+
+AVS_UNIT_TEST(access_control, mask_cache) {
+    const anjay_dm_object_def_t *const *obj_defs[] = { &FAKE_SECURITY,
+                                                       &FAKE_SERVER, &TEST };
+    anjay_ssid_t ssids[] = { 1, 2 };
+    DM_TEST_INIT_GENERIC(obj_defs, ssids, DM_TEST_CONFIGURATION());
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_install(anjay));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    /* prevent sending Update, as that will fail in the test environment */
+    AVS_LIST(anjay_server_info_t) server;
+    AVS_LIST_FOREACH(server, anjay_unlocked->servers) {
+        avs_sched_del(&server->next_action_handle);
+    }
+
+    access_control_t *ac = _anjay_access_control_get(anjay_unlocked);
+    AVS_LIST(access_control_instance_t) instance =
+            AVS_LIST_NEW_ELEMENT(access_control_instance_t);
+    AVS_UNIT_ASSERT_NOT_NULL(instance);
+    instance->iid = 5;
+    instance->target.oid = TEST_OID;
+    instance->target.iid = 1;
+    instance->owner = 1;
+    instance->has_acl = true;
+    AVS_UNIT_ASSERT_NOT_NULL(AVS_LIST_APPEND_NEW(acl_entry_t, &instance->acl));
+    instance->acl->ssid = 2;
+    instance->acl->mask = ANJAY_ACCESS_MASK_READ;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_access_control_add_instance(ac, instance, NULL));
+
+    AVS_UNIT_ASSERT_TRUE(action_allowed(anjay_unlocked, 2, ANJAY_ACTION_READ));
+    AVS_UNIT_ASSERT_FALSE(
+            action_allowed(anjay_unlocked, 2, ANJAY_ACTION_WRITE));
+    AVS_UNIT_ASSERT_FALSE(action_allowed(anjay_unlocked, 1, ANJAY_ACTION_READ));
+
+    const anjay_access_mask_cache_t *cache =
+            &anjay_unlocked->dm.access_mask_cache;
+    AVS_UNIT_ASSERT_EQUAL(cache->state, ANJAY_ACCESS_MASK_CACHE_VALID);
+    AVS_UNIT_ASSERT_EQUAL(cache->size, 1);
+    AVS_UNIT_ASSERT_EQUAL(cache->entries[0].ac_iid, 5);
+
+    // changes not notified are not visible
+    instance->acl->mask = ANJAY_ACCESS_MASK_WRITE;
+    AVS_UNIT_ASSERT_TRUE(action_allowed(anjay_unlocked, 2, ANJAY_ACTION_READ));
+
+    // only the changed instance is re-read
+    _anjay_access_mask_cache_invalidate(anjay_unlocked, 5);
+    AVS_UNIT_ASSERT_EQUAL(cache->state, ANJAY_ACCESS_MASK_CACHE_VALID);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(cache->dirty_ac_iids), 1);
+    AVS_UNIT_ASSERT_FALSE(action_allowed(anjay_unlocked, 2, ANJAY_ACTION_READ));
+    AVS_UNIT_ASSERT_TRUE(action_allowed(anjay_unlocked, 2, ANJAY_ACTION_WRITE));
+    AVS_UNIT_ASSERT_NULL(cache->dirty_ac_iids);
+    AVS_UNIT_ASSERT_EQUAL(cache->size, 1);
+
+    // empty ACL grants access to the owner
+    AVS_LIST_CLEAR(&instance->acl);
+    _anjay_access_mask_cache_invalidate(anjay_unlocked, ANJAY_ID_INVALID);
+    AVS_UNIT_ASSERT_EQUAL(cache->state, ANJAY_ACCESS_MASK_CACHE_INVALID);
+    AVS_UNIT_ASSERT_TRUE(action_allowed(anjay_unlocked, 1, ANJAY_ACTION_WRITE));
+    AVS_UNIT_ASSERT_FALSE(action_allowed(anjay_unlocked, 2, ANJAY_ACTION_READ));
+    AVS_UNIT_ASSERT_EQUAL(cache->state, ANJAY_ACCESS_MASK_CACHE_VALID);
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    DM_TEST_FINISH;
+}
+
+static void add_ac_instance(access_control_t *ac,
+                            anjay_iid_t iid,
+                            anjay_oid_t target_oid,
+                            anjay_iid_t target_iid) {
+    AVS_LIST(access_control_instance_t) instance =
+            AVS_LIST_NEW_ELEMENT(access_control_instance_t);
+    AVS_UNIT_ASSERT_NOT_NULL(instance);
+    instance->iid = iid;
+    instance->target.oid = target_oid;
+    instance->target.iid = target_iid;
+    instance->owner = 1;
+    instance->has_acl = true;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_access_control_add_instance(ac, instance, NULL));
+}
+
+AVS_UNIT_TEST(access_control, sync_only_changed_objects) {
+    const anjay_dm_object_def_t *const *obj_defs[] = { &FAKE_SECURITY,
+                                                       &FAKE_SERVER, &TEST };
+    anjay_ssid_t ssids[] = { 1, 2 };
+    DM_TEST_INIT_GENERIC(obj_defs, ssids, DM_TEST_CONFIGURATION());
+    AVS_UNIT_ASSERT_SUCCESS(anjay_access_control_install(anjay));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    /* prevent sending Update, as that will fail in the test environment */
+    AVS_LIST(anjay_server_info_t) server;
+    AVS_LIST_FOREACH(server, anjay_unlocked->servers) {
+        avs_sched_del(&server->next_action_handle);
+    }
+
+    access_control_t *ac = _anjay_access_control_get(anjay_unlocked);
+    add_ac_instance(ac, 1, TEST_OID, 1);
+    add_ac_instance(ac, 2, TEST_OID, 2);
+    // refers to a non-existent object, but that object did not change
+    add_ac_instance(ac, 3, 42, 1);
+
+    anjay_notify_queue_t queue = NULL;
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_notify_queue_instance_removed(&queue, TEST_OID, 2));
+
+    // only the changed object is queried
+    _anjay_mock_dm_expect_list_instances(
+            anjay, &TEST, 0, (const anjay_iid_t[]) { 1, ANJAY_ID_INVALID });
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sync_access_control(
+            anjay_unlocked, ANJAY_SSID_BOOTSTRAP, &queue));
+
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(ac->current.instances), 2);
+    AVS_UNIT_ASSERT_EQUAL(ac->current.instances->iid, 1);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(ac->current.instances)->iid, 3);
+
+    _anjay_notify_clear_queue(&queue);
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    DM_TEST_FINISH;
+}
+
+AVS_UNIT_TEST(access_control, rollback_restores_only_touched_instances) {
+    ACCESS_CONTROL_TEST_INIT;
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, anjay);
+    access_control_t *ac = _anjay_access_control_get(anjay_unlocked);
+    add_ac_instance(ac, 1, TEST_OID, 1);
+    add_ac_instance(ac, 2, TEST_OID, 2);
+    add_ac_instance(ac, 4, TEST_OID, 4);
+    AVS_LIST(acl_entry_t) acl = AVS_LIST_NEW_ELEMENT(acl_entry_t);
+    AVS_UNIT_ASSERT_NOT_NULL(acl);
+    acl->ssid = 1;
+    acl->mask = ANJAY_ACCESS_MASK_READ | ANJAY_ACCESS_MASK_WRITE;
+    ac->current.instances->acl = acl;
+
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_dm_call_transaction_begin(anjay_unlocked, &ac->obj_def_ptr));
+    AVS_UNIT_ASSERT_NULL(ac->undo_log);
+    // modify
+    AVS_UNIT_ASSERT_SUCCESS(
+            _anjay_dm_call_instance_reset(anjay_unlocked, &ac->obj_def_ptr, 1));
+    AVS_UNIT_ASSERT_NULL(ac->current.instances->acl);
+    AVS_UNIT_ASSERT_EQUAL(ac->current.instances->owner, 0);
+    // remove
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_remove(
+            anjay_unlocked, &ac->obj_def_ptr, 2));
+    // create
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_instance_create(
+            anjay_unlocked, &ac->obj_def_ptr, 3));
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(ac->undo_log), 3);
+    AVS_UNIT_ASSERT_FALSE(ac->has_saved_state);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_dm_call_transaction_rollback(
+            anjay_unlocked, &ac->obj_def_ptr));
+
+    AVS_UNIT_ASSERT_NULL(ac->undo_log);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(ac->current.instances), 3);
+    access_control_instance_t *inst = ac->current.instances;
+    AVS_UNIT_ASSERT_EQUAL(inst->iid, 1);
+    AVS_UNIT_ASSERT_EQUAL(inst->owner, 1);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(inst->acl), 1);
+    AVS_UNIT_ASSERT_EQUAL(inst->acl->ssid, 1);
+    AVS_UNIT_ASSERT_EQUAL(inst->acl->mask, ANJAY_ACCESS_MASK_READ
+                                                   | ANJAY_ACCESS_MASK_WRITE);
+    inst = AVS_LIST_NEXT(inst);
+    AVS_UNIT_ASSERT_EQUAL(inst->iid, 2);
+    AVS_UNIT_ASSERT_EQUAL(inst->target.iid, 2);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(inst)->iid, 4);
+    ANJAY_MUTEX_UNLOCK(anjay);
+
+    DM_TEST_FINISH;
+}
@@ -93,3 +93,113 @@ AVS_UNIT_TEST(security_object_api, add_instance_with_null_uri) {
     AVS_UNIT_ASSERT_FAILED(
             anjay_security_object_add_instance(env->anjay, &instance, &iid));
 }
+
+AVS_UNIT_TEST(security_object_api, rollback_restores_only_touched_instances) {
+    SCOPED_SERVER_TEST_ENV(env);
+    static const char IDENTITY[] = "identity";
+    static const char KEY[] = "secret key";
+    anjay_security_instance_t psk_instance = instance1;
+    psk_instance.security_mode = ANJAY_SECURITY_PSK;
+    psk_instance.public_cert_or_psk_identity = (const uint8_t *) IDENTITY;
+    psk_instance.public_cert_or_psk_identity_size = sizeof(IDENTITY) - 1;
+    psk_instance.private_cert_or_psk_key = (const uint8_t *) KEY;
+    psk_instance.private_cert_or_psk_key_size = sizeof(KEY) - 1;
+    anjay_iid_t iid1 = 1;
+    AVS_UNIT_ASSERT_SUCCESS(anjay_security_object_add_instance(
+            env->anjay, &psk_instance, &iid1));
+    anjay_iid_t iid2 = 2;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_security_object_add_instance(env->anjay, &instance2, &iid2));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, env->anjay);
+    const anjay_dm_installed_object_t *obj_ptr =
+            _anjay_dm_find_object_by_oid(anjay_unlocked,
+                                         ANJAY_DM_OID_SECURITY);
+    AVS_UNIT_ASSERT_NOT_NULL(obj_ptr);
+    sec_repr_t *repr = _anjay_sec_get(*obj_ptr);
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_begin_impl(repr));
+    AVS_UNIT_ASSERT_NULL(repr->undo_log);
+
+    // modify: the saved copy shares the key buffers with the live instance
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_save_instance(repr, iid1));
+    sec_instance_t *modified = find_instance(repr, iid1);
+    AVS_UNIT_ASSERT_NOT_NULL(modified);
+    modified->ssid = 42;
+    AVS_UNIT_ASSERT_NOT_NULL(repr->undo_log);
+    AVS_UNIT_ASSERT_NOT_NULL(repr->undo_log->saved);
+    AVS_UNIT_ASSERT_TRUE(
+            repr->undo_log->saved->private_cert_or_psk_key.value.data.data
+            == modified->private_cert_or_psk_key.value.data.data);
+    // saving an instance again does not overwrite its original state
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_save_instance(repr, iid1));
+    AVS_UNIT_ASSERT_EQUAL(repr->undo_log->saved->ssid, instance1.ssid);
+
+    // remove and create
+    AVS_UNIT_ASSERT_SUCCESS(
+            sec_instance_remove(anjay_unlocked, *obj_ptr, iid2));
+    AVS_UNIT_ASSERT_SUCCESS(sec_instance_create(anjay_unlocked, *obj_ptr, 3));
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->undo_log), 3);
+    AVS_UNIT_ASSERT_FALSE(repr->has_saved_instances);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_rollback_impl(repr));
+
+    AVS_UNIT_ASSERT_NULL(repr->undo_log);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->instances), 2);
+    const sec_instance_t *restored = repr->instances;
+    AVS_UNIT_ASSERT_EQUAL(restored->iid, iid1);
+    AVS_UNIT_ASSERT_EQUAL(restored->ssid, instance1.ssid);
+    AVS_UNIT_ASSERT_EQUAL_STRING(restored->server_uri, instance1.server_uri);
+    // the restored instance is the only owner of the key buffers again
+    AVS_UNIT_ASSERT_EQUAL(restored->public_cert_or_psk_identity.type,
+                          SEC_KEY_AS_DATA);
+    AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(
+            restored->public_cert_or_psk_identity.value.data.data, IDENTITY,
+            sizeof(IDENTITY) - 1);
+    AVS_UNIT_ASSERT_NULL(restored->public_cert_or_psk_identity.prev_ref);
+    AVS_UNIT_ASSERT_NULL(restored->public_cert_or_psk_identity.next_ref);
+    AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(
+            restored->private_cert_or_psk_key.value.data.data, KEY,
+            sizeof(KEY) - 1);
+    AVS_UNIT_ASSERT_NULL(restored->private_cert_or_psk_key.prev_ref);
+    AVS_UNIT_ASSERT_NULL(restored->private_cert_or_psk_key.next_ref);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(repr->instances)->iid, iid2);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(repr->instances)->ssid,
+                          instance2.ssid);
+    ANJAY_MUTEX_UNLOCK(env->anjay);
+}
+
+AVS_UNIT_TEST(security_object_api, rollback_after_instance_reset) {
+    SCOPED_SERVER_TEST_ENV(env);
+    static const char IDENTITY[] = "identity";
+    anjay_security_instance_t psk_instance = instance1;
+    psk_instance.security_mode = ANJAY_SECURITY_PSK;
+    psk_instance.public_cert_or_psk_identity = (const uint8_t *) IDENTITY;
+    psk_instance.public_cert_or_psk_identity_size = sizeof(IDENTITY) - 1;
+    anjay_iid_t iid = 1;
+    AVS_UNIT_ASSERT_SUCCESS(anjay_security_object_add_instance(
+            env->anjay, &psk_instance, &iid));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, env->anjay);
+    const anjay_dm_installed_object_t *obj_ptr =
+            _anjay_dm_find_object_by_oid(anjay_unlocked,
+                                         ANJAY_DM_OID_SECURITY);
+    AVS_UNIT_ASSERT_NOT_NULL(obj_ptr);
+    sec_repr_t *repr = _anjay_sec_get(*obj_ptr);
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_begin_impl(repr));
+    // resetting drops the live reference to the key buffer, leaving the saved
+    // copy as its only owner
+    AVS_UNIT_ASSERT_SUCCESS(sec_instance_reset(anjay_unlocked, *obj_ptr, iid));
+    AVS_UNIT_ASSERT_NULL(repr->instances->server_uri);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->undo_log), 1);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_sec_transaction_rollback_impl(repr));
+
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->instances), 1);
+    AVS_UNIT_ASSERT_EQUAL(repr->instances->iid, iid);
+    AVS_UNIT_ASSERT_EQUAL_STRING(repr->instances->server_uri,
+                                 instance1.server_uri);
+    AVS_UNIT_ASSERT_EQUAL_BYTES_SIZED(
+            repr->instances->public_cert_or_psk_identity.value.data.data,
+            IDENTITY, sizeof(IDENTITY) - 1);
+    ANJAY_MUTEX_UNLOCK(env->anjay);
+}
@@ -89,3 +89,37 @@ AVS_UNIT_TEST(server_object_api, set_lifetime) {
     AVS_UNIT_ASSERT_SUCCESS(
             anjay_server_object_set_lifetime(env->anjay, iid, 1234));
 }
+
+AVS_UNIT_TEST(server_object_api, rollback_restores_only_touched_instances) {
+    SCOPED_SERVER_TEST_ENV(env);
+    anjay_iid_t iid1 = 1;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_server_object_add_instance(env->anjay, &instance1, &iid1));
+    anjay_iid_t iid2 = 2;
+    AVS_UNIT_ASSERT_SUCCESS(
+            anjay_server_object_add_instance(env->anjay, &instance2, &iid2));
+
+    ANJAY_MUTEX_LOCK(anjay_unlocked, env->anjay);
+    const anjay_dm_installed_object_t *obj_ptr =
+            _anjay_dm_find_object_by_oid(anjay_unlocked, ANJAY_DM_OID_SERVER);
+    AVS_UNIT_ASSERT_NOT_NULL(obj_ptr);
+    server_repr_t *repr = _anjay_serv_get(*obj_ptr);
+
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_serv_transaction_begin_impl(repr));
+    AVS_UNIT_ASSERT_NULL(repr->undo_log);
+    AVS_UNIT_ASSERT_SUCCESS(
+            serv_instance_remove(anjay_unlocked, *obj_ptr, iid1));
+    AVS_UNIT_ASSERT_SUCCESS(
+            serv_instance_create(anjay_unlocked, *obj_ptr, 3));
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->undo_log), 2);
+    AVS_UNIT_ASSERT_FALSE(repr->has_saved_instances);
+    AVS_UNIT_ASSERT_SUCCESS(_anjay_serv_transaction_rollback_impl(repr));
+
+    AVS_UNIT_ASSERT_NULL(repr->undo_log);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_SIZE(repr->instances), 2);
+    AVS_UNIT_ASSERT_EQUAL(repr->instances->iid, iid1);
+    AVS_UNIT_ASSERT_EQUAL(repr->instances->ssid, instance1.ssid);
+    AVS_UNIT_ASSERT_EQUAL(repr->instances->lifetime, instance1.lifetime);
+    AVS_UNIT_ASSERT_EQUAL(AVS_LIST_NEXT(repr->instances)->iid, iid2);
+    ANJAY_MUTEX_UNLOCK(env->anjay);
+}
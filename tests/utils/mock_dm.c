@@ -36,7 +36,10 @@ typedef enum {
     MOCK_DM_RESOURCE_READ_ATTRS,
     MOCK_DM_RESOURCE_WRITE_ATTRS,
     MOCK_DM_RESOURCE_INSTANCE_READ_ATTRS,
-    MOCK_DM_RESOURCE_INSTANCE_WRITE_ATTRS
+    MOCK_DM_RESOURCE_INSTANCE_WRITE_ATTRS,
+    MOCK_DM_INSTANCE_PRESENT,
+    MOCK_DM_RESOURCE_PRESENT,
+    MOCK_DM_INSTANCE_READ
 } anjay_mock_dm_expected_command_type_t;
 
 typedef struct {
@@ -80,6 +83,9 @@ typedef struct {
         const anjay_mock_dm_execute_data_t *execute_data;
         anjay_dm_oi_attributes_t common_attributes;
         anjay_dm_r_attributes_t resource_attributes;
+        bool present;
+        anjay_mock_dm_res_entry_t res_entry;
+        anjay_mock_dm_res_value_t *res_values;
     } value;
     int retval;
 } anjay_mock_dm_expected_command_t;
@@ -227,6 +233,31 @@ int _anjay_mock_dm_list_resources(anjay_t *anjay,
     return retval;
 }
 
+int _anjay_mock_dm_instance_present(anjay_t *anjay,
+                                    const anjay_dm_object_def_t *const *obj_ptr,
+                                    anjay_iid_t iid,
+                                    bool *out_present) {
+    DM_ACTION_COMMON(INSTANCE_PRESENT);
+    AVS_UNIT_ASSERT_EQUAL(iid, EXPECTED_COMMANDS->input.iid);
+    *out_present = EXPECTED_COMMANDS->value.present;
+    DM_ACTION_RETURN;
+}
+
+int _anjay_mock_dm_resource_present(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        anjay_dm_resource_kind_t *out_kind,
+        anjay_dm_resource_presence_t *out_presence) {
+    DM_ACTION_COMMON(RESOURCE_PRESENT);
+    AVS_UNIT_ASSERT_EQUAL(iid, EXPECTED_COMMANDS->input.iid_and_rid.iid);
+    AVS_UNIT_ASSERT_EQUAL(rid, EXPECTED_COMMANDS->input.iid_and_rid.rid);
+    *out_kind = EXPECTED_COMMANDS->value.res_entry.kind;
+    *out_presence = EXPECTED_COMMANDS->value.res_entry.presence;
+    DM_ACTION_RETURN;
+}
+
 static void perform_output(anjay_output_ctx_t *ctx,
                            const anjay_mock_dm_data_t *output) {
     int retval;
@@ -276,6 +307,31 @@ int _anjay_mock_dm_resource_read(anjay_t *anjay,
     DM_ACTION_RETURN;
 }
 
+int _anjay_mock_dm_instance_read(anjay_t *anjay,
+                                 const anjay_dm_object_def_t *const *obj_ptr,
+                                 anjay_iid_t iid,
+                                 anjay_output_ctx_t *ctx) {
+    DM_ACTION_COMMON(INSTANCE_READ);
+    AVS_UNIT_ASSERT_EQUAL(iid, EXPECTED_COMMANDS->input.iid);
+    int result = 0;
+    for (const anjay_mock_dm_res_value_t *res =
+                 EXPECTED_COMMANDS->value.res_values;
+         !result && res->rid != ANJAY_ID_INVALID;
+         ++res) {
+        if (!(result = anjay_ret_resource_path(ctx, res->rid,
+                                               ANJAY_ID_INVALID))) {
+            perform_output(ctx, res->data);
+        }
+    }
+    avs_free(EXPECTED_COMMANDS->value.res_values);
+    if (result) {
+        // the handler is expected to fail with the error returned by
+        // anjay_ret_resource_path()
+        AVS_UNIT_ASSERT_EQUAL(result, EXPECTED_COMMANDS->retval);
+    }
+    DM_ACTION_RETURN;
+}
+
 static void perform_input(anjay_input_ctx_t *ctx,
                           const anjay_mock_dm_data_t *input) {
     int retval = 0;
@@ -669,6 +725,64 @@ void _anjay_mock_dm_expect_list_resources(
     command->retval = retval;
 }
 
+void _anjay_mock_dm_expect_instance_present(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        int retval,
+        bool present) {
+    anjay_mock_dm_expected_command_t *command =
+            NEW_EXPECTED_COMMAND(MOCK_DM_INSTANCE_PRESENT);
+    command->anjay = anjay;
+    command->obj_ptr = obj_ptr;
+    command->input.iid = iid;
+    command->retval = retval;
+    command->value.present = present;
+}
+
+void _anjay_mock_dm_expect_resource_present(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        int retval,
+        anjay_dm_resource_kind_t kind,
+        anjay_dm_resource_presence_t presence) {
+    anjay_mock_dm_expected_command_t *command =
+            NEW_EXPECTED_COMMAND(MOCK_DM_RESOURCE_PRESENT);
+    command->anjay = anjay;
+    command->obj_ptr = obj_ptr;
+    command->input.iid_and_rid.iid = iid;
+    command->input.iid_and_rid.rid = rid;
+    command->retval = retval;
+    command->value.res_entry.rid = rid;
+    command->value.res_entry.kind = kind;
+    command->value.res_entry.presence = presence;
+}
+
+void _anjay_mock_dm_expect_instance_read(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        int retval,
+        const anjay_mock_dm_res_value_t *values) {
+    anjay_mock_dm_expected_command_t *command =
+            NEW_EXPECTED_COMMAND(MOCK_DM_INSTANCE_READ);
+    command->anjay = anjay;
+    command->obj_ptr = obj_ptr;
+    command->input.iid = iid;
+    size_t array_size = 1;
+    while (values[array_size - 1].rid != ANJAY_ID_INVALID) {
+        ++array_size;
+    }
+    command->value.res_values =
+            avs_malloc(array_size * sizeof(anjay_mock_dm_res_value_t));
+    AVS_UNIT_ASSERT_NOT_NULL(command->value.res_values);
+    memcpy(command->value.res_values, values,
+           array_size * sizeof(anjay_mock_dm_res_value_t));
+    command->retval = retval;
+}
+
 #define EXPECT_RESOURCE_ACTION_COMMON(UName)                \
     anjay_mock_dm_expected_command_t *command =             \
             NEW_EXPECTED_COMMAND(MOCK_DM_RESOURCE_##UName); \
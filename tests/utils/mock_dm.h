@@ -156,6 +156,14 @@ typedef struct {
 #define ANJAY_MOCK_DM_RES_END \
     { ANJAY_ID_INVALID, ANJAY_DM_RES_R, ANJAY_DM_RES_ABSENT }
 
+typedef struct {
+    anjay_rid_t rid;
+    const anjay_mock_dm_data_t *data;
+} anjay_mock_dm_res_value_t;
+
+#define ANJAY_MOCK_DM_RES_VALUES_END \
+    { ANJAY_ID_INVALID, NULL }
+
 anjay_dm_object_read_default_attrs_t _anjay_mock_dm_object_read_default_attrs;
 anjay_dm_object_write_default_attrs_t _anjay_mock_dm_object_write_default_attrs;
 anjay_dm_instance_reset_t _anjay_mock_dm_instance_reset;
@@ -180,6 +188,9 @@ anjay_dm_resource_instance_read_attrs_t
 anjay_dm_resource_instance_write_attrs_t
         _anjay_mock_dm_resource_instance_write_attrs;
 #endif // ANJAY_WITH_LWM2M11
+anjay_dm_instance_present_t _anjay_mock_dm_instance_present;
+anjay_dm_resource_present_t _anjay_mock_dm_resource_present;
+anjay_dm_instance_read_t _anjay_mock_dm_instance_read;
 
 #define ANJAY_MOCK_DM_HANDLERS_BASIC                     \
     .list_instances = _anjay_mock_dm_list_instances,     \
@@ -284,6 +295,26 @@ void _anjay_mock_dm_expect_list_resources(
         anjay_iid_t iid,
         int retval,
         const anjay_mock_dm_res_entry_t *res_array);
+void _anjay_mock_dm_expect_instance_present(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        int retval,
+        bool present);
+void _anjay_mock_dm_expect_resource_present(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        anjay_rid_t rid,
+        int retval,
+        anjay_dm_resource_kind_t kind,
+        anjay_dm_resource_presence_t presence);
+void _anjay_mock_dm_expect_instance_read(
+        anjay_t *anjay,
+        const anjay_dm_object_def_t *const *obj_ptr,
+        anjay_iid_t iid,
+        int retval,
+        const anjay_mock_dm_res_value_t *values);
 void _anjay_mock_dm_expect_resource_read(
         anjay_t *anjay,
         const anjay_dm_object_def_t *const *obj_ptr,